@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/helper/beamforming-helper-base.h"
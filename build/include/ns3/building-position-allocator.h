@@ -0,0 +1 @@
+#include "/root/repo/src/buildings/helper/building-position-allocator.h"
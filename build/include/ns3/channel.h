@@ -0,0 +1 @@
+#include "/root/repo/src/network/model/channel.h"
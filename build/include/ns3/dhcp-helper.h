@@ -0,0 +1 @@
+#include "/root/repo/src/internet-apps/helper/dhcp-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/utils/distance-based-three-gpp-spectrum-propagation-loss-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/fdbet-ff-mac-scheduler.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/fdmt-ff-mac-scheduler.h"
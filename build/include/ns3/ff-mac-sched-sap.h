@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/ff-mac-sched-sap.h"
@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/helper/file-scenario-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/helper/grid-scenario-helper.h"
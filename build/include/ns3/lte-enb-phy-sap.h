@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/lte-enb-phy-sap.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/lte-ffr-distributed-algorithm.h"
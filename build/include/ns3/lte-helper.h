@@ -0,0 +1 @@
+#include "/root/repo/src/lte/helper/lte-helper.h"
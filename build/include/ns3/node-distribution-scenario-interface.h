@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/helper/node-distribution-scenario-interface.h"
@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/helper/nr-bearer-stats-simple.h"
@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/helper/nr-gfbr-prediction-stage.h"
@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/helper/nr-radio-environment-map-helper.h"
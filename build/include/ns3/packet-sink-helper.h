@@ -0,0 +1 @@
+#include "/root/repo/src/applications/helper/packet-sink-helper.h"
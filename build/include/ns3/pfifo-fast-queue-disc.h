@@ -0,0 +1 @@
+#include "/root/repo/src/traffic-control/model/pfifo-fast-queue-disc.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/propagation/model/propagation-delay-model.h"
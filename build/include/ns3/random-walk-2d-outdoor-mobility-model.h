@@ -0,0 +1 @@
+#include "/root/repo/src/buildings/model/random-walk-2d-outdoor-mobility-model.h"
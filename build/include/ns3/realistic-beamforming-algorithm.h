@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/model/realistic-beamforming-algorithm.h"
@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/helper/scenario-parameters.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/tcp-veno.h"
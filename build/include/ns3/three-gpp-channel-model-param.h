@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/utils/three-gpp-channel-model-param.h"
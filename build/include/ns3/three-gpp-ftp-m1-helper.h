@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/helper/three-gpp-ftp-m1-helper.h"
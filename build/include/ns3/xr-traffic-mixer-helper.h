@@ -0,0 +1 @@
+#include "/root/repo/contrib/nr/utils/traffic-generators/helper/xr-traffic-mixer-helper.h"
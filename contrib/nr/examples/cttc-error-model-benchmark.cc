@@ -0,0 +1,141 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/core-module.h"
+#include "ns3/nr-module.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * \file cttc-error-model-benchmark.cc
+ * \ingroup examples
+ * \brief Error model microbenchmark: decode time of a TB.
+ *
+ * This example measures the time that the error models take to compute the
+ * decodification statistics of a TB (NrErrorModel::GetTbDecodificationStats),
+ * which the PHY calls for every TB received, and the time of the CQI feedback
+ * of the ErrorModel AMC, which calls the error model for several MCSs.
+ *
+ * The TB occupies all the RBs of the band (by default 273, the maximum
+ * bandwidth of NR in FR1), with a frequency-selective SINR. The time is
+ * reported for every error model and for every instruction set of the
+ * effective SINR kernels (NrSinrKernels) supported by the CPU.
+ *
+ * There is no simulation: the example only calls the error models. To run it
+ * with the default configuration one shall run the following in the command
+ * line:
+ *
+ * ./ns3 run cttc-error-model-benchmark
+ *
+ * The build should be optimized (./ns3 configure --build-profile=optimized)
+ * for the times to be meaningful.
+ */
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t numRbs = 273;
+    uint32_t iterations = 20000;
+    double sinrDb = 15.0;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("numRbs", "Number of RBs of the band, all assigned to the TB", numRbs);
+    cmd.AddValue("iterations", "Number of TBs decoded for each measure", iterations);
+    cmd.AddValue("sinrDb", "Average SINR of the RBs, in dB", sinrDb);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(numRbs == 0 || iterations == 0, "numRbs and iterations must be positive");
+
+    std::vector<double> freqs;
+    std::vector<int> map;
+    for (uint32_t rb = 0; rb < numRbs; ++rb)
+    {
+        freqs.push_back(3.5e9 + rb * 180e3);
+        map.push_back(rb);
+    }
+    SpectrumValue sinr(Create<SpectrumModel>(freqs));
+    for (uint32_t rb = 0; rb < numRbs; ++rb)
+    {
+        sinr[rb] = std::pow(10.0, (sinrDb + 6.0 * std::sin(0.3 * rb)) / 10.0);
+    }
+
+    const NrSinrKernels::Isa defaultIsa = NrSinrKernels::GetIsa();
+
+    std::cout << numRbs << " RBs, average SINR " << sinrDb << " dB, " << iterations
+              << " iterations" << std::endl;
+    std::cout << std::left << std::setw(22) << "Error model" << std::setw(10) << "ISA"
+              << std::right << std::setw(12) << "Decode [ns]" << std::setw(12) << "CQI [ns]"
+              << std::endl;
+
+    for (const auto& errorModelType : {NrEesmCcT1::GetTypeId(),
+                                       NrEesmCcT2::GetTypeId(),
+                                       NrEesmIrT1::GetTypeId(),
+                                       NrEesmIrT2::GetTypeId(),
+                                       NrLteMiErrorModel::GetTypeId()})
+    {
+        ObjectFactory factory;
+        factory.SetTypeId(errorModelType);
+        Ptr<NrErrorModel> errorModel = DynamicCast<NrErrorModel>(factory.Create());
+
+        Ptr<NrAmc> amc = CreateObject<NrAmc>();
+        amc->SetAttribute("AmcModel", EnumValue(NrAmc::ErrorModel));
+        amc->SetErrorModelType(errorModelType);
+        amc->SetDlMode();
+
+        const uint8_t mcs = errorModel->GetMaxMcs() / 2;
+        const uint32_t tbSize = amc->CalculateTbSize(mcs, numRbs);
+
+        for (auto isa : {NrSinrKernels::SCALAR, NrSinrKernels::AVX2, NrSinrKernels::AVX512F})
+        {
+            if (!NrSinrKernels::IsSupported(isa))
+            {
+                continue;
+            }
+            NrSinrKernels::SetIsa(isa);
+
+            double tbler = 0.0;
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < iterations; ++i)
+            {
+                tbler += errorModel
+                             ->GetTbDecodificationStats(sinr,
+                                                        map,
+                                                        tbSize,
+                                                        mcs,
+                                                        NrErrorModel::NrErrorModelHistory())
+                             ->m_tbler;
+            }
+            auto decode = std::chrono::steady_clock::now() - start;
+
+            uint32_t cqiSum = 0;
+            start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < iterations; ++i)
+            {
+                uint8_t cqiMcs = 0;
+                cqiSum += amc->CreateCqiFeedbackWbTdma(sinr, cqiMcs);
+            }
+            auto cqi = std::chrono::steady_clock::now() - start;
+
+            // The results are printed, so that the loops are not optimized away
+            std::cout << std::left << std::setw(22) << errorModelType.GetName().substr(5)
+                      << std::setw(10) << NrSinrKernels::GetIsaName(isa) << std::right
+                      << std::setw(12) << std::fixed << std::setprecision(1)
+                      << std::chrono::duration<double, std::nano>(decode).count() / iterations
+                      << std::setw(12)
+                      << std::chrono::duration<double, std::nano>(cqi).count() / iterations
+                      << "   (TBLER " << std::setprecision(4) << tbler / iterations << ", CQI "
+                      << cqiSum / iterations << ")" << std::endl;
+        }
+    }
+
+    NrSinrKernels::SetIsa(defaultIsa);
+    return 0;
+}
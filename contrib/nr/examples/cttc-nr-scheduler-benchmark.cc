@@ -0,0 +1,719 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "ns3/core-module.h"
+#include "ns3/nr-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+/**
+ * \file cttc-nr-scheduler-benchmark.cc
+ * \ingroup examples
+ * \brief MAC scheduler microbenchmark: time of the DL and UL scheduling of a slot.
+ *
+ * This example measures the time that the MAC schedulers (NrMacSchedulerNs3
+ * subclasses) take to schedule a slot, that is, the time spent inside
+ * NrMacSchedSapProvider::SchedDlTriggerReq and
+ * NrMacSchedSapProvider::SchedUlTriggerReq, for a number of UEs.
+ *
+ * There is no simulation, MAC or PHY: the scheduler is connected to stubs of
+ * NrMacSchedSapUser and NrMacCschedSapUser, and the example plays the role of
+ * the gNB MAC. Every slot it feeds the scheduler with synthetic reports, in
+ * the order of NrGnbMac:
+ *
+ * - the UL CQI of the UL data of the slot (PUSCH SINR of the UE);
+ * - the DL wideband CQI of the UEs whose report is due, which varies
+ *   randomly around the average CQI of each UE;
+ * - the RLC buffer status (DL) and the BSR (UL) of the UEs whose buffer
+ *   changed, with packets of 1500 bytes arriving at the rate "rate", minus
+ *   the new data of the TBs assigned by the scheduler;
+ * - the HARQ feedback of the TBs, which are NACKed with probability "bler".
+ *
+ * Then it triggers the UL scheduling of slot n + 2 and the DL scheduling of
+ * slot n, all the slots being of type F.
+ *
+ * For every scheduler and number of UEs, the example prints the mean, the
+ * 50th, 90th and 99th percentiles and the maximum of the time of the DL and
+ * UL triggers, and the data allocations (DCIs) and bytes per slot. With
+ * "outputFile" the same results are appended to a CSV file, to track
+ * regressions between builds. The reports are generated from a random
+ * stream that does not depend on the scheduler, but the feedback loop (the
+ * buffers depend on the allocations) makes the workload of every scheduler
+ * slightly different.
+ *
+ * To run it with the default configuration one shall run the following in
+ * the command line:
+ *
+ * ./ns3 run cttc-nr-scheduler-benchmark
+ *
+ * or, to benchmark only some schedulers:
+ *
+ * ./ns3 run "cttc-nr-scheduler-benchmark --schedulers=OfdmaPF,OfdmaDPP --numUes=20,200"
+ *
+ * The build should be optimized (./ns3 configure --build-profile=optimized)
+ * for the times to be meaningful.
+ */
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * \brief Stub of the MAC as seen by the scheduler (SCHED SAP)
+ *
+ * It describes the cell to the scheduler and keeps the data DCIs of the last
+ * scheduling decision.
+ */
+class BenchSchedSapUser : public NrMacSchedSapUser
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param model the spectrum model of the BWP, one band per RB
+     * \param numRbPerRbg the number of RBs per RBG
+     * \param slotPeriod the slot period
+     */
+    BenchSchedSapUser(const Ptr<const SpectrumModel>& model,
+                      uint32_t numRbPerRbg,
+                      const Time& slotPeriod)
+        : m_model(model),
+          m_numRbPerRbg(numRbPerRbg),
+          m_slotPeriod(slotPeriod)
+    {
+    }
+
+    void SchedConfigInd(const struct SchedConfigIndParameters& params) override
+    {
+        m_dataDci.clear();
+        for (const auto& varTti : params.m_slotAllocInfo.m_varTtiAllocInfo)
+        {
+            if (varTti.m_dci->m_type == DciInfoElementTdma::DATA)
+            {
+                m_dataDci.push_back(varTti.m_dci);
+            }
+        }
+    }
+
+    Ptr<const SpectrumModel> GetSpectrumModel() const override
+    {
+        return m_model;
+    }
+
+    uint32_t GetNumRbPerRbg() const override
+    {
+        return m_numRbPerRbg;
+    }
+
+    uint8_t GetNumHarqProcess() const override
+    {
+        return 16;
+    }
+
+    uint16_t GetBwpId() const override
+    {
+        return 0;
+    }
+
+    uint16_t GetCellId() const override
+    {
+        return 1;
+    }
+
+    uint32_t GetSymbolsPerSlot() const override
+    {
+        return 14;
+    }
+
+    Time GetSlotPeriod() const override
+    {
+        return m_slotPeriod;
+    }
+
+    /**
+     * \brief Get the data DCIs of the last scheduled slot
+     * \return the data DCIs
+     */
+    const std::vector<std::shared_ptr<DciInfoElementTdma>>& GetDataDci() const
+    {
+        return m_dataDci;
+    }
+
+  private:
+    Ptr<const SpectrumModel> m_model;                           //!< Spectrum model
+    uint32_t m_numRbPerRbg;                                     //!< RBs per RBG
+    Time m_slotPeriod;                                          //!< Slot period
+    std::vector<std::shared_ptr<DciInfoElementTdma>> m_dataDci; //!< Data DCIs of the last slot
+};
+
+/**
+ * \brief Stub of the MAC as seen by the scheduler (CSCHED SAP): it ignores
+ * all the confirmations
+ */
+class BenchCschedSapUser : public NrMacCschedSapUser
+{
+  public:
+    void CschedCellConfigCnf(
+        [[maybe_unused]] const struct CschedCellConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigCnf(
+        [[maybe_unused]] const struct CschedUeConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcConfigCnf(
+        [[maybe_unused]] const struct CschedLcConfigCnfParameters& params) override
+    {
+    }
+
+    void CschedLcReleaseCnf(
+        [[maybe_unused]] const struct CschedLcReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeReleaseCnf(
+        [[maybe_unused]] const struct CschedUeReleaseCnfParameters& params) override
+    {
+    }
+
+    void CschedUeConfigUpdateInd(
+        [[maybe_unused]] const struct CschedUeConfigUpdateIndParameters& params) override
+    {
+    }
+
+    void CschedCellConfigUpdateInd(
+        [[maybe_unused]] const struct CschedCellConfigUpdateIndParameters& params) override
+    {
+    }
+};
+
+/**
+ * \brief Configuration of a benchmark run
+ */
+struct BenchConfig
+{
+    uint32_t numRbs{273};    //!< RBs of the BWP
+    uint32_t numRbPerRbg{1}; //!< RBs per RBG
+    uint16_t numerology{1};  //!< Numerology
+    uint32_t numBeams{4};    //!< Beams among which the UEs are distributed
+    uint32_t slots{4000};    //!< Measured slots
+    uint32_t warmup{200};    //!< Slots before the measures
+    double rate{5e6};        //!< Offered traffic per UE and direction, in bit/s
+    double bler{0.1};        //!< Probability of NACK of a TB
+    uint64_t gfbr{2000000};  //!< GFBR of the LC of every UE, in bit/s
+    uint32_t cqiPeriod{5};   //!< Slots between two DL CQI reports of a UE
+    uint32_t harqDelay{4};   //!< Slots between a DL TB and its feedback
+};
+
+/**
+ * \brief Results of a benchmark run
+ */
+struct BenchResult
+{
+    std::vector<double> dlUs; //!< Time of each DL trigger, in us
+    std::vector<double> ulUs; //!< Time of each UL trigger, in us
+    uint64_t dlAllocs{0};     //!< DL data DCIs
+    uint64_t ulAllocs{0};     //!< UL data DCIs
+    uint64_t dlBytes{0};      //!< DL TB bytes (new data and retransmissions)
+    uint64_t ulBytes{0};      //!< UL TB bytes (new data and retransmissions)
+};
+
+/**
+ * \brief Synthetic state of a UE
+ */
+struct BenchUe
+{
+    uint16_t rnti{0};         //!< RNTI
+    double meanCqi{0.0};      //!< Average DL CQI
+    uint8_t cqi{0};           //!< Last reported DL CQI
+    std::vector<double> sinr; //!< Linear UL SINR, per RB
+    uint32_t dlBuffer{0};     //!< DL RLC buffer, in bytes
+    uint32_t ulBuffer{0};     //!< UL buffer, in bytes
+    bool dlChanged{false};    //!< Whether the DL buffer changed since the last report
+    bool ulChanged{false};    //!< Whether the UL buffer changed since the last BSR
+};
+
+const uint8_t BENCH_LC_ID = 4;   //!< LC of the UEs
+const uint8_t BENCH_LCG_ID = 1;  //!< LCG of the LC of the UEs
+const uint32_t BENCH_PKT = 1500; //!< Size of the synthetic packets
+
+/**
+ * \brief Get a percentile of a set of samples, with the nearest-rank method
+ * \param sorted the samples, sorted
+ * \param p the percentile, in (0, 100]
+ * \return the percentile
+ */
+double
+Percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted.at(std::max<std::size_t>(rank, 1) - 1);
+}
+
+/**
+ * \brief Run the benchmark of a scheduler
+ * \param type the scheduler type
+ * \param numUes the number of UEs
+ * \param conf the configuration
+ * \return the times and allocations
+ */
+BenchResult
+RunScheduler(const TypeId& type, uint32_t numUes, const BenchConfig& conf)
+{
+    const Time slotPeriod = Seconds(1e-3 / (1 << conf.numerology));
+    const double rbWidth = 12 * 15e3 * (1 << conf.numerology);
+    std::vector<double> freqs;
+    for (uint32_t rb = 0; rb < conf.numRbs; ++rb)
+    {
+        freqs.push_back(3.5e9 + rb * rbWidth);
+    }
+    Ptr<const SpectrumModel> model = Create<SpectrumModel>(freqs);
+
+    BenchSchedSapUser schedSapUser(model, conf.numRbPerRbg, slotPeriod);
+    BenchCschedSapUser cschedSapUser;
+
+    ObjectFactory factory;
+    factory.SetTypeId(type);
+    Ptr<NrMacSchedulerNs3> sched = DynamicCast<NrMacSchedulerNs3>(factory.Create());
+    NS_ABORT_MSG_IF(sched == nullptr, "Can't create a NrMacSchedulerNs3 from type " << type);
+    sched->SetMacSchedSapUser(&schedSapUser);
+    sched->SetMacCschedSapUser(&cschedSapUser);
+
+    Ptr<NrAmc> dlAmc = CreateObject<NrAmc>();
+    dlAmc->SetDlMode();
+    Ptr<NrAmc> ulAmc = CreateObject<NrAmc>();
+    ulAmc->SetUlMode();
+    sched->InstallDlAmc(dlAmc);
+    sched->InstallUlAmc(ulAmc);
+
+    Ptr<NrMacSchedulerOfdmaDPP> dpp = DynamicCast<NrMacSchedulerOfdmaDPP>(sched);
+    if (dpp != nullptr)
+    {
+        dpp->SetTimeSlot(slotPeriod.GetSeconds());
+    }
+
+    NrMacSchedSapProvider* sapProvider = sched->GetMacSchedSapProvider();
+    NrMacCschedSapProvider* cschedSapProvider = sched->GetMacCschedSapProvider();
+
+    NrMacCschedSapProvider::CschedCellConfigReqParameters cellConfig{};
+    cellConfig.m_dlBandwidth = static_cast<uint16_t>(conf.numRbs / conf.numRbPerRbg);
+    cellConfig.m_ulBandwidth = cellConfig.m_dlBandwidth;
+    cschedSapProvider->CschedCellConfigReq(cellConfig);
+
+    // The workload is drawn from a stream that does not depend on the scheduler
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    random->SetStream(1);
+
+    std::map<uint16_t, BenchUe> ues;
+    for (uint32_t i = 0; i < numUes; ++i)
+    {
+        BenchUe ue;
+        ue.rnti = static_cast<uint16_t>(i + 1);
+        ue.meanCqi = random->GetValue(4.0, 15.0);
+        ue.cqi = static_cast<uint8_t>(std::lround(ue.meanCqi));
+        double sinrDb = 2.0 * ue.meanCqi - 8.0;
+        double phase = random->GetValue(0.0, 2 * M_PI);
+        for (uint32_t rb = 0; rb < conf.numRbs; ++rb)
+        {
+            ue.sinr.push_back(std::pow(10.0, (sinrDb + 3.0 * std::sin(0.2 * rb + phase)) / 10.0));
+        }
+
+        NrMacCschedSapProvider::CschedUeConfigReqParameters ueConfig{};
+        ueConfig.m_rnti = ue.rnti;
+        ueConfig.m_beamConfId =
+            BeamConfId(BeamId(static_cast<uint16_t>(i % conf.numBeams), 120.0),
+                       BeamId::GetEmptyBeamId());
+        cschedSapProvider->CschedUeConfigReq(ueConfig);
+
+        LogicalChannelConfigListElement_s lc;
+        lc.m_logicalChannelIdentity = BENCH_LC_ID;
+        lc.m_logicalChannelGroup = BENCH_LCG_ID;
+        lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+        lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_GBR;
+        lc.m_qci = 1;
+        lc.m_eRabGuaranteedBitrateDl = conf.gfbr;
+        lc.m_eRabGuaranteedBitrateUl = conf.gfbr;
+        lc.m_eRabMaximulBitrateDl = conf.gfbr;
+        lc.m_eRabMaximulBitrateUl = conf.gfbr;
+        NrMacCschedSapProvider::CschedLcConfigReqParameters lcConfig{};
+        lcConfig.m_rnti = ue.rnti;
+        lcConfig.m_reconfigureFlag = false;
+        lcConfig.m_logicalChannelConfigList.push_back(lc);
+        cschedSapProvider->CschedLcConfigReq(lcConfig);
+
+        if (dpp != nullptr)
+        {
+            dpp->UpdateUeDlLcGfbr(ue.rnti, BENCH_LC_ID, conf.gfbr);
+            dpp->UpdateUeUlGfbr(ue.rnti, conf.gfbr);
+        }
+
+        ues.emplace(ue.rnti, std::move(ue));
+    }
+
+    const double pktProb = conf.rate * slotPeriod.GetSeconds() / (8.0 * BENCH_PKT);
+    NS_ABORT_MSG_IF(pktProb > 1.0, "Rate too high: more than one packet per slot");
+
+    // Feedback to deliver, by slot index
+    std::map<uint32_t, std::vector<DlHarqInfo>> dlHarq;
+    std::map<uint32_t, std::vector<UlHarqInfo>> ulHarq;
+    // UL data to receive (symbol start and UE), by slot index
+    std::map<uint32_t, std::map<uint8_t, uint16_t>> ulData;
+
+    BenchResult result;
+    result.dlUs.reserve(conf.slots);
+    result.ulUs.reserve(conf.slots);
+
+    SfnSf sfn(0, 0, 0, static_cast<uint8_t>(conf.numerology));
+    for (uint32_t n = 0; n < conf.warmup + conf.slots; ++n, sfn.Add(1))
+    {
+        const bool measure = n >= conf.warmup;
+
+        // Traffic
+        for (auto& [rnti, ue] : ues)
+        {
+            if (random->GetValue() < pktProb)
+            {
+                ue.dlBuffer += BENCH_PKT;
+                ue.dlChanged = true;
+            }
+            if (random->GetValue() < pktProb)
+            {
+                ue.ulBuffer += BENCH_PKT;
+                ue.ulChanged = true;
+            }
+        }
+
+        // DL CQI
+        NrMacSchedSapProvider::SchedDlCqiInfoReqParameters dlCqi;
+        dlCqi.m_sfnsf = sfn;
+        for (auto& [rnti, ue] : ues)
+        {
+            if ((n + rnti) % conf.cqiPeriod == 0)
+            {
+                double cqi = ue.meanCqi + random->GetValue(-1.5, 1.5);
+                ue.cqi = static_cast<uint8_t>(std::clamp(std::lround(cqi), 1L, 15L));
+                DlCqiInfo info;
+                info.m_rnti = rnti;
+                info.m_ri = 1;
+                info.m_cqiType = DlCqiInfo::WB;
+                info.m_wbCqi.push_back(ue.cqi);
+                dlCqi.m_cqiList.push_back(info);
+            }
+        }
+        if (!dlCqi.m_cqiList.empty())
+        {
+            sapProvider->SchedDlCqiInfoReq(dlCqi);
+        }
+
+        // RLC buffer status and BSR
+        NrMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters bsr;
+        bsr.m_sfnSf = sfn;
+        for (auto& [rnti, ue] : ues)
+        {
+            if (ue.dlChanged)
+            {
+                NrMacSchedSapProvider::SchedDlRlcBufferReqParameters rlc{};
+                rlc.m_rnti = rnti;
+                rlc.m_logicalChannelIdentity = BENCH_LC_ID;
+                rlc.m_rlcTransmissionQueueSize = ue.dlBuffer;
+                sapProvider->SchedDlRlcBufferReq(rlc);
+                ue.dlChanged = false;
+            }
+            if (ue.ulChanged)
+            {
+                MacCeElement element;
+                element.m_rnti = rnti;
+                element.m_macCeType = MacCeElement::BSR;
+                element.m_macCeValue.m_bufferStatus.resize(4, 0);
+                element.m_macCeValue.m_bufferStatus.at(BENCH_LCG_ID) =
+                    NrMacShortBsrCe::FromBytesToLevel(ue.ulBuffer);
+                bsr.m_macCeList.push_back(element);
+                ue.ulChanged = false;
+            }
+        }
+        if (!bsr.m_macCeList.empty())
+        {
+            sapProvider->SchedUlMacCtrlInfoReq(bsr);
+        }
+
+        // UL scheduling of slot n + 2
+        NrMacSchedSapProvider::SchedUlTriggerReqParameters ulParams;
+        ulParams.m_snfSf = sfn.GetFutureSfnSf(2);
+        ulParams.m_slotType = LteNrTddSlotType::F;
+        if (auto it = ulHarq.find(n); it != ulHarq.end())
+        {
+            ulParams.m_ulHarqInfoList = std::move(it->second);
+            ulHarq.erase(it);
+        }
+        auto start = std::chrono::steady_clock::now();
+        sapProvider->SchedUlTriggerReq(ulParams);
+        auto ulTime = std::chrono::steady_clock::now() - start;
+
+        for (const auto& dci : schedSapUser.GetDataDci())
+        {
+            ulData[n + 2].emplace(dci->m_symStart, dci->m_rnti);
+
+            UlHarqInfo harq;
+            harq.m_rnti = dci->m_rnti;
+            harq.m_harqProcessId = dci->m_harqProcess;
+            harq.m_numRetx = dci->m_rv.at(0);
+            harq.m_receptionStatus =
+                random->GetValue() < conf.bler ? UlHarqInfo::NotOk : UlHarqInfo::Ok;
+            ulHarq[n + 3].push_back(harq);
+
+            auto& ue = ues.at(dci->m_rnti);
+            if (dci->m_ndi.at(0) == 1)
+            {
+                ue.ulBuffer -= std::min(ue.ulBuffer, dci->m_tbSize.at(0));
+                ue.ulChanged = true;
+            }
+            if (measure)
+            {
+                result.ulAllocs++;
+                result.ulBytes += dci->m_tbSize.at(0);
+            }
+        }
+
+        // DL scheduling of slot n
+        NrMacSchedSapProvider::SchedDlTriggerReqParameters dlParams;
+        dlParams.m_snfSf = sfn;
+        dlParams.m_slotType = LteNrTddSlotType::F;
+        if (auto it = dlHarq.find(n); it != dlHarq.end())
+        {
+            dlParams.m_dlHarqInfoList = std::move(it->second);
+            dlHarq.erase(it);
+        }
+        start = std::chrono::steady_clock::now();
+        sapProvider->SchedDlTriggerReq(dlParams);
+        auto dlTime = std::chrono::steady_clock::now() - start;
+
+        for (const auto& dci : schedSapUser.GetDataDci())
+        {
+            DlHarqInfo harq;
+            harq.m_rnti = dci->m_rnti;
+            harq.m_harqProcessId = dci->m_harqProcess;
+            harq.m_bwpIndex = 0;
+            auto& ue = ues.at(dci->m_rnti);
+            for (std::size_t stream = 0; stream < dci->m_tbSize.size(); ++stream)
+            {
+                if (dci->m_tbSize.at(stream) == 0)
+                {
+                    harq.m_harqStatus.push_back(DlHarqInfo::NONE);
+                }
+                else
+                {
+                    harq.m_harqStatus.push_back(random->GetValue() < conf.bler ? DlHarqInfo::NACK
+                                                                               : DlHarqInfo::ACK);
+                }
+                harq.m_numRetx.push_back(dci->m_rv.at(stream));
+
+                if (dci->m_ndi.at(stream) == 1)
+                {
+                    ue.dlBuffer -= std::min(ue.dlBuffer, dci->m_tbSize.at(stream));
+                    ue.dlChanged = true;
+                }
+                if (measure)
+                {
+                    result.dlBytes += dci->m_tbSize.at(stream);
+                }
+            }
+            dlHarq[n + conf.harqDelay].push_back(harq);
+            if (measure)
+            {
+                result.dlAllocs++;
+            }
+        }
+
+        // UL CQI of the UL data of slot n: one per allocated symbol start, as
+        // the scheduler attributes it to all the allocations starting there
+        if (auto it = ulData.find(n); it != ulData.end())
+        {
+            for (const auto& [symStart, rnti] : it->second)
+            {
+                NrMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi;
+                ulCqi.m_sfnSf = sfn;
+                ulCqi.m_symStart = symStart;
+                ulCqi.m_ulCqi.m_type = UlCqiInfo::PUSCH;
+                ulCqi.m_ulCqi.m_sinr = ues.at(rnti).sinr;
+                sapProvider->SchedUlCqiInfoReq(ulCqi);
+            }
+            ulData.erase(it);
+        }
+
+        if (measure)
+        {
+            result.dlUs.push_back(std::chrono::duration<double, std::micro>(dlTime).count());
+            result.ulUs.push_back(std::chrono::duration<double, std::micro>(ulTime).count());
+        }
+    }
+
+    sched->Dispose();
+    return result;
+}
+
+/**
+ * \brief Split a comma-separated list
+ * \param list the list
+ * \return the elements
+ */
+std::vector<std::string>
+Split(const std::string& list)
+{
+    std::vector<std::string> elements;
+    std::stringstream ss(list);
+    std::string element;
+    while (std::getline(ss, element, ','))
+    {
+        if (!element.empty())
+        {
+            elements.push_back(element);
+        }
+    }
+    return elements;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    BenchConfig conf;
+    std::string schedulers =
+        "TdmaRR,TdmaPF,TdmaMR,TdmaQos,OfdmaRR,OfdmaPF,OfdmaMR,OfdmaQos,OfdmaDPP,OfdmaDPPFS,"
+        "OfdmaDPPA";
+    std::string numUesList = "50,100,500";
+    std::string outputFile;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("schedulers",
+                 "Comma-separated list of schedulers, as the suffix of their type "
+                 "(ns3::NrMacScheduler<name>)",
+                 schedulers);
+    cmd.AddValue("numUes", "Comma-separated list of numbers of UEs", numUesList);
+    cmd.AddValue("slots", "Number of measured slots", conf.slots);
+    cmd.AddValue("warmup", "Number of slots before the measures", conf.warmup);
+    cmd.AddValue("numRbs", "Number of RBs of the BWP", conf.numRbs);
+    cmd.AddValue("numRbPerRbg", "Number of RBs per RBG", conf.numRbPerRbg);
+    cmd.AddValue("numerology", "Numerology of the BWP", conf.numerology);
+    cmd.AddValue("numBeams", "Number of beams among which the UEs are distributed", conf.numBeams);
+    cmd.AddValue("rate", "Offered traffic per UE, in DL and in UL, in bit/s", conf.rate);
+    cmd.AddValue("bler", "Probability of a NACK for every TB", conf.bler);
+    cmd.AddValue("gfbr", "GFBR of every UE, in bit/s", conf.gfbr);
+    cmd.AddValue("outputFile",
+                 "CSV file to which the results are appended (none if empty)",
+                 outputFile);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(conf.slots == 0, "slots must be positive");
+    NS_ABORT_MSG_IF(conf.numRbPerRbg == 0 || conf.numRbs < conf.numRbPerRbg,
+                    "numRbs must be at least numRbPerRbg");
+    NS_ABORT_MSG_IF(conf.numBeams == 0, "numBeams must be positive");
+
+    // The schedulers do not run in a simulation: no trace files
+    for (const auto& stream : {"EnableDppG",
+                               "EnableDppQ",
+                               "EnableDppAlpha",
+                               "EnableDppQos",
+                               "EnableDppTbs",
+                               "EnableDppaG",
+                               "EnableDppaQ",
+                               "EnableDppaAlpha",
+                               "EnableDppUlQos"})
+    {
+        Config::SetDefault(std::string("ns3::NrMacSchedulerDppTraceWriter::") + stream,
+                           BooleanValue(false));
+    }
+
+    std::ofstream csv;
+    if (!outputFile.empty())
+    {
+        bool exists = std::ifstream(outputFile).good();
+        csv.open(outputFile, std::ios::app);
+        NS_ABORT_MSG_IF(!csv.is_open(), "Can't open " << outputFile);
+        if (!exists)
+        {
+            csv << "scheduler,numUes,numRbs,numRbPerRbg,slots,"
+                   "dlMeanUs,dlP50Us,dlP90Us,dlP99Us,dlMaxUs,"
+                   "ulMeanUs,ulP50Us,ulP90Us,ulP99Us,ulMaxUs,"
+                   "dlAllocsPerSlot,ulAllocsPerSlot,dlBytesPerSlot,ulBytesPerSlot"
+                << std::endl;
+        }
+    }
+
+    std::cout << conf.numRbs << " RBs, " << conf.numRbPerRbg << " RB per RBG, " << conf.slots
+              << " slots; times in us, data allocations (DCIs) per slot" << std::endl;
+    std::cout << std::left << std::setw(12) << "Scheduler" << std::right << std::setw(6) << "UEs"
+              << std::setw(9) << "DL mean" << std::setw(9) << "DL p50" << std::setw(9) << "DL p90"
+              << std::setw(9) << "DL p99" << std::setw(9) << "DL max" << std::setw(9) << "UL mean"
+              << std::setw(9) << "UL p50" << std::setw(9) << "UL p90" << std::setw(9) << "UL p99"
+              << std::setw(9) << "UL max" << std::setw(10) << "DL alloc" << std::setw(10)
+              << "UL alloc" << std::endl;
+
+    for (const auto& name : Split(schedulers))
+    {
+        TypeId type;
+        NS_ABORT_MSG_IF(!TypeId::LookupByNameFailSafe("ns3::NrMacScheduler" + name, &type),
+                        "Unknown scheduler " << name);
+
+        for (const auto& numUes : Split(numUesList))
+        {
+            BenchResult r = RunScheduler(type, std::stoul(numUes), conf);
+            std::sort(r.dlUs.begin(), r.dlUs.end());
+            std::sort(r.ulUs.begin(), r.ulUs.end());
+
+            std::vector<double> values;
+            for (const auto* times : {&r.dlUs, &r.ulUs})
+            {
+                values.push_back(std::accumulate(times->begin(), times->end(), 0.0) /
+                                 times->size());
+                values.push_back(Percentile(*times, 50));
+                values.push_back(Percentile(*times, 90));
+                values.push_back(Percentile(*times, 99));
+                values.push_back(times->back());
+            }
+            values.push_back(static_cast<double>(r.dlAllocs) / conf.slots);
+            values.push_back(static_cast<double>(r.ulAllocs) / conf.slots);
+
+            std::cout << std::left << std::setw(12) << name << std::right << std::setw(6)
+                      << numUes << std::fixed << std::setprecision(1);
+            for (std::size_t i = 0; i < 10; ++i)
+            {
+                std::cout << std::setw(9) << values.at(i);
+            }
+            std::cout << std::setprecision(2) << std::setw(10) << values.at(10) << std::setw(10)
+                      << values.at(11) << std::endl;
+
+            if (csv.is_open())
+            {
+                csv << name << "," << numUes << "," << conf.numRbs << "," << conf.numRbPerRbg
+                    << "," << conf.slots;
+                for (double v : values)
+                {
+                    csv << "," << v;
+                }
+                csv << "," << static_cast<double>(r.dlBytes) / conf.slots << ","
+                    << static_cast<double>(r.ulBytes) / conf.slots << std::endl;
+            }
+        }
+    }
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,19 @@
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "cttc-nr-traffic-3gpp-xr-qos-sched_sergi.h"
+
+/**
+ * \file cttc-nr-traffic-3gpp-xr-qos-sched_sergi-main.cc
+ * \ingroup examples
+ * \brief Run one configuration of the XR QoS scheduling scenario; see
+ * cttc-nr-traffic-3gpp-xr-qos-sched_sergi.cc for the parameters. To run a
+ * sweep of configurations, use cttc-nr-xr-qos-sched-batch.
+ */
+
+int
+main(int argc, char* argv[])
+{
+    return CttcNrTraffic3gppXrQosSched(argc, argv);
+}
@@ -20,8 +20,9 @@
 #include "ns3/packet-sink.h"
 #include "ns3/point-to-point-module.h"
 #include "ns3/xr-traffic-mixer-helper.h"
-// #include "json.hpp"
-#include "/home/sergi/5glena-lyapunov-mac-scheduler/json.hpp"
+
+#include "cttc-nr-traffic-3gpp-xr-qos-sched_sergi.h"
+#include "../../../json.hpp"
 #include <vector>
 #include <fstream>
 #include <iomanip>
@@ -64,23 +65,16 @@ ParseStringList(const std::string& input)
 
 
 
-struct UeIntervalStats {
-    uint64_t lastRxBytes = 0;
-    uint64_t lastRxPackets = 0;
-    uint64_t lastTxPackets = 0;
-    double lastDelaySumSec = 0;
-};
-
 struct UeDynamicContext {
     Ptr<TrafficGenerator3gppGenericVideo> video;
     Ptr<NrUeNetDevice> ueDev;
     Ptr<PacketSink> sink;
     std::vector<uint64_t> traffic;
     std::vector<uint64_t> gbr;
-    uint32_t index = 0;
-    uint16_t rnti = 0;
     uint32_t jsonId = 0; // <--- ADD THIS
-    UeIntervalStats tracker; // <--- ADD THIS HERE
+    uint32_t kpiIndex = 0; // Index of the UE in the KPI collector
+    uint32_t scheduleIndex = 0; // Index of the UE in the GFBR schedule controller
+    uint32_t predictionIndex = 0; // Index of the UE in the GFBR prediction stage
 };
 
 
@@ -114,125 +108,26 @@ GetQciFromString(const std::string& qciStr)
     }
 
 
-std::map<uint16_t, uint32_t> g_intervalAllocatedRBs;
-
-
-
-namespace ns3 {
-    extern std::map<uint16_t, uint32_t> g_intervalAllocatedRBs;
-}
-
-void MasterLogger(std::vector<UeDynamicContext> *ues,
-                  Ptr<NrMacScheduler> baseSched,
-                  Ptr<FlowMonitor> flowMon,
-                  Ptr<Ipv4FlowClassifier> classifier,
-                  double interval,
-                  std::string filename)
+/**
+ * Write the KPIs of the interval that ends now, with its traffic and GFBR, and
+ * predict the next GFBRs, if online; called by the schedule controller right
+ * before it applies the next traffic (and GFBRs, if from the scenario file)
+ */
+void WriteIntervalKpis(std::vector<UeDynamicContext> *ues,
+                       const NrGfbrScheduleController *controller,
+                       Ptr<NrGfbrPredictionStage> predictionStage,
+                       Ptr<NrUeKpiCollector> kpiCollector)
 {
-    static bool headerWritten = false;
-    std::ofstream unifiedFile;
-    unifiedFile.open(filename, std::ios_base::app);
-
-    if (!headerWritten) {
-        unifiedFile << "Time(s),UE_ID,RNTI,TargetTraffic(Mbps),GFBR(Mbps),MeasuredThroughput(Mbps),MeasuredDelay(ms),PacketRate(pps),DropRate,AllocatedRBGs\n";
-        headerWritten = true;
-    }
-    // 1. DYNAMICALLY FETCH RNTI
-    // By 0.4s, the UEs will be attached and will have an RNTI > 0
-    for (auto &ctx : *ues) {
-        uint16_t currentRnti = ctx.ueDev->GetRrc()->GetRnti();
-        if (currentRnti > 0) {
-            ctx.rnti = currentRnti;
-        }
+    for (const auto &ctx : *ues) {
+        const uint64_t gfbr = predictionStage ? predictionStage->GetGfbr(ctx.predictionIndex)
+                                              : controller->GetGfbr(ctx.scheduleIndex);
+        kpiCollector->SetExtra(ctx.kpiIndex, 0, controller->GetTraffic(ctx.scheduleIndex) / 1e6);
+        kpiCollector->SetExtra(ctx.kpiIndex, 1, gfbr / 1e6);
     }
-    // 1. Sort the vector by RNTI every single tick to ensure 1, 2, 3... order
-   // 2. Change the Sort to use jsonId instead of rnti
-        std::sort(ues->begin(), ues->end(), [](const UeDynamicContext& a, const UeDynamicContext& b) {
-            return a.jsonId < b.jsonId; // <--- Sort by JSON order!
-        });
-
-    double now = Simulator::Now().GetSeconds();
-
-    for (uint32_t i = 0; i < ues->size(); ++i) {
-        UeDynamicContext &ctx = (*ues)[i];
-        // UeIntervalStats *tracker = trackers[i];
-        uint16_t rnti = ctx.rnti;
-
-        // --- CALCULATION LOGIC ---
-        double throughputMbps = 0.0;
-        if (ctx.sink) {
-            uint64_t curRxBytes = ctx.sink->GetTotalRx();
-            throughputMbps = (curRxBytes - ctx.tracker.lastRxBytes) * 8.0 / (interval * 1e6);
-            ctx.tracker.lastRxBytes = curRxBytes;
-        }
-
-        double intervalDelayMs = 0.0;
-        double packetRatePps = 0.0;
-        double dropRateInterval = 0.0;
-
-        Ptr<Ipv4> ipv4 = ctx.ueDev->GetNode()->GetObject<Ipv4>();
-        Ipv4Address ueIp = ipv4->GetAddress(1, 0).GetLocal();
-   
-        std::map<FlowId, FlowMonitor::FlowStats> stats = flowMon->GetFlowStats();
-
-        for (auto const& [id, stat] : stats) {
-            if (classifier->FindFlow(id).destinationAddress == ueIp) {
-                
-                // 1. Cast to signed integers to prevent wrap-around underflow
-                int64_t rxInInterval = static_cast<int64_t>(stat.rxPackets) - static_cast<int64_t>(ctx.tracker.lastRxPackets);
-                int64_t txInInterval = static_cast<int64_t>(stat.txPackets) - static_cast<int64_t>(ctx.tracker.lastTxPackets);
-                
-                // 2. Safely calculate Packet Rate
-                packetRatePps = (rxInInterval > 0) ? static_cast<double>(rxInInterval) / interval : 0.0;
-                
-                // 3. Safely calculate Drop Rate
-                if (txInInterval > 0) {
-                    double loss = static_cast<double>(txInInterval - rxInInterval);
-                    // Only calculate drop rate if loss is actually positive
-                    dropRateInterval = (loss > 0) ? loss / static_cast<double>(txInInterval) : 0.0;
-                } else {
-                    dropRateInterval = 0.0;
-                }
-
-                // 4. Calculate Delay
-                if (rxInInterval > 0) {
-                    intervalDelayMs = ((stat.delaySum.GetSeconds() - ctx.tracker.lastDelaySumSec) / rxInInterval) * 1000.0;
-                }
-                
-                // 5. Save state for next interval
-                ctx.tracker.lastRxPackets = stat.rxPackets;
-                ctx.tracker.lastTxPackets = stat.txPackets;
-                ctx.tracker.lastDelaySumSec = stat.delaySum.GetSeconds();
-                break;
-            }
-        }
-
-        double pastTraffic = (ctx.index > 0) ? (ctx.traffic[ctx.index - 1] / 1e6) : 0.0;
-        double pastGfbr = (ctx.index > 0) ? (ctx.gbr[ctx.index - 1] / 1e6) : 0.0;
-        uint32_t rbgThisInterval = ns3::g_intervalAllocatedRBs[rnti];
-        ns3::g_intervalAllocatedRBs[rnti] = 0;
-
-        // Write the line
-        unifiedFile << now << "," << ctx.jsonId << "," << rnti << "," << pastTraffic << "," << pastGfbr << "," 
-                    << throughputMbps << "," << intervalDelayMs << "," << packetRatePps << "," 
-                    << dropRateInterval << "," << rbgThisInterval << "\n";
-
-        // Update GFBR for next interval
-        if (ctx.index < ctx.traffic.size()) {
-            ctx.video->SetDynamicDataRate(ctx.traffic[ctx.index] / 1e6);
-            // if (auto qosSched = DynamicCast<NrMacSchedulerOfdmaQos>(baseSched)) qosSched->UpdateUeDlGfbr(rnti, ctx.gbr[ctx.index]);
-            if (auto dppSched = DynamicCast<NrMacSchedulerOfdmaDPP>(baseSched)) dppSched->UpdateUeDlGfbr(rnti, ctx.gbr[ctx.index]);
-            ctx.index++;
-        }
+    kpiCollector->WriteInterval();
+    if (predictionStage) {
+        predictionStage->EndInterval();
     }
-    unifiedFile.close();
-
-    // Schedule the next master tick
-    // Simulator::Schedule(Seconds(interval), &MasterLogger, ues, baseSched, flowMon, classifier, trackers, interval, filename);
-    // Re-schedule
-    Simulator::Schedule(Seconds(interval), [=]() {
-        MasterLogger(ues, baseSched, flowMon, classifier, interval, filename);
-    });
 }
 
 void
@@ -366,7 +261,7 @@ return videoPtrs;
 }
 
 int
-main(int argc, char* argv[])
+CttcNrTraffic3gppXrQosSched(int argc, char* argv[])
 {
     // set simulation time and mobility
     uint32_t appDuration = 10000;
@@ -385,6 +280,9 @@ main(int argc, char* argv[])
     double dppV = 0.0;
     bool enableVirtualQueue = true;
 
+    double checkpointInterval = 0.0; // seconds, 0 disables the checkpoints
+    std::string gfbrPredictor = ""; // empty: GFBRs from the scenario file
+
     uint32_t buffersize = 1250000; // in bytes, corresponds to 1 second of buffering at 1 Gbps. Adjust as needed.
 
     double Datarate = 5; // Mbps, default value for the video traffic generator
@@ -465,6 +363,14 @@ main(int argc, char* argv[])
     cmd.AddValue("qosSymPerSec", "Symbols per sec for QoS Scheduler", qosSymbolsPerSec);
     cmd.AddValue("dppTimeSlot", "Timeslot duration for DPP Scheduler", dppTimeSlot);
     cmd.AddValue("buffersize", "Buffer size in bytes for RLC", buffersize);
+    cmd.AddValue("checkpointInterval",
+                 "Simulation time between two checkpoints (seconds), to resume the simulation "
+                 "from the last one if it dies; 0 disables them",
+                 checkpointInterval);
+    cmd.AddValue("gfbrPredictor",
+                 "Online GFBR predictor (e.g., ns3::NrGfbrPredictorEwma, configured through its "
+                 "attributes), instead of the GFBRs of the scenario file; empty to disable it",
+                 gfbrPredictor);
     cmd.Parse(argc, argv);
 
 
@@ -842,7 +748,6 @@ if (!configFile.empty())
         // ctx.gbr = gbrProfile;      
         ctx.traffic = ParseProfile(trafficStrings[i]);
         ctx.gbr = ParseProfile(gbrStrings[i]);     // full vector
-        ctx.index = 0;   // IMPORTANT
         ctx.jsonId = i + 1;
 
         dynamicUes.push_back(ctx);
@@ -900,28 +805,52 @@ std::cout << "dynamicUes size = " << dynamicUes.size() << std::endl;
     double averageFlowThroughput = 0.0;
     double averageFlowDelay = 0.0;
 
-std::sort(dynamicUes.begin(), dynamicUes.end(), [](const UeDynamicContext& a, const UeDynamicContext& b) {
-    return a.ueDev->GetRrc()->GetRnti() < b.ueDev->GetRrc()->GetRnti();
-});
-
-std::vector<UeIntervalStats*> trackers;
-for (uint32_t i = 0; i < dynamicUes.size(); ++i) {
-    // This uses the variable, so the warning disappears
-    dynamicUes[i].rnti = dynamicUes[i].ueDev->GetRrc()->GetRnti();
-    trackers.push_back(new UeIntervalStats());
+// The UEs are in JSON order, which is the order of the rows of the unified stats
+Ptr<NrUeKpiCollector> kpiCollector = CreateObject<NrUeKpiCollector>();
+kpiCollector->OpenFile(unified_name, {"TargetTraffic(Mbps)", "GFBR(Mbps)"});
+for (auto& ctx : dynamicUes) {
+    ctx.kpiIndex = kpiCollector->AddUe(ctx.jsonId, ctx.ueDev, ctx.sink);
+}
+kpiCollector->AddSender(remoteHost);
+if (auto dppSched = DynamicCast<NrMacSchedulerOfdmaDPP>(baseSched)) {
+    kpiCollector->ConnectDppScheduler(dppSched);
 }
 
-auto ues_ptr = &dynamicUes;
-
-// Start the logger
-Simulator::Schedule(Seconds(appStartTimeMs / 1000.0), [=]() {
-    MasterLogger(ues_ptr, 
-                 Ptr<NrMacScheduler>(baseSched), 
-                 monitor, 
-                 classifier, 
-                 (double)interval, 
-                 (std::string)unified_name);
-});
+// The traffic and the GFBR series are applied to all the UEs by a single event
+// per interval, which first writes the KPIs of the interval that ends
+Ptr<NrGfbrScheduleController> gfbrController = CreateObject<NrGfbrScheduleController>();
+for (auto& ctx : dynamicUes) {
+    ctx.scheduleIndex = gfbrController->AddUe(ctx.ueDev, ctx.video, ctx.traffic, ctx.gbr);
+}
+// With an online predictor, the GFBRs follow the load offered in the previous
+// interval instead of the series of the scenario file
+Ptr<NrGfbrPredictionStage> predictionStage;
+if (!gfbrPredictor.empty()) {
+    predictionStage = CreateObject<NrGfbrPredictionStage>();
+    predictionStage->SetAttribute("PredictorType",
+                                  TypeIdValue(TypeId::LookupByName(gfbrPredictor)));
+    for (auto& ctx : dynamicUes) {
+        ctx.predictionIndex = predictionStage->AddUe(ctx.ueDev, ctx.video);
+    }
+}
+if (auto dppSched = DynamicCast<NrMacSchedulerOfdmaDPP>(baseSched)) {
+    if (predictionStage) {
+        predictionStage->SetScheduler(dppSched);
+    } else {
+        gfbrController->SetScheduler(dppSched);
+    }
+}
+gfbrController->SetIntervalEndCallback(MakeBoundCallback(&WriteIntervalKpis,
+                                                         &dynamicUes,
+                                                         PeekPointer(gfbrController),
+                                                         predictionStage,
+                                                         kpiCollector));
+gfbrController->Start(MilliSeconds(appStartTimeMs), Seconds(interval));
+
+Ptr<NrCheckpointHelper> checkpoint = CreateObject<NrCheckpointHelper>();
+checkpoint->SetAttribute("Interval", TimeValue(Seconds(checkpointInterval)));
+checkpoint->AddOutputFile(unified_name);
+checkpoint->Start();
 
 Simulator::Run();
     
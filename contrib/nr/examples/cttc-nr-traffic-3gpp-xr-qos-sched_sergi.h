@@ -0,0 +1,21 @@
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+/**
+ * \ingroup examples
+ * \brief Run the XR QoS scheduling scenario of
+ * cttc-nr-traffic-3gpp-xr-qos-sched_sergi.cc
+ *
+ * The scenario is configured by its command line, exactly as the example
+ * program, so that it can be run both by the example and, one configuration
+ * after another, by the batch driver cttc-nr-xr-qos-sched-batch. The
+ * simulator is destroyed before returning.
+ *
+ * \param argc the number of arguments
+ * \param argv the arguments, starting with the program name
+ * \return the exit code of the scenario
+ */
+int CttcNrTraffic3gppXrQosSched(int argc, char* argv[]);
@@ -0,0 +1,462 @@
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "cttc-nr-traffic-3gpp-xr-qos-sched_sergi.h"
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/log.h"
+
+#include "../../../json.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sched.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * \file cttc-nr-xr-qos-sched-batch.cc
+ * \ingroup examples
+ * \brief Batch driver of the XR QoS scheduling scenario
+ *
+ * Runs every configuration of a sweep of the scenario of
+ * cttc-nr-traffic-3gpp-xr-qos-sched_sergi.cc, without going through
+ * "./ns3 run" for each of them. Each configuration is run in a process forked
+ * from the driver, which calls the scenario in-process, so that every run
+ * starts from a clean simulator and from the default attribute values. Up to
+ * "workers" runs are executed at the same time, each worker pinned to its own
+ * core.
+ *
+ * The sweep is described by a JSON manifest:
+ *
+ * \code{.json}
+ * {
+ *   "outputDir": "final_results",
+ *   "workers": 40,
+ *   "configFiles": ["scenarios/scenario_1gbr_1nongbr_4K.json",
+ *                   "scenarios/scenario_2gbr_2nongbr_4K.json"],
+ *   "schedulers": ["RR", {"name": "DPP", "args": {"dppTimeSlot": 0.5e-3}}],
+ *   "rngRuns": {"first": 11, "last": 100},
+ *   "args": {"appDuration": 450000, "bandwidth": 100e6, "numerology": 1},
+ *   "sweep": {"buffersize": [937500, 1250000]}
+ * }
+ * \endcode
+ *
+ * The runs are the product of the scenario files, the schedulers, the values
+ * of every parameter of "sweep" and the RNG runs ("rngRuns" is either a list or
+ * a range). "args" are passed to all the runs, the "args" of a scheduler only
+ * to its runs. The relative paths of the manifest are relative to the working
+ * directory of the driver.
+ *
+ * Every run writes its unified stats to its own file in "outputDir", named
+ * after the configuration, e.g. scenario_1gbr_1nongbr_4K_DPP_buffersize937500_run11.csv,
+ * and its console output to the same name with the .log extension. The other
+ * files of the scenario (res.txt, the traces of the schedulers such as g.txt,
+ * q.txt or qos_trace.csv, and the traces of the NR helper) have fixed names
+ * and are written to the working directory, so every run works in its own
+ * directory of "outputDir", with the same name. When a run ends successfully,
+ * an empty .done file is created next to them. The driver can be stopped and
+ * started again with the same manifest: the runs with a .done file are
+ * skipped, the incomplete ones are run again from scratch.
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-xr-qos-sched-batch --manifest=sweep.json"
+ * \endcode
+ */
+
+using namespace ns3;
+using json = nlohmann::json;
+
+NS_LOG_COMPONENT_DEFINE("CttcNrXrQosSchedBatch");
+
+namespace
+{
+
+/**
+ * \brief A configuration of the scenario
+ */
+struct Run
+{
+    std::string name;              //!< Name of the run, used for its files
+    std::vector<std::string> args; //!< Command line of the scenario
+};
+
+/**
+ * \brief A run in progress
+ */
+struct Worker
+{
+    std::size_t run;                             //!< Index of the run in the pending runs
+    uint32_t slot;                               //!< Worker slot, which gives the core
+    std::chrono::steady_clock::time_point start; //!< Start time
+};
+
+/**
+ * \brief Get the command line value of a JSON value
+ * \param value the value
+ * \return the value as expected by CommandLine
+ */
+std::string
+ToArg(const json& value)
+{
+    if (value.is_string())
+    {
+        return value.get<std::string>();
+    }
+    if (value.is_boolean())
+    {
+        return value.get<bool>() ? "true" : "false";
+    }
+    NS_ABORT_MSG_UNLESS(value.is_number(), "Unsupported argument value " << value.dump());
+    return value.dump();
+}
+
+/**
+ * \brief Get the RNG runs of the manifest
+ * \param value the "rngRuns" entry, a list or a {"first", "last"} range
+ * \return the RNG runs
+ */
+std::vector<uint32_t>
+GetRngRuns(const json& value)
+{
+    std::vector<uint32_t> runs;
+    if (value.is_array())
+    {
+        for (const auto& run : value)
+        {
+            runs.push_back(run.get<uint32_t>());
+        }
+    }
+    else if (value.is_object())
+    {
+        for (auto run = value.at("first").get<uint32_t>(); run <= value.at("last").get<uint32_t>();
+             ++run)
+        {
+            runs.push_back(run);
+        }
+    }
+    else
+    {
+        runs.push_back(value.get<uint32_t>());
+    }
+    return runs;
+}
+
+/**
+ * \brief Expand the manifest into the list of runs
+ * \param manifest the manifest
+ * \param outputDir the directory of the results
+ * \return the runs
+ */
+std::vector<Run>
+GetRuns(const json& manifest, const std::filesystem::path& outputDir)
+{
+    // Common arguments, then the product of the sweep parameters
+    const json common = manifest.value("args", json::object());
+    const json sweep = manifest.value("sweep", json::object());
+    std::vector<std::string> commonArgs;
+    for (const auto& [key, value] : common.items())
+    {
+        commonArgs.push_back("--" + key + "=" + ToArg(value));
+    }
+    std::vector<std::pair<std::string, std::vector<std::string>>> sweepArgs{{"", {}}};
+    for (const auto& [key, values] : sweep.items())
+    {
+        NS_ABORT_MSG_UNLESS(values.is_array(), "The sweep of " << key << " is not a list");
+        std::vector<std::pair<std::string, std::vector<std::string>>> expanded;
+        for (const auto& [suffix, args] : sweepArgs)
+        {
+            for (const auto& value : values)
+            {
+                auto newArgs = args;
+                newArgs.push_back("--" + key + "=" + ToArg(value));
+                expanded.emplace_back(suffix + "_" + key + ToArg(value), newArgs);
+            }
+        }
+        sweepArgs = std::move(expanded);
+    }
+    const std::vector<uint32_t> rngRuns = GetRngRuns(manifest.at("rngRuns"));
+
+    std::vector<Run> runs;
+    for (const auto& configFile : manifest.at("configFiles"))
+    {
+        const std::filesystem::path configPath =
+            std::filesystem::absolute(configFile.get<std::string>());
+        NS_ABORT_MSG_UNLESS(std::filesystem::exists(configPath),
+                            "Can't find the scenario file " << configPath);
+
+        for (const auto& scheduler : manifest.at("schedulers"))
+        {
+            std::string schedulerName;
+            std::vector<std::string> schedulerArgs;
+            if (scheduler.is_object())
+            {
+                schedulerName = scheduler.at("name").get<std::string>();
+                const json args = scheduler.value("args", json::object());
+                for (const auto& [key, value] : args.items())
+                {
+                    schedulerArgs.push_back("--" + key + "=" + ToArg(value));
+                }
+            }
+            else
+            {
+                schedulerName = scheduler.get<std::string>();
+            }
+
+            for (const auto& [suffix, args] : sweepArgs)
+            {
+                for (uint32_t rngRun : rngRuns)
+                {
+                    Run run;
+                    run.name = configPath.stem().string() + "_" + schedulerName + suffix + "_run" +
+                               std::to_string(rngRun);
+                    run.args = {"cttc-nr-traffic-3gpp-xr-qos-sched_sergi"};
+                    run.args.insert(run.args.end(), commonArgs.begin(), commonArgs.end());
+                    run.args.insert(run.args.end(), schedulerArgs.begin(), schedulerArgs.end());
+                    run.args.insert(run.args.end(), args.begin(), args.end());
+                    run.args.push_back("--configFile=" + configPath.string());
+                    run.args.push_back("--schedulerType=" + schedulerName);
+                    run.args.push_back("--rngRun=" + std::to_string(rngRun));
+                    run.args.push_back("--unifiedName=" + (outputDir / (run.name + ".csv")).string());
+                    runs.push_back(std::move(run));
+                }
+            }
+        }
+    }
+    return runs;
+}
+
+/**
+ * \brief Run the scenario in the current (forked) process, and exit
+ * \param run the configuration
+ * \param outputDir the directory of the results, where the run writes its console output and
+ * creates its working directory
+ * \param cpu the core to pin the process to, or -1
+ */
+[[noreturn]] void
+RunWorker(const Run& run, const std::filesystem::path& outputDir, int cpu)
+{
+#ifdef __linux__
+    if (cpu >= 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        {
+            std::perror("sched_setaffinity");
+        }
+    }
+#endif
+
+    const std::filesystem::path logFile = outputDir / (run.name + ".log");
+    int fd = open(logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0)
+    {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+    }
+
+    // The scenario writes the files with a fixed name to the working directory: give every run
+    // its own, so that the runs at the same time do not write the same files. The paths in the
+    // arguments are absolute.
+    const std::filesystem::path runDir = outputDir / run.name;
+    std::error_code error;
+    std::filesystem::create_directories(runDir, error);
+    if (error || chdir(runDir.c_str()) != 0)
+    {
+        std::cerr << "Can't work in " << runDir << std::endl;
+        _exit(1);
+    }
+
+    std::vector<char*> argv;
+    for (const auto& arg : run.args)
+    {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    int ret = CttcNrTraffic3gppXrQosSched(static_cast<int>(run.args.size()), argv.data());
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    _exit(ret);
+}
+
+/**
+ * \brief Get the cores the driver can run on
+ * \return the cores, empty if unknown
+ */
+std::vector<int>
+GetCores()
+{
+    std::vector<int> cores;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set))
+            {
+                cores.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cores;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    std::string manifestFile;
+    uint32_t workers = 0;
+    bool pinCores = true;
+    bool dryRun = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("manifest", "JSON manifest of the sweep", manifestFile);
+    cmd.AddValue("workers",
+                 "Number of runs at the same time; if 0, the workers of the manifest or, if "
+                 "missing, one per available core",
+                 workers);
+    cmd.AddValue("pinCores", "Pin every worker to its own core", pinCores);
+    cmd.AddValue("dryRun", "Print the command line of the pending runs without running them", dryRun);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(manifestFile.empty(), "Please specify the manifest with --manifest");
+    std::ifstream manifestStream(manifestFile);
+    NS_ABORT_MSG_UNLESS(manifestStream.is_open(), "Can't open the manifest " << manifestFile);
+    json manifest;
+    manifestStream >> manifest;
+
+    const std::filesystem::path outputDir =
+        std::filesystem::absolute(manifest.value("outputDir", std::string("results")));
+    std::filesystem::create_directories(outputDir);
+
+    const std::vector<int> cores = GetCores();
+    if (workers == 0)
+    {
+        workers = manifest.value("workers", static_cast<uint32_t>(cores.size()));
+    }
+    workers = std::max<uint32_t>(workers, 1);
+
+    // Skip the completed runs, and remove the partial results of the others, as the scenario
+    // appends to its stats file
+    std::vector<Run> pending;
+    const std::vector<Run> runs = GetRuns(manifest, outputDir);
+    for (const auto& run : runs)
+    {
+        if (std::filesystem::exists(outputDir / (run.name + ".done")))
+        {
+            continue;
+        }
+        std::filesystem::remove(outputDir / (run.name + ".csv"));
+        std::filesystem::remove_all(outputDir / run.name);
+        pending.push_back(run);
+    }
+    std::cout << runs.size() << " runs, " << runs.size() - pending.size() << " already done, "
+              << pending.size() << " to run with " << workers << " workers" << std::endl;
+
+    if (dryRun)
+    {
+        for (const auto& run : pending)
+        {
+            for (const auto& arg : run.args)
+            {
+                std::cout << arg << " ";
+            }
+            std::cout << std::endl;
+        }
+        return 0;
+    }
+
+    std::map<pid_t, Worker> active;
+    std::vector<bool> freeSlots(workers, true);
+    std::size_t next = 0;
+    uint32_t completed = 0;
+    uint32_t failed = 0;
+    std::cout.flush();
+
+    while (next < pending.size() || !active.empty())
+    {
+        while (next < pending.size() && active.size() < workers)
+        {
+            uint32_t slot = 0;
+            while (!freeSlots[slot])
+            {
+                ++slot;
+            }
+            int cpu = pinCores && !cores.empty() ? cores[slot % cores.size()] : -1;
+            const Run& run = pending[next];
+
+            pid_t pid = fork();
+            NS_ABORT_MSG_IF(pid < 0, "Can't fork a worker");
+            if (pid == 0)
+            {
+                RunWorker(run, outputDir, cpu);
+            }
+            freeSlots[slot] = false;
+            active[pid] = {next, slot, std::chrono::steady_clock::now()};
+            ++next;
+        }
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            NS_ABORT_MSG_IF(errno != EINTR, "waitpid failed");
+            continue;
+        }
+        auto it = active.find(pid);
+        if (it == active.end())
+        {
+            continue;
+        }
+        const Worker worker = it->second;
+        active.erase(it);
+        freeSlots[worker.slot] = true;
+
+        const Run& run = pending[worker.run];
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - worker.start).count();
+        std::cout << "[" << completed + failed + 1 << "/" << pending.size() << "] " << run.name;
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+        {
+            std::ofstream(outputDir / (run.name + ".done"));
+            ++completed;
+            std::cout << " done in " << seconds << " s" << std::endl;
+        }
+        else
+        {
+            ++failed;
+            if (WIFSIGNALED(status))
+            {
+                std::cout << " FAILED with signal " << WTERMSIG(status);
+            }
+            else
+            {
+                std::cout << " FAILED with exit code " << WEXITSTATUS(status);
+            }
+            std::cout << " after " << seconds << " s, see " << run.name << ".log" << std::endl;
+        }
+    }
+
+    std::cout << completed << " runs done, " << failed << " failed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
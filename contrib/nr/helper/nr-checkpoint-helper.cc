@@ -0,0 +1,314 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-checkpoint-helper.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/nr-mac-scheduler-dpp-trace-writer.h>
+#include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <filesystem>
+#include <iostream>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrCheckpointHelper");
+NS_OBJECT_ENSURE_REGISTERED(NrCheckpointHelper);
+
+namespace
+{
+
+/**
+ * \brief Message of a checkpoint to the supervisor
+ */
+struct CheckpointMessage
+{
+    pid_t m_pid;      //!< Process of the checkpoint
+    int64_t m_timeNs; //!< Simulation time of the checkpoint, in ns
+};
+
+/**
+ * \brief Flush the standard streams, so that a fork doesn't duplicate their buffers
+ */
+void
+FlushStreams()
+{
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+}
+
+/**
+ * \brief Count the threads of the process
+ * \return the number of threads, or 0 if they can't be listed
+ */
+std::size_t
+CountThreads()
+{
+    std::error_code error;
+    std::size_t threads = 0;
+    for (std::filesystem::directory_iterator it("/proc/self/task", error), end;
+         !error && it != end;
+         it.increment(error))
+    {
+        ++threads;
+    }
+    return error ? 0 : threads;
+}
+
+} // namespace
+
+TypeId
+NrCheckpointHelper::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrCheckpointHelper")
+            .SetParent<Object>()
+            .AddConstructor<NrCheckpointHelper>()
+            .AddAttribute("Interval",
+                          "Simulation time between two checkpoints; zero disables them",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&NrCheckpointHelper::m_interval),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("MaxResumes",
+                          "Maximum number of times the simulation is resumed from a checkpoint",
+                          UintegerValue(3),
+                          MakeUintegerAccessor(&NrCheckpointHelper::m_maxResumes),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+NrCheckpointHelper::NrCheckpointHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrCheckpointHelper::~NrCheckpointHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NrCheckpointHelper::AddOutputFile(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    m_files.push_back(fileName);
+}
+
+void
+NrCheckpointHelper::Start()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_started, "The checkpoints are already started");
+    m_started = true;
+    if (m_interval.IsZero())
+    {
+        return;
+    }
+#ifdef __linux__
+    int fds[2];
+    NS_ABORT_MSG_IF(pipe(fds) != 0, "Can't create the pipe of the checkpoints");
+    // The processes of the checkpoints are orphaned when the simulation dies: adopt them
+    NS_ABORT_MSG_IF(prctl(PR_SET_CHILD_SUBREAPER, 1) != 0, "Can't become a subreaper");
+    FlushStreams();
+
+    m_supervisor = getpid();
+    pid_t live = fork();
+    NS_ABORT_MSG_IF(live < 0, "Can't fork the simulation");
+    if (live > 0)
+    {
+        close(fds[1]);
+        m_pipe = fds[0];
+        Supervise(live);
+    }
+    prctl(PR_SET_CHILD_SUBREAPER, 0);
+    close(fds[0]);
+    m_pipe = fds[1];
+    ScheduleNext();
+#else
+    NS_LOG_WARN("The checkpoints are supported only on Linux, running without them");
+#endif
+}
+
+void
+NrCheckpointHelper::Checkpoint()
+{
+    NS_LOG_FUNCTION(this);
+    FlushStreams();
+
+    // The writer has a thread, which the fork doesn't copy, and its files would share their
+    // offsets with the checkpoint: write its records and close its files. Each process
+    // restarts it with its next record.
+    NrMacSchedulerDppTraceWriter* writer = NrMacSchedulerDppTraceWriter::Get();
+    writer->Suspend();
+
+    // A thread that isn't ours would be missing in the checkpoint, maybe in the middle of an
+    // update or holding a lock
+    if (CountThreads() > 1)
+    {
+        std::cerr << "Checkpoint at " << Simulator::Now().As(Time::S)
+                  << " skipped: the simulation runs other threads" << std::endl;
+        ScheduleNext();
+        return;
+    }
+
+    // Reap the checkpoints killed by the supervisor
+    while (waitpid(-1, nullptr, WNOHANG) > 0)
+    {
+    }
+
+    std::vector<std::string> files = m_files;
+    for (const auto& file : writer->GetOutputFiles())
+    {
+        files.push_back(file);
+    }
+    m_sizes.clear();
+    for (const auto& file : files)
+    {
+        struct stat st;
+        m_sizes.emplace_back(file, stat(file.c_str(), &st) == 0 ? st.st_size : -1);
+    }
+
+    // SIGUSR1 wakes up the checkpoint; it's blocked before the fork, so that it stays pending
+    // until the checkpoint waits for it
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGUSR1);
+    sigprocmask(SIG_BLOCK, &set, nullptr);
+    pid_t pid = fork();
+    NS_ABORT_MSG_IF(pid < 0, "Can't fork a checkpoint");
+    if (pid == 0)
+    {
+        WaitResume();
+        return;
+    }
+    sigprocmask(SIG_UNBLOCK, &set, nullptr);
+    ScheduleNext();
+}
+
+void
+NrCheckpointHelper::WaitResume()
+{
+    CheckpointMessage message{getpid(), Simulator::Now().GetNanoSeconds()};
+    if (write(m_pipe, &message, sizeof(message)) != sizeof(message))
+    {
+        _exit(1);
+    }
+
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGUSR1);
+    const struct timespec timeout = {1, 0};
+    while (sigtimedwait(&set, nullptr, &timeout) != SIGUSR1)
+    {
+        // Don't outlive the supervisor
+        if (kill(m_supervisor, 0) != 0 && errno == ESRCH)
+        {
+            _exit(1);
+        }
+    }
+    sigprocmask(SIG_UNBLOCK, &set, nullptr);
+
+    ++m_resumes;
+    for (const auto& [file, size] : m_sizes)
+    {
+        if (size >= 0 && truncate(file.c_str(), size) != 0)
+        {
+            NS_LOG_WARN("Can't truncate " << file);
+        }
+    }
+    std::cerr << "Simulation resumed from the checkpoint at " << Simulator::Now().As(Time::S)
+              << std::endl;
+    ScheduleNext();
+}
+
+void
+NrCheckpointHelper::ScheduleNext()
+{
+    // Don't keep alive a simulation that ends without a stop time
+    if (!Simulator::IsFinished())
+    {
+        Simulator::Schedule(m_interval, &NrCheckpointHelper::Checkpoint, this);
+    }
+}
+
+void
+NrCheckpointHelper::Supervise(pid_t live)
+{
+    fcntl(m_pipe, F_SETFL, O_NONBLOCK);
+    pid_t checkpoint = -1;
+    int64_t checkpointNs = 0;
+    uint32_t resumes = 0;
+
+    // Keep only the last checkpoint
+    auto readCheckpoints = [this, &checkpoint, &checkpointNs]() {
+        CheckpointMessage message;
+        while (read(m_pipe, &message, sizeof(message)) == sizeof(message))
+        {
+            if (checkpoint > 0)
+            {
+                kill(checkpoint, SIGKILL);
+            }
+            checkpoint = message.m_pid;
+            checkpointNs = message.m_timeNs;
+        }
+    };
+
+    while (true)
+    {
+        struct pollfd fd = {m_pipe, POLLIN, 0};
+        poll(&fd, 1, 1000);
+        readCheckpoints();
+
+        int status = 0;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+        {
+            if (pid != live)
+            {
+                continue; // A killed checkpoint
+            }
+            readCheckpoints();
+            const bool success = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            if (!success && checkpoint > 0 && resumes < m_maxResumes)
+            {
+                ++resumes;
+                std::cerr << "Simulation " << live << " died ("
+                          << (WIFSIGNALED(status) ? "signal " : "exit code ")
+                          << (WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status))
+                          << "), resuming it from the checkpoint at "
+                          << NanoSeconds(checkpointNs).As(Time::S) << std::endl;
+                live = checkpoint;
+                checkpoint = -1;
+                kill(live, SIGUSR1);
+                continue;
+            }
+            if (checkpoint > 0)
+            {
+                kill(checkpoint, SIGKILL);
+            }
+            _exit(WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status));
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,155 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+
+#include <string>
+#include <sys/types.h>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup helper
+ * \brief Periodic checkpoints of a simulation, to resume it if it dies
+ *
+ * The state of a running simulation (the scheduler state, the RLC and MAC
+ * buffers, the random streams, the pending events...) is spread over objects
+ * and callbacks that can't be written to a file. The checkpoints are hence
+ * snapshots of the whole process, taken with fork():
+ *
+ * - Start() turns the calling process into a supervisor, which doesn't
+ *   simulate, and forks the process that runs the simulation;
+ * - every Interval of simulation time, the simulation forks a copy of itself
+ *   that stays blocked: the checkpoint. The supervisor keeps the last one
+ *   and kills the previous one;
+ * - if the simulation dies (a signal, e.g., from the OOM killer, or an exit
+ *   code other than 0), the supervisor wakes up the last checkpoint, which
+ *   goes on from the simulation time of the checkpoint. The output files
+ *   added with AddOutputFile() and the files of the
+ *   NrMacSchedulerDppTraceWriter are truncated to their size at the
+ *   checkpoint, so that the records written after it aren't duplicated;
+ * - the supervisor exits with the exit code of the simulation, once it ends
+ *   successfully or after MaxResumes resumes.
+ *
+ * The random streams are resumed from the checkpoint as well, so a resumed
+ * simulation gives the same results as an uninterrupted one, but it also dies
+ * again if the cause is in the simulation itself. Since the pages are shared
+ * with the simulation until it writes them, a checkpoint costs the memory
+ * written by the simulation in an interval.
+ *
+ * Only the supervisor can resume the simulation: the checkpoints are
+ * processes in memory, so they die with it. A kill of the supervisor or of
+ * its process group (e.g., by a batch driver or a job scheduler), a crash of
+ * the machine or a reboot lose them, and the simulation has to be run again
+ * from the start.
+ *
+ * fork() copies only the thread that calls it. The
+ * NrMacSchedulerDppTraceWriter is suspended before each checkpoint, and
+ * restarted by its next record in each process; if any other thread is
+ * running, the checkpoint is skipped.
+ *
+ * This helper should be used in the following way:
+ *
+ * \code{.cpp}
+ *   Ptr<NrCheckpointHelper> checkpoint = CreateObject<NrCheckpointHelper>();
+ *   checkpoint->SetAttribute("Interval", TimeValue(Seconds(30)));
+ *   checkpoint->AddOutputFile("stats.csv");
+ *   checkpoint->Start(); // Right before Simulator::Run()
+ *   Simulator::Run();
+ * \endcode
+ *
+ * The checkpoints need fork() and a subreaper (prctl()); on other systems
+ * than Linux, Start() only warns and the simulation runs without them.
+ */
+class NrCheckpointHelper : public Object
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrCheckpointHelper constructor
+     */
+    NrCheckpointHelper();
+
+    /**
+     * \brief ~NrCheckpointHelper deconstructor
+     */
+    ~NrCheckpointHelper() override;
+
+    /**
+     * \brief Add a file written by the simulation, to truncate on resume
+     *
+     * The file must be written in append mode, or reopened after every
+     * record, as the files kept open by the simulation are shared with the
+     * checkpoints. The files of the NrMacSchedulerDppTraceWriter don't have to
+     * be added.
+     *
+     * \param fileName the name of the file
+     */
+    void AddOutputFile(const std::string& fileName);
+
+    /**
+     * \brief Start the supervisor and schedule the checkpoints
+     *
+     * To be called once, after the setup of the simulation and right before
+     * Simulator::Run(). In the supervisor, it doesn't return. If Interval is
+     * zero, it does nothing.
+     */
+    void Start();
+
+    /**
+     * \brief Get the number of times the simulation was resumed
+     * \return the number of resumes of the simulation in this process
+     */
+    uint32_t GetResumes() const
+    {
+        return m_resumes;
+    }
+
+  private:
+    /**
+     * \brief Wait for the end of the simulation, and resume it when it dies
+     * \param live the process of the simulation
+     */
+    [[noreturn]] void Supervise(pid_t live);
+
+    /**
+     * \brief Take a checkpoint; scheduled every Interval
+     */
+    void Checkpoint();
+
+    /**
+     * \brief Schedule the next checkpoint, unless the simulation is over
+     */
+    void ScheduleNext();
+
+    /**
+     * \brief Block a checkpoint until it's resumed (it returns) or killed
+     */
+    void WaitResume();
+
+    Time m_interval;                  //!< Simulation time between two checkpoints
+    uint32_t m_maxResumes{0};         //!< Maximum number of resumes
+    std::vector<std::string> m_files; //!< Output files to truncate on resume
+    std::vector<std::pair<std::string, int64_t>>
+        m_sizes;            //!< Output files and their size at the checkpoint
+    uint32_t m_resumes{0};  //!< Resumes of this simulation
+    pid_t m_supervisor{-1}; //!< Process of the supervisor
+    int m_pipe{-1};         //!< Pipe between the checkpoints and the supervisor
+    bool m_started{false};  //!< Whether Start() was called
+};
+
+} // namespace ns3
@@ -0,0 +1,188 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-gfbr-prediction-stage.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/nr-gfbr-predictor-ewma.h>
+#include <ns3/nr-mac-scheduler-ofdma-dpp.h>
+#include <ns3/nr-ue-net-device.h>
+#include <ns3/packet.h>
+#include <ns3/simulator.h>
+#include <ns3/traffic-generator.h>
+#include <ns3/type-id.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrGfbrPredictionStage");
+NS_OBJECT_ENSURE_REGISTERED(NrGfbrPredictionStage);
+
+TypeId
+NrGfbrPredictionStage::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrGfbrPredictionStage")
+            .SetParent<Object>()
+            .AddConstructor<NrGfbrPredictionStage>()
+            .AddAttribute("PredictorType",
+                          "Type of the GFBR predictor (a subclass of ns3::NrGfbrPredictor)",
+                          TypeIdValue(NrGfbrPredictorEwma::GetTypeId()),
+                          MakeTypeIdAccessor(&NrGfbrPredictionStage::SetPredictorType),
+                          MakeTypeIdChecker());
+    return tid;
+}
+
+NrGfbrPredictionStage::NrGfbrPredictionStage()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrGfbrPredictionStage::~NrGfbrPredictionStage()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NrGfbrPredictionStage::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_ues.clear();
+    m_predictor = nullptr;
+    m_scheduler = nullptr;
+    Object::DoDispose();
+}
+
+void
+NrGfbrPredictionStage::SetPredictorType(const TypeId& type)
+{
+    NS_LOG_FUNCTION(this << type);
+    NS_ABORT_MSG_UNLESS(type.IsChildOf(NrGfbrPredictor::GetTypeId()),
+                        type.GetName() << " is not a GFBR predictor");
+    m_predictorType = type;
+    ObjectFactory factory;
+    factory.SetTypeId(type);
+    m_predictor = DynamicCast<NrGfbrPredictor>(factory.Create());
+}
+
+Ptr<NrGfbrPredictor>
+NrGfbrPredictionStage::GetPredictor() const
+{
+    return m_predictor;
+}
+
+void
+NrGfbrPredictionStage::SetScheduler(const Ptr<NrMacSchedulerOfdmaDPP>& scheduler)
+{
+    NS_LOG_FUNCTION(this);
+    m_scheduler = scheduler;
+}
+
+uint32_t
+NrGfbrPredictionStage::AddUe(const Ptr<NrUeNetDevice>& ueDev,
+                             const Ptr<TrafficGenerator>& generator)
+{
+    NS_LOG_FUNCTION(this);
+    const auto ue = static_cast<uint32_t>(m_ues.size());
+    Ue info;
+    info.m_ueDev = ueDev;
+    m_ues.push_back(info);
+    if (generator != nullptr)
+    {
+        generator->TraceConnectWithoutContext(
+            "Tx",
+            MakeCallback(&NrGfbrPredictionStage::GeneratorTx, this).Bind(ue));
+    }
+    return ue;
+}
+
+void
+NrGfbrPredictionStage::Start(Time start, Time interval)
+{
+    NS_LOG_FUNCTION(this << start << interval);
+    NS_ABORT_MSG_UNLESS(interval.IsStrictlyPositive(), "The interval must be positive");
+    m_interval = interval;
+    Simulator::Schedule(start, &NrGfbrPredictionStage::Update, this);
+}
+
+uint64_t
+NrGfbrPredictionStage::GetGfbr(uint32_t ue) const
+{
+    NS_ASSERT(ue < m_ues.size());
+    return m_ues[ue].m_gfbr;
+}
+
+double
+NrGfbrPredictionStage::GetOfferedLoad(uint32_t ue) const
+{
+    NS_ASSERT(ue < m_ues.size());
+    return m_ues[ue].m_offeredLoad;
+}
+
+void
+NrGfbrPredictionStage::GeneratorTx(uint32_t ue, Ptr<const Packet> packet)
+{
+    m_ues[ue].m_txBytes += packet->GetSize();
+}
+
+void
+NrGfbrPredictionStage::EndInterval()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_predictor == nullptr, "No GFBR predictor");
+    const double interval = (Simulator::Now() - m_intervalStart).GetSeconds();
+    m_intervalStart = Simulator::Now();
+    if (!m_started || interval <= 0)
+    {
+        // The traffic before the first interval is not offered load
+        m_started = true;
+        for (auto& info : m_ues)
+        {
+            info.m_txBytes = 0;
+        }
+        return;
+    }
+
+    for (uint32_t ue = 0; ue < m_ues.size(); ++ue)
+    {
+        Ue& info = m_ues[ue];
+        info.m_offeredLoad = info.m_txBytes * 8.0 / interval;
+        info.m_txBytes = 0;
+        info.m_gfbr = static_cast<uint64_t>(
+            std::llround(std::max(m_predictor->Predict(ue, info.m_offeredLoad), 0.0)));
+        NS_LOG_INFO("UE " << ue << " offered " << info.m_offeredLoad << " bit/s, GFBR "
+                          << info.m_gfbr << " bit/s");
+
+        if (m_scheduler != nullptr && info.m_ueDev != nullptr)
+        {
+            if (info.m_rnti == 0)
+            {
+                info.m_rnti = info.m_ueDev->GetRrc()->GetRnti();
+            }
+            m_scheduler->UpdateUeDlGfbr(info.m_rnti, info.m_gfbr);
+        }
+    }
+}
+
+void
+NrGfbrPredictionStage::Update()
+{
+    NS_LOG_FUNCTION(this);
+    EndInterval();
+
+    // Don't keep alive a simulation that ends without a stop time
+    if (!Simulator::IsFinished())
+    {
+        Simulator::Schedule(m_interval, &NrGfbrPredictionStage::Update, this);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,162 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+#include <ns3/ptr.h>
+
+#include <vector>
+
+namespace ns3
+{
+
+class NrGfbrPredictor;
+class NrMacSchedulerOfdmaDPP;
+class NrUeNetDevice;
+class Packet;
+class TrafficGenerator;
+
+/**
+ * \ingroup helper
+ * \brief Online prediction of the GFBR of the UEs, from their offered load
+ *
+ * The stage counts the bytes sent by the traffic generator of every UE (its
+ * Tx trace) and, every interval, passes the offered load of the interval
+ * that ends to a NrGfbrPredictor, whose predictions are the GFBRs of the
+ * next interval, set in the DPP scheduler with
+ * NrMacSchedulerOfdmaDPP::UpdateUeDlGfbr(). The predictions are hence made
+ * during the simulation, with no offline pass, and react to the traffic that
+ * the scheduler actually serves (closed loop).
+ *
+ * The intervals end at every call to EndInterval(), scheduled by Start() or
+ * made by the user, e.g., from the interval-end callback of a
+ * NrGfbrScheduleController, to write the KPIs of an interval before the GFBRs
+ * change. The first call only starts the first interval.
+ *
+ * The predictor is created from the attribute PredictorType, and configured
+ * through its attributes (e.g., with Config::SetDefault) or through
+ * GetPredictor(), before Start().
+ *
+ * \code{.cpp}
+ *   Ptr<NrGfbrPredictionStage> stage = CreateObject<NrGfbrPredictionStage>();
+ *   stage->SetAttribute("PredictorType", TypeIdValue(NrGfbrPredictorEwma::GetTypeId()));
+ *   stage->SetScheduler(dppScheduler);
+ *   stage->AddUe(ueDev, videoGenerator);
+ *   stage->Start(appStartTime, MilliSeconds(100));
+ * \endcode
+ */
+class NrGfbrPredictionStage : public Object
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrGfbrPredictionStage constructor
+     */
+    NrGfbrPredictionStage();
+
+    /**
+     * \brief ~NrGfbrPredictionStage deconstructor
+     */
+    ~NrGfbrPredictionStage() override;
+
+    /**
+     * \brief Set the type of the predictor, and create it
+     * \param type the TypeId of a subclass of NrGfbrPredictor
+     */
+    void SetPredictorType(const TypeId& type);
+
+    /**
+     * \brief Get the predictor
+     * \return the predictor
+     */
+    Ptr<NrGfbrPredictor> GetPredictor() const;
+
+    /**
+     * \brief Set the DPP scheduler that gets the GFBRs
+     * \param scheduler the scheduler
+     */
+    void SetScheduler(const Ptr<NrMacSchedulerOfdmaDPP>& scheduler);
+
+    /**
+     * \brief Add an UE
+     * \param ueDev the device of the UE, for its RNTI
+     * \param generator the generator of the DL traffic of the UE
+     * \return the index of the UE in the stage
+     */
+    uint32_t AddUe(const Ptr<NrUeNetDevice>& ueDev, const Ptr<TrafficGenerator>& generator);
+
+    /**
+     * \brief Schedule the end of the intervals
+     * \param start the start of the first interval
+     * \param interval the time between two predictions
+     */
+    void Start(Time start, Time interval);
+
+    /**
+     * \brief End the current interval: predict the GFBRs of the next one, from
+     * the load offered in the current one, and set them
+     */
+    void EndInterval();
+
+    /**
+     * \brief Get the GFBR of an UE in the current interval
+     * \param ue the index of the UE
+     * \return the GFBR in bit/s, 0 before the first prediction
+     */
+    uint64_t GetGfbr(uint32_t ue) const;
+
+    /**
+     * \brief Get the load offered to an UE in the last interval
+     * \param ue the index of the UE
+     * \return the offered load in bit/s
+     */
+    double GetOfferedLoad(uint32_t ue) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief An UE and its counters
+     */
+    struct Ue
+    {
+        Ptr<NrUeNetDevice> m_ueDev; //!< Device of the UE
+        uint16_t m_rnti{0};         //!< RNTI, once attached
+        uint64_t m_txBytes{0};      //!< Bytes sent to the UE in the current interval
+        double m_offeredLoad{0.0};  //!< Offered load of the last interval (bit/s)
+        uint64_t m_gfbr{0};         //!< GFBR of the current interval (bit/s)
+    };
+
+    /**
+     * \brief Count a packet sent to an UE
+     * \param ue the index of the UE
+     * \param packet the packet
+     */
+    void GeneratorTx(uint32_t ue, Ptr<const Packet> packet);
+
+    /**
+     * \brief End the current interval and schedule the end of the next one
+     */
+    void Update();
+
+    TypeId m_predictorType;                  //!< Type of the predictor
+    Ptr<NrGfbrPredictor> m_predictor;        //!< The predictor
+    Ptr<NrMacSchedulerOfdmaDPP> m_scheduler; //!< Scheduler of the GFBRs
+    std::vector<Ue> m_ues;                   //!< The UEs
+    Time m_interval;                         //!< Time between two calls of Update()
+    Time m_intervalStart;                    //!< Start of the current interval
+    bool m_started{false};                   //!< Whether the first interval has started
+};
+
+} // namespace ns3
@@ -0,0 +1,251 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-gfbr-schedule-controller.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/nr-mac-scheduler-ofdma-dpp.h>
+#include <ns3/nr-ue-net-device.h>
+#include <ns3/simulator.h>
+#include <ns3/traffic-generator-3gpp-generic-video.h>
+
+#include <cstring>
+#include <fstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrGfbrScheduleController");
+NS_OBJECT_ENSURE_REGISTERED(NrGfbrScheduleController);
+
+namespace
+{
+
+const char HEADER_MAGIC[8] = {'N', 'R', 'G', 'F', 'B', 'R', '0', '1'};
+
+/**
+ * \brief Write an unsigned integer in little endian
+ * \param out the stream
+ * \param value the value
+ * \param bytes the number of bytes to write
+ */
+void
+WriteLe(std::ostream& out, uint64_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; ++i)
+    {
+        out.put(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+/**
+ * \brief Read an unsigned integer in little endian
+ * \param in the stream
+ * \param bytes the number of bytes to read
+ * \return the value
+ */
+uint64_t
+ReadLe(std::istream& in, unsigned bytes)
+{
+    uint64_t value = 0;
+    for (unsigned i = 0; i < bytes; ++i)
+    {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(in.get())) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+TypeId
+NrGfbrScheduleController::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrGfbrScheduleController")
+                            .SetParent<Object>()
+                            .AddConstructor<NrGfbrScheduleController>();
+    return tid;
+}
+
+NrGfbrScheduleController::NrGfbrScheduleController()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrGfbrScheduleController::~NrGfbrScheduleController()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NrGfbrScheduleController::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_ues.clear();
+    m_scheduler = nullptr;
+    m_intervalEndCallback = MakeNullCallback<void>();
+    Object::DoDispose();
+}
+
+uint32_t
+NrGfbrScheduleController::AddUe(const Ptr<NrUeNetDevice>& ueDev,
+                                const Ptr<TrafficGenerator3gppGenericVideo>& video,
+                                const std::vector<uint64_t>& traffic,
+                                const std::vector<uint64_t>& gfbr)
+{
+    NS_LOG_FUNCTION(this << traffic.size() << gfbr.size());
+    NS_ABORT_MSG_IF(traffic.size() != gfbr.size(),
+                    "The traffic and the GFBR series of an UE have different lengths");
+    Ue ue;
+    ue.m_ueDev = ueDev;
+    ue.m_video = video;
+    ue.m_traffic = traffic;
+    ue.m_gfbr = gfbr;
+    m_ues.push_back(std::move(ue));
+    return static_cast<uint32_t>(m_ues.size() - 1);
+}
+
+void
+NrGfbrScheduleController::SetUe(uint32_t ue,
+                                const Ptr<NrUeNetDevice>& ueDev,
+                                const Ptr<TrafficGenerator3gppGenericVideo>& video)
+{
+    NS_LOG_FUNCTION(this << ue);
+    NS_ABORT_MSG_IF(ue >= m_ues.size(), "The schedule has no UE " << ue);
+    m_ues[ue].m_ueDev = ueDev;
+    m_ues[ue].m_video = video;
+}
+
+void
+NrGfbrScheduleController::LoadBinary(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    std::ifstream in(fileName, std::ios::in | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(in.is_open(), "Can't open the GFBR schedule " << fileName);
+    char magic[sizeof(HEADER_MAGIC)];
+    in.read(magic, sizeof(magic));
+    NS_ABORT_MSG_IF(!in || std::memcmp(magic, HEADER_MAGIC, sizeof(magic)) != 0,
+                    fileName << " is not a GFBR schedule");
+
+    m_ues.clear();
+    m_ues.resize(ReadLe(in, 4));
+    for (auto& ue : m_ues)
+    {
+        const auto numIntervals = static_cast<std::size_t>(ReadLe(in, 4));
+        ue.m_traffic.resize(numIntervals);
+        ue.m_gfbr.resize(numIntervals);
+        for (auto& traffic : ue.m_traffic)
+        {
+            traffic = ReadLe(in, 8);
+        }
+        for (auto& gfbr : ue.m_gfbr)
+        {
+            gfbr = ReadLe(in, 8);
+        }
+        NS_ABORT_MSG_IF(!in, "Truncated GFBR schedule " << fileName);
+    }
+}
+
+void
+NrGfbrScheduleController::SaveBinary(const std::string& fileName) const
+{
+    NS_LOG_FUNCTION(this << fileName);
+    std::ofstream out(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(out.is_open(), "Can't open the GFBR schedule " << fileName);
+    out.write(HEADER_MAGIC, sizeof(HEADER_MAGIC));
+    WriteLe(out, m_ues.size(), 4);
+    for (const auto& ue : m_ues)
+    {
+        WriteLe(out, ue.m_traffic.size(), 4);
+        for (auto traffic : ue.m_traffic)
+        {
+            WriteLe(out, traffic, 8);
+        }
+        for (auto gfbr : ue.m_gfbr)
+        {
+            WriteLe(out, gfbr, 8);
+        }
+    }
+}
+
+void
+NrGfbrScheduleController::SetScheduler(const Ptr<NrMacSchedulerOfdmaDPP>& scheduler)
+{
+    NS_LOG_FUNCTION(this);
+    m_scheduler = scheduler;
+}
+
+void
+NrGfbrScheduleController::SetIntervalEndCallback(const Callback<void>& callback)
+{
+    NS_LOG_FUNCTION(this);
+    m_intervalEndCallback = callback;
+}
+
+void
+NrGfbrScheduleController::Start(Time start, Time interval)
+{
+    NS_LOG_FUNCTION(this << start << interval);
+    NS_ABORT_MSG_UNLESS(interval.IsStrictlyPositive(), "The interval must be positive");
+    m_interval = interval;
+    Simulator::Schedule(start, &NrGfbrScheduleController::Update, this);
+}
+
+uint64_t
+NrGfbrScheduleController::GetTraffic(uint32_t ue) const
+{
+    NS_ASSERT(ue < m_ues.size());
+    const auto& traffic = m_ues[ue].m_traffic;
+    return m_next == 0 || traffic.empty() ? 0 : traffic[std::min(m_next, traffic.size()) - 1];
+}
+
+uint64_t
+NrGfbrScheduleController::GetGfbr(uint32_t ue) const
+{
+    NS_ASSERT(ue < m_ues.size());
+    const auto& gfbr = m_ues[ue].m_gfbr;
+    return m_next == 0 || gfbr.empty() ? 0 : gfbr[std::min(m_next, gfbr.size()) - 1];
+}
+
+void
+NrGfbrScheduleController::Update()
+{
+    NS_LOG_FUNCTION(this << m_next);
+    if (!m_intervalEndCallback.IsNull())
+    {
+        m_intervalEndCallback();
+    }
+
+    for (auto& ue : m_ues)
+    {
+        if (m_next >= ue.m_traffic.size())
+        {
+            continue; // The last values stay
+        }
+        if (ue.m_video != nullptr)
+        {
+            ue.m_video->SetDynamicDataRate(ue.m_traffic[m_next] / 1e6);
+        }
+        if (m_scheduler != nullptr)
+        {
+            if (ue.m_rnti == 0)
+            {
+                ue.m_rnti = ue.m_ueDev->GetRrc()->GetRnti();
+            }
+            m_scheduler->UpdateUeDlGfbr(ue.m_rnti, ue.m_gfbr[m_next]);
+        }
+    }
+    ++m_next;
+
+    // Don't keep alive a simulation that ends without a stop time
+    if (!Simulator::IsFinished())
+    {
+        Simulator::Schedule(m_interval, &NrGfbrScheduleController::Update, this);
+    }
+}
+
+} // namespace ns3
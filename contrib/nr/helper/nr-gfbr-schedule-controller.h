@@ -0,0 +1,176 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <ns3/callback.h>
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+#include <ns3/ptr.h>
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class NrMacSchedulerOfdmaDPP;
+class NrUeNetDevice;
+class TrafficGenerator3gppGenericVideo;
+
+/**
+ * \ingroup helper
+ * \brief Apply a preloaded schedule of traffic rates and GFBRs to the UEs
+ *
+ * The schedule of every UE is a time series of traffic rates and of DL
+ * GFBRs, one value per interval, loaded once with AddUe() (e.g., the
+ * traffic_bps and gfbr_bps arrays of a scenario file) or with LoadBinary().
+ * Every interval, a single event applies the values of the interval to all
+ * the UEs:
+ *
+ * - the traffic rate to the video generator of the UE
+ *   (TrafficGenerator3gppGenericVideo::SetDynamicDataRate);
+ * - the GFBR to the DPP scheduler (NrMacSchedulerOfdmaDPP::UpdateUeDlGfbr),
+ *   if set with SetScheduler().
+ *
+ * Each update is O(1) per UE. When the series of an UE ends, its last values
+ * stay. Before applying the values of an interval, the event calls the
+ * interval-end callback, if any, e.g., to write the KPIs of the interval that
+ * ends with GetTraffic() and GetGfbr(), which still return its values.
+ *
+ * The binary form of the schedule is little endian:
+ *
+ *     header: "NRGFBR01", u32 number of UEs
+ *     UE:     u32 number of intervals, then that many u64 traffic rates (bit/s)
+ *             and then that many u64 GFBRs (bit/s)
+ */
+class NrGfbrScheduleController : public Object
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrGfbrScheduleController constructor
+     */
+    NrGfbrScheduleController();
+
+    /**
+     * \brief ~NrGfbrScheduleController deconstructor
+     */
+    ~NrGfbrScheduleController() override;
+
+    /**
+     * \brief Add an UE and its schedule
+     * \param ueDev the device of the UE, for its RNTI
+     * \param video the generator of the traffic of the UE (can be null)
+     * \param traffic the traffic rate of every interval, in bit/s
+     * \param gfbr the DL GFBR of every interval, in bit/s
+     * \return the index of the UE in the controller
+     */
+    uint32_t AddUe(const Ptr<NrUeNetDevice>& ueDev,
+                   const Ptr<TrafficGenerator3gppGenericVideo>& video,
+                   const std::vector<uint64_t>& traffic,
+                   const std::vector<uint64_t>& gfbr);
+
+    /**
+     * \brief Set the devices and the generators of the UEs of a schedule loaded
+     * with LoadBinary(), in the order of the file
+     * \param ue the index of the UE
+     * \param ueDev the device of the UE, for its RNTI
+     * \param video the generator of the traffic of the UE (can be null)
+     */
+    void SetUe(uint32_t ue,
+               const Ptr<NrUeNetDevice>& ueDev,
+               const Ptr<TrafficGenerator3gppGenericVideo>& video);
+
+    /**
+     * \brief Get the number of UEs
+     * \return the number of UEs
+     */
+    uint32_t GetNUes() const
+    {
+        return static_cast<uint32_t>(m_ues.size());
+    }
+
+    /**
+     * \brief Load the schedules of the UEs from a binary file
+     * \param fileName the name of the file
+     */
+    void LoadBinary(const std::string& fileName);
+
+    /**
+     * \brief Save the schedules of the UEs to a binary file
+     * \param fileName the name of the file
+     */
+    void SaveBinary(const std::string& fileName) const;
+
+    /**
+     * \brief Set the DPP scheduler that gets the GFBRs
+     * \param scheduler the scheduler
+     */
+    void SetScheduler(const Ptr<NrMacSchedulerOfdmaDPP>& scheduler);
+
+    /**
+     * \brief Set the callback called at the end of every interval, before the
+     * values of the next one are applied
+     * \param callback the callback
+     */
+    void SetIntervalEndCallback(const Callback<void>& callback);
+
+    /**
+     * \brief Schedule the updates
+     * \param start the time of the first update
+     * \param interval the time between two updates
+     */
+    void Start(Time start, Time interval);
+
+    /**
+     * \brief Get the traffic rate of an UE in the current interval
+     * \param ue the index of the UE
+     * \return the rate in bit/s, 0 before the first update
+     */
+    uint64_t GetTraffic(uint32_t ue) const;
+
+    /**
+     * \brief Get the GFBR of an UE in the current interval
+     * \param ue the index of the UE
+     * \return the GFBR in bit/s, 0 before the first update
+     */
+    uint64_t GetGfbr(uint32_t ue) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief An UE and its schedule
+     */
+    struct Ue
+    {
+        Ptr<NrUeNetDevice> m_ueDev;                    //!< Device of the UE
+        Ptr<TrafficGenerator3gppGenericVideo> m_video; //!< Traffic generator of the UE
+        uint16_t m_rnti{0};                            //!< RNTI, once attached
+        std::vector<uint64_t> m_traffic;               //!< Traffic rate per interval (bit/s)
+        std::vector<uint64_t> m_gfbr;                  //!< GFBR per interval (bit/s)
+    };
+
+    /**
+     * \brief End the current interval and apply the values of the next one
+     */
+    void Update();
+
+    std::vector<Ue> m_ues;                   //!< The UEs
+    Ptr<NrMacSchedulerOfdmaDPP> m_scheduler; //!< Scheduler of the GFBRs
+    Callback<void> m_intervalEndCallback;    //!< Called at the end of every interval
+    Time m_interval;                         //!< Time between two updates
+    std::size_t m_next{0};                   //!< Index of the next interval
+};
+
+} // namespace ns3
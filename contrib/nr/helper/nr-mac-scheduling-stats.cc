@@ -6,6 +6,7 @@
 
 #include "nr-mac-scheduling-stats.h"
 
+#include "ns3/enum.h"
 #include "ns3/string.h"
 #include <ns3/log.h>
 #include <ns3/simulator.h>
@@ -18,7 +19,9 @@ NS_LOG_COMPONENT_DEFINE("NrMacSchedulingStats");
 NS_OBJECT_ENSURE_REGISTERED(NrMacSchedulingStats);
 
 NrMacSchedulingStats::NrMacSchedulingStats()
-    : m_dlFirstWrite(true),
+    : m_outputFormat(NrColumnarTraceFile::TEXT),
+      m_closeScheduled(false),
+      m_dlFirstWrite(true),
       m_ulFirstWrite(true)
 {
     NS_LOG_FUNCTION(this);
@@ -46,7 +49,17 @@ NrMacSchedulingStats::GetTypeId()
                           "Name of the file where the uplink results will be saved.",
                           StringValue("NrUlMacStats.txt"),
                           MakeStringAccessor(&NrMacSchedulingStats::SetUlOutputFilename),
-                          MakeStringChecker());
+                          MakeStringChecker())
+            .AddAttribute("OutputFormat",
+                          "Format of the output files: text, or NrColumnarTraceFile (written "
+                          "with the .nrct extension)",
+                          EnumValue(NrColumnarTraceFile::TEXT),
+                          MakeEnumAccessor(
+                              &NrMacSchedulingStats::m_outputFormat),
+                          MakeEnumChecker(NrColumnarTraceFile::TEXT,
+                                          "Text",
+                                          NrColumnarTraceFile::COLUMNAR,
+                                          "Columnar"));
     return tid;
 }
 
@@ -83,6 +96,12 @@ NrMacSchedulingStats::DlScheduling(uint16_t cellId,
                          << traceInfo.m_rnti << (uint32_t)traceInfo.m_mcs << traceInfo.m_tbSize);
     NS_LOG_INFO("Write DL Mac Stats in " << GetDlOutputFilename().c_str());
 
+    if (m_outputFormat == NrColumnarTraceFile::COLUMNAR)
+    {
+        WriteColumnar(&m_dlColumnarFile, GetDlOutputFilename(), cellId, imsi, traceInfo);
+        return;
+    }
+
     std::ofstream outFile;
     if (m_dlFirstWrite == true)
     {
@@ -137,6 +156,12 @@ NrMacSchedulingStats::UlScheduling(uint16_t cellId,
                          << traceInfo.m_rnti << (uint32_t)traceInfo.m_mcs << traceInfo.m_tbSize);
     NS_LOG_INFO("Write UL Mac Stats in " << GetUlOutputFilename().c_str());
 
+    if (m_outputFormat == NrColumnarTraceFile::COLUMNAR)
+    {
+        WriteColumnar(&m_ulColumnarFile, GetUlOutputFilename(), cellId, imsi, traceInfo);
+        return;
+    }
+
     std::ofstream outFile;
     if (m_ulFirstWrite == true)
     {
@@ -182,6 +207,72 @@ NrMacSchedulingStats::UlScheduling(uint16_t cellId,
     outFile.close();
 }
 
+void
+NrMacSchedulingStats::WriteColumnar(NrColumnarTraceFile* file,
+                                    const std::string& outputFilename,
+                                    uint16_t cellId,
+                                    uint64_t imsi,
+                                    const NrSchedulingCallbackInfo& traceInfo)
+{
+    if (!file->IsOpen())
+    {
+        using Column = NrColumnarTraceFile::Column;
+        std::vector<Column> columns;
+        for (const auto& name : {"cellId",
+                                 "bwpId",
+                                 "IMSI",
+                                 "RNTI",
+                                 "frame",
+                                 "sframe",
+                                 "slot",
+                                 "symStart",
+                                 "numSym",
+                                 "stream",
+                                 "harqId",
+                                 "ndi",
+                                 "rv",
+                                 "mcs",
+                                 "tbSize"})
+        {
+            columns.push_back(Column{name, NrColumnarTraceFile::INTEGER, 1.0});
+        }
+        if (!file->Open(NrColumnarTraceFile::GetFileName(outputFilename), columns))
+        {
+            return;
+        }
+        if (!m_closeScheduled)
+        {
+            Simulator::ScheduleDestroy(&NrMacSchedulingStats::CloseColumnarFiles,
+                                       Ptr<NrMacSchedulingStats>(this));
+            m_closeScheduled = true;
+        }
+    }
+
+    file->Append(Simulator::Now().GetNanoSeconds(),
+                 {double(cellId),
+                  double(traceInfo.m_bwpId),
+                  double(imsi),
+                  double(traceInfo.m_rnti),
+                  double(traceInfo.m_frameNum),
+                  double(traceInfo.m_subframeNum),
+                  double(traceInfo.m_slotNum),
+                  double(traceInfo.m_symStart),
+                  double(traceInfo.m_numSym),
+                  double(traceInfo.m_streamId),
+                  double(traceInfo.m_harqId),
+                  double(traceInfo.m_ndi),
+                  double(traceInfo.m_rv),
+                  double(traceInfo.m_mcs),
+                  double(traceInfo.m_tbSize)});
+}
+
+void
+NrMacSchedulingStats::CloseColumnarFiles()
+{
+    m_dlColumnarFile.Close();
+    m_ulColumnarFile.Close();
+}
+
 void
 NrMacSchedulingStats::DlSchedulingCallback(Ptr<NrMacSchedulingStats> macStats,
                                            std::string path,
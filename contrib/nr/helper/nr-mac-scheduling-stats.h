@@ -7,6 +7,7 @@
 #ifndef NR_MAC_SCHEDULING_STATS_H_
 #define NR_MAC_SCHEDULING_STATS_H_
 
+#include "ns3/nr-columnar-trace-file.h"
 #include "ns3/nr-gnb-mac.h"
 #include "ns3/nr-stats-calculator.h"
 #include "ns3/nstime.h"
@@ -33,6 +34,10 @@ namespace ns3
  *   - Stream id
  *   - MCS
  *   - Size of transport block
+ *
+ * With the attribute OutputFormat set to "Columnar", the statistics are written
+ * in a NrColumnarTraceFile with the name of the output file and the ".nrct"
+ * extension; the columns are the same, with the time in ns.
  */
 class NrMacSchedulingStats : public NrStatsCalculator
 {
@@ -122,6 +127,30 @@ class NrMacSchedulingStats : public NrStatsCalculator
                                      NrSchedulingCallbackInfo traceInfo);
 
   private:
+    /**
+     * Write a scheduling event in a columnar file, opening it at the first call.
+     * \param file the columnar file
+     * \param outputFilename the name of the text output file
+     * \param cellId Cell ID of the attached gNB
+     * \param imsi IMSI of the scheduled UE
+     * \param traceInfo the scheduling information
+     */
+    void WriteColumnar(NrColumnarTraceFile* file,
+                       const std::string& outputFilename,
+                       uint16_t cellId,
+                       uint64_t imsi,
+                       const NrSchedulingCallbackInfo& traceInfo);
+
+    /**
+     * Write the index of the columnar files and close them.
+     */
+    void CloseColumnarFiles();
+
+    NrColumnarTraceFile::TraceFormat m_outputFormat; //!< Format of the output files
+    NrColumnarTraceFile m_dlColumnarFile;            //!< DL columnar output
+    NrColumnarTraceFile m_ulColumnarFile;            //!< UL columnar output
+    bool m_closeScheduled;                           //!< Whether the files are closed at destroy
+
     /**
      * When writing DL MAC statistics first time to file,
      * columns description is added. Then next lines are
@@ -7,6 +7,7 @@
 
 #include "nr-phy-rx-trace.h"
 
+#include <ns3/enum.h>
 #include <ns3/log.h>
 #include <ns3/nr-gnb-net-device.h>
 #include <ns3/nr-ue-net-device.h>
@@ -30,6 +31,7 @@ std::string NrPhyRxTrace::m_dlCtrlSinrFileName;
 
 std::ofstream NrPhyRxTrace::m_rxPacketTraceFile;
 std::string NrPhyRxTrace::m_rxPacketTraceFilename;
+NrColumnarTraceFile NrPhyRxTrace::m_rxPacketTraceColumnarFile;
 std::string NrPhyRxTrace::m_simTag;
 std::string NrPhyRxTrace::m_resultsFolder;
 
@@ -56,6 +58,7 @@ std::ofstream NrPhyRxTrace::m_dlDataPathlossFile;
 std::string NrPhyRxTrace::m_dlDataPathlossFileName;
 
 NrPhyRxTrace::NrPhyRxTrace()
+    : m_outputFormat(NrColumnarTraceFile::TEXT)
 {
 }
 
@@ -76,6 +79,8 @@ NrPhyRxTrace::~NrPhyRxTrace()
         m_rxPacketTraceFile.close();
     }
 
+    CloseColumnarFiles();
+
     if (m_rxedGnbPhyCtrlMsgsFile.is_open())
     {
         m_rxedGnbPhyCtrlMsgsFile.close();
@@ -135,7 +140,18 @@ NrPhyRxTrace::GetTypeId()
                 "in order to distinguish them, for example: RxPacketTrace-${SimTag}.out. ",
                 StringValue(""),
                 MakeStringAccessor(&NrPhyRxTrace::SetSimTag),
-                MakeStringChecker());
+                MakeStringChecker())
+            .AddAttribute("OutputFormat",
+                          "Format of the RxPacketTrace output: text, or NrColumnarTraceFile "
+                          "(written with the .nrct extension)",
+                          EnumValue(NrColumnarTraceFile::TEXT),
+                          MakeEnumAccessor(
+                              &NrPhyRxTrace::SetOutputFormat,
+                              &NrPhyRxTrace::GetOutputFormat),
+                          MakeEnumChecker(NrColumnarTraceFile::TEXT,
+                                          "Text",
+                                          NrColumnarTraceFile::COLUMNAR,
+                                          "Columnar"));
     return tid;
 }
 
@@ -151,6 +167,82 @@ NrPhyRxTrace::SetResultsFolder(const std::string& resultsFolder)
     m_resultsFolder = resultsFolder;
 }
 
+void
+NrPhyRxTrace::SetOutputFormat(NrColumnarTraceFile::TraceFormat format)
+{
+    m_outputFormat = format;
+}
+
+NrColumnarTraceFile::TraceFormat
+NrPhyRxTrace::GetOutputFormat() const
+{
+    return m_outputFormat;
+}
+
+void
+NrPhyRxTrace::WriteRxPacketTraceColumnar(const RxPacketTraceParams& params, bool downlink)
+{
+    if (!m_rxPacketTraceColumnarFile.IsOpen())
+    {
+        std::ostringstream oss;
+        oss << m_resultsFolder << "RxPacketTrace" << m_simTag.c_str() << ".nrct";
+
+        using Column = NrColumnarTraceFile::Column;
+        std::vector<Column> columns;
+        for (const auto& name : {"direction",
+                                 "frame",
+                                 "subF",
+                                 "slot",
+                                 "1stSym",
+                                 "nSymbol",
+                                 "cellId",
+                                 "bwpId",
+                                 "streamId",
+                                 "rnti",
+                                 "tbSize",
+                                 "mcs",
+                                 "rv"})
+        {
+            columns.push_back(Column{name, NrColumnarTraceFile::INTEGER, 1.0});
+        }
+        columns.push_back(Column{"SINR(dB)", NrColumnarTraceFile::FLOAT64, 1.0});
+        columns.push_back(Column{"CQI", NrColumnarTraceFile::INTEGER, 1.0});
+        columns.push_back(Column{"corrupt", NrColumnarTraceFile::INTEGER, 1.0});
+        columns.push_back(Column{"TBler", NrColumnarTraceFile::FLOAT64, 1.0});
+
+        if (!m_rxPacketTraceColumnarFile.Open(oss.str(), columns))
+        {
+            NS_FATAL_ERROR("Could not open tracefile");
+        }
+        Simulator::ScheduleDestroy(&NrPhyRxTrace::CloseColumnarFiles);
+    }
+
+    m_rxPacketTraceColumnarFile.Append(Simulator::Now().GetNanoSeconds(),
+                                       {downlink ? 0.0 : 1.0,
+                                        double(params.m_frameNum),
+                                        double(params.m_subframeNum),
+                                        double(params.m_slotNum),
+                                        double(params.m_symStart),
+                                        double(params.m_numSym),
+                                        double(params.m_cellId),
+                                        double(params.m_bwpId),
+                                        double(params.m_streamId),
+                                        double(params.m_rnti),
+                                        double(params.m_tbSize),
+                                        double(params.m_mcs),
+                                        double(params.m_rv),
+                                        10 * log10(params.m_sinr),
+                                        downlink ? double(params.m_cqi) : -1.0,
+                                        double(params.m_corrupt),
+                                        params.m_tbler});
+}
+
+void
+NrPhyRxTrace::CloseColumnarFiles()
+{
+    m_rxPacketTraceColumnarFile.Close();
+}
+
 void
 NrPhyRxTrace::DlDataSinrCallback([[maybe_unused]] Ptr<NrPhyRxTrace> phyStats,
                                  [[maybe_unused]] std::string path,
@@ -814,6 +906,12 @@ NrPhyRxTrace::RxPacketTraceUeCallback(Ptr<NrPhyRxTrace> phyStats,
                                       std::string path,
                                       RxPacketTraceParams params)
 {
+    if (phyStats->m_outputFormat == NrColumnarTraceFile::COLUMNAR)
+    {
+        WriteRxPacketTraceColumnar(params, true);
+        return;
+    }
+
     if (!m_rxPacketTraceFile.is_open())
     {
         std::ostringstream oss;
@@ -893,6 +991,12 @@ NrPhyRxTrace::RxPacketTraceEnbCallback(Ptr<NrPhyRxTrace> phyStats,
                                        std::string path,
                                        RxPacketTraceParams params)
 {
+    if (phyStats->m_outputFormat == NrColumnarTraceFile::COLUMNAR)
+    {
+        WriteRxPacketTraceColumnar(params, false);
+        return;
+    }
+
     if (!m_rxPacketTraceFile.is_open())
     {
         std::ostringstream oss;
@@ -8,6 +8,7 @@
 #ifndef SRC_NR_HELPER_NR_PHY_RX_TRACE_H_
 #define SRC_NR_HELPER_NR_PHY_RX_TRACE_H_
 
+#include <ns3/nr-columnar-trace-file.h>
 #include <ns3/nr-control-messages.h>
 #include <ns3/nr-phy-mac-common.h>
 #include <ns3/nr-spectrum-phy.h>
@@ -41,6 +42,24 @@ class NrPhyRxTrace : public Object
      */
     void SetResultsFolder(const std::string& resultsFolder);
 
+    /**
+     * \brief Set the format of the RxPacketTrace output
+     *
+     * With NrColumnarTraceFile::COLUMNAR the RxPacketTrace is written in a
+     * NrColumnarTraceFile with the ".nrct" extension. Its columns are the
+     * ones of the text file, with the time in ns, the direction as 0 (DL) or
+     * 1 (UL), and a CQI of -1 for the UL.
+     *
+     * \param format the output format
+     */
+    void SetOutputFormat(NrColumnarTraceFile::TraceFormat format);
+
+    /**
+     * \brief Get the format of the RxPacketTrace output
+     * \return the output format
+     */
+    NrColumnarTraceFile::TraceFormat GetOutputFormat() const;
+
     /**
      * \brief Trace sink for DL Average SINR of DATA (in dB).
      * \param [in] phyStats NrPhyRxTrace object
@@ -270,6 +289,18 @@ class NrPhyRxTrace : public Object
                                      uint8_t cqi);
 
   private:
+    /**
+     * \brief Write a RxPacketTrace entry in the columnar file
+     * \param params the trace parameters
+     * \param downlink whether the TB was received by a UE
+     */
+    static void WriteRxPacketTraceColumnar(const RxPacketTraceParams& params, bool downlink);
+
+    /**
+     * \brief Write the index of the columnar files and close them
+     */
+    static void CloseColumnarFiles();
+
     void ReportInterferenceTrace(uint64_t imsi, SpectrumValue& sinr);
     void ReportPowerTrace(uint64_t imsi, SpectrumValue& power);
     void ReportPacketCountUe(UePhyPacketCountParameter param);
@@ -307,6 +338,7 @@ class NrPhyRxTrace : public Object
 
     static std::ofstream m_rxPacketTraceFile;
     static std::string m_rxPacketTraceFilename;
+    static NrColumnarTraceFile m_rxPacketTraceColumnarFile;
 
     static std::ofstream m_rxedGnbPhyCtrlMsgsFile;
     static std::string m_rxedGnbPhyCtrlMsgsFileName;
@@ -328,6 +360,8 @@ class NrPhyRxTrace : public Object
     static std::string m_dlCtrlPathlossFileName;
     static std::ofstream m_dlDataPathlossFile;
     static std::string m_dlDataPathlossFileName;
+
+    NrColumnarTraceFile::TraceFormat m_outputFormat; //!< The `OutputFormat` attribute.
 };
 
 } /* namespace ns3 */
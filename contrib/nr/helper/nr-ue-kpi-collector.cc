@@ -0,0 +1,291 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-ue-kpi-collector.h"
+
+#include <ns3/abort.h>
+#include <ns3/ipv4-header.h>
+#include <ns3/ipv4-l3-protocol.h>
+#include <ns3/log.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/node.h>
+#include <ns3/nr-mac-scheduler-ofdma-dpp.h>
+#include <ns3/nr-ue-net-device.h>
+#include <ns3/packet-sink.h>
+#include <ns3/simulator.h>
+#include <ns3/tag.h>
+#include <ns3/tcp-l4-protocol.h>
+#include <ns3/udp-l4-protocol.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrUeKpiCollector");
+NS_OBJECT_ENSURE_REGISTERED(NrUeKpiCollector);
+
+/**
+ * \ingroup helper
+ * \brief Byte tag with the time a packet was sent to an UE, for NrUeKpiCollector
+ */
+class NrUeKpiTimestampTag : public Tag
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::NrUeKpiTimestampTag")
+                                .SetParent<Tag>()
+                                .AddConstructor<NrUeKpiTimestampTag>();
+        return tid;
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return sizeof(int64_t);
+    }
+
+    void Serialize(TagBuffer i) const override
+    {
+        i.WriteU64(static_cast<uint64_t>(m_txTimeNs));
+    }
+
+    void Deserialize(TagBuffer i) override
+    {
+        m_txTimeNs = static_cast<int64_t>(i.ReadU64());
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        os << "TxTime=" << m_txTimeNs << "ns";
+    }
+
+    int64_t m_txTimeNs{0}; //!< Time the packet was sent, in ns
+};
+
+NS_OBJECT_ENSURE_REGISTERED(NrUeKpiTimestampTag);
+
+TypeId
+NrUeKpiCollector::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrUeKpiCollector")
+                            .SetParent<Object>()
+                            .AddConstructor<NrUeKpiCollector>();
+    return tid;
+}
+
+NrUeKpiCollector::NrUeKpiCollector()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrUeKpiCollector::~NrUeKpiCollector()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NrUeKpiCollector::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+    m_ues.clear();
+    Object::DoDispose();
+}
+
+uint32_t
+NrUeKpiCollector::AddUe(uint32_t ueId,
+                        const Ptr<NrUeNetDevice>& ueDev,
+                        const Ptr<PacketSink>& sink)
+{
+    NS_LOG_FUNCTION(this << ueId);
+    const auto ue = static_cast<uint32_t>(m_ues.size());
+
+    Ptr<Ipv4> ipv4 = ueDev->GetNode()->GetObject<Ipv4>();
+    NS_ABORT_MSG_IF(ipv4 == nullptr || ipv4->GetNInterfaces() < 2,
+                    "UE " << ueId << " has no IPv4 address");
+    m_ueByAddress[ipv4->GetAddress(1, 0).GetLocal().Get()] = ue;
+
+    m_ues.push_back({ueId, ueDev, 0});
+    m_counters.emplace_back();
+    m_extra.resize(m_ues.size() * m_numExtra, 0.0);
+    if (sink != nullptr)
+    {
+        sink->TraceConnectWithoutContext(
+            "Rx",
+            MakeCallback(&NrUeKpiCollector::SinkRx, this).Bind(ue));
+    }
+    return ue;
+}
+
+void
+NrUeKpiCollector::AddSender(const Ptr<Node>& node)
+{
+    NS_LOG_FUNCTION(this << node->GetId());
+    Ptr<Ipv4L3Protocol> ipv4 = node->GetObject<Ipv4L3Protocol>();
+    NS_ABORT_MSG_IF(ipv4 == nullptr, "Node " << node->GetId() << " has no IPv4 stack");
+    ipv4->TraceConnectWithoutContext("SendOutgoing",
+                                     MakeCallback(&NrUeKpiCollector::SendOutgoing, this));
+}
+
+void
+NrUeKpiCollector::ConnectDppScheduler(const Ptr<NrMacSchedulerOfdmaDPP>& scheduler)
+{
+    NS_LOG_FUNCTION(this);
+    scheduler->TraceConnectWithoutContext("DlRbgAllocation",
+                                          MakeCallback(&NrUeKpiCollector::RbgAllocation, this));
+}
+
+void
+NrUeKpiCollector::OpenFile(const std::string& fileName,
+                           const std::vector<std::string>& extraColumns)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    m_file.open(fileName, std::ios_base::out | std::ios_base::app | std::ios_base::ate);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Can't open " << fileName);
+    m_numExtra = extraColumns.size();
+    m_extra.assign(m_ues.size() * m_numExtra, 0.0);
+    m_intervalStart = Simulator::Now();
+
+    if (m_file.tellp() == 0)
+    {
+        m_file << "Time(s),UE_ID,RNTI,";
+        for (const auto& column : extraColumns)
+        {
+            m_file << column << ",";
+        }
+        m_file << "MeasuredThroughput(Mbps),MeasuredDelay(ms),PacketRate(pps),DropRate,"
+                  "AllocatedRBGs\n";
+        m_file.flush();
+    }
+}
+
+void
+NrUeKpiCollector::SetExtra(uint32_t ue, std::size_t column, double value)
+{
+    NS_ASSERT(ue < m_ues.size() && column < m_numExtra);
+    m_extra[ue * m_numExtra + column] = value;
+}
+
+uint16_t
+NrUeKpiCollector::GetRnti(uint32_t ue)
+{
+    NS_ASSERT(ue < m_ues.size());
+    Ue& info = m_ues[ue];
+    if (info.m_rnti == 0)
+    {
+        info.m_rnti = info.m_ueDev->GetRrc()->GetRnti();
+        if (info.m_rnti != 0)
+        {
+            m_ueByRnti[info.m_rnti] = ue;
+        }
+    }
+    return info.m_rnti;
+}
+
+void
+NrUeKpiCollector::SendOutgoing(const Ipv4Header& header,
+                               Ptr<const Packet> packet,
+                               uint32_t /* interface */)
+{
+    // Only the data flows, as the flow monitor
+    const uint8_t protocol = header.GetProtocol();
+    if (protocol != UdpL4Protocol::PROT_NUMBER && protocol != TcpL4Protocol::PROT_NUMBER)
+    {
+        return;
+    }
+    auto it = m_ueByAddress.find(header.GetDestination().Get());
+    if (it == m_ueByAddress.end())
+    {
+        return;
+    }
+    ++m_counters[it->second].m_txPackets;
+    NrUeKpiTimestampTag tag;
+    tag.m_txTimeNs = Simulator::Now().GetNanoSeconds();
+    packet->AddByteTag(tag);
+}
+
+void
+NrUeKpiCollector::SinkRx(uint32_t ue, Ptr<const Packet> packet, const Address& /* from */)
+{
+    Counters& counters = m_counters[ue];
+    ++counters.m_rxPackets;
+    counters.m_rxBytes += packet->GetSize();
+    NrUeKpiTimestampTag tag;
+    if (packet->FindFirstMatchingByteTag(tag))
+    {
+        counters.m_delaySumNs += Simulator::Now().GetNanoSeconds() - tag.m_txTimeNs;
+    }
+}
+
+void
+NrUeKpiCollector::RbgAllocation(uint16_t rnti, uint32_t rbgs)
+{
+    auto it = m_ueByRnti.find(rnti);
+    if (it == m_ueByRnti.end() && m_ueByRnti.size() < m_ues.size())
+    {
+        // An UE attached since the last lookup
+        for (uint32_t ue = 0; ue < m_ues.size(); ++ue)
+        {
+            GetRnti(ue);
+        }
+        it = m_ueByRnti.find(rnti);
+    }
+    if (it != m_ueByRnti.end())
+    {
+        m_counters[it->second].m_rbgs += rbgs;
+    }
+}
+
+void
+NrUeKpiCollector::WriteInterval()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "The output file is not open");
+
+    const double now = Simulator::Now().GetSeconds();
+    const double interval = (Simulator::Now() - m_intervalStart).GetSeconds();
+    m_intervalStart = Simulator::Now();
+
+    m_rows.str("");
+    for (uint32_t ue = 0; ue < m_ues.size(); ++ue)
+    {
+        Counters& counters = m_counters[ue];
+        const auto rx = static_cast<double>(counters.m_rxPackets);
+        const auto tx = static_cast<double>(counters.m_txPackets);
+
+        const double throughputMbps = interval > 0 ? counters.m_rxBytes * 8.0 / (interval * 1e6)
+                                                   : 0.0;
+        const double delayMs = rx > 0 ? counters.m_delaySumNs / rx / 1e6 : 0.0;
+        const double packetRate = interval > 0 ? rx / interval : 0.0;
+        const double dropRate = tx > rx ? (tx - rx) / tx : 0.0;
+
+        m_rows << now << "," << m_ues[ue].m_ueId << "," << GetRnti(ue) << ",";
+        for (std::size_t column = 0; column < m_numExtra; ++column)
+        {
+            m_rows << m_extra[ue * m_numExtra + column] << ",";
+        }
+        m_rows << throughputMbps << "," << delayMs << "," << packetRate << "," << dropRate << ","
+               << counters.m_rbgs << "\n";
+        counters = Counters();
+    }
+
+    // One write per interval, so that the file is complete up to the last interval
+    m_file << m_rows.str();
+    m_file.flush();
+}
+
+} // namespace ns3
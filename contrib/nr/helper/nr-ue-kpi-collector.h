@@ -0,0 +1,189 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <ns3/ipv4-address.h>
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+#include <ns3/ptr.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class Address;
+class Ipv4Header;
+class Node;
+class NrMacSchedulerOfdmaDPP;
+class NrUeNetDevice;
+class Packet;
+class PacketSink;
+
+/**
+ * \ingroup helper
+ * \brief Collector of the DL KPIs of every UE, per interval
+ *
+ * Each UE is registered once, with AddUe(), and gets an index. The counters
+ * of the UEs are kept in a flat array, indexed by UE, and updated by trace
+ * callbacks:
+ *
+ * - the UDP and TCP packets sent to an UE are counted at the IP layer of the
+ *   sender nodes (AddSender()), in the SendOutgoing trace, where the packets
+ *   are also stamped with a byte tag with the sending time. The UE is found
+ *   by its IP address in a hash table;
+ * - the packets received by an UE, their size and their delay are counted in
+ *   the Rx trace of its PacketSink;
+ * - the RBGs assigned to an UE are counted in the DlRbgAllocation trace of
+ *   a DPP scheduler (ConnectDppScheduler()), by RNTI.
+ *
+ * Every call to WriteInterval() writes one row per UE, in the order of
+ * registration, with the KPIs of the interval since the previous call, and
+ * resets the counters:
+ *
+ *     Time(s),UE_ID,RNTI,<extra columns>,MeasuredThroughput(Mbps),MeasuredDelay(ms),
+ *     PacketRate(pps),DropRate,AllocatedRBGs
+ *
+ * The extra columns are set by the user for each UE with SetExtra() (e.g.,
+ * the target traffic and the GFBR). The rows of an interval are written to
+ * the file with a single write; the file is opened once, in append mode.
+ *
+ * The RNTIs are per cell, so a collector counts the RBGs of the UEs of a
+ * single gNB.
+ */
+class NrUeKpiCollector : public Object
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrUeKpiCollector constructor
+     */
+    NrUeKpiCollector();
+
+    /**
+     * \brief ~NrUeKpiCollector deconstructor
+     */
+    ~NrUeKpiCollector() override;
+
+    /**
+     * \brief Register an UE
+     * \param ueId the ID of the UE in the output
+     * \param ueDev the device of the UE, which must have an IPv4 address already
+     * \param sink the application that receives the DL traffic of the UE
+     * \return the index of the UE in the collector
+     */
+    uint32_t AddUe(uint32_t ueId, const Ptr<NrUeNetDevice>& ueDev, const Ptr<PacketSink>& sink);
+
+    /**
+     * \brief Count the packets sent by a node to the registered UEs
+     * \param node the node, e.g., the remote host
+     */
+    void AddSender(const Ptr<Node>& node);
+
+    /**
+     * \brief Count the RBGs assigned by a DPP scheduler to the registered UEs
+     * \param scheduler the scheduler
+     */
+    void ConnectDppScheduler(const Ptr<NrMacSchedulerOfdmaDPP>& scheduler);
+
+    /**
+     * \brief Open the output file and write the header, if the file is empty
+     * \param fileName the name of the file
+     * \param extraColumns the names of the extra columns
+     */
+    void OpenFile(const std::string& fileName, const std::vector<std::string>& extraColumns);
+
+    /**
+     * \brief Set the value of an extra column of an UE, for the next rows
+     * \param ue the index of the UE
+     * \param column the index of the extra column
+     * \param value the value
+     */
+    void SetExtra(uint32_t ue, std::size_t column, double value);
+
+    /**
+     * \brief Get the RNTI of an UE
+     * \param ue the index of the UE
+     * \return the RNTI, or 0 if the UE isn't attached yet
+     */
+    uint16_t GetRnti(uint32_t ue);
+
+    /**
+     * \brief Write the rows of the interval that ends now, and reset the counters
+     */
+    void WriteInterval();
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Counters of an UE in the current interval
+     */
+    struct Counters
+    {
+        uint64_t m_txPackets{0}; //!< Packets sent to the UE
+        uint64_t m_rxPackets{0}; //!< Packets received by the UE
+        uint64_t m_rxBytes{0};   //!< Bytes received by the UE
+        int64_t m_delaySumNs{0}; //!< Sum of the delay of the received packets, in ns
+        uint64_t m_rbgs{0};      //!< RBGs assigned to the UE
+    };
+
+    /**
+     * \brief A registered UE
+     */
+    struct Ue
+    {
+        uint32_t m_ueId{0};         //!< ID of the UE in the output
+        Ptr<NrUeNetDevice> m_ueDev; //!< Device of the UE
+        uint16_t m_rnti{0};         //!< RNTI, once attached
+    };
+
+    /**
+     * \brief Count a packet sent by a sender node
+     * \param header the IPv4 header
+     * \param packet the packet
+     * \param interface the interface
+     */
+    void SendOutgoing(const Ipv4Header& header, Ptr<const Packet> packet, uint32_t interface);
+
+    /**
+     * \brief Count a packet received by an UE
+     * \param ue the index of the UE
+     * \param packet the packet
+     * \param from the sender address
+     */
+    void SinkRx(uint32_t ue, Ptr<const Packet> packet, const Address& from);
+
+    /**
+     * \brief Count the RBGs assigned to an UE
+     * \param rnti the RNTI of the UE
+     * \param rbgs the RBGs
+     */
+    void RbgAllocation(uint16_t rnti, uint32_t rbgs);
+
+    std::vector<Ue> m_ues;                                //!< Registered UEs
+    std::vector<Counters> m_counters;                     //!< Counters, per UE
+    std::unordered_map<uint32_t, uint32_t> m_ueByAddress; //!< UE index, per IPv4 address
+    std::unordered_map<uint16_t, uint32_t> m_ueByRnti;    //!< UE index, per RNTI
+    std::vector<double> m_extra;                          //!< Extra columns, per UE
+    std::size_t m_numExtra{0};                            //!< Number of extra columns
+    std::ofstream m_file;                                 //!< Output file
+    std::ostringstream m_rows;                            //!< Rows of the interval
+    Time m_intervalStart;                                 //!< Start of the interval
+};
+
+} // namespace ns3
@@ -17,12 +17,17 @@
 #include <ns3/nr-spectrum-value-helper.h>
 #include <ns3/uinteger.h>
 
+#include <limits>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("NrAmc");
 NS_OBJECT_ENSURE_REGISTERED(NrAmc);
 
+/// Entry of the TB size table not computed yet
+static constexpr uint32_t TbsUnknown = std::numeric_limits<uint32_t>::max();
+
 NrAmc::NrAmc()
 {
     NS_LOG_INFO("Initialze AMC module");
@@ -37,6 +42,7 @@ NrAmc::SetDlMode()
 {
     NS_LOG_FUNCTION(this);
     m_emMode = NrErrorModel::DL;
+    m_tbsTable.clear();
 }
 
 void
@@ -44,6 +50,7 @@ NrAmc::SetUlMode()
 {
     NS_LOG_FUNCTION(this);
     m_emMode = NrErrorModel::UL;
+    m_tbsTable.clear();
 }
 
 TypeId
@@ -65,6 +72,17 @@ NrAmc::GetTypeId()
                                           "ErrorModel",
                                           NrAmc::ShannonModel,
                                           "ShannonModel"))
+            .AddAttribute("TbsTableMaxPrb",
+                          "Largest number of RBs of the precomputed table of TB sizes. "
+                          "CalculateTbSize reads the table up to this number of RBs, and "
+                          "computes the TB size with the error model above it. The "
+                          "schedulers count the RBs of all the symbols of the allocation, "
+                          "so the default covers 275 RBs over the 14 symbols of a slot. "
+                          "0 disables the table",
+                          UintegerValue(275 * 14),
+                          MakeUintegerAccessor(&NrAmc::SetTbsTableMaxPrb,
+                                               &NrAmc::GetTbsTableMaxPrb),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("ErrorModelType",
                           "Type of the Error Model to use when AmcModel is set to ErrorModel. "
                           "This parameter has to match the ErrorModelType in nr-spectrum-model,"
@@ -114,6 +132,31 @@ NrAmc::SetNumRefScPerRb(uint8_t nref)
 {
     NS_LOG_FUNCTION(this);
     m_numRefScPerRb = nref;
+    m_tbsTable.clear();
+}
+
+uint32_t
+NrAmc::GetTbsTableMaxPrb() const
+{
+    return m_tbsTableMaxPrb;
+}
+
+void
+NrAmc::SetTbsTableMaxPrb(uint32_t maxPrb)
+{
+    NS_LOG_FUNCTION(this << maxPrb);
+    m_tbsTableMaxPrb = maxPrb;
+    m_tbsTable.clear();
+}
+
+void
+NrAmc::BuildTbsTable() const
+{
+    NS_LOG_FUNCTION(this);
+    // The entries are computed at their first use: not all the numbers of RBs
+    // are valid for every error model (e.g., the LENA one)
+    uint32_t numMcs = m_errorModel->GetMaxMcs() + 1;
+    m_tbsTable.assign(numMcs * (m_tbsTableMaxPrb + 1), TbsUnknown);
 }
 
 uint32_t
@@ -125,6 +168,26 @@ NrAmc::CalculateTbSize(uint8_t mcs, uint32_t nprb) const
                   "MCS=" << static_cast<uint32_t>(mcs) << " while maximum MCS is "
                          << static_cast<uint32_t>(m_errorModel->GetMaxMcs()));
 
+    if (m_tbsTableMaxPrb > 0 && nprb <= m_tbsTableMaxPrb)
+    {
+        if (m_tbsTable.empty())
+        {
+            BuildTbsTable();
+        }
+        uint32_t& tbSize = m_tbsTable[mcs * (m_tbsTableMaxPrb + 1) + nprb];
+        if (tbSize == TbsUnknown)
+        {
+            tbSize = ComputeTbSize(mcs, nprb);
+        }
+        return tbSize;
+    }
+
+    return ComputeTbSize(mcs, nprb);
+}
+
+uint32_t
+NrAmc::ComputeTbSize(uint8_t mcs, uint32_t nprb) const
+{
     uint32_t payloadSize = GetPayloadSize(mcs, nprb);
     uint32_t tbSize = payloadSize;
 
@@ -218,7 +281,8 @@ NrAmc::CreateCqiFeedbackWbTdma(const SpectrumValue& sinr, uint8_t& mcs) const
     }
     else if (m_amcModel == ErrorModel)
     {
-        std::vector<int> rbMap;
+        std::vector<int>& rbMap = m_rbMap;
+        rbMap.clear();
         int rbId = 0;
         for (it = sinr.ConstValuesBegin(); it != sinr.ConstValuesEnd(); it++)
         {
@@ -229,37 +293,34 @@ NrAmc::CreateCqiFeedbackWbTdma(const SpectrumValue& sinr, uint8_t& mcs) const
             rbId += 1;
         }
 
-        mcs = 0;
-        Ptr<NrErrorModelOutput> output;
-        while (mcs <= m_errorModel->GetMaxMcs())
-        {
-            output = m_errorModel->GetTbDecodificationStats(sinr,
-                                                            rbMap,
-                                                            CalculateTbSize(mcs, rbMap.size()),
-                                                            mcs,
-                                                            NrErrorModel::NrErrorModelHistory());
-            if (output->m_tbler > 0.1)
-            {
-                break;
-            }
-            mcs++;
-        }
-
-        if (mcs > 0)
+        // First MCS with a BLER above 10% (maxMcs + 1 if none). The BLER is not
+        // monotone in the MCS (the TB size changes the code blocks), so the MCS
+        // are tried in order
+        const uint8_t maxMcs = m_errorModel->GetMaxMcs();
+        uint32_t first = 0;
+        while (first <= maxMcs &&
+               m_errorModel->GetTbBler(sinr,
+                                       rbMap,
+                                       CalculateTbSize(first, rbMap.size()),
+                                       static_cast<uint8_t>(first)) <= 0.1)
         {
-            mcs--;
+            ++first;
         }
 
-        if ((output->m_tbler > 0.1) && (mcs == 0))
+        if (first <= 1)
         {
+            // Not even the MCS 1 can guarantee the 10 % of BER
+            mcs = 0;
             cqi = 0;
         }
-        else if (mcs == m_errorModel->GetMaxMcs())
+        else if (first == maxMcs + 1u)
         {
+            mcs = maxMcs;
             cqi = 15; // all MCSs can guarantee the 10 % of BER
         }
         else
         {
+            mcs = static_cast<uint8_t>(first - 1);
             double s = m_errorModel->GetSpectralEfficiencyForMcs(mcs);
             cqi = 0;
             while ((cqi < 15) && (m_errorModel->GetSpectralEfficiencyForCqi(cqi + 1) <= s))
@@ -332,6 +393,7 @@ NrAmc::SetErrorModelType(const TypeId& type)
     factory.SetTypeId(m_errorModelType);
     m_errorModel = DynamicCast<NrErrorModel>(factory.Create());
     NS_ASSERT(m_errorModel != nullptr);
+    m_tbsTable.clear();
 }
 
 TypeId
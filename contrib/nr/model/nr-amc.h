@@ -118,6 +118,11 @@ class NrAmc : public Object
      * which the gNB/UE has transmitted power, and from which the SINR can be
      * measured, during 1 OFDM symbol, is assumed.
      *
+     * With the ErrorModel AMC, the MCS is the highest one before the first
+     * MCS with a BLER above 10%. The MCS are tried in order, since the BLER
+     * of the error models is not monotone in the MCS, and each BLER is
+     * obtained with NrErrorModel::GetTbBler, which creates no output.
+     *
      * \param sinr the sinr values
      * \param mcsWb The calculated MCS
      * \return The calculated CQI
@@ -173,6 +178,11 @@ class NrAmc : public Object
      * It depends on the error model and the "mode" configured with SetMode().
      * Please note that this function expects in input the RB, not the RBG of the transmission.
      *
+     * Up to "TbsTableMaxPrb" RBs the value is read from a table of all the
+     * (MCS, number of RB) pairs, cleared when the configuration changes and
+     * filled at the first use of each pair; the values are the same that the
+     * error model gives.
+     *
      * \param mcs the MCS of the transmission
      * \param nprb The number of physical resource blocks used in the transmission
      * \return the TBS in bytes
@@ -187,7 +197,33 @@ class NrAmc : public Object
      */
     uint32_t GetPayloadSize(uint8_t mcs, uint32_t nprb) const;
 
+    /**
+     * \brief Set the largest number of RBs of the TB size table
+     * \param maxPrb the number of RBs (0 disables the table)
+     */
+    void SetTbsTableMaxPrb(uint32_t maxPrb);
+
+    /**
+     * \brief Get the largest number of RBs of the TB size table
+     * \return the number of RBs
+     */
+    uint32_t GetTbsTableMaxPrb() const;
+
   private:
+    /**
+     * \brief Compute the TransportBlock size with the error model
+     * \param mcs the MCS of the transmission
+     * \param nprb The number of physical resource blocks used in the transmission
+     * \return the TBS in bytes
+     */
+    uint32_t ComputeTbSize(uint8_t mcs, uint32_t nprb) const;
+
+    /**
+     * \brief Allocate the TB size table for the current configuration, with
+     * all the entries still to compute
+     */
+    void BuildTbsTable() const;
+
     /**
      * \brief Get the requested BER in assigning MCS (Shannon-bound model)
      * \return BER
@@ -201,6 +237,9 @@ class NrAmc : public Object
     uint8_t m_numRefScPerRb{1};                    //!< number of reference subcarriers per RB
     NrErrorModel::Mode m_emMode{NrErrorModel::DL}; //!< Error model mode
     static const unsigned int m_crcLen = 24 / 8;   //!< CRC length (in bytes)
+    uint32_t m_tbsTableMaxPrb{275 * 14};           //!< Largest number of RBs of the TBS table
+    mutable std::vector<uint32_t> m_tbsTable;      //!< TB sizes, indexed by MCS and number of RBs
+    mutable std::vector<int> m_rbMap;              //!< RBs of the last CQI feedback, reused
 };
 
 } // end namespace ns3
@@ -0,0 +1,523 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-columnar-trace-file.h"
+
+#include <ns3/abort.h>
+#include <ns3/assert.h>
+#include <ns3/log.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrColumnarTraceFile");
+
+namespace
+{
+
+const char HEADER_MAGIC[8] = {'N', 'R', 'C', 'T', 'R', 'C', '0', '1'};
+const char TRAILER_MAGIC[8] = {'N', 'R', 'C', 'T', 'I', 'D', 'X', '1'};
+
+/**
+ * \brief Append an unsigned integer in little endian
+ * \param out the buffer
+ * \param value the value
+ * \param bytes the number of bytes to write
+ */
+void
+PutLe(std::vector<uint8_t>* out, uint64_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; ++i)
+    {
+        out->push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/**
+ * \brief Append a double in little endian
+ * \param out the buffer
+ * \param value the value
+ */
+void
+PutDouble(std::vector<uint8_t>* out, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    PutLe(out, bits, 8);
+}
+
+/**
+ * \brief Append a zig-zag mapped LEB128 varint
+ * \param out the buffer
+ * \param value the value
+ */
+void
+PutVarint(std::vector<uint8_t>* out, int64_t value)
+{
+    uint64_t zz = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    while (zz >= 0x80)
+    {
+        out->push_back(static_cast<uint8_t>(zz | 0x80));
+        zz >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(zz));
+}
+
+/**
+ * \brief Read an unsigned integer in little endian
+ * \param in the buffer
+ * \param bytes the number of bytes to read
+ * \return the value
+ */
+uint64_t
+GetLe(const uint8_t* in, unsigned bytes)
+{
+    uint64_t value = 0;
+    for (unsigned i = 0; i < bytes; ++i)
+    {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * \brief Read a double in little endian
+ * \param in the buffer
+ * \return the value
+ */
+double
+GetDouble(const uint8_t* in)
+{
+    uint64_t bits = GetLe(in, 8);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * \brief Read a zig-zag mapped LEB128 varint
+ * \param in the buffer, advanced past the varint
+ * \param end the end of the buffer
+ * \return the value
+ */
+int64_t
+GetVarint(const uint8_t** in, const uint8_t* end)
+{
+    uint64_t zz = 0;
+    unsigned shift = 0;
+    while (*in < end)
+    {
+        uint8_t byte = *(*in)++;
+        zz |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            break;
+        }
+        shift += 7;
+    }
+    return static_cast<int64_t>(zz >> 1) ^ -static_cast<int64_t>(zz & 1);
+}
+
+} // namespace
+
+NrColumnarTraceFile::~NrColumnarTraceFile()
+{
+    Close();
+}
+
+bool
+NrColumnarTraceFile::Open(const std::string& fileName,
+                          const std::vector<Column>& columns,
+                          uint32_t rowsPerChunk)
+{
+    NS_LOG_FUNCTION(this << fileName << columns.size() << rowsPerChunk);
+    NS_ABORT_MSG_IF(m_file.is_open(), "File already open");
+    NS_ABORT_MSG_IF(rowsPerChunk == 0, "Chunks cannot be empty");
+
+    m_file.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        NS_LOG_ERROR("Can't open file " << fileName);
+        return false;
+    }
+
+    m_fileName = fileName;
+    m_suspended = false;
+    m_columns.clear();
+    m_columns.push_back({"time_ns", INTEGER, 1.0});
+    m_columns.insert(m_columns.end(), columns.begin(), columns.end());
+    m_rowsPerChunk = rowsPerChunk;
+    m_numRows = 0;
+    m_index.clear();
+    m_intValues.assign(m_columns.size(), {});
+    m_realValues.assign(m_columns.size(), {});
+    for (std::size_t c = 0; c < m_columns.size(); ++c)
+    {
+        if (m_columns[c].m_kind == FLOAT64)
+        {
+            m_realValues[c].reserve(m_rowsPerChunk);
+        }
+        else
+        {
+            m_intValues[c].reserve(m_rowsPerChunk);
+        }
+    }
+
+    m_encoded.clear();
+    m_encoded.insert(m_encoded.end(), HEADER_MAGIC, HEADER_MAGIC + sizeof(HEADER_MAGIC));
+    PutLe(&m_encoded, m_columns.size(), 4);
+    for (const auto& column : m_columns)
+    {
+        NS_ABORT_MSG_IF(column.m_kind == FIXED_POINT && column.m_scale <= 0.0,
+                        "Invalid scale for column " << column.m_name);
+        m_encoded.push_back(column.m_kind);
+        PutDouble(&m_encoded, column.m_scale);
+        PutLe(&m_encoded, column.m_name.size(), 2);
+        m_encoded.insert(m_encoded.end(), column.m_name.begin(), column.m_name.end());
+    }
+    m_file.write(reinterpret_cast<const char*>(m_encoded.data()), m_encoded.size());
+    return true;
+}
+
+bool
+NrColumnarTraceFile::IsOpen() const
+{
+    return m_file.is_open() || m_suspended;
+}
+
+void
+NrColumnarTraceFile::Append(int64_t timeNs, std::initializer_list<double> values)
+{
+    NS_ASSERT_MSG(IsOpen(), "File not open");
+    NS_ASSERT_MSG(values.size() + 1 == m_columns.size(),
+                  "Expected " << m_columns.size() - 1 << " values, got " << values.size());
+
+    m_intValues[0].push_back(timeNs);
+    std::size_t c = 1;
+    for (const auto& v : values)
+    {
+        switch (m_columns[c].m_kind)
+        {
+        case INTEGER:
+            m_intValues[c].push_back(std::llround(v));
+            break;
+        case FIXED_POINT:
+            m_intValues[c].push_back(std::llround(v * m_columns[c].m_scale));
+            break;
+        case FLOAT64:
+            m_realValues[c].push_back(v);
+            break;
+        }
+        ++c;
+    }
+
+    if (++m_numRows == m_rowsPerChunk)
+    {
+        WriteChunk();
+    }
+}
+
+void
+NrColumnarTraceFile::WriteChunk()
+{
+    if (m_numRows == 0)
+    {
+        return;
+    }
+    Resume();
+
+    ChunkIndex entry;
+    entry.m_offset = m_file.tellp();
+    entry.m_firstTime = m_intValues[0].front();
+    entry.m_lastTime = m_intValues[0].back();
+    entry.m_numRows = m_numRows;
+    m_index.push_back(entry);
+
+    m_encoded.clear();
+    PutLe(&m_encoded, m_numRows, 4);
+    for (std::size_t c = 0; c < m_columns.size(); ++c)
+    {
+        // Reserve the length, and fill it once the column is encoded
+        std::size_t lengthPos = m_encoded.size();
+        PutLe(&m_encoded, 0, 4);
+        std::size_t start = m_encoded.size();
+        if (m_columns[c].m_kind == FLOAT64)
+        {
+            for (const auto& v : m_realValues[c])
+            {
+                PutDouble(&m_encoded, v);
+            }
+            m_realValues[c].clear();
+        }
+        else
+        {
+            int64_t prev = 0;
+            for (const auto& v : m_intValues[c])
+            {
+                PutVarint(&m_encoded, v - prev);
+                prev = v;
+            }
+            m_intValues[c].clear();
+        }
+        uint64_t length = m_encoded.size() - start;
+        NS_ABORT_MSG_IF(length > UINT32_MAX, "Column too large, reduce the chunk size");
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            m_encoded[lengthPos + i] = static_cast<uint8_t>(length >> (8 * i));
+        }
+    }
+    m_file.write(reinterpret_cast<const char*>(m_encoded.data()), m_encoded.size());
+    m_numRows = 0;
+}
+
+void
+NrColumnarTraceFile::Close()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    Resume();
+    WriteChunk();
+
+    uint64_t indexOffset = m_file.tellp();
+    m_encoded.clear();
+    for (const auto& entry : m_index)
+    {
+        PutLe(&m_encoded, entry.m_offset, 8);
+        PutLe(&m_encoded, static_cast<uint64_t>(entry.m_firstTime), 8);
+        PutLe(&m_encoded, static_cast<uint64_t>(entry.m_lastTime), 8);
+        PutLe(&m_encoded, entry.m_numRows, 4);
+    }
+    PutLe(&m_encoded, m_index.size(), 8);
+    PutLe(&m_encoded, indexOffset, 8);
+    m_encoded.insert(m_encoded.end(), TRAILER_MAGIC, TRAILER_MAGIC + sizeof(TRAILER_MAGIC));
+    m_file.write(reinterpret_cast<const char*>(m_encoded.data()), m_encoded.size());
+    m_file.close();
+
+    m_index.clear();
+    m_encoded.clear();
+    m_encoded.shrink_to_fit();
+}
+
+void
+NrColumnarTraceFile::Suspend()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file.is_open())
+    {
+        m_file.close();
+        m_suspended = true;
+    }
+}
+
+void
+NrColumnarTraceFile::Resume()
+{
+    if (!m_suspended)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    m_file.open(m_fileName, std::ios::in | std::ios::out | std::ios::binary);
+    NS_ABORT_MSG_IF(!m_file.is_open(), "Can't reopen file " << m_fileName);
+    m_file.seekp(0, std::ios::end);
+    m_suspended = false;
+}
+
+std::string
+NrColumnarTraceFile::GetFileName(const std::string& textFileName)
+{
+    auto dot = textFileName.find_last_of('.');
+    auto slash = textFileName.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return textFileName + ".nrct";
+    }
+    return textFileName.substr(0, dot) + ".nrct";
+}
+
+bool
+NrColumnarTraceFileReader::Open(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    m_file.open(fileName, std::ios::in | std::ios::binary);
+    if (!m_file.is_open())
+    {
+        NS_LOG_ERROR("Can't open file " << fileName);
+        return false;
+    }
+
+    // Header
+    m_buffer.resize(sizeof(HEADER_MAGIC) + 4);
+    m_file.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size());
+    if (!m_file || std::memcmp(m_buffer.data(), HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0)
+    {
+        NS_LOG_ERROR(fileName << " is not a NrColumnarTraceFile");
+        m_file.close();
+        return false;
+    }
+    uint64_t numColumns = GetLe(m_buffer.data() + sizeof(HEADER_MAGIC), 4);
+    m_columns.clear();
+    for (uint64_t c = 0; c < numColumns; ++c)
+    {
+        uint8_t fixed[11];
+        m_file.read(reinterpret_cast<char*>(fixed), sizeof(fixed));
+        NrColumnarTraceFile::Column column;
+        column.m_kind = static_cast<NrColumnarTraceFile::Kind>(fixed[0]);
+        column.m_scale = GetDouble(fixed + 1);
+        column.m_name.resize(GetLe(fixed + 9, 2));
+        m_file.read(&column.m_name[0], column.m_name.size());
+        m_columns.push_back(column);
+    }
+
+    // Trailer and index
+    const std::size_t trailerSize = 16 + sizeof(TRAILER_MAGIC);
+    m_file.seekg(-static_cast<std::streamoff>(trailerSize), std::ios::end);
+    m_buffer.resize(trailerSize);
+    m_file.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size());
+    if (!m_file || std::memcmp(m_buffer.data() + 16, TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0)
+    {
+        NS_LOG_ERROR(fileName << " has no index: it was not closed");
+        m_file.close();
+        return false;
+    }
+    uint64_t numChunks = GetLe(m_buffer.data(), 8);
+    uint64_t indexOffset = GetLe(m_buffer.data() + 8, 8);
+    m_file.seekg(indexOffset);
+    m_buffer.resize(numChunks * 28);
+    m_file.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size());
+    m_index.clear();
+    for (uint64_t i = 0; i < numChunks; ++i)
+    {
+        const uint8_t* entry = m_buffer.data() + i * 28;
+        ChunkIndex chunk;
+        chunk.m_offset = GetLe(entry, 8);
+        chunk.m_firstTime = static_cast<int64_t>(GetLe(entry + 8, 8));
+        chunk.m_lastTime = static_cast<int64_t>(GetLe(entry + 16, 8));
+        chunk.m_numRows = static_cast<uint32_t>(GetLe(entry + 24, 4));
+        m_index.push_back(chunk);
+    }
+    return static_cast<bool>(m_file);
+}
+
+bool
+NrColumnarTraceFileReader::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+const std::vector<NrColumnarTraceFile::Column>&
+NrColumnarTraceFileReader::GetColumns() const
+{
+    return m_columns;
+}
+
+uint64_t
+NrColumnarTraceFileReader::GetNumRows() const
+{
+    uint64_t rows = 0;
+    for (const auto& chunk : m_index)
+    {
+        rows += chunk.m_numRows;
+    }
+    return rows;
+}
+
+uint32_t
+NrColumnarTraceFileReader::Read(int64_t startNs,
+                                int64_t endNs,
+                                std::vector<int64_t>* timeNs,
+                                std::vector<std::vector<double>>* values)
+{
+    NS_LOG_FUNCTION(this << startNs << endNs);
+    NS_ASSERT_MSG(m_file.is_open(), "File not open");
+    timeNs->clear();
+    values->assign(m_columns.size() - 1, {});
+
+    uint32_t decoded = 0;
+    std::vector<int64_t> chunkTime;
+    std::vector<std::vector<double>> chunkValues(m_columns.size() - 1);
+    for (const auto& chunk : m_index)
+    {
+        if (chunk.m_lastTime < startNs || chunk.m_firstTime >= endNs)
+        {
+            continue;
+        }
+        ++decoded;
+
+        m_file.seekg(chunk.m_offset);
+        uint8_t header[4];
+        m_file.read(reinterpret_cast<char*>(header), sizeof(header));
+        uint32_t numRows = static_cast<uint32_t>(GetLe(header, 4));
+        NS_ABORT_MSG_IF(numRows != chunk.m_numRows, "Corrupted chunk at " << chunk.m_offset);
+
+        for (std::size_t c = 0; c < m_columns.size(); ++c)
+        {
+            m_file.read(reinterpret_cast<char*>(header), sizeof(header));
+            m_buffer.resize(GetLe(header, 4));
+            m_file.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size());
+            NS_ABORT_MSG_IF(!m_file, "Truncated chunk at " << chunk.m_offset);
+
+            const NrColumnarTraceFile::Column& column = m_columns[c];
+            const uint8_t* in = m_buffer.data();
+            const uint8_t* end = in + m_buffer.size();
+            std::vector<double>* out = c > 0 ? &chunkValues[c - 1] : nullptr;
+            if (out != nullptr)
+            {
+                out->clear();
+            }
+            else
+            {
+                chunkTime.clear();
+            }
+            int64_t value = 0;
+            for (uint32_t row = 0; row < numRows; ++row)
+            {
+                if (column.m_kind == NrColumnarTraceFile::FLOAT64)
+                {
+                    NS_ABORT_MSG_IF(in + 8 > end, "Truncated column " << column.m_name);
+                    out->push_back(GetDouble(in));
+                    in += 8;
+                    continue;
+                }
+                value += GetVarint(&in, end);
+                if (out == nullptr)
+                {
+                    chunkTime.push_back(value);
+                }
+                else if (column.m_kind == NrColumnarTraceFile::FIXED_POINT)
+                {
+                    out->push_back(value / column.m_scale);
+                }
+                else
+                {
+                    out->push_back(static_cast<double>(value));
+                }
+            }
+        }
+
+        for (uint32_t row = 0; row < numRows; ++row)
+        {
+            if (chunkTime[row] < startNs || chunkTime[row] >= endNs)
+            {
+                continue;
+            }
+            timeNs->push_back(chunkTime[row]);
+            for (std::size_t c = 0; c < chunkValues.size(); ++c)
+            {
+                (*values)[c].push_back(chunkValues[c][row]);
+            }
+        }
+    }
+    return decoded;
+}
+
+} // namespace ns3
@@ -0,0 +1,241 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup utils
+ *
+ * \brief Compact, chunked and columnar binary trace file
+ *
+ * It is an alternative to the tab-separated text traces, for traces with
+ * millions of rows (one per UE and slot). Rows are buffered and written in
+ * chunks; inside a chunk each column is stored contiguously:
+ *
+ * - INTEGER columns are delta encoded (the first row of a chunk against zero),
+ *   zig-zag mapped and written as LEB128 varints;
+ * - FIXED_POINT columns are quantized to 1/scale and then stored as INTEGER;
+ * - FLOAT64 columns are stored as raw little-endian doubles.
+ *
+ * The first column is always the simulation time in ns ("time_ns"). At the
+ * end of the file an index with the offset and the time span of every chunk
+ * allows a reader to load only the chunks of a time window.
+ *
+ * Layout (all the fields are little endian):
+ *
+ *     header:  "NRCTRC01", u32 numColumns,
+ *              numColumns x {u8 kind, f64 scale, u16 nameLength, name}
+ *     chunk:   u32 numRows, numColumns x {u32 numBytes, bytes}
+ *     index:   numChunks x {u64 offset, i64 firstTime, i64 lastTime, u32 numRows}
+ *     trailer: u64 numChunks, u64 indexOffset, "NRCTIDX1"
+ *
+ * A file is readable only after Close(), which writes the index. The files
+ * are read with NrColumnarTraceFileReader, or, from Python/NumPy, with
+ * contrib/nr/utils/nr_columnar_trace.py.
+ */
+class NrColumnarTraceFile
+{
+  public:
+    /**
+     * \brief Output format of the traces that can also be written as columnar files
+     */
+    enum TraceFormat
+    {
+        TEXT,    //!< Tab-separated (or comma-separated) text
+        COLUMNAR //!< NrColumnarTraceFile
+    };
+
+    /**
+     * \brief Encoding of a column
+     */
+    enum Kind : uint8_t
+    {
+        INTEGER = 0,     //!< Integer, delta + varint encoded
+        FIXED_POINT = 1, //!< Real quantized to 1/scale, delta + varint encoded
+        FLOAT64 = 2      //!< Real stored as it is
+    };
+
+    /**
+     * \brief Description of a column
+     */
+    struct Column
+    {
+        std::string m_name;   //!< Name of the column
+        Kind m_kind{INTEGER}; //!< Encoding
+        double m_scale{1.0};  //!< Quantization of FIXED_POINT columns
+    };
+
+    /**
+     * \brief NrColumnarTraceFile constructor
+     */
+    NrColumnarTraceFile() = default;
+
+    /**
+     * \brief ~NrColumnarTraceFile deconstructor; closes the file
+     */
+    ~NrColumnarTraceFile();
+
+    NrColumnarTraceFile(const NrColumnarTraceFile&) = delete;
+    NrColumnarTraceFile& operator=(const NrColumnarTraceFile&) = delete;
+
+    /**
+     * \brief Create the file and write its header
+     * \param fileName name of the file
+     * \param columns the columns, excluding the time column
+     * \param rowsPerChunk rows of each chunk (the granularity of the index)
+     * \return true if the file could be created
+     */
+    bool Open(const std::string& fileName,
+              const std::vector<Column>& columns,
+              uint32_t rowsPerChunk = 16384);
+
+    /**
+     * \brief Check if the file is open
+     * \return true if Open() succeeded and Close() was not called
+     */
+    bool IsOpen() const;
+
+    /**
+     * \brief Append a row
+     * \param timeNs simulation time of the row, in ns
+     * \param values the values of the columns, in the order given to Open()
+     */
+    void Append(int64_t timeNs, std::initializer_list<double> values);
+
+    /**
+     * \brief Write the pending rows, the index and close the file
+     */
+    void Close();
+
+    /**
+     * \brief Close the stream but keep the file open for Append()
+     *
+     * Before a fork(), so that the two processes don't share the offset of
+     * the file: the written chunks are flushed, the pending rows and the
+     * index stay in memory, and each process reopens the file at its end
+     * with the next chunk or Close().
+     */
+    void Suspend();
+
+    /**
+     * \brief Get the file name that corresponds to a text trace
+     * \param textFileName name of the text trace (e.g., "g.txt")
+     * \return the same name with the ".nrct" extension (e.g., "g.nrct")
+     */
+    static std::string GetFileName(const std::string& textFileName);
+
+  private:
+    /**
+     * \brief Index entry of a chunk
+     */
+    struct ChunkIndex
+    {
+        uint64_t m_offset{0};   //!< Offset of the chunk in the file
+        int64_t m_firstTime{0}; //!< Time of the first row
+        int64_t m_lastTime{0};  //!< Time of the last row
+        uint32_t m_numRows{0};  //!< Rows in the chunk
+    };
+
+    /**
+     * \brief Encode and write the buffered rows
+     */
+    void WriteChunk();
+
+    /**
+     * \brief Reopen the file at its end, after Suspend()
+     */
+    void Resume();
+
+    std::ofstream m_file;                  //!< The output file
+    std::string m_fileName;                //!< Name of the file
+    bool m_suspended{false};               //!< Whether the stream was closed by Suspend()
+    std::vector<Column> m_columns;         //!< Columns, time included
+    uint32_t m_rowsPerChunk{0};            //!< Rows of a full chunk
+    uint32_t m_numRows{0};                 //!< Rows buffered
+    std::vector<std::vector<int64_t>> m_intValues; //!< Buffered integer columns
+    std::vector<std::vector<double>> m_realValues; //!< Buffered FLOAT64 columns
+    std::vector<uint8_t> m_encoded;        //!< Scratch buffer for the encoding
+    std::vector<ChunkIndex> m_index;       //!< Index of the written chunks
+};
+
+/**
+ * \ingroup utils
+ *
+ * \brief Reader of the files written by NrColumnarTraceFile
+ *
+ * It loads the header and the index at Open(); Read() then decodes only the
+ * chunks that overlap the requested time window, as the Python reader does.
+ */
+class NrColumnarTraceFileReader
+{
+  public:
+    /**
+     * \brief Open a file and load its columns and its index
+     * \param fileName name of the file
+     * \return true if the file is a complete NrColumnarTraceFile
+     */
+    bool Open(const std::string& fileName);
+
+    /**
+     * \brief Check if the file is open
+     * \return true if Open() succeeded
+     */
+    bool IsOpen() const;
+
+    /**
+     * \brief Get the columns of the file
+     * \return the columns, the time ("time_ns") included as the first one
+     */
+    const std::vector<NrColumnarTraceFile::Column>& GetColumns() const;
+
+    /**
+     * \brief Get the number of rows of the file
+     * \return the number of rows
+     */
+    uint64_t GetNumRows() const;
+
+    /**
+     * \brief Read the rows with startNs <= time < endNs
+     * \param startNs start of the window, in ns
+     * \param endNs end of the window, in ns
+     * \param timeNs the time of the rows
+     * \param values the values of the rows, one vector per column, the time
+     * excluded; FIXED_POINT values are converted back with their scale
+     * \return the number of chunks decoded
+     */
+    uint32_t Read(int64_t startNs,
+                  int64_t endNs,
+                  std::vector<int64_t>* timeNs,
+                  std::vector<std::vector<double>>* values);
+
+  private:
+    /**
+     * \brief Index entry of a chunk
+     */
+    struct ChunkIndex
+    {
+        uint64_t m_offset{0};   //!< Offset of the chunk in the file
+        int64_t m_firstTime{0}; //!< Time of the first row
+        int64_t m_lastTime{0};  //!< Time of the last row
+        uint32_t m_numRows{0};  //!< Rows in the chunk
+    };
+
+    std::ifstream m_file;                               //!< The input file
+    std::vector<NrColumnarTraceFile::Column> m_columns; //!< Columns, time included
+    std::vector<ChunkIndex> m_index;                    //!< Index of the chunks
+    std::vector<uint8_t> m_buffer;                      //!< Scratch buffer for the decoding
+};
+
+} // namespace ns3
@@ -8,6 +8,7 @@
 #include "nr-eesm-error-model.h"
 
 #include "nr-phy-mac-common.h"
+#include "nr-sinr-kernels.h"
 
 #include "ns3/enum.h"
 #include "ns3/log.h"
@@ -66,7 +67,12 @@ NrEesmErrorModel::SinrEff(const SpectrumValue& sinr,
     // for HARQ-IR: b = sum (map.size()), a = sum_j(sum_n (exp (-sinr/beta))) (for previous retx,
     // till j=q-1) for HARQ-CC: b = map.size(), a = 0.0 (SINRs are already combined in sinr input)
 
-    double sinrExpSum = SinrExp(sinr, map, mcs);
+    return SinrEffFromExp(SinrExp(sinr, map, mcs), mcs, a, b);
+}
+
+double
+NrEesmErrorModel::SinrEffFromExp(double sinrExpSum, uint8_t mcs, double a, double b) const
+{
     double beta = GetBetaTable()->at(mcs);
     double SINR = -beta * log((a + sinrExpSum) / b);
 
@@ -83,16 +89,8 @@ NrEesmErrorModel::SinrExp(const SpectrumValue& sinr, const std::vector<int>& map
     NS_ABORT_MSG_IF(map.size() == 0,
                     " Error: number of allocated RBs cannot be 0 - EESM method - SinrEff function");
 
-    double SINRexp = 0.0;
-    double SINRsum = 0.0;
     double beta = GetBetaTable()->at(mcs);
-    for (uint32_t i = 0; i < map.size(); i++)
-    {
-        double sinrLin = sinr[map.at(i)];
-        SINRexp = exp(-sinrLin / beta);
-        SINRsum += SINRexp;
-    }
-    return SINRsum;
+    return NrSinrKernels::SumExp(&(*sinr.ConstValuesBegin()), map.data(), map.size(), beta);
 }
 
 const std::vector<double>&
@@ -111,6 +109,78 @@ NrEesmErrorModel::GetBLERVectorFromSimulatedValues(NrEesmErrorModel::GraphType g
     return std::get<1>(GetSimulatedBlerFromSINR()->at(graphType).at(mcs).at(cbSizeIndex));
 }
 
+std::shared_ptr<const NrEesmErrorModel::FlatBlerTable>
+NrEesmErrorModel::BuildFlatBlerTable(const SimulatedBlerFromSINR& table)
+{
+    auto flat = std::make_shared<FlatBlerTable>();
+    NS_ABORT_MSG_IF(table.empty(), "Empty SINR-BLER table");
+    flat->m_numMcs = table.front().size();
+
+    for (const auto& graph : table)
+    {
+        NS_ABORT_MSG_IF(graph.size() != flat->m_numMcs, "Base graphs with different MCS");
+        for (const auto& cbMap : graph)
+        {
+            NS_ABORT_MSG_IF(cbMap.empty(), "MCS without SINR-BLER curves");
+            flat->m_mcsCurves.push_back(flat->m_curves.size());
+            for (const auto& [cbSize, values] : cbMap)
+            {
+                const DoubleVector& sinrDb = std::get<0>(values);
+                const DoubleVector& bler = std::get<1>(values);
+                NS_ABORT_MSG_IF(sinrDb.empty() || sinrDb.size() != bler.size(),
+                                "Malformed SINR-BLER curve for CB size " << cbSize);
+
+                FlatBlerTable::Curve curve;
+                curve.m_cbSize = cbSize;
+                curve.m_offset = flat->m_sinrDb.size();
+                curve.m_size = sinrDb.size();
+                curve.m_bucketOffset = flat->m_bucket.size();
+                curve.m_numBuckets = 2 * sinrDb.size();
+                double range = sinrDb.back() - sinrDb.front();
+                curve.m_bucketScale = range > 0.0 ? curve.m_numBuckets / range : 0.0;
+
+                uint32_t last = 0;
+                for (uint32_t bucket = 0; bucket < curve.m_numBuckets; ++bucket)
+                {
+                    double start = curve.m_bucketScale > 0.0
+                                       ? sinrDb.front() + bucket / curve.m_bucketScale
+                                       : sinrDb.front();
+                    while (last + 1 < sinrDb.size() && sinrDb[last + 1] <= start)
+                    {
+                        ++last;
+                    }
+                    flat->m_bucket.push_back(last);
+                }
+
+                flat->m_sinrDb.insert(flat->m_sinrDb.end(), sinrDb.begin(), sinrDb.end());
+                flat->m_bler.insert(flat->m_bler.end(), bler.begin(), bler.end());
+                flat->m_curves.push_back(curve);
+            }
+        }
+    }
+    flat->m_mcsCurves.push_back(flat->m_curves.size());
+    return flat;
+}
+
+const NrEesmErrorModel::FlatBlerTable&
+NrEesmErrorModel::GetFlatBlerTable() const
+{
+    if (m_flatBlerTable == nullptr)
+    {
+        static std::map<const SimulatedBlerFromSINR*, std::shared_ptr<const FlatBlerTable>>
+            flatTables;
+        const SimulatedBlerFromSINR* table = GetSimulatedBlerFromSINR();
+        NS_ASSERT(table != nullptr);
+        auto it = flatTables.find(table);
+        if (it == flatTables.end())
+        {
+            it = flatTables.emplace(table, BuildFlatBlerTable(*table)).first;
+        }
+        m_flatBlerTable = it->second;
+    }
+    return *m_flatBlerTable;
+}
+
 double
 NrEesmErrorModel::MappingSinrBler(double sinr, uint8_t mcs, uint32_t cbSizeBit)
 {
@@ -121,46 +191,54 @@ NrEesmErrorModel::MappingSinrBler(double sinr, uint8_t mcs, uint32_t cbSizeBit)
     // use cbSize to obtain the index of CBSIZE in the map, jointly with mcs and sinr. take the
     // lowest CBSIZE simulated including this CB for removing CB size quatization
     // errors. sinr is also lower-bounded.
+    const FlatBlerTable& table = GetFlatBlerTable();
     double bler = 0.0;
     double sinr_db = 10 * log10(sinr);
     GraphType bg_type = GetBaseGraphType(cbSizeBit, mcs);
 
-    // Get the index of CBSIZE in the map
+    // Get the curve of the largest CB size not above cbSizeBit (or the smallest one)
     NS_LOG_INFO("For sinr " << sinr << " and mcs " << +mcs << " CbSizebit " << cbSizeBit
                             << " we got bg type " << m_bgTypeName[bg_type]);
-    auto cbMap = GetSimulatedBlerFromSINR()->at(bg_type).at(mcs);
-    auto cbIt = cbMap.upper_bound(cbSizeBit);
-
-    if (cbIt != cbMap.begin())
+    const uint32_t mcsIndex = bg_type * table.m_numMcs + mcs;
+    auto firstCurve = table.m_curves.begin() + table.m_mcsCurves[mcsIndex];
+    auto endCurve = table.m_curves.begin() + table.m_mcsCurves[mcsIndex + 1];
+    auto curveIt = std::upper_bound(firstCurve,
+                                    endCurve,
+                                    cbSizeBit,
+                                    [](uint32_t size, const FlatBlerTable::Curve& curve) {
+                                        return size < curve.m_cbSize;
+                                    });
+    if (curveIt != firstCurve)
     {
-        cbIt--;
+        curveIt--;
     }
+    const FlatBlerTable::Curve& curve = *curveIt;
+    const double* sinrDb = table.m_sinrDb.data() + curve.m_offset;
 
-    if (sinr_db < GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).front())
+    if (sinr_db < sinrDb[0])
     {
         bler = 1.0;
     }
-    else if (sinr_db > GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).back())
+    else if (sinr_db > sinrDb[curve.m_size - 1])
     {
         bler = 0.0;
     }
     else
     {
-        // Get the index of SINR in the vector
-        auto sinrIt =
-            std::upper_bound(GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).begin(),
-                             GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).end(),
-                             sinr_db);
-
-        if (sinrIt != GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).begin())
+        // Get the index of the last SINR not above sinr_db: start from the
+        // bucket, and correct the rounding of the bucket index
+        auto bucket = static_cast<uint32_t>((sinr_db - sinrDb[0]) * curve.m_bucketScale);
+        bucket = std::min(bucket, curve.m_numBuckets - 1);
+        uint32_t sinr_index = table.m_bucket[curve.m_bucketOffset + bucket];
+        while (sinr_index + 1 < curve.m_size && sinrDb[sinr_index + 1] <= sinr_db)
         {
-            sinrIt--;
+            ++sinr_index;
         }
-
-        auto sinr_index =
-            std::distance(GetSinrDbVectorFromSimulatedValues(bg_type, mcs, cbIt->first).begin(),
-                          sinrIt);
-        bler = GetBLERVectorFromSimulatedValues(bg_type, mcs, cbIt->first).at(sinr_index);
+        while (sinr_index > 0 && sinrDb[sinr_index] > sinr_db)
+        {
+            --sinr_index;
+        }
+        bler = table.m_bler[curve.m_offset + sinr_index];
     }
 
     NS_LOG_LOGIC("SINR effective: " << sinr << " BLER:" << bler);
@@ -266,6 +344,31 @@ NrEesmErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
     return GetTbBitDecodificationStats(sinr, map, size * 8, mcs, sinrHistory);
 }
 
+double
+NrEesmErrorModel::GetTbBler(const SpectrumValue& sinr,
+                            const std::vector<int>& map,
+                            uint32_t size,
+                            uint8_t mcs)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_IF(mcs > GetMaxMcs());
+
+    // The same steps of GetTbBitDecodificationStats without history
+    uint32_t sizeBit = size * 8;
+    double SINR = SinrEff(sinr, map, mcs, 0, map.size());
+    GraphType bg_type = GetBaseGraphType(sizeBit, mcs);
+    std::pair<uint32_t, uint32_t> cbSeg = CodeBlockSegmentation(sizeBit + 24, bg_type);
+    uint32_t K = cbSeg.first;
+    uint32_t C = cbSeg.second;
+
+    if (C != 1)
+    {
+        double cbler = MappingSinrBler(SINR, mcs, K);
+        return 1.0 - pow(1.0 - cbler, C);
+    }
+    return MappingSinrBler(SINR, mcs, K);
+}
+
 std::string
 NrEesmErrorModel::PrintMap(const std::vector<int>& map) const
 {
@@ -289,9 +392,9 @@ NrEesmErrorModel::GetTbBitDecodificationStats(const SpectrumValue& sinr,
     NS_LOG_FUNCTION(this);
     NS_ABORT_IF(mcs > GetMaxMcs());
 
-    double tbSinr = SinrEff(sinr, map, mcs, 0, map.size()); // effective SINR for this tx
-    double SINR = tbSinr;
     double sinrExpSum = SinrExp(sinr, map, mcs); // exponential sum of SINRs for this tx
+    double tbSinr = SinrEffFromExp(sinrExpSum, mcs, 0, map.size()); // effective SINR for this tx
+    double SINR = tbSinr;
 
     NS_LOG_DEBUG(" mcs " << +mcs << " TBSize in bit " << sizeBit << " history elements: "
                          << sinrHistory.size() << " SINR of the tx: " << tbSinr << std::endl
@@ -10,6 +10,7 @@
 #include "nr-error-model.h"
 
 #include <map>
+#include <memory>
 
 namespace ns3
 {
@@ -121,6 +122,24 @@ class NrEesmErrorModel : public NrErrorModel
         uint8_t mcs,
         const NrErrorModelHistory& sinrHistory) override;
 
+    /**
+     * \brief Get the tbler of a first transmission, as GetTbDecodificationStats
+     * with an empty history but without creating the output
+     *
+     * The exponential sum of the SINRs, which depends on the MCS through its
+     * beta, is computed once.
+     *
+     * \param sinr SINR vector
+     * \param map RB map
+     * \param size Transport block size in Bytes
+     * \param mcs MCS
+     * \return the tbler
+     */
+    double GetTbBler(const SpectrumValue& sinr,
+                     const std::vector<int>& map,
+                     uint32_t size,
+                     uint8_t mcs) override;
+
     /**
      * \brief Get the SE for a given CQI, following the CQIs in NR Table1/Table2
      * in TS38.214
@@ -194,6 +213,18 @@ class NrEesmErrorModel : public NrErrorModel
                    double a,
                    double b) const;
 
+    /**
+     * \brief compute the effective SINR from the sum of exponential SINRs
+     * \param sinrExpSum the sum of exponential SINRs, from SinrExp()
+     * \param mcs the MCS of the TB
+     * \param a the sum term to the exponential SINR
+     * \param b the denominator for the exponentials sum
+     * \return the effective SINR
+     *
+     * \see SinrEff
+     */
+    double SinrEffFromExp(double sinrExpSum, uint8_t mcs, double a, double b) const;
+
     /**
      * \brief compute the sum of exponential SINRs for the specified MCS and SINR, according
      * to the EESM method, used in HARQ-IR
@@ -347,6 +378,60 @@ class NrEesmErrorModel : public NrErrorModel
     const std::vector<double>& GetBLERVectorFromSimulatedValues(GraphType graphType,
                                                                 uint8_t mcs,
                                                                 uint32_t cbSizeIndex) const;
+
+    /**
+     * \brief The SINR-BLER curves of a SimulatedBlerFromSINR table, in
+     * contiguous arrays
+     *
+     * There is a curve for each base graph, MCS and CB size. The points of
+     * all the curves are stored one after the other in m_sinrDb and m_bler.
+     * The SINR range of each curve is split in buckets of the same width,
+     * each one with the last point at or below its start. A lookup indexes
+     * the bucket and then moves over the few points inside it, and gives the
+     * same point as a binary search over the curve.
+     */
+    struct FlatBlerTable
+    {
+        /**
+         * \brief A SINR-BLER curve
+         */
+        struct Curve
+        {
+            uint32_t m_cbSize{0};       //!< CB size of the curve, in bits
+            uint32_t m_offset{0};       //!< First point, in m_sinrDb and m_bler
+            uint32_t m_size{0};         //!< Number of points
+            uint32_t m_bucketOffset{0}; //!< First bucket, in m_bucket
+            uint32_t m_numBuckets{0};   //!< Number of buckets
+            double m_bucketScale{0.0};  //!< Buckets per dB
+        };
+
+        uint32_t m_numMcs{0};              //!< MCS of each base graph
+        std::vector<uint32_t> m_mcsCurves; //!< First curve of each base graph and MCS, and the end
+        std::vector<Curve> m_curves;       //!< Curves, by base graph, MCS and CB size
+        std::vector<double> m_sinrDb;      //!< SINR of the points, in dB
+        std::vector<double> m_bler;        //!< BLER of the points
+        std::vector<uint32_t> m_bucket;    //!< Last point at or below the start of each bucket
+    };
+
+    /**
+     * \brief Build the flat version of a table
+     * \param table the table
+     * \return the flat table
+     */
+    static std::shared_ptr<const FlatBlerTable> BuildFlatBlerTable(
+        const SimulatedBlerFromSINR& table);
+
+    /**
+     * \brief Get the flat version of the table of GetSimulatedBlerFromSINR()
+     *
+     * The flat tables are built on first use, once for each table, and
+     * shared by all the instances that use it.
+     *
+     * \return the flat table
+     */
+    const FlatBlerTable& GetFlatBlerTable() const;
+
+    mutable std::shared_ptr<const FlatBlerTable> m_flatBlerTable; //!< Flat table, once retrieved
 };
 
 } // namespace ns3
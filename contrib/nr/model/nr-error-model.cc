@@ -37,4 +37,13 @@ NrErrorModel::GetInstanceTypeId() const
     return NrErrorModel::GetTypeId();
 }
 
+double
+NrErrorModel::GetTbBler(const SpectrumValue& sinr,
+                        const std::vector<int>& map,
+                        uint32_t size,
+                        uint8_t mcs)
+{
+    return GetTbDecodificationStats(sinr, map, size, mcs, NrErrorModelHistory())->m_tbler;
+}
+
 } // namespace ns3
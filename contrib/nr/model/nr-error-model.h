@@ -141,6 +141,25 @@ class NrErrorModel : public Object
         uint8_t mcs,
         const NrErrorModelHistory& history) = 0;
 
+    /**
+     * \brief Get the decodification error probability of a first transmission
+     *
+     * The tbler of GetTbDecodificationStats with an empty history. It is the
+     * query of the AMC, which does it for several MCS for each CQI report, so
+     * the subclasses may override it with a version that does not create an
+     * output; by default, it calls GetTbDecodificationStats.
+     *
+     * \param sinr SINR vector
+     * \param map RB map
+     * \param size Transport block size
+     * \param mcs MCS
+     * \return the tbler
+     */
+    virtual double GetTbBler(const SpectrumValue& sinr,
+                             const std::vector<int>& map,
+                             uint32_t size,
+                             uint8_t mcs);
+
     /**
      * \brief Get the SpectralEfficiency for a given CQI
      * \param cqi CQI to take into consideration
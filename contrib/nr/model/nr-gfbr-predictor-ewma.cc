@@ -0,0 +1,79 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-gfbr-predictor-ewma.h"
+
+#include <ns3/double.h>
+#include <ns3/log.h>
+
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrGfbrPredictorEwma");
+NS_OBJECT_ENSURE_REGISTERED(NrGfbrPredictorEwma);
+
+NrGfbrPredictorEwma::NrGfbrPredictorEwma()
+    : NrGfbrPredictor()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrGfbrPredictorEwma::~NrGfbrPredictorEwma()
+{
+}
+
+TypeId
+NrGfbrPredictorEwma::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrGfbrPredictorEwma")
+            .SetParent<NrGfbrPredictor>()
+            .AddConstructor<NrGfbrPredictorEwma>()
+            .AddAttribute("Alpha",
+                          "Weight of the last offered load in the averages",
+                          DoubleValue(0.2),
+                          MakeDoubleAccessor(&NrGfbrPredictorEwma::m_alpha),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("Margin",
+                          "Number of standard deviations added to the average",
+                          DoubleValue(2.0),
+                          MakeDoubleAccessor(&NrGfbrPredictorEwma::m_margin),
+                          MakeDoubleChecker<double>(0.0));
+    return tid;
+}
+
+TypeId
+NrGfbrPredictorEwma::GetInstanceTypeId() const
+{
+    return NrGfbrPredictorEwma::GetTypeId();
+}
+
+double
+NrGfbrPredictorEwma::Predict(uint32_t ue, double offeredLoad)
+{
+    NS_LOG_FUNCTION(this << ue << offeredLoad);
+    if (ue >= m_ues.size())
+    {
+        m_ues.resize(ue + 1);
+    }
+    auto& moments = m_ues[ue];
+    if (!moments.m_init)
+    {
+        moments.m_mean = offeredLoad;
+        moments.m_init = true;
+    }
+    else
+    {
+        const double delta = offeredLoad - moments.m_mean;
+        moments.m_mean += m_alpha * delta;
+        moments.m_variance = (1.0 - m_alpha) * (moments.m_variance + m_alpha * delta * delta);
+    }
+    return moments.m_mean + m_margin * std::sqrt(moments.m_variance);
+}
+
+} // namespace ns3
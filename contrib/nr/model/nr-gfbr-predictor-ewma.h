@@ -0,0 +1,75 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-gfbr-predictor.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief GFBR predictor that adds a safety margin to the exponentially
+ * weighted moving average (EWMA) of the offered load.
+ *
+ * For every UE, the predictor keeps the EWMA \f$ \mu \f$ and the
+ * exponentially weighted variance \f$ \sigma^2 \f$ of the offered load x:
+ *
+ * \f$ \delta = x - \mu, \quad \mu \leftarrow \mu + \alpha \delta, \quad
+ * \sigma^2 \leftarrow (1 - \alpha) (\sigma^2 + \alpha \delta^2) \f$
+ *
+ * and predicts \f$ \mu + k \sigma \f$, with \f$ \alpha \f$ the attribute
+ * Alpha and k the attribute Margin. The first observation of an UE
+ * initializes its average, with no variance.
+ */
+class NrGfbrPredictorEwma : public NrGfbrPredictor
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Get the type ID of this instance
+     * \return the Type ID of this instance
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrGfbrPredictorEwma constructor
+     */
+    NrGfbrPredictorEwma();
+
+    /**
+     * \brief ~NrGfbrPredictorEwma deconstructor
+     */
+    ~NrGfbrPredictorEwma() override;
+
+    double Predict(uint32_t ue, double offeredLoad) override;
+
+  private:
+    /**
+     * \brief The moments of the offered load of an UE
+     */
+    struct Moments
+    {
+        double m_mean{0.0};     //!< EWMA of the offered load
+        double m_variance{0.0}; //!< Exponentially weighted variance of the offered load
+        bool m_init{false};     //!< Whether the UE has been observed
+    };
+
+    double m_alpha{0.0};        //!< Weight of the last observation
+    double m_margin{0.0};       //!< Number of standard deviations added to the mean
+    std::vector<Moments> m_ues; //!< Moments, per UE
+};
+
+} // namespace ns3
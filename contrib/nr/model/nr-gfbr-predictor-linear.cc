@@ -0,0 +1,134 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-gfbr-predictor-linear.h"
+
+#include <ns3/abort.h>
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrGfbrPredictorLinear");
+NS_OBJECT_ENSURE_REGISTERED(NrGfbrPredictorLinear);
+
+NrGfbrPredictorLinear::NrGfbrPredictorLinear()
+    : NrGfbrPredictor()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrGfbrPredictorLinear::~NrGfbrPredictorLinear()
+{
+}
+
+TypeId
+NrGfbrPredictorLinear::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrGfbrPredictorLinear")
+            .SetParent<NrGfbrPredictor>()
+            .AddConstructor<NrGfbrPredictorLinear>()
+            .AddAttribute("WeightsFile",
+                          "Text file with the bias and the weights of the model",
+                          StringValue(""),
+                          MakeStringAccessor(&NrGfbrPredictorLinear::SetWeightsFile,
+                                             &NrGfbrPredictorLinear::GetWeightsFile),
+                          MakeStringChecker())
+            .AddAttribute("Scale",
+                          "Offered load, in bit/s, of a unit of the model (e.g., 1e6 for Mbit/s)",
+                          DoubleValue(1e6),
+                          MakeDoubleAccessor(&NrGfbrPredictorLinear::m_scale),
+                          MakeDoubleChecker<double>(0.0));
+    return tid;
+}
+
+TypeId
+NrGfbrPredictorLinear::GetInstanceTypeId() const
+{
+    return NrGfbrPredictorLinear::GetTypeId();
+}
+
+void
+NrGfbrPredictorLinear::SetWeightsFile(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    m_weightsFile = fileName;
+    if (fileName.empty())
+    {
+        return;
+    }
+
+    std::ifstream file(fileName);
+    NS_ABORT_MSG_UNLESS(file.is_open(), "Can't open the GFBR model " << fileName);
+    std::vector<double> values;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        double value;
+        while (fields >> value)
+        {
+            values.push_back(value);
+        }
+        NS_ABORT_MSG_UNLESS(fields.eof(), "Wrong value in the GFBR model " << fileName);
+    }
+    NS_ABORT_MSG_IF(values.size() < 2, "The GFBR model " << fileName << " has no weights");
+    SetWeights(values.front(), std::vector<double>(values.begin() + 1, values.end()));
+}
+
+std::string
+NrGfbrPredictorLinear::GetWeightsFile() const
+{
+    return m_weightsFile;
+}
+
+void
+NrGfbrPredictorLinear::SetWeights(double bias, const std::vector<double>& weights)
+{
+    NS_LOG_FUNCTION(this << bias << weights.size());
+    NS_ABORT_MSG_IF(weights.empty(), "The GFBR model has no weights");
+    m_bias = bias;
+    m_weights = weights;
+    m_loads.clear();
+}
+
+double
+NrGfbrPredictorLinear::Predict(uint32_t ue, double offeredLoad)
+{
+    NS_LOG_FUNCTION(this << ue << offeredLoad);
+    NS_ABORT_MSG_IF(m_weights.empty(), "No model set for NrGfbrPredictorLinear");
+    if (ue >= m_loads.size())
+    {
+        m_loads.resize(ue + 1);
+    }
+    auto& loads = m_loads[ue];
+    loads.push_front(offeredLoad / m_scale);
+    if (loads.size() > m_weights.size())
+    {
+        loads.pop_back();
+    }
+
+    double prediction = m_bias;
+    for (std::size_t i = 0; i < m_weights.size(); ++i)
+    {
+        prediction += m_weights[i] * (i < loads.size() ? loads[i] : loads.back());
+    }
+    return std::max(prediction, 0.0) * m_scale;
+}
+
+} // namespace ns3
@@ -0,0 +1,91 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-gfbr-predictor.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief GFBR predictor with a linear model of the last offered loads.
+ *
+ * The prediction for an UE is
+ *
+ * \f$ s \cdot \max(0, b + \sum_{i=1}^{N} w_i x_{t-i+1} / s) \f$
+ *
+ * where \f$ x_t \f$ is the last offered load, s the attribute Scale (e.g.,
+ * 1e6 for a model trained in Mbit/s), b the bias and \f$ w_i \f$ the N
+ * weights. Until an UE has N observations, its oldest one stands for the
+ * missing ones.
+ *
+ * The model is read from the text file of the attribute WeightsFile: the
+ * bias and then the weights, \f$ w_1 \f$ (for the last load) first,
+ * separated by blanks, commas or new lines. The lines that start with '#'
+ * are comments. The model can also be set with SetWeights().
+ */
+class NrGfbrPredictorLinear : public NrGfbrPredictor
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Get the type ID of this instance
+     * \return the Type ID of this instance
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrGfbrPredictorLinear constructor
+     */
+    NrGfbrPredictorLinear();
+
+    /**
+     * \brief ~NrGfbrPredictorLinear deconstructor
+     */
+    ~NrGfbrPredictorLinear() override;
+
+    /**
+     * \brief Read the model from a file
+     * \param fileName the name of the file (empty to keep the current model)
+     */
+    void SetWeightsFile(const std::string& fileName);
+
+    /**
+     * \brief Get the name of the file of the model
+     * \return the name of the file
+     */
+    std::string GetWeightsFile() const;
+
+    /**
+     * \brief Set the model
+     * \param bias the bias
+     * \param weights the weights, for the last load first
+     */
+    void SetWeights(double bias, const std::vector<double>& weights);
+
+    double Predict(uint32_t ue, double offeredLoad) override;
+
+  private:
+    std::string m_weightsFile;               //!< File of the model
+    double m_scale{1.0};                     //!< Scale of the loads in the model
+    double m_bias{0.0};                      //!< Bias of the model
+    std::vector<double> m_weights;           //!< Weights of the model, for the last load first
+    std::vector<std::deque<double>> m_loads; //!< Last loads, scaled, per UE (last first)
+};
+
+} // namespace ns3
@@ -0,0 +1,86 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-gfbr-predictor-window.h"
+
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrGfbrPredictorWindow");
+NS_OBJECT_ENSURE_REGISTERED(NrGfbrPredictorWindow);
+
+NrGfbrPredictorWindow::NrGfbrPredictorWindow()
+    : NrGfbrPredictor()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrGfbrPredictorWindow::~NrGfbrPredictorWindow()
+{
+}
+
+TypeId
+NrGfbrPredictorWindow::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrGfbrPredictorWindow")
+            .SetParent<NrGfbrPredictor>()
+            .AddConstructor<NrGfbrPredictorWindow>()
+            .AddAttribute("WindowSize",
+                          "Number of past intervals in the window",
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&NrGfbrPredictorWindow::m_windowSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Quantile",
+                          "Quantile of the offered loads of the window (1 for the maximum)",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&NrGfbrPredictorWindow::m_quantile),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("Margin",
+                          "Factor applied to the quantile, as a safety margin",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&NrGfbrPredictorWindow::m_margin),
+                          MakeDoubleChecker<double>(0.0));
+    return tid;
+}
+
+TypeId
+NrGfbrPredictorWindow::GetInstanceTypeId() const
+{
+    return NrGfbrPredictorWindow::GetTypeId();
+}
+
+double
+NrGfbrPredictorWindow::Predict(uint32_t ue, double offeredLoad)
+{
+    NS_LOG_FUNCTION(this << ue << offeredLoad);
+    if (ue >= m_window.size())
+    {
+        m_window.resize(ue + 1);
+    }
+    auto& window = m_window[ue];
+    window.push_back(offeredLoad);
+    while (window.size() > m_windowSize)
+    {
+        window.pop_front();
+    }
+
+    // Nearest rank: the smallest load with at least Quantile of the window below or equal
+    const auto rank = static_cast<std::size_t>(
+        std::max(std::ceil(m_quantile * window.size()), 1.0) - 1);
+    m_sorted.assign(window.begin(), window.end());
+    std::nth_element(m_sorted.begin(), m_sorted.begin() + rank, m_sorted.end());
+    return m_sorted[rank] * m_margin;
+}
+
+} // namespace ns3
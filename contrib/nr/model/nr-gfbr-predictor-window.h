@@ -0,0 +1,62 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-gfbr-predictor.h"
+
+#include <deque>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief GFBR predictor that takes a quantile of the offered loads of the
+ * last WindowSize intervals, scaled by Margin.
+ *
+ * With the default Quantile of 1, the prediction is the maximum of the
+ * window. The quantile is the nearest-rank one, computed on a copy of the
+ * window with a selection (linear in WindowSize).
+ */
+class NrGfbrPredictorWindow : public NrGfbrPredictor
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Get the type ID of this instance
+     * \return the Type ID of this instance
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrGfbrPredictorWindow constructor
+     */
+    NrGfbrPredictorWindow();
+
+    /**
+     * \brief ~NrGfbrPredictorWindow deconstructor
+     */
+    ~NrGfbrPredictorWindow() override;
+
+    double Predict(uint32_t ue, double offeredLoad) override;
+
+  private:
+    uint32_t m_windowSize{0};                 //!< Number of intervals in the window
+    double m_quantile{1.0};                   //!< Quantile of the window, in [0, 1]
+    double m_margin{1.0};                     //!< Factor applied to the quantile
+    std::vector<std::deque<double>> m_window; //!< Offered loads of the window, per UE
+    std::vector<double> m_sorted;             //!< Scratch copy of a window
+};
+
+} // namespace ns3
@@ -0,0 +1,40 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-gfbr-predictor.h"
+
+#include <ns3/log.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrGfbrPredictor");
+NS_OBJECT_ENSURE_REGISTERED(NrGfbrPredictor);
+
+NrGfbrPredictor::NrGfbrPredictor()
+    : Object()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrGfbrPredictor::~NrGfbrPredictor()
+{
+}
+
+TypeId
+NrGfbrPredictor::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrGfbrPredictor").SetParent<Object>();
+    return tid;
+}
+
+TypeId
+NrGfbrPredictor::GetInstanceTypeId() const
+{
+    return NrGfbrPredictor::GetTypeId();
+}
+
+} // namespace ns3
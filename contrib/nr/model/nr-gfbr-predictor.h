@@ -0,0 +1,69 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <ns3/object.h>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief Interface for the online predictors of the GFBR of the UEs served by
+ * NrMacSchedulerOfdmaDPP.
+ *
+ * At the end of every interval, the predictor observes the load offered to
+ * each UE in that interval and returns the GFBR to guarantee to the UE in the
+ * next one. The predictors keep the history of each UE, indexed by the
+ * position of the UE in the caller (e.g., NrGfbrPredictionStage); the UEs are
+ * observed once per interval, so the state of an UE is updated in O(1) or in
+ * the size of its window.
+ *
+ * The predictor is chosen through the NrGfbrPredictionStage attribute
+ * "PredictorType" and configured through its own attributes:
+ * NrGfbrPredictorWindow (maximum or quantile over a sliding window),
+ * NrGfbrPredictorEwma (exponentially weighted mean plus a safety margin) and
+ * NrGfbrPredictorLinear (linear model of the last loads, with the weights
+ * read from a file).
+ */
+class NrGfbrPredictor : public Object
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Get the type ID of this instance
+     * \return the Type ID of this instance
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrGfbrPredictor constructor
+     */
+    NrGfbrPredictor();
+
+    /**
+     * \brief ~NrGfbrPredictor deconstructor
+     */
+    ~NrGfbrPredictor() override;
+
+    /**
+     * \brief Observe the load offered to an UE in the interval that ends, and
+     * predict the GFBR of the next interval
+     * \param ue the index of the UE
+     * \param offeredLoad the offered load in the interval that ends, in bit/s
+     * \return the GFBR of the next interval, in bit/s
+     */
+    virtual double Predict(uint32_t ue, double offeredLoad) = 0;
+};
+
+} // namespace ns3
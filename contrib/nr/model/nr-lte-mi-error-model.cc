@@ -6,6 +6,8 @@
 
 #include "nr-lte-mi-error-model.h"
 
+#include "nr-sinr-kernels.h"
+
 #include <ns3/log.h>
 
 #include <algorithm>
@@ -930,83 +932,52 @@ NrLteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, u
 {
     NS_LOG_FUNCTION(sinr << &map << (uint32_t)mcs);
 
-    double MI;
-    double MIsum = 0.0;
+    // the values in the MI axes are uniformly spaced, so the index of a SINR is
+    // ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1); the
+    // scaling coefficients are always the same, so we use static consts to
+    // speed up the calculation
+    static const double scalingCoeffQpsk =
+        (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
+    static const double scalingCoeff16qam =
+        (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
+    static const double scalingCoeff64qam =
+        (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
 
-    for (uint32_t i = 0; i < map.size(); i++)
+    const double* sinrLin = &(*sinr.ConstValuesBegin());
+    double MI;
+    double MIsum;
+    if (mcs <= MI_QPSK_MAX_ID) // QPSK
     {
-        double sinrLin = sinr[map.at(i)];
-        if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
-            if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1])
-            {
-                MI = 1;
-            }
-            else
-            {
-                // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-                // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                // the scaling coefficient is always the same, so we use a static const
-                // to speed up the calculation
-                static const double scalingCoeffQpsk =
-                    (MI_MAP_QPSK_SIZE - 1) /
-                    (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-                double sinrIndexDouble = (sinrLin - MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-                uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                NS_ASSERT_MSG(sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-                MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-        else
-        {
-            if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID) // 16-QAM
-            {
-                if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff16qam =
-                        (MI_MAP_16QAM_SIZE - 1) /
-                        (MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                    MI = MI_map_16qam[sinrIndex];
-                }
-            }
-            else // 64-QAM
-            {
-                if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff64qam =
-                        (MI_MAP_64QAM_SIZE - 1) /
-                        (MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                    MI = MI_map_64qam[sinrIndex];
-                }
-            }
-        }
-        NS_LOG_LOGIC(" RB " << map.at(i) << "Minimum SNR = " << 10 * std::log10(sinrLin) << " dB, "
-                            << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
-        MIsum += MI;
+        MIsum = NrSinrKernels::SumMi(sinrLin,
+                                     map.data(),
+                                     map.size(),
+                                     MI_map_qpsk,
+                                     MI_MAP_QPSK_SIZE,
+                                     MI_map_qpsk_axis[0],
+                                     MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1],
+                                     scalingCoeffQpsk);
+    }
+    else if (mcs <= MI_16QAM_MAX_ID) // 16-QAM
+    {
+        MIsum = NrSinrKernels::SumMi(sinrLin,
+                                     map.data(),
+                                     map.size(),
+                                     MI_map_16qam,
+                                     MI_MAP_16QAM_SIZE,
+                                     MI_map_16qam_axis[0],
+                                     MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1],
+                                     scalingCoeff16qam);
+    }
+    else // 64-QAM
+    {
+        MIsum = NrSinrKernels::SumMi(sinrLin,
+                                     map.data(),
+                                     map.size(),
+                                     MI_map_64qam,
+                                     MI_MAP_64QAM_SIZE,
+                                     MI_map_64qam_axis[0],
+                                     MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1],
+                                     scalingCoeff64qam);
     }
     if (map.size() == 0)
     {
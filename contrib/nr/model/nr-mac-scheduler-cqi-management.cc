@@ -22,12 +22,31 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("NrMacSchedulerCQIManagement");
 
 void
-NrMacSchedulerCQIManagement::DlSBCQIReported(
-    [[maybe_unused]] const DlCqiInfo& info,
-    [[maybe_unused]] const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo) const
+NrMacSchedulerCQIManagement::DlSBCQIReported(const DlCqiInfo& info,
+                                             const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
+                                             uint32_t expirationTime,
+                                             int8_t maxDlMcs) const
 {
     NS_LOG_INFO(this);
-    // TODO
+    NS_ASSERT(info.m_sbSize > 0);
+
+    DlWBCQIReported(info, ueInfo, expirationTime, maxDlMcs);
+
+    ueInfo->m_dlCqi.m_cqiType = NrMacSchedulerUeInfo::DlCqiInfo::SB;
+    ueInfo->m_dlCqi.m_sbSize = info.m_sbSize;
+    ueInfo->m_dlCqi.m_sbCqi = info.m_sbCqi;
+    ueInfo->m_dlCqi.m_sbMcs.resize(info.m_sbCqi.size());
+    for (std::size_t sb = 0; sb < info.m_sbCqi.size(); ++sb)
+    {
+        // As in the WB case, CQI 0 is mapped to MCS 0
+        ueInfo->m_dlCqi.m_sbMcs[sb] =
+            info.m_sbCqi[sb] > 0
+                ? std::min(static_cast<uint8_t>(GetAmcDl()->GetMcsFromCqi(info.m_sbCqi[sb])),
+                           static_cast<uint8_t>(maxDlMcs))
+                : 0;
+    }
+    NS_LOG_INFO("Updated " << info.m_sbCqi.size() << " SB CQI of UE " << ueInfo->m_rnti
+                           << ", with sub-bands of " << info.m_sbSize << " RBs");
 }
 
 void
@@ -207,6 +226,8 @@ NrMacSchedulerCQIManagement::RefreshDlCqiMaps(
         if (ue->m_dlCqi.m_timer == 0)
         {
             ue->m_dlCqi.m_cqiType = NrMacSchedulerUeInfo::DlCqiInfo::WB;
+            ue->m_dlCqi.m_sbCqi.clear();
+            ue->m_dlCqi.m_sbMcs.clear();
             for (std::size_t stream = 0; stream < ue->m_dlCqi.m_wbCqi.size(); stream++)
             {
                 ue->m_dlCqi.m_wbCqi.at(stream) = 1; // lowest value for trying a transmission
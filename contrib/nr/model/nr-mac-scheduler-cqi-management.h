@@ -83,14 +83,21 @@ class NrMacSchedulerCQIManagement
                          uint32_t expirationTime,
                          int8_t maxDlMcs) const;
     /**
-     * \brief SB CQI reported
+     * \brief A sub-band CQI has been reported for the specified UE
      * \param info SB CQI
      * \param ueInfo UE
+     * \param expirationTime expiration time of the CQI in number of slot
+     * \param maxDlMcs maximum DL MCS index
      *
-     * NOT IMPLEMENTED
+     * The WB part of the report is processed as in DlWBCQIReported; then the
+     * CQI of each sub-band (of the first stream) and the corresponding MCS are
+     * stored in the m_dlCqi value of the UE, for the schedulers that take
+     * the frequency selectivity into account.
      */
     void DlSBCQIReported(const DlCqiInfo& info,
-                         const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo) const;
+                         const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
+                         uint32_t expirationTime,
+                         int8_t maxDlMcs) const;
 
     /**
      * \brief An UL SB CQI has been reported for the specified UE
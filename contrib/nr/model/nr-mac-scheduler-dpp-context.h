@@ -0,0 +1,185 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-mac-scheduler-dpp-solver.h"
+#include "nr-mac-scheduler-ns3.h"
+
+#include <ns3/assert.h>
+
+#include <algorithm>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief Per-beam scheduling state of the DPP and DPPA schedulers
+ *
+ * It keeps, in structure-of-arrays form, what the drift-plus-penalty
+ * allocation reads for each active UE of a beam: RNTI, MCS, buffer, virtual
+ * queue, and the metric or TB size computed by the scheduler. Entry n always
+ * refers to the n-th element of the beam's UE vector, which is referenced and
+ * not copied.
+ *
+ * The scheduler keeps one context and refreshes it for every beam. The
+ * arrays only grow, so once they reach the largest number of UEs of a beam
+ * no memory is allocated per slot. Typed pointers to the UE representations
+ * are resolved once in Refresh() with a static cast (the schedulers only
+ * create their own UE representation), instead of a dynamic_pointer_cast per
+ * UE and use.
+ */
+class NrMacSchedulerDppContext
+{
+  public:
+    /**
+     * \brief Load the UEs of a beam, for the DL
+     * \tparam UeInfo the UE representation of the scheduler
+     * \param ueVector the active UEs of the beam; it must outlive the use of the context
+     */
+    template <class UeInfo>
+    void Refresh(const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector)
+    {
+        Load<UeInfo>(ueVector);
+        for (std::size_t i = 0; i < ueVector.size(); ++i)
+        {
+            auto info = GetUe<UeInfo>(i);
+            m_mcs[i] = info->m_dlMcs.empty() ? 0 : info->m_dlMcs[0];
+            m_g[i] = info->m_g;
+        }
+    }
+
+    /**
+     * \brief Load the UEs of a beam, for the UL
+     * \tparam UeInfo the UE representation of the scheduler, with the UL virtual queue m_gUl
+     * \param ueVector the active UEs of the beam; it must outlive the use of the context
+     *
+     * The buffers are the ones reported in the BSR, and the MCS the UL ones.
+     */
+    template <class UeInfo>
+    void RefreshUl(const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector)
+    {
+        Load<UeInfo>(ueVector);
+        for (std::size_t i = 0; i < ueVector.size(); ++i)
+        {
+            auto info = GetUe<UeInfo>(i);
+            m_mcs[i] = info->m_ulMcs;
+            m_g[i] = info->m_gUl;
+        }
+    }
+
+    /**
+     * \brief Get the number of UEs loaded
+     * \return the number of UEs
+     */
+    std::size_t GetSize() const
+    {
+        return m_ue.size();
+    }
+
+    /**
+     * \brief Get the UE representation of an entry
+     * \tparam UeInfo the UE representation given to Refresh()
+     * \param i the entry
+     * \return the UE representation
+     */
+    template <class UeInfo>
+    UeInfo* GetUe(std::size_t i) const
+    {
+        return static_cast<UeInfo*>(m_info[i]);
+    }
+
+    /**
+     * \brief Fill m_rbgMcs with the MCS of every UE in every RBG
+     * \param numRbg the number of RBGs of the band
+     * \param numRbPerRbg the number of RBs of a RBG
+     *
+     * The MCS of a RBG is the lowest MCS of the sub-bands it overlaps, from
+     * the last SB CQI report of the UE; UEs without a valid SB report use
+     * their WB MCS in all the RBGs.
+     */
+    void RefreshRbgMcs(uint32_t numRbg, uint32_t numRbPerRbg)
+    {
+        m_numRbg = numRbg;
+        m_rbgMcs.resize(GetSize() * numRbg);
+        for (std::size_t n = 0; n < GetSize(); ++n)
+        {
+            const auto& cqi = m_info[n]->m_dlCqi;
+            uint8_t* rbgMcs = &m_rbgMcs[n * numRbg];
+            if (cqi.m_cqiType != NrMacSchedulerUeInfo::DlCqiInfo::SB || cqi.m_sbMcs.empty())
+            {
+                std::fill(rbgMcs, rbgMcs + numRbg, m_mcs[n]);
+                continue;
+            }
+            const std::size_t lastSb = cqi.m_sbMcs.size() - 1;
+            for (uint32_t k = 0; k < numRbg; ++k)
+            {
+                std::size_t firstSb = std::min<std::size_t>(k * numRbPerRbg / cqi.m_sbSize, lastSb);
+                std::size_t endSb =
+                    std::min<std::size_t>(((k + 1) * numRbPerRbg - 1) / cqi.m_sbSize, lastSb);
+                rbgMcs[k] = *std::min_element(cqi.m_sbMcs.begin() + firstSb,
+                                              cqi.m_sbMcs.begin() + endSb + 1);
+            }
+        }
+    }
+
+    std::vector<const NrMacSchedulerNs3::UePtrAndBufferReq*> m_ue; //!< UE and buffer, in the beam vector
+    std::vector<NrMacSchedulerUeInfo*> m_info; //!< UE representation
+    std::vector<uint16_t> m_rnti;              //!< RNTI
+    std::vector<uint8_t> m_mcs;                //!< MCS (DL: of the first stream)
+    std::vector<uint32_t> m_buffer;            //!< Buffer (Q), in bytes
+    std::vector<double> m_g;                   //!< Virtual queue (G) of the direction
+    std::vector<double> m_metric;              //!< Scheduler metric (K in DPPA)
+    std::vector<uint32_t> m_tbs;               //!< TB size used in the DPP costs
+    std::vector<uint32_t> m_order;             //!< Order of service of the entries
+
+    uint32_t m_numRbg{0};           //!< RBGs of the band, in the frequency-selective arrays
+    std::vector<uint8_t> m_rbgMcs;  //!< MCS of each UE (row) in each RBG (column)
+    std::vector<int32_t> m_rbgOwner; //!< Entry that receives each RBG (-1 for none)
+
+    NrMacSchedulerDppSolver::Problem m_problem; //!< DPP problem of the beam
+    std::vector<double> m_alpha;                //!< Solution of the problem
+    std::vector<double> m_reference;            //!< Solution of the cross-check solver
+
+  private:
+    /**
+     * \brief Load the entries that do not depend on the direction
+     * \tparam UeInfo the UE representation of the scheduler
+     * \param ueVector the active UEs of the beam
+     */
+    template <class UeInfo>
+    void Load(const std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector)
+    {
+        std::size_t n = ueVector.size();
+        m_ue.resize(n);
+        m_info.resize(n);
+        m_rnti.resize(n);
+        m_mcs.resize(n);
+        m_buffer.resize(n);
+        m_g.resize(n);
+        m_metric.resize(n);
+        m_tbs.resize(n);
+        m_order.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto& ue = ueVector[i];
+            NS_ASSERT_MSG(dynamic_cast<UeInfo*>(ue.first.get()) != nullptr,
+                          "Unexpected UE representation");
+            auto info = static_cast<UeInfo*>(ue.first.get());
+            m_ue[i] = &ue;
+            m_info[i] = info;
+            m_rnti[i] = info->m_rnti;
+            m_buffer[i] = ue.second;
+            m_metric[i] = 0.0;
+            m_tbs[i] = 0;
+            m_order[i] = i;
+        }
+    }
+};
+
+} // namespace ns3
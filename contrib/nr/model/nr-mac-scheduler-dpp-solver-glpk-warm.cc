@@ -0,0 +1,170 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-scheduler-dpp-solver-glpk-warm.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <cmath>
+#include <glpk.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMacSchedulerDppSolverGlpkWarm");
+NS_OBJECT_ENSURE_REGISTERED(NrMacSchedulerDppSolverGlpkWarm);
+
+NrMacSchedulerDppSolverGlpkWarm::NrMacSchedulerDppSolverGlpkWarm()
+    : NrMacSchedulerDppSolver()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrMacSchedulerDppSolverGlpkWarm::~NrMacSchedulerDppSolverGlpkWarm()
+{
+    if (m_lp != nullptr)
+    {
+        glp_delete_prob(m_lp);
+        m_lp = nullptr;
+    }
+}
+
+TypeId
+NrMacSchedulerDppSolverGlpkWarm::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrMacSchedulerDppSolverGlpkWarm")
+                            .SetParent<NrMacSchedulerDppSolver>()
+                            .AddConstructor<NrMacSchedulerDppSolverGlpkWarm>();
+    return tid;
+}
+
+TypeId
+NrMacSchedulerDppSolverGlpkWarm::GetInstanceTypeId() const
+{
+    return NrMacSchedulerDppSolverGlpkWarm::GetTypeId();
+}
+
+void
+NrMacSchedulerDppSolverGlpkWarm::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_lp != nullptr)
+    {
+        glp_delete_prob(m_lp);
+        m_lp = nullptr;
+    }
+    m_numCols = 0;
+    m_activeCols = 0;
+    m_fhCoef.clear();
+    NrMacSchedulerDppSolver::DoDispose();
+}
+
+void
+NrMacSchedulerDppSolverGlpkWarm::GrowModel(int numCols)
+{
+    NS_LOG_FUNCTION(this << numCols);
+    if (m_lp == nullptr)
+    {
+        m_lp = glp_create_prob();
+        glp_set_prob_name(m_lp, "Drift_plus_penalty");
+        glp_set_obj_dir(m_lp, GLP_MIN);
+        glp_add_rows(m_lp, 2);
+        glp_set_row_name(m_lp, 1, "con1");
+        glp_set_row_name(m_lp, 2, "con2");
+    }
+
+    if (numCols <= m_numCols)
+    {
+        return;
+    }
+
+    // New columns start fixed to zero and non-basic, so that the
+    // current basis stays valid
+    int first = glp_add_cols(m_lp, numCols - m_numCols);
+    int ind[3] = {0, 1, 2};
+    double val[3] = {0.0, 1.0, 1.0};
+    for (int j = first; j <= numCols; j++)
+    {
+        glp_set_col_bnds(m_lp, j, GLP_FX, 0.0, 0.0);
+        glp_set_mat_col(m_lp, j, 2, ind, val);
+    }
+    m_fhCoef.resize(numCols, 1.0);
+    m_numCols = numCols;
+}
+
+void
+NrMacSchedulerDppSolverGlpkWarm::Solve(const Problem& problem, std::vector<double>* alpha)
+{
+    NS_LOG_FUNCTION(this);
+    int N = problem.m_cost.size();
+    alpha->assign(N, 0.0);
+    if (N == 0)
+    {
+        return;
+    }
+
+    GrowModel(N);
+
+    for (int j = 1; j <= N; j++)
+    {
+        if (j > m_activeCols)
+        {
+            glp_set_col_bnds(m_lp, j, GLP_LO, 0.0, 0.0);
+        }
+        glp_set_obj_coef(m_lp, j, problem.m_cost[j - 1]);
+
+        double f = problem.GetFhCoef(j - 1);
+        if (f != m_fhCoef[j - 1])
+        {
+            int ind[3] = {0, 1, 2};
+            double val[3] = {0.0, 1.0, f};
+            glp_set_mat_col(m_lp, j, 2, ind, val);
+            m_fhCoef[j - 1] = f;
+        }
+    }
+    for (int j = N + 1; j <= m_activeCols; j++)
+    {
+        glp_set_col_bnds(m_lp, j, GLP_FX, 0.0, 0.0);
+        glp_set_obj_coef(m_lp, j, 0.0);
+    }
+    m_activeCols = N;
+
+    glp_set_row_bnds(m_lp, 1, GLP_UP, 0.0, problem.m_rbgBudget);
+    if (std::isfinite(problem.m_fhBudget))
+    {
+        glp_set_row_bnds(m_lp, 2, GLP_UP, 0.0, problem.m_fhBudget);
+    }
+    else
+    {
+        glp_set_row_bnds(m_lp, 2, GLP_FR, 0.0, 0.0);
+    }
+
+    // Only the costs and the bounds changed, so the previous basis is still
+    // dual feasible in most slots: start with the dual simplex, GLPK falls
+    // back to the primal one when it is not
+    glp_smcp parm;
+    glp_init_smcp(&parm);
+    parm.msg_lev = GLP_MSG_OFF;
+    parm.meth = GLP_DUALP;
+    int ret = glp_simplex(m_lp, &parm);
+    if (ret == GLP_EBADB || ret == GLP_ESING || ret == GLP_ECOND)
+    {
+        NS_LOG_DEBUG("Invalid warm basis (" << ret << "), restarting from the standard basis");
+        glp_std_basis(m_lp);
+        ret = glp_simplex(m_lp, &parm);
+    }
+    NS_ABORT_MSG_IF(ret != 0 || glp_get_status(m_lp) != GLP_OPT,
+                    "GLPK could not solve the DPP problem, error " << ret << ", status "
+                                                                   << glp_get_status(m_lp));
+
+    for (int n = 1; n <= N; n++)
+    {
+        (*alpha)[n - 1] = glp_get_col_prim(m_lp, n);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,77 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-mac-scheduler-dpp-solver.h"
+
+struct glp_prob;
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief GLPK solver for the DPP problem that keeps its model across slots
+ *
+ * Unlike NrMacSchedulerDppSolverGlpk, the GLPK problem is created once and
+ * kept alive. At every call only the objective coefficients, the fronthaul
+ * row coefficients that changed and the row bounds are updated, and the
+ * simplex is restarted from the basis of the previous call. No MIP pass is
+ * made, as all the variables are continuous.
+ *
+ * The model grows when a call has more UEs than any previous one; the
+ * columns that are not used in a call are fixed to zero. NrMacSchedulerOfdmaDPP
+ * creates one solver per beam, so that each beam keeps its own basis.
+ *
+ * This solver is meant for constraint sets that need a general LP solver;
+ * for the current problem NrMacSchedulerDppSolverNative is exact and faster.
+ */
+class NrMacSchedulerDppSolverGlpkWarm : public NrMacSchedulerDppSolver
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Get the type ID of this instance
+     * \return the Type ID of this instance
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrMacSchedulerDppSolverGlpkWarm constructor
+     */
+    NrMacSchedulerDppSolverGlpkWarm();
+
+    /**
+     * \brief ~NrMacSchedulerDppSolverGlpkWarm deconstructor
+     */
+    ~NrMacSchedulerDppSolverGlpkWarm() override;
+
+    void Solve(const Problem& problem, std::vector<double>* alpha) override;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Add columns to the model, up to the number of UEs
+     * \param numCols the number of columns needed
+     */
+    void GrowModel(int numCols);
+
+    glp_prob* m_lp{nullptr};      //!< The persistent GLPK problem
+    int m_numCols{0};             //!< Columns in the model
+    int m_activeCols{0};          //!< Columns that were free in the previous call
+    std::vector<double> m_fhCoef; //!< Fronthaul coefficients loaded in the model
+};
+
+} // namespace ns3
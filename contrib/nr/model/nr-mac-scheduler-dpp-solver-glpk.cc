@@ -0,0 +1,115 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-scheduler-dpp-solver-glpk.h"
+
+#include <ns3/log.h>
+
+#include <cmath>
+#include <glpk.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMacSchedulerDppSolverGlpk");
+NS_OBJECT_ENSURE_REGISTERED(NrMacSchedulerDppSolverGlpk);
+
+NrMacSchedulerDppSolverGlpk::NrMacSchedulerDppSolverGlpk()
+    : NrMacSchedulerDppSolver()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrMacSchedulerDppSolverGlpk::~NrMacSchedulerDppSolverGlpk()
+{
+}
+
+TypeId
+NrMacSchedulerDppSolverGlpk::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrMacSchedulerDppSolverGlpk")
+                            .SetParent<NrMacSchedulerDppSolver>()
+                            .AddConstructor<NrMacSchedulerDppSolverGlpk>();
+    return tid;
+}
+
+TypeId
+NrMacSchedulerDppSolverGlpk::GetInstanceTypeId() const
+{
+    return NrMacSchedulerDppSolverGlpk::GetTypeId();
+}
+
+void
+NrMacSchedulerDppSolverGlpk::Solve(const Problem& problem, std::vector<double>* alpha)
+{
+    NS_LOG_FUNCTION(this);
+    int N = problem.m_cost.size();
+    alpha->assign(N, 0.0);
+    if (N == 0)
+    {
+        return;
+    }
+
+    /* Crear un objeto de problema LP */
+    glp_prob* lp;
+    lp = glp_create_prob();
+    glp_set_prob_name(lp, "Drift_plus_penalty");
+    glp_set_obj_dir(lp, GLP_MIN);
+
+    // Añadir columnas para las variables de decisión
+    glp_add_cols(lp, N);
+    for (int n = 1; n <= N; n++)
+    {
+        glp_set_col_kind(lp, n, GLP_CV);
+        glp_set_col_bnds(lp, n, GLP_LO, 0.0, 0.0);
+        glp_set_obj_coef(lp, n, problem.m_cost[n - 1]);
+    }
+
+    // Rows for constraints
+    glp_add_rows(lp, 2);
+    glp_set_row_name(lp, 1, "con1");
+    glp_set_row_bnds(lp, 1, GLP_UP, 0.0, problem.m_rbgBudget);
+    glp_set_row_name(lp, 2, "con2");
+    if (std::isfinite(problem.m_fhBudget))
+    {
+        glp_set_row_bnds(lp, 2, GLP_UP, 0.0, problem.m_fhBudget);
+    }
+    else
+    {
+        glp_set_row_bnds(lp, 2, GLP_FR, 0.0, 0.0);
+    }
+
+    std::vector<int> ia(1 + 2 * N);
+    std::vector<int> ja(1 + 2 * N);
+    std::vector<double> ar(1 + 2 * N);
+    int count = 1;
+    for (int i = 1; i < 3; i++)
+    {
+        for (int j = 1; j <= N; j++)
+        {
+            ia[count] = i;
+            ja[count] = j;
+            ar[count] = i == 1 ? 1.0 : problem.GetFhCoef(j - 1);
+            count++;
+        }
+    }
+
+    glp_load_matrix(lp, 2 * N, ia.data(), ja.data(), ar.data());
+
+    // Solve problem
+    glp_term_out(GLP_OFF);
+    glp_simplex(lp, nullptr);
+    glp_intopt(lp, nullptr);
+
+    for (int n = 1; n <= N; n++)
+    {
+        (*alpha)[n - 1] = glp_get_col_prim(lp, n);
+    }
+
+    glp_delete_prob(lp);
+}
+
+} // namespace ns3
@@ -0,0 +1,52 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-mac-scheduler-dpp-solver.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief Reference solver for the DPP problem, based on GLPK
+ *
+ * A new GLPK problem is built, solved (simplex followed by the MIP pass)
+ * and deleted at every call. It is much slower than
+ * NrMacSchedulerDppSolverNative, and it is kept as the reference against
+ * which other solvers are validated.
+ */
+class NrMacSchedulerDppSolverGlpk : public NrMacSchedulerDppSolver
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Get the type ID of this instance
+     * \return the Type ID of this instance
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrMacSchedulerDppSolverGlpk constructor
+     */
+    NrMacSchedulerDppSolverGlpk();
+
+    /**
+     * \brief ~NrMacSchedulerDppSolverGlpk deconstructor
+     */
+    ~NrMacSchedulerDppSolverGlpk() override;
+
+    void Solve(const Problem& problem, std::vector<double>* alpha) override;
+};
+
+} // namespace ns3
@@ -0,0 +1,158 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-scheduler-dpp-solver-native.h"
+
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMacSchedulerDppSolverNative");
+NS_OBJECT_ENSURE_REGISTERED(NrMacSchedulerDppSolverNative);
+
+NrMacSchedulerDppSolverNative::NrMacSchedulerDppSolverNative()
+    : NrMacSchedulerDppSolver()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrMacSchedulerDppSolverNative::~NrMacSchedulerDppSolverNative()
+{
+}
+
+TypeId
+NrMacSchedulerDppSolverNative::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrMacSchedulerDppSolverNative")
+                            .SetParent<NrMacSchedulerDppSolver>()
+                            .AddConstructor<NrMacSchedulerDppSolverNative>();
+    return tid;
+}
+
+TypeId
+NrMacSchedulerDppSolverNative::GetInstanceTypeId() const
+{
+    return NrMacSchedulerDppSolverNative::GetTypeId();
+}
+
+void
+NrMacSchedulerDppSolverNative::Solve(const Problem& problem, std::vector<double>* alpha)
+{
+    NS_LOG_FUNCTION(this);
+    const std::size_t N = problem.m_cost.size();
+    NS_ASSERT(problem.m_fhCoef.empty() || problem.m_fhCoef.size() == N);
+
+    alpha->assign(N, 0.0);
+    if (N == 0 || problem.m_rbgBudget <= 0.0 || problem.m_fhBudget <= 0.0)
+    {
+        return;
+    }
+
+    const double R = problem.m_rbgBudget;
+    const double gamma = problem.m_fhBudget;
+
+    // Largest share that UE n can get alone
+    auto singleShare = [&](std::size_t n) {
+        double f = problem.GetFhCoef(n);
+        return f > 0.0 ? std::min(R, gamma / f) : R;
+    };
+
+    // Can the fronthaul row bind for some allocation of the RBG budget?
+    bool fhCanBind = false;
+    if (std::isfinite(gamma))
+    {
+        for (std::size_t n = 0; n < N && !fhCanBind; ++n)
+        {
+            fhCanBind = problem.m_cost[n] < 0.0 && problem.GetFhCoef(n) * R > gamma;
+        }
+    }
+
+    std::size_t best = N;
+    double bestObj = 0.0;
+    for (std::size_t n = 0; n < N; ++n)
+    {
+        if (problem.m_cost[n] >= 0.0)
+        {
+            continue;
+        }
+        double obj = problem.m_cost[n] * singleShare(n);
+        if (obj < bestObj)
+        {
+            bestObj = obj;
+            best = n;
+        }
+    }
+
+    if (!fhCanBind)
+    {
+        if (best < N)
+        {
+            (*alpha)[best] = singleShare(best);
+            NS_LOG_DEBUG("All the " << (*alpha)[best] << " RBGs to UE index " << best);
+        }
+        return;
+    }
+
+    // Two-UE vertices, with both rows tight:
+    // a_n + a_m = R and f_n a_n + f_m a_m = gamma
+    std::size_t bestM = N;
+    double bestAn = 0.0;
+    double bestAm = 0.0;
+    for (std::size_t n = 0; n < N; ++n)
+    {
+        if (problem.m_cost[n] >= 0.0)
+        {
+            continue;
+        }
+        for (std::size_t m = n + 1; m < N; ++m)
+        {
+            if (problem.m_cost[m] >= 0.0)
+            {
+                continue;
+            }
+            double fn = problem.GetFhCoef(n);
+            double fm = problem.GetFhCoef(m);
+            if (fn == fm)
+            {
+                continue;
+            }
+            double an = (gamma - fm * R) / (fn - fm);
+            double am = R - an;
+            if (an < 0.0 || am < 0.0)
+            {
+                continue;
+            }
+            double obj = problem.m_cost[n] * an + problem.m_cost[m] * am;
+            if (obj < bestObj)
+            {
+                bestObj = obj;
+                best = n;
+                bestM = m;
+                bestAn = an;
+                bestAm = am;
+            }
+        }
+    }
+
+    if (bestM < N)
+    {
+        (*alpha)[best] = bestAn;
+        (*alpha)[bestM] = bestAm;
+        NS_LOG_DEBUG("Split " << bestAn << "/" << bestAm << " RBGs to UE index " << best << "/"
+                              << bestM);
+    }
+    else if (best < N)
+    {
+        (*alpha)[best] = singleShare(best);
+        NS_LOG_DEBUG("All the " << (*alpha)[best] << " RBGs to UE index " << best);
+    }
+}
+
+} // namespace ns3
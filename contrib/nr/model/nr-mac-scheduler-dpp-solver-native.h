@@ -0,0 +1,59 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-mac-scheduler-dpp-solver.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief Exact closed-form solver for the DPP problem
+ *
+ * The DPP LP has at most two rows, so an optimal basic solution has at
+ * most two UEs with a non-zero share. When the fronthaul row cannot be
+ * binding (the default, with an infinite \f$ \Gamma \f$), the optimum gives
+ * all the budget to the UE with the most negative cost, or nothing if no
+ * cost is negative: a single O(N) pass. When the fronthaul row can bind,
+ * all the single-UE and two-UE vertices of the feasible region are
+ * evaluated, among the UEs with negative cost only.
+ *
+ * Ties are broken in favour of the UE that comes first in the problem.
+ * The solver does not allocate memory once the output vector has reached
+ * the number of UEs.
+ */
+class NrMacSchedulerDppSolverNative : public NrMacSchedulerDppSolver
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Get the type ID of this instance
+     * \return the Type ID of this instance
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrMacSchedulerDppSolverNative constructor
+     */
+    NrMacSchedulerDppSolverNative();
+
+    /**
+     * \brief ~NrMacSchedulerDppSolverNative deconstructor
+     */
+    ~NrMacSchedulerDppSolverNative() override;
+
+    void Solve(const Problem& problem, std::vector<double>* alpha) override;
+};
+
+} // namespace ns3
@@ -0,0 +1,93 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-scheduler-dpp-solver.h"
+
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMacSchedulerDppSolver");
+NS_OBJECT_ENSURE_REGISTERED(NrMacSchedulerDppSolver);
+
+NrMacSchedulerDppSolver::NrMacSchedulerDppSolver()
+    : Object()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrMacSchedulerDppSolver::~NrMacSchedulerDppSolver()
+{
+}
+
+TypeId
+NrMacSchedulerDppSolver::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrMacSchedulerDppSolver").SetParent<Object>();
+    return tid;
+}
+
+TypeId
+NrMacSchedulerDppSolver::GetInstanceTypeId() const
+{
+    return NrMacSchedulerDppSolver::GetTypeId();
+}
+
+double
+NrMacSchedulerDppSolver::GetObjective(const Problem& problem, const std::vector<double>& alpha)
+{
+    NS_ASSERT(alpha.size() == problem.m_cost.size());
+    double obj = 0.0;
+    for (std::size_t n = 0; n < alpha.size(); ++n)
+    {
+        obj += problem.m_cost[n] * alpha[n];
+    }
+    return obj;
+}
+
+bool
+NrMacSchedulerDppSolver::IsEquivalent(const Problem& problem,
+                                      const std::vector<double>& alpha,
+                                      const std::vector<double>& reference)
+{
+    if (alpha.size() != problem.m_cost.size() || reference.size() != problem.m_cost.size())
+    {
+        return false;
+    }
+
+    // Tolerance relative to the magnitude of the problem, as GLPK works
+    // with its own feasibility and optimality tolerances
+    const double eps = 1e-6;
+    double sumAlpha = 0.0;
+    double sumFh = 0.0;
+    for (std::size_t n = 0; n < alpha.size(); ++n)
+    {
+        if (alpha[n] < -eps)
+        {
+            return false;
+        }
+        sumAlpha += alpha[n];
+        sumFh += problem.GetFhCoef(n) * alpha[n];
+    }
+    if (sumAlpha > problem.m_rbgBudget * (1 + eps) + eps)
+    {
+        return false;
+    }
+    if (std::isfinite(problem.m_fhBudget) && sumFh > problem.m_fhBudget * (1 + eps) + eps)
+    {
+        return false;
+    }
+
+    double obj = GetObjective(problem, alpha);
+    double objRef = GetObjective(problem, reference);
+    return std::abs(obj - objRef) <= eps * std::max({1.0, std::abs(obj), std::abs(objRef)});
+}
+
+} // namespace ns3
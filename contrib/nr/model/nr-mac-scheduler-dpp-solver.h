@@ -0,0 +1,117 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <ns3/object.h>
+
+#include <limits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief Interface for the solvers of the per-slot Lyapunov drift-plus-penalty
+ * problem used by NrMacSchedulerOfdmaDPP.
+ *
+ * Every slot, and for every beam, the DPP scheduler has to solve the
+ * following linear program over the RBG shares \f$ \alpha_n \f$ of the N
+ * active UEs:
+ *
+ * \f$ \min \sum_n c_n \alpha_n \f$
+ *
+ * \f$ s.t. \sum_n \alpha_n \le R \f$ (RBG budget)
+ *
+ * \f$ \sum_n f_n \alpha_n \le \Gamma \f$ (fronthaul capacity, optional)
+ *
+ * \f$ \alpha_n \ge 0 \f$
+ *
+ * with \f$ c_n = V - TBS_n (Q_n + G_n) \f$. The solver is chosen through the
+ * NrMacSchedulerOfdmaDPP attribute "DppSolverType"; NrMacSchedulerDppSolverNative
+ * is an exact solver that exploits the structure of the problem, while
+ * NrMacSchedulerDppSolverGlpk is the general LP reference backend.
+ */
+class NrMacSchedulerDppSolver : public Object
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Get the type ID of this instance
+     * \return the Type ID of this instance
+     */
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * \brief NrMacSchedulerDppSolver constructor
+     */
+    NrMacSchedulerDppSolver();
+
+    /**
+     * \brief ~NrMacSchedulerDppSolver deconstructor
+     */
+    ~NrMacSchedulerDppSolver() override;
+
+    /**
+     * \brief The drift-plus-penalty LP of one beam in one slot
+     */
+    struct Problem
+    {
+        std::vector<double> m_cost; //!< Objective coefficient c_n of each UE
+        std::vector<double> m_fhCoef; //!< Fronthaul row coefficient f_n of each UE (empty = all 1)
+        double m_rbgBudget{0.0};      //!< RBG budget R
+        double m_fhBudget{std::numeric_limits<double>::infinity()}; //!< Fronthaul budget Gamma
+
+        /**
+         * \brief Get the fronthaul row coefficient of a UE
+         * \param n index of the UE in the problem
+         * \return f_n
+         */
+        double GetFhCoef(std::size_t n) const
+        {
+            return m_fhCoef.empty() ? 1.0 : m_fhCoef[n];
+        }
+    };
+
+    /**
+     * \brief Solve the problem
+     * \param problem the problem to solve
+     * \param alpha output vector, resized to the number of UEs, with the RBGs of each UE
+     */
+    virtual void Solve(const Problem& problem, std::vector<double>* alpha) = 0;
+
+    /**
+     * \brief Evaluate the objective of a solution
+     * \param problem the problem
+     * \param alpha the solution
+     * \return the value of the objective function
+     */
+    static double GetObjective(const Problem& problem, const std::vector<double>& alpha);
+
+    /**
+     * \brief Check that a solution is feasible and that it is as good as a reference one
+     *
+     * Two optimal solutions can differ when several UEs have the same cost, so the
+     * comparison is made on the objective value and not on the allocation.
+     *
+     * \param problem the problem
+     * \param alpha the solution to check
+     * \param reference the reference solution
+     * \return true if alpha is feasible and its objective matches the reference one
+     */
+    static bool IsEquivalent(const Problem& problem,
+                             const std::vector<double>& alpha,
+                             const std::vector<double>& reference);
+};
+
+} // namespace ns3
@@ -0,0 +1,581 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-scheduler-dpp-trace-writer.h"
+
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
+#include <ns3/enum.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+
+#include <chrono>
+#include <iomanip>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrMacSchedulerDppTraceWriter");
+NS_OBJECT_ENSURE_REGISTERED(NrMacSchedulerDppTraceWriter);
+
+Ptr<NrMacSchedulerDppTraceWriter> NrMacSchedulerDppTraceWriter::m_instance = nullptr;
+
+TypeId
+NrMacSchedulerDppTraceWriter::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrMacSchedulerDppTraceWriter")
+            .SetParent<Object>()
+            .AddConstructor<NrMacSchedulerDppTraceWriter>()
+            .AddAttribute("EnableDppG",
+                          "Write the virtual queues of the DPP scheduler (g.txt)",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&NrMacSchedulerDppTraceWriter::SetEnabled<DPP_G>,
+                                              &NrMacSchedulerDppTraceWriter::GetEnabled<DPP_G>),
+                          MakeBooleanChecker())
+            .AddAttribute("EnableDppQ",
+                          "Write the buffers seen by the DPP scheduler (q.txt)",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&NrMacSchedulerDppTraceWriter::SetEnabled<DPP_Q>,
+                                              &NrMacSchedulerDppTraceWriter::GetEnabled<DPP_Q>),
+                          MakeBooleanChecker())
+            .AddAttribute(
+                "EnableDppAlpha",
+                "Write the RBGs allocated by the DPP scheduler (alpha.txt)",
+                BooleanValue(true),
+                MakeBooleanAccessor(&NrMacSchedulerDppTraceWriter::SetEnabled<DPP_ALPHA>,
+                                    &NrMacSchedulerDppTraceWriter::GetEnabled<DPP_ALPHA>),
+                MakeBooleanChecker())
+            .AddAttribute("EnableDppQos",
+                          "Write the throughput, GFBR and virtual queue of the DPP scheduler "
+                          "(qos_trace.csv)",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&NrMacSchedulerDppTraceWriter::SetEnabled<DPP_QOS>,
+                                              &NrMacSchedulerDppTraceWriter::GetEnabled<DPP_QOS>),
+                          MakeBooleanChecker())
+            .AddAttribute("EnableDppTbs",
+                          "Write the TB sizes of the DPP scheduler (tbs.txt)",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&NrMacSchedulerDppTraceWriter::SetEnabled<DPP_TBS>,
+                                              &NrMacSchedulerDppTraceWriter::GetEnabled<DPP_TBS>),
+                          MakeBooleanChecker())
+            .AddAttribute("EnableDppaG",
+                          "Write the virtual queues of the DPPA scheduler (queue_g.txt)",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&NrMacSchedulerDppTraceWriter::SetEnabled<DPPA_G>,
+                                              &NrMacSchedulerDppTraceWriter::GetEnabled<DPPA_G>),
+                          MakeBooleanChecker())
+            .AddAttribute("EnableDppaQ",
+                          "Write the buffers seen by the DPPA scheduler (queue_q.txt)",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&NrMacSchedulerDppTraceWriter::SetEnabled<DPPA_Q>,
+                                              &NrMacSchedulerDppTraceWriter::GetEnabled<DPPA_Q>),
+                          MakeBooleanChecker())
+            .AddAttribute(
+                "EnableDppaAlpha",
+                "Write the RBGs, MCS and UL CQI/SINR of the DPPA scheduler (alpha.txt)",
+                BooleanValue(true),
+                MakeBooleanAccessor(&NrMacSchedulerDppTraceWriter::SetEnabled<DPPA_ALPHA>,
+                                    &NrMacSchedulerDppTraceWriter::GetEnabled<DPPA_ALPHA>),
+                MakeBooleanChecker())
+            .AddAttribute("EnableDppUlQos",
+                          "Write the UL throughput, GFBR and virtual queue of the DPP scheduler "
+                          "(qos_trace_ul.csv)",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&NrMacSchedulerDppTraceWriter::SetEnabled<DPP_UL_QOS>,
+                                              &NrMacSchedulerDppTraceWriter::GetEnabled<DPP_UL_QOS>),
+                          MakeBooleanChecker())
+            .AddAttribute("DecimationPeriod",
+                          "Minimum time between two recorded slots of a stream. "
+                          "Zero records every slot",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&NrMacSchedulerDppTraceWriter::m_decimationPeriod),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("BufferSize",
+                          "Number of records of the ring buffer between the schedulers and "
+                          "the writer thread (rounded up to a power of two)",
+                          UintegerValue(65536),
+                          MakeUintegerAccessor(&NrMacSchedulerDppTraceWriter::SetBufferSize,
+                                               &NrMacSchedulerDppTraceWriter::GetBufferSize),
+                          MakeUintegerChecker<uint32_t>(2))
+            .AddAttribute("OutputFormat",
+                          "Format of the trace files: the tab-separated text files, or the "
+                          "compact NrColumnarTraceFile (.nrct) files",
+                          EnumValue(NrColumnarTraceFile::TEXT),
+                          MakeEnumAccessor(
+                              &NrMacSchedulerDppTraceWriter::m_outputFormat),
+                          MakeEnumChecker(NrColumnarTraceFile::TEXT,
+                                          "Text",
+                                          NrColumnarTraceFile::COLUMNAR,
+                                          "Columnar"));
+    return tid;
+}
+
+NrMacSchedulerDppTraceWriter::NrMacSchedulerDppTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    m_lastSample.fill(std::numeric_limits<int64_t>::min());
+}
+
+NrMacSchedulerDppTraceWriter::~NrMacSchedulerDppTraceWriter()
+{
+    Stop();
+    CloseOutput();
+}
+
+void
+NrMacSchedulerDppTraceWriter::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Stop();
+    CloseOutput();
+    Object::DoDispose();
+}
+
+NrMacSchedulerDppTraceWriter*
+NrMacSchedulerDppTraceWriter::Get()
+{
+    if (m_instance == nullptr)
+    {
+        m_instance = CreateObject<NrMacSchedulerDppTraceWriter>();
+        Simulator::ScheduleDestroy(&NrMacSchedulerDppTraceWriter::DestroyInstance);
+    }
+    return PeekPointer(m_instance);
+}
+
+void
+NrMacSchedulerDppTraceWriter::DestroyInstance()
+{
+    if (m_instance != nullptr)
+    {
+        NS_LOG_INFO("Trace writer destroyed, the scheduler stalled " << m_instance->GetStalls()
+                                                                     << " times");
+        m_instance->Dispose();
+        m_instance = nullptr;
+    }
+}
+
+void
+NrMacSchedulerDppTraceWriter::SetBufferSize(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    NS_ABORT_MSG_IF(m_thread.joinable(), "Cannot resize the ring once the writer started");
+    uint32_t pow2 = 1;
+    while (pow2 < size)
+    {
+        pow2 <<= 1;
+    }
+    m_bufferSize = pow2;
+}
+
+uint32_t
+NrMacSchedulerDppTraceWriter::GetBufferSize() const
+{
+    return m_bufferSize;
+}
+
+bool
+NrMacSchedulerDppTraceWriter::Sample(Stream stream)
+{
+    if (m_decimationPeriod.IsZero())
+    {
+        return true;
+    }
+    int64_t now = Simulator::Now().GetTimeStep();
+    int64_t& last = m_lastSample[stream];
+    if (now != last && last != std::numeric_limits<int64_t>::min() &&
+        now - last < m_decimationPeriod.GetTimeStep())
+    {
+        return false;
+    }
+    last = now;
+    return true;
+}
+
+void
+NrMacSchedulerDppTraceWriter::Write(Stream stream,
+                                    uint16_t rnti,
+                                    double v0,
+                                    double v1,
+                                    double v2,
+                                    double v3)
+{
+    if (!m_thread.joinable())
+    {
+        Start();
+    }
+
+    std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) > m_mask)
+    {
+        // Full: wake the writer up and wait for it, never drop records
+        ++m_stalls;
+        m_cv.notify_one();
+        while (head - m_tail.load(std::memory_order_acquire) > m_mask)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    Record& r = m_ring[head & m_mask];
+    r.m_timeNs = Simulator::Now().GetNanoSeconds();
+    r.m_rnti = rnti;
+    r.m_stream = stream;
+    r.m_value = {v0, v1, v2, v3};
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+void
+NrMacSchedulerDppTraceWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+    std::size_t head = m_head.load(std::memory_order_relaxed);
+    while (m_tail.load(std::memory_order_acquire) != head)
+    {
+        m_cv.notify_one();
+        std::this_thread::yield();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& file : m_files)
+    {
+        if (file)
+        {
+            file->flush();
+        }
+    }
+}
+
+uint64_t
+NrMacSchedulerDppTraceWriter::GetStalls() const
+{
+    return m_stalls.load();
+}
+
+void
+NrMacSchedulerDppTraceWriter::Suspend()
+{
+    NS_LOG_FUNCTION(this);
+    Stop();
+    for (auto& file : m_files)
+    {
+        if (file)
+        {
+            file->close();
+            file.reset();
+        }
+    }
+    for (auto& file : m_columnarFiles)
+    {
+        if (file)
+        {
+            file->Suspend();
+        }
+    }
+}
+
+std::vector<std::string>
+NrMacSchedulerDppTraceWriter::GetOutputFiles() const
+{
+    std::vector<std::string> files;
+    for (uint8_t stream = 0; stream < NUM_STREAMS; ++stream)
+    {
+        if (m_created[stream])
+        {
+            files.push_back(GetFileName(static_cast<Stream>(stream)));
+        }
+        if (m_columnarFiles[stream])
+        {
+            files.push_back(
+                NrColumnarTraceFile::GetFileName(GetFileName(static_cast<Stream>(stream))));
+        }
+    }
+    return files;
+}
+
+void
+NrMacSchedulerDppTraceWriter::Start()
+{
+    NS_LOG_FUNCTION(this);
+    m_ring.resize(m_bufferSize);
+    m_mask = m_bufferSize - 1;
+    m_running = true;
+    m_thread = std::thread(&NrMacSchedulerDppTraceWriter::Run, this);
+}
+
+void
+NrMacSchedulerDppTraceWriter::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+    m_running = false;
+    m_cv.notify_one();
+    m_thread.join();
+}
+
+void
+NrMacSchedulerDppTraceWriter::Run()
+{
+    while (true)
+    {
+        // Read the flag before draining: when it is false, the producer
+        // has pushed its last record already
+        bool running = m_running.load(std::memory_order_acquire);
+        if (Drain() > 0)
+        {
+            continue;
+        }
+        if (!running)
+        {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+std::size_t
+NrMacSchedulerDppTraceWriter::Drain()
+{
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    std::size_t head = m_head.load(std::memory_order_acquire);
+    if (tail == head)
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t drained = head - tail;
+    while (tail != head)
+    {
+        std::size_t idx = tail & m_mask;
+        std::size_t len = std::min(head - tail, m_ring.size() - idx);
+        Consume(&m_ring[idx], len);
+        tail += len;
+        // Give back the space as soon as possible
+        m_tail.store(tail, std::memory_order_release);
+    }
+    return drained;
+}
+
+std::string
+NrMacSchedulerDppTraceWriter::GetFileName(Stream stream)
+{
+    switch (stream)
+    {
+    case DPP_G:
+        return "g.txt";
+    case DPP_Q:
+        return "q.txt";
+    case DPP_ALPHA:
+        return "alpha.txt";
+    case DPP_QOS:
+        return "qos_trace.csv";
+    case DPP_TBS:
+        return "tbs.txt";
+    case DPPA_G:
+        return "queue_g.txt";
+    case DPPA_Q:
+        return "queue_q.txt";
+    case DPPA_ALPHA:
+        return "alpha.txt";
+    case DPP_UL_QOS:
+        return "qos_trace_ul.csv";
+    default:
+        NS_FATAL_ERROR("Unknown stream " << +stream);
+    }
+}
+
+std::string
+NrMacSchedulerDppTraceWriter::GetHeader(Stream stream)
+{
+    switch (stream)
+    {
+    case DPP_G:
+    case DPPA_G:
+        return "time\tue\tg\n";
+    case DPP_Q:
+    case DPPA_Q:
+        return "time\tue\tq\n";
+    case DPP_ALPHA:
+        return "time\tUE\tresources\n";
+    case DPP_QOS:
+    case DPP_UL_QOS:
+        return "time,rnti,throughput_mbps,gfbr_mbps,g\n";
+    case DPP_TBS:
+        return "time\tue\ttbs\n";
+    case DPPA_ALPHA:
+        return "time\tue\tresources\tmcs\tULcqi\tULsinr\n";
+    default:
+        NS_FATAL_ERROR("Unknown stream " << +stream);
+    }
+}
+
+std::vector<NrColumnarTraceFile::Column>
+NrMacSchedulerDppTraceWriter::GetColumns(Stream stream)
+{
+    using Column = NrColumnarTraceFile::Column;
+    const Column rnti{"rnti", NrColumnarTraceFile::INTEGER, 1.0};
+    switch (stream)
+    {
+    case DPP_G:
+    case DPPA_G:
+        return {rnti, {"g", NrColumnarTraceFile::FIXED_POINT, 1e3}};
+    case DPP_Q:
+    case DPPA_Q:
+        return {rnti, {"q", NrColumnarTraceFile::INTEGER, 1.0}};
+    case DPP_ALPHA:
+        return {rnti, {"resources", NrColumnarTraceFile::INTEGER, 1.0}};
+    case DPP_QOS:
+    case DPP_UL_QOS:
+        // The GFBR and the virtual queue are in bit/s and bits, despite the
+        // name of the text column, so a scale of 1 keeps the varints short
+        return {rnti,
+                {"throughput_mbps", NrColumnarTraceFile::FIXED_POINT, 1e6},
+                {"gfbr_bps", NrColumnarTraceFile::FIXED_POINT, 1.0},
+                {"g", NrColumnarTraceFile::FIXED_POINT, 1.0}};
+    case DPP_TBS:
+        return {rnti, {"tbs", NrColumnarTraceFile::INTEGER, 1.0}};
+    case DPPA_ALPHA:
+        return {rnti,
+                {"resources", NrColumnarTraceFile::INTEGER, 1.0},
+                {"mcs", NrColumnarTraceFile::INTEGER, 1.0},
+                {"ULcqi", NrColumnarTraceFile::INTEGER, 1.0},
+                {"ULsinr", NrColumnarTraceFile::FLOAT64, 1.0}};
+    default:
+        NS_FATAL_ERROR("Unknown stream " << +stream);
+    }
+}
+
+void
+NrMacSchedulerDppTraceWriter::Consume(const Record* records, std::size_t n)
+{
+    if (m_outputFormat == NrColumnarTraceFile::COLUMNAR)
+    {
+        ConsumeColumnar(records, n);
+        return;
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Record& r = records[i];
+        auto stream = static_cast<Stream>(r.m_stream);
+        auto& file = m_files[stream];
+        if (!file)
+        {
+            if (m_created[stream])
+            {
+                // Closed by Suspend()
+                file = std::make_unique<std::ofstream>(GetFileName(stream), std::ios::app);
+            }
+            else
+            {
+                file = std::make_unique<std::ofstream>(GetFileName(stream));
+                *file << GetHeader(stream);
+                m_created[stream] = true;
+            }
+            if (stream == DPP_QOS || stream == DPP_UL_QOS)
+            {
+                *file << std::fixed << std::setprecision(6);
+            }
+        }
+
+        // Same formatting that the schedulers used when writing directly
+        double ms = r.m_timeNs / 1e6;
+        switch (stream)
+        {
+        case DPP_G:
+        case DPPA_G:
+            *file << ms << "\t" << r.m_rnti << "\t" << r.m_value[0] << "\n";
+            break;
+        case DPP_Q:
+        case DPPA_Q:
+        case DPP_ALPHA:
+        case DPP_TBS:
+            *file << ms << "\t" << r.m_rnti << "\t" << static_cast<uint32_t>(r.m_value[0])
+                  << "\n";
+            break;
+        case DPP_QOS:
+        case DPP_UL_QOS:
+            *file << r.m_timeNs / 1e9 << "," << r.m_rnti << "," << r.m_value[0] << ","
+                  << r.m_value[1] << "," << r.m_value[2] << "\n";
+            break;
+        case DPPA_ALPHA:
+            *file << ms << "\t" << r.m_rnti << "\t" << static_cast<uint32_t>(r.m_value[0]) << "\t"
+                  << static_cast<int>(r.m_value[1]) << "\t" << static_cast<int>(r.m_value[2])
+                  << "\t" << r.m_value[3] << "\n";
+            break;
+        default:
+            NS_FATAL_ERROR("Unknown stream " << +stream);
+        }
+    }
+}
+
+void
+NrMacSchedulerDppTraceWriter::ConsumeColumnar(const Record* records, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Record& r = records[i];
+        auto stream = static_cast<Stream>(r.m_stream);
+        auto& file = m_columnarFiles[stream];
+        if (!file)
+        {
+            file = std::make_unique<NrColumnarTraceFile>();
+            file->Open(NrColumnarTraceFile::GetFileName(GetFileName(stream)), GetColumns(stream));
+        }
+        if (!file->IsOpen())
+        {
+            continue;
+        }
+
+        switch (stream)
+        {
+        case DPP_QOS:
+        case DPP_UL_QOS:
+            file->Append(r.m_timeNs, {double(r.m_rnti), r.m_value[0], r.m_value[1], r.m_value[2]});
+            break;
+        case DPPA_ALPHA:
+            file->Append(
+                r.m_timeNs,
+                {double(r.m_rnti), r.m_value[0], r.m_value[1], r.m_value[2], r.m_value[3]});
+            break;
+        default:
+            file->Append(r.m_timeNs, {double(r.m_rnti), r.m_value[0]});
+        }
+    }
+}
+
+void
+NrMacSchedulerDppTraceWriter::CloseOutput()
+{
+    for (auto& file : m_columnarFiles)
+    {
+        if (file)
+        {
+            file->Close();
+            file.reset();
+        }
+    }
+    for (auto& file : m_files)
+    {
+        if (file)
+        {
+            file->close();
+            file.reset();
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,315 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-columnar-trace-file.h"
+
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ *
+ * \brief Asynchronous writer of the per-slot state of the DPP/DPPA schedulers
+ *
+ * The schedulers push fixed-size binary records into a single-producer,
+ * single-consumer lock-free ring buffer. A background thread drains the
+ * buffer in batches and formats the records into the trace files, so the
+ * scheduler never waits on the filesystem (unless the ring is full, in which
+ * case it yields until the writer catches up; records are never dropped).
+ *
+ * Each stream has its own file, which is opened the first time the stream is
+ * written, with the same name and format of the files that the schedulers
+ * used to write directly:
+ *
+ * | Stream     | File            | Columns                                  |
+ * |------------|-----------------|------------------------------------------|
+ * | DPP_G      | g.txt           | time (ms), ue, g                         |
+ * | DPP_Q      | q.txt           | time (ms), ue, q                         |
+ * | DPP_ALPHA  | alpha.txt       | time (ms), UE, resources                 |
+ * | DPP_QOS    | qos_trace.csv   | time (s), rnti, throughput, gfbr, g      |
+ * | DPP_TBS    | tbs.txt         | time (ms), ue, tbs                       |
+ * | DPPA_G     | queue_g.txt     | time (ms), ue, g                         |
+ * | DPPA_Q     | queue_q.txt     | time (ms), ue, q                         |
+ * | DPPA_ALPHA | alpha.txt       | time (ms), ue, resources, mcs, ULcqi, ULsinr |
+ * | DPP_UL_QOS | qos_trace_ul.csv | time (s), rnti, throughput, gfbr, g     |
+ *
+ * With the attribute "OutputFormat" set to "Columnar", each stream is written
+ * instead as a NrColumnarTraceFile, with the same name and the ".nrct"
+ * extension (e.g., g.nrct). The columns are "time_ns", "rnti" and the values
+ * of the stream, named as in the text header, except the GFBR of the QoS
+ * streams: it is in bit/s, stored with a 1 bit/s resolution as "gfbr_bps"
+ * (the text column keeps its historical "gfbr_mbps" name). The virtual
+ * queue "g" of the QoS streams also has a resolution of 1 bit.
+ *
+ * Every stream can be disabled with its attribute (e.g., "EnableDppG"); the
+ * schedulers check IsEnabled() before building a record, so a disabled
+ * stream costs a single branch, and no thread is started until the first
+ * record is written. With "DecimationPeriod" only one slot every period is
+ * recorded for each stream (all the UEs of a recorded slot are kept).
+ *
+ * The writer is shared by all the schedulers of the simulation. It is
+ * created by the first call to Get(), and it is flushed and destroyed when
+ * the simulator is destroyed. Its attributes can be set with
+ * Config::SetDefault before the simulation starts.
+ */
+class NrMacSchedulerDppTraceWriter : public Object
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrMacSchedulerDppTraceWriter constructor
+     */
+    NrMacSchedulerDppTraceWriter();
+
+    /**
+     * \brief ~NrMacSchedulerDppTraceWriter deconstructor
+     */
+    ~NrMacSchedulerDppTraceWriter() override;
+
+    /**
+     * \brief The traced streams
+     */
+    enum Stream : uint8_t
+    {
+        DPP_G = 0,  //!< Virtual queues of the DPP scheduler
+        DPP_Q,      //!< Buffer of the UEs in the DPP scheduler
+        DPP_ALPHA,  //!< RBGs allocated by the DPP scheduler
+        DPP_QOS,    //!< Throughput, GFBR and virtual queue after each DPP slot
+        DPP_TBS,    //!< TB size of each UE after each DPP slot
+        DPPA_G,     //!< Virtual queues of the DPPA scheduler
+        DPPA_Q,     //!< Buffer of the UEs in the DPPA scheduler
+        DPPA_ALPHA, //!< RBGs, MCS and UL CQI/SINR in the DPPA scheduler
+        DPP_UL_QOS, //!< UL throughput, GFBR and virtual queue after each DPP slot
+        NUM_STREAMS //!< Number of streams
+    };
+
+    /**
+     * \brief A fixed-size trace record
+     */
+    struct Record
+    {
+        int64_t m_timeNs{0};                  //!< Simulation time, in ns
+        uint16_t m_rnti{0};                   //!< RNTI of the UE
+        uint8_t m_stream{0};                  //!< Stream of the record
+        std::array<double, 4> m_value{};      //!< Values, meaning depends on the stream
+    };
+
+    /**
+     * \brief Get the writer, creating it at the first call
+     * \return the writer shared by all the schedulers
+     */
+    static NrMacSchedulerDppTraceWriter* Get();
+
+    /**
+     * \brief Check if a stream is enabled
+     * \param stream the stream
+     * \return true if records of the stream are written
+     */
+    bool IsEnabled(Stream stream) const
+    {
+        return m_enabled[stream];
+    }
+
+    /**
+     * \brief Check if the current slot has to be recorded for a stream
+     *
+     * It implements the decimation; it has to be called once per slot and
+     * stream, before writing the records of the slot.
+     *
+     * \param stream the stream
+     * \return true if the records of the current slot have to be written
+     */
+    bool Sample(Stream stream);
+
+    /**
+     * \brief Push a record of the current simulation time
+     * \param stream the stream
+     * \param rnti RNTI of the UE
+     * \param v0 first value
+     * \param v1 second value
+     * \param v2 third value
+     * \param v3 fourth value
+     */
+    void Write(Stream stream,
+               uint16_t rnti,
+               double v0,
+               double v1 = 0.0,
+               double v2 = 0.0,
+               double v3 = 0.0);
+
+    /**
+     * \brief Wait until all the records pushed so far are written and flushed
+     */
+    void Flush();
+
+    /**
+     * \brief Get the number of times the scheduler had to wait for a full ring
+     * \return the number of stalls
+     */
+    uint64_t GetStalls() const;
+
+    /**
+     * \brief Write all the records pushed so far, stop the thread and close the files
+     *
+     * Before a fork(): the child would have the ring but not the thread, and
+     * the two processes would share the offsets of the open files. The next
+     * record, in each process, restarts the thread, and the files are
+     * reopened at their end.
+     */
+    void Suspend();
+
+    /**
+     * \brief Get the files created so far; to be called while suspended
+     * \return the names of the files
+     */
+    std::vector<std::string> GetOutputFiles() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Format records drained from the ring into the trace files
+     * \param records the records, in the order they were pushed
+     * \param n number of records
+     */
+    void Consume(const Record* records, std::size_t n);
+
+    /**
+     * \brief Write records drained from the ring into the columnar files
+     * \param records the records, in the order they were pushed
+     * \param n number of records
+     */
+    void ConsumeColumnar(const Record* records, std::size_t n);
+
+    /**
+     * \brief Flush and close the trace files
+     */
+    void CloseOutput();
+
+    /**
+     * \brief Get the file name of a stream
+     * \param stream the stream
+     * \return the file name
+     */
+    static std::string GetFileName(Stream stream);
+
+    /**
+     * \brief Get the header line of a stream
+     * \param stream the stream
+     * \return the header, including the line termination
+     */
+    static std::string GetHeader(Stream stream);
+
+    /**
+     * \brief Get the columns of a stream in the columnar format
+     * \param stream the stream
+     * \return the columns, excluding the time
+     */
+    static std::vector<NrColumnarTraceFile::Column> GetColumns(Stream stream);
+
+    /**
+     * \brief Destroy the shared writer (scheduled at simulator destroy)
+     */
+    static void DestroyInstance();
+
+    /**
+     * \brief Start the background thread
+     */
+    void Start();
+
+    /**
+     * \brief Stop the background thread, after draining the ring
+     */
+    void Stop();
+
+    /**
+     * \brief Body of the background thread
+     */
+    void Run();
+
+    /**
+     * \brief Drain the ring
+     * \return the number of records drained
+     */
+    std::size_t Drain();
+
+    /**
+     * \brief Set the size of the ring
+     * \param size the number of records (rounded up to a power of two)
+     */
+    void SetBufferSize(uint32_t size);
+
+    /**
+     * \brief Get the size of the ring
+     * \return the number of records
+     */
+    uint32_t GetBufferSize() const;
+
+    /**
+     * \brief Enable or disable a stream (attribute accessor)
+     * \param enabled whether the stream is enabled
+     */
+    template <Stream S>
+    void SetEnabled(bool enabled)
+    {
+        m_enabled[S] = enabled;
+    }
+
+    /**
+     * \brief Check if a stream is enabled (attribute accessor)
+     * \return whether the stream is enabled
+     */
+    template <Stream S>
+    bool GetEnabled() const
+    {
+        return m_enabled[S];
+    }
+
+    static Ptr<NrMacSchedulerDppTraceWriter> m_instance; //!< The shared writer
+
+    std::array<bool, NUM_STREAMS> m_enabled{};        //!< Enabled streams
+    std::array<int64_t, NUM_STREAMS> m_lastSample{}; //!< Last recorded slot of each stream
+    Time m_decimationPeriod{0};                       //!< Decimation period
+
+    uint32_t m_bufferSize{0};               //!< Size of the ring, in records
+    std::vector<Record> m_ring;             //!< The ring buffer
+    std::size_t m_mask{0};                  //!< Ring size - 1
+    std::atomic<std::size_t> m_head{0};     //!< Next position to write (producer)
+    std::atomic<std::size_t> m_tail{0};     //!< Next position to read (consumer)
+    std::atomic<bool> m_running{false};     //!< Whether the thread has to keep running
+    std::atomic<uint64_t> m_stalls{0};      //!< Times the producer found the ring full
+    std::thread m_thread;                   //!< The background writer
+    std::mutex m_mutex;                     //!< Mutex for the wake-up condition
+    std::condition_variable m_cv;           //!< Wake-up condition of the writer
+
+    NrColumnarTraceFile::TraceFormat m_outputFormat{NrColumnarTraceFile::TEXT}; //!< Output format
+    std::array<std::unique_ptr<std::ofstream>, NUM_STREAMS> m_files; //!< Text output files
+    std::array<bool, NUM_STREAMS> m_created{}; //!< Whether the text file of a stream was created
+    std::array<std::unique_ptr<NrColumnarTraceFile>, NUM_STREAMS>
+        m_columnarFiles; //!< Columnar output files
+};
+
+} // namespace ns3
@@ -6,6 +6,8 @@
 
 #include "nr-mac-scheduler-lc-alg.h"
 
+#include "nr-mac-scheduler-ue-info.h"
+
 #include <ns3/log.h>
 
 namespace ns3
@@ -37,4 +39,12 @@ NrMacSchedulerLcAlgorithm::GetInstanceTypeId() const
     return NrMacSchedulerLcAlgorithm::GetTypeId();
 }
 
+std::vector<NrMacSchedulerLcAlgorithm::Assignation>
+NrMacSchedulerLcAlgorithm::AssignBytesToDlLC(const NrMacSchedulerUeInfo& ue,
+                                             uint32_t tbs,
+                                             Time slotPeriod) const
+{
+    return AssignBytesToDlLC(ue.m_dlLCG, tbs, slotPeriod);
+}
+
 } // namespace ns3
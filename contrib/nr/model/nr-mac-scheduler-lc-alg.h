@@ -15,6 +15,8 @@
 namespace ns3
 {
 
+class NrMacSchedulerUeInfo;
+
 /**
  * \ingroup scheduler
  *
@@ -117,6 +119,21 @@ class NrMacSchedulerLcAlgorithm : public Object
         uint32_t tbs,
         Time slotPeriod) const = 0;
 
+    /**
+     * \brief Method to decide how to distribute the assigned bytes to the
+     *        different LCs of a UE for the DL direction, with the information
+     *        that the UE representation keeps about its LCs.
+     *        By default, it distributes the LCs of the UE (m_dlLCG) with the
+     *        method above.
+     * \param ue the UE representation
+     * \param tbs TBS to divide between the LCG/LC
+     * \param slotPeriod the slot period
+     * \return A vector of Assignation
+     */
+    virtual std::vector<Assignation> AssignBytesToDlLC(const NrMacSchedulerUeInfo& ue,
+                                                       uint32_t tbs,
+                                                       Time slotPeriod) const;
+
     /**
      * \brief Method to decide how to distribute the assigned bytes to the different LCs
      *        for the UL direction. Notice that in the UL there is a limitation in the
@@ -6,6 +6,8 @@
 
 #include "nr-mac-scheduler-lc-qos.h"
 
+#include "nr-mac-scheduler-ue-info.h"
+
 #include "ns3/ff-mac-common.h"
 #include "ns3/log.h"
 
@@ -47,6 +49,25 @@ std::vector<NrMacSchedulerLcAlgorithm::Assignation>
 NrMacSchedulerLcQos::AssignBytesToDlLC(const std::unordered_map<uint8_t, LCGPtr>& ueLCG,
                                        uint32_t tbs,
                                        Time slotPeriod) const
+{
+    NS_LOG_FUNCTION(this);
+    return DistributeDl(ueLCG, tbs, slotPeriod, nullptr);
+}
+
+std::vector<NrMacSchedulerLcAlgorithm::Assignation>
+NrMacSchedulerLcQos::AssignBytesToDlLC(const NrMacSchedulerUeInfo& ue,
+                                       uint32_t tbs,
+                                       Time slotPeriod) const
+{
+    NS_LOG_FUNCTION(this);
+    return DistributeDl(ue.m_dlLCG, tbs, slotPeriod, &ue);
+}
+
+std::vector<NrMacSchedulerLcAlgorithm::Assignation>
+NrMacSchedulerLcQos::DistributeDl(const std::unordered_map<uint8_t, LCGPtr>& ueLCG,
+                                  uint32_t tbs,
+                                  Time slotPeriod,
+                                  const NrMacSchedulerUeInfo* ue) const
 {
     NS_LOG_FUNCTION(this);
     GetFirst GetLCGID;
@@ -70,20 +91,24 @@ NrMacSchedulerLcQos::AssignBytesToDlLC(const std::unordered_map<uint8_t, LCGPtr>
         AssignedBytesToGbrLCsList; // vector that stores the LC ID with the bytes assigned for the
                                    // case of GBR LCs
 
+    // Bit rate guaranteed to a LC in this slot
+    auto guaranteedBitRate = [ue](uint8_t lcId, const LCPtr& lc) {
+        return ue != nullptr ? ue->GetDlLcGuaranteedBitRate(lcId, lc->m_eRabGuaranteedBitrateDl)
+                             : lc->m_eRabGuaranteedBitrateDl;
+    };
+
     for (const auto& lcg : ueLCG)
     {
         std::vector<uint8_t> ueActiveLCs = GetLCG(lcg)->GetActiveLCIds();
         for (const auto lcId : ueActiveLCs)
         {
-            if ((GetLCG(lcg)->GetLC(lcId)->m_resourceType ==
-                     LogicalChannelConfigListElement_s::QBT_DGBR ||
-                 GetLCG(lcg)->GetLC(lcId)->m_resourceType ==
-                     LogicalChannelConfigListElement_s::QBT_GBR) &&
-                GetLCG(lcg)->GetLC(lcId)->m_eRabGuaranteedBitrateDl != UINT64_MAX)
+            const LCPtr& lc = GetLCG(lcg)->GetLC(lcId);
+            if ((lc->m_resourceType == LogicalChannelConfigListElement_s::QBT_DGBR ||
+                 lc->m_resourceType == LogicalChannelConfigListElement_s::QBT_GBR) &&
+                guaranteedBitRate(lcId, lc) != UINT64_MAX)
             {
                 gbrActiveLCs.emplace_back(std::make_pair(GetLCGID(lcg), lcId));
-                sumErabGueanteedBitRate +=
-                    (GetLCG(lcg)->GetLC(lcId)->m_eRabGuaranteedBitrateDl / 8);
+                sumErabGueanteedBitRate += (guaranteedBitRate(lcId, lc) / 8);
             }
             restActiveLCs.emplace_back(std::make_pair(GetLCGID(lcg), lcId));
         }
@@ -120,17 +145,13 @@ NrMacSchedulerLcQos::AssignBytesToDlLC(const std::unordered_map<uint8_t, LCGPtr>
             {
                 if (itGbrActiveLCs.first == GetLCGID(lcg))
                 {
-                    NS_ASSERT_MSG(
-                        GetLCG(lcg)->GetLC(itGbrActiveLCs.second)->m_eRabGuaranteedBitrateDl !=
-                            UINT64_MAX,
-                        "LC is not guaranteed bit rate!");
-
-                    uint32_t bytes = std::min(
-                        static_cast<uint32_t>(
-                            slotPeriod.GetSeconds() *
-                            (GetLCG(lcg)->GetLC(itGbrActiveLCs.second)->m_eRabGuaranteedBitrateDl /
-                             8)),
-                        GetLCG(lcg)->GetLC(itGbrActiveLCs.second)->GetTotalSize());
+                    const LCPtr& lc = GetLCG(lcg)->GetLC(itGbrActiveLCs.second);
+                    const uint64_t gbr = guaranteedBitRate(itGbrActiveLCs.second, lc);
+                    NS_ASSERT_MSG(gbr != UINT64_MAX, "LC is not guaranteed bit rate!");
+
+                    uint32_t bytes =
+                        std::min(static_cast<uint32_t>(slotPeriod.GetSeconds() * (gbr / 8)),
+                                 lc->GetTotalSize());
 
                     bytesAssigned = bytes >= bytesLeftToBeAssigned ? bytesLeftToBeAssigned : bytes;
 
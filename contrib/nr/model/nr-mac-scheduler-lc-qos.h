@@ -69,6 +69,21 @@ class NrMacSchedulerLcQos : public NrMacSchedulerLcAlgorithm
                                                uint32_t tbs,
                                                Time slotPeriod) const override;
 
+    /**
+     * \brief Method to decide how to distribute the assigned bytes to the different LCs
+     *        of a UE for the DL direction. The same algorithm as above, where the bytes
+     *        guaranteed to each GBR LC are those of the bit rate given by
+     *        NrMacSchedulerUeInfo::GetDlLcGuaranteedBitRate (e.g., the GFBR plus
+     *        the deficit of the LC virtual queue, in NrMacSchedulerUeInfoDPP).
+     * \param ue the UE representation
+     * \param tbs TBS to divide between the LCG/LC
+     * \param slotPeriod the slot period
+     * \return A vector of Assignation
+     */
+    std::vector<Assignation> AssignBytesToDlLC(const NrMacSchedulerUeInfo& ue,
+                                               uint32_t tbs,
+                                               Time slotPeriod) const override;
+
     /**
      * \brief Method to decide how to distribute the assigned bytes to the different LCs
      *        for the UL direction. Due to the scheduler limitation the applied algorithm
@@ -79,6 +94,21 @@ class NrMacSchedulerLcQos : public NrMacSchedulerLcAlgorithm
      */
     std::vector<Assignation> AssignBytesToUlLC(const std::unordered_map<uint8_t, LCGPtr>& ueLCG,
                                                uint32_t tbs) const override;
+
+  private:
+    /**
+     * \brief Distribute the bytes of a DL TB among the LCs
+     * \param ueLCG LCG of an UE
+     * \param tbs TBS to divide between the LCG/LC
+     * \param slotPeriod the slot period
+     * \param ue the UE representation that gives the guaranteed bit rate of
+     * the LCs, or nullptr to use their ERAB guaranteed bit rate
+     * \return A vector of Assignation
+     */
+    std::vector<Assignation> DistributeDl(const std::unordered_map<uint8_t, LCGPtr>& ueLCG,
+                                          uint32_t tbs,
+                                          Time slotPeriod,
+                                          const NrMacSchedulerUeInfo* ue) const;
 };
 } // namespace ns3
 
@@ -43,6 +43,8 @@ class NrMacSchedulerLcRR : public NrMacSchedulerLcAlgorithm
      */
     ~NrMacSchedulerLcRR() override;
 
+    using NrMacSchedulerLcAlgorithm::AssignBytesToDlLC;
+
     /**
      * \brief Method to decide how to distribute the assigned bytes to the different LCs
      *        for the DL direction. In the RR case the method to distribute the bytes will
@@ -870,7 +870,7 @@ NrMacSchedulerNs3::DoSchedDlCqiInfoReq(
         }
         else
         {
-            m_cqiManagement.DlSBCQIReported(cqi, ue);
+            m_cqiManagement.DlSBCQIReported(cqi, ue, expirationTime, m_maxDlMcs);
         }
     }
 }
@@ -1457,9 +1457,15 @@ NrMacSchedulerNs3::DoScheduleDlData(PointInFTPlane* spoint,
                 // distribute tbsize of each stream among the LCs of the UE
                 // distributedBytes size is equal to the number of LCs
                 auto distributedBytes =
-                    m_schedLc->AssignBytesToDlLC(ue.first->m_dlLCG,
+                    m_schedLc->AssignBytesToDlLC(*ue.first,
                                                  it,
                                                  m_macSchedSapUser->GetSlotPeriod());
+                for (const auto& assignation : distributedBytes)
+                {
+                    ue.first->DlLcBytesAssigned(assignation.m_lcId,
+                                                assignation.m_bytes,
+                                                m_macSchedSapUser->GetSlotPeriod());
+                }
                 if (bytesPerLcPerStream.size() == 0)
                 {
                     bytesPerLcPerStream.resize(distributedBytes.size());
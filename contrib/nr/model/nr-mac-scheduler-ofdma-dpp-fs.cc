@@ -0,0 +1,125 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-mac-scheduler-ofdma-dpp-fs.h"
+
+#include "nr-mac-scheduler-ue-info-dpp.h"
+
+#include <ns3/log.h>
+
+#include <algorithm>
+
+namespace ns3
+{
+NS_LOG_COMPONENT_DEFINE("NrMacSchedulerOfdmaDPPFS");
+NS_OBJECT_ENSURE_REGISTERED(NrMacSchedulerOfdmaDPPFS);
+
+TypeId
+NrMacSchedulerOfdmaDPPFS::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::NrMacSchedulerOfdmaDPPFS")
+                            .SetParent<NrMacSchedulerOfdmaDPP>()
+                            .AddConstructor<NrMacSchedulerOfdmaDPPFS>();
+    return tid;
+}
+
+NrMacSchedulerOfdmaDPPFS::NrMacSchedulerOfdmaDPPFS()
+    : NrMacSchedulerOfdmaDPP()
+{
+}
+
+NrMacSchedulerNs3::BeamSymbolMap
+NrMacSchedulerOfdmaDPPFS::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl) const
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_LOG_DEBUG("# beams active flows: " << activeDl.size() << ", # sym: " << symAvail);
+
+    GetFirst GetBeamId;
+    GetSecond GetUeVector;
+    BeamSymbolMap symPerBeam = GetSymPerBeam(symAvail, activeDl);
+
+    const std::vector<uint8_t> dlNotchedRBGsMask = GetDlNotchedRbgMask();
+
+    for (const auto& el : activeDl)
+    {
+        uint32_t beamSym = symPerBeam.at(GetBeamId(el));
+        uint32_t rbgAssignable = 1 * beamSym;
+        const std::vector<UePtrAndBufferReq>& ueVector = GetUeVector(el);
+        FTResources assigned(0, 0);
+
+        auto& ctx = m_fsContext;
+        ctx.Refresh<NrMacSchedulerUeInfoDPP>(ueVector);
+        ctx.RefreshRbgMcs(GetBandwidthInRbg(), GetNumRbPerRbg());
+        NrMacSchedulerUeInfoDPP::LyapunovDppPerRbg(&ctx, dlNotchedRBGsMask, m_dlAmc);
+
+        for (std::size_t n = 0; n < ctx.GetSize(); n++)
+        {
+            const UePtrAndBufferReq& ue = *ctx.m_ue[n];
+            auto uePtr = ctx.GetUe<NrMacSchedulerUeInfoDPP>(n);
+
+            uePtr->m_dlRBG = rbgAssignable * uePtr->m_dlRBGallocated;
+            assigned.m_rbg += uePtr->m_dlRBG;
+            uePtr->m_dlSym = beamSym;
+            assigned.m_sym = beamSym;
+
+            if (uePtr->m_dlRBG > 0)
+            {
+                // The TB size, and the throughput of the virtual queue, are
+                // those of the MCS of the assigned RBGs (m_dlSlotMcs)
+                uePtr->UpdateDlMetric(m_dlAmc);
+                AssignedDlResources(ue, FTResources(uePtr->m_dlRBG, beamSym), assigned);
+                NS_LOG_INFO("Assigned " << uePtr->m_dlRBGallocated << " DL RBG with MCS "
+                                        << +uePtr->m_dlSlotMcs << ", spanned over " << beamSym
+                                        << " SYM, to UE " << uePtr->m_rnti);
+            }
+            else
+            {
+                NotAssignedDlResources(ue, FTResources(0, beamSym), assigned);
+            }
+        }
+        saveTBS(ueVector);
+    }
+
+    return symPerBeam;
+}
+
+std::shared_ptr<DciInfoElementTdma>
+NrMacSchedulerOfdmaDPPFS::CreateDlDci(NrMacSchedulerNs3::PointInFTPlane* spoint,
+                                      const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
+                                      uint32_t maxSym) const
+{
+    NS_LOG_FUNCTION(this);
+    auto uePtr = static_cast<NrMacSchedulerUeInfoDPP*>(ueInfo.get());
+
+    // The DCI takes the TB size of the UE, computed with the MCS of the RBGs
+    // chosen by the scheduler, and a contiguous set of RBGs with the number of
+    // RBGs assigned. The DCI is then built again with that MCS and those RBGs.
+    std::shared_ptr<DciInfoElementTdma> dci =
+        NrMacSchedulerOfdmaDPP::CreateDlDci(spoint, ueInfo, maxSym);
+    if (dci == nullptr)
+    {
+        return nullptr;
+    }
+
+    NS_ASSERT(std::count(dci->m_rbgBitmask.begin(), dci->m_rbgBitmask.end(), 1) ==
+              std::count(uePtr->m_dlRbgMask.begin(), uePtr->m_dlRbgMask.end(), 1));
+    auto slotDci = std::make_shared<DciInfoElementTdma>(dci->m_rnti,
+                                                        dci->m_format,
+                                                        dci->m_symStart,
+                                                        dci->m_numSym,
+                                                        uePtr->GetDlSlotMcs(),
+                                                        dci->m_tbSize,
+                                                        dci->m_ndi,
+                                                        dci->m_rv,
+                                                        dci->m_type,
+                                                        dci->m_bwpIndex,
+                                                        dci->m_tpc);
+    slotDci->m_rbgBitmask = uePtr->m_dlRbgMask;
+    return slotDci;
+}
+
+} // namespace ns3
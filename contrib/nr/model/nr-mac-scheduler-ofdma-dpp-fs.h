@@ -0,0 +1,71 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include "nr-mac-scheduler-ofdma-dpp.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief Frequency-selective drift-plus-penalty scheduler
+ *
+ * The same scheduler of NrMacSchedulerOfdmaDPP, but the problem is solved
+ * RBG by RBG (see NrMacSchedulerUeInfoDPP::LyapunovDppPerRbg): each RBG is
+ * priced with the MCS that the UE reported for it in its sub-band CQI, and
+ * the UE receives specific RBGs instead of a number of them. A UE transmits
+ * with the lowest MCS of the RBGs it receives, which the price of each RBG
+ * does not take into account (see LyapunovDppPerRbg).
+ *
+ * The UEs report sub-band CQI only when the attribute
+ * NrUePhy::DlSubbandCqiSize is set; the UEs without it are priced with their
+ * WB MCS in all the RBGs, as in NrMacSchedulerOfdmaDPP.
+ *
+ * \see NrMacSchedulerOfdmaDPP
+ */
+class NrMacSchedulerOfdmaDPPFS : public NrMacSchedulerOfdmaDPP
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrMacSchedulerOfdmaDPPFS constructor
+     */
+    NrMacSchedulerOfdmaDPPFS();
+
+    /**
+     * \brief ~NrMacSchedulerOfdmaDPPFS deconstructor
+     */
+    ~NrMacSchedulerOfdmaDPPFS() override
+    {
+    }
+
+  protected:
+    BeamSymbolMap AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl) const override;
+
+    /**
+     * \brief Create the DL DCI with the RBGs and the MCS chosen in AssignDLRBG
+     * \param spoint Starting point
+     * \param ueInfo UE representation
+     * \param maxSym Maximum symbols to use
+     * \return a pointer to the newly created DCI
+     */
+    std::shared_ptr<DciInfoElementTdma> CreateDlDci(
+        PointInFTPlane* spoint,
+        const std::shared_ptr<NrMacSchedulerUeInfo>& ueInfo,
+        uint32_t maxSym) const override;
+
+  private:
+    mutable NrMacSchedulerDppContext m_fsContext; //!< State of the beam being scheduled
+};
+
+} // namespace ns3
@@ -6,19 +6,20 @@
 
 #include "nr-mac-scheduler-ofdma-dpp.h"
 
+#include "nr-mac-scheduler-dpp-solver-glpk.h"
+#include "nr-mac-scheduler-dpp-solver-native.h"
+#include "nr-mac-scheduler-dpp-trace-writer.h"
 #include "nr-mac-scheduler-ue-info-dpp.h"
 
+#include <ns3/boolean.h>
+#include <ns3/double.h>
 #include <ns3/log.h>
 
-#include <fstream>
-
 namespace ns3
 {
 NS_LOG_COMPONENT_DEFINE("NrMacSchedulerOfdmaDPP");
 NS_OBJECT_ENSURE_REGISTERED(NrMacSchedulerOfdmaDPP);
 
-std::ofstream outputFileTBS("tbs.txt");
-
 TypeId
 NrMacSchedulerOfdmaDPP::GetTypeId()
 {
@@ -38,6 +39,36 @@ NrMacSchedulerOfdmaDPP::GetTypeId()
                 BooleanValue(true),
                 MakeBooleanAccessor(&NrMacSchedulerOfdmaDPP::m_enableVirtualQueue),
                 MakeBooleanChecker())
+            .AddAttribute(
+                "DppSolverType",
+                "Type of the solver of the drift-plus-penalty problem",
+                TypeIdValue(NrMacSchedulerDppSolverNative::GetTypeId()),
+                MakeTypeIdAccessor(&NrMacSchedulerOfdmaDPP::SetDppSolverType),
+                MakeTypeIdChecker())
+            .AddAttribute(
+                "DppSolverCrossCheck",
+                "Solve every problem also with the GLPK reference solver, and abort "
+                "the simulation if the two solutions are not equivalent",
+                BooleanValue(false),
+                MakeBooleanAccessor(&NrMacSchedulerOfdmaDPP::SetDppSolverCrossCheck),
+                MakeBooleanChecker())
+            .AddAttribute(
+                "EnableUplinkDpp",
+                "Assign the UL RBGs solving the drift-plus-penalty problem, with the "
+                "buffers of the BSR and UL virtual queues, instead of as NrMacSchedulerOfdma",
+                BooleanValue(false),
+                MakeBooleanAccessor(&NrMacSchedulerOfdmaDPP::m_enableUplinkDpp),
+                MakeBooleanChecker())
+            .AddTraceSource(
+                "DppSolveTime",
+                "Wall-clock time spent by the solver on the DPP problem of a beam, every slot",
+                MakeTraceSourceAccessor(&NrMacSchedulerOfdmaDPP::m_dppSolveTimeTrace),
+                "ns3::NrMacSchedulerOfdmaDPP::SolveTimeTracedCallback")
+            .AddTraceSource(
+                "DlRbgAllocation",
+                "DL RBGs (per symbol) assigned to each UE by the DPP problem, every slot",
+                MakeTraceSourceAccessor(&NrMacSchedulerOfdmaDPP::m_dlRbgAllocationTrace),
+                "ns3::NrMacSchedulerOfdmaDPP::RbgAllocationTracedCallback")
                 ;
 
     return tid;
@@ -49,6 +80,39 @@ NrMacSchedulerOfdmaDPP::NrMacSchedulerOfdmaDPP()
   
 }
 
+void
+NrMacSchedulerOfdmaDPP::SetDppSolverType(const TypeId& type)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(type.IsChildOf(NrMacSchedulerDppSolver::GetTypeId()));
+    m_dppSolverType = type;
+    m_dppSolvers.clear();
+    m_dppUlSolvers.clear();
+}
+
+Ptr<NrMacSchedulerDppSolver>
+NrMacSchedulerOfdmaDPP::GetDppSolver(const BeamConfId& beamConfId, bool uplink) const
+{
+    auto& solvers = uplink ? m_dppUlSolvers : m_dppSolvers;
+    auto it = solvers.find(beamConfId);
+    if (it == solvers.end())
+    {
+        ObjectFactory factory;
+        factory.SetTypeId(m_dppSolverType);
+        auto solver = DynamicCast<NrMacSchedulerDppSolver>(factory.Create());
+        NS_ASSERT(solver != nullptr);
+        it = solvers.emplace(beamConfId, solver).first;
+    }
+    return it->second;
+}
+
+void
+NrMacSchedulerOfdmaDPP::SetDppSolverCrossCheck(bool crossCheck)
+{
+    NS_LOG_FUNCTION(this << crossCheck);
+    m_dppReferenceSolver = crossCheck ? CreateObject<NrMacSchedulerDppSolverGlpk>() : nullptr;
+}
+
 std::shared_ptr<NrMacSchedulerUeInfo>
 NrMacSchedulerOfdmaDPP::CreateUeRepresentation(
     const NrMacCschedSapProvider::CschedUeConfigReqParameters& params) const
@@ -73,7 +137,6 @@ NrMacSchedulerOfdmaDPP::BeforeDlSched(const UePtrAndBufferReq& ue,
                                       const FTResources& assignableInIteration) const
 {
     NS_LOG_FUNCTION(this);
-    auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPP>(ue.first);
     //  TODO Obtener FH capacity tput constraint
 }
 
@@ -83,7 +146,7 @@ NrMacSchedulerOfdmaDPP::AssignedDlResources(const UePtrAndBufferReq& ue,
                                             [[maybe_unused]] const FTResources& totAssigned) const
 {
     NS_LOG_FUNCTION(this);
-    auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPP>(ue.first);
+    auto uePtr = static_cast<NrMacSchedulerUeInfoDPP*>(ue.first.get());
     // double timeSlot = 1e-3;
     // double timeSlot = 0.5e-3;
     double timeSlot = m_timeSlot;
@@ -100,7 +163,7 @@ NrMacSchedulerOfdmaDPP::NotAssignedDlResources(
     [[maybe_unused]] const FTResources& totAssigned) const
 {
     NS_LOG_FUNCTION(this);
-    auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPP>(ue.first);
+    auto uePtr = static_cast<NrMacSchedulerUeInfoDPP*>(ue.first.get());
     // double timeSlot = 1e-3;
     // double timeSlot = 0.5e-3;
     double timeSlot = m_timeSlot;
@@ -143,6 +206,13 @@ NrMacSchedulerOfdmaDPP::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& active
     GetSecond GetUeVector;
     BeamSymbolMap symPerBeam = GetSymPerBeam(symAvail, activeDl);
 
+    const std::vector<uint8_t> dlNotchedRBGsMask = GetDlNotchedRbgMask();
+    const uint32_t bandResources =
+        dlNotchedRBGsMask.size() > 0
+            ? std::count(dlNotchedRBGsMask.begin(), dlNotchedRBGsMask.end(), 1)
+            : GetBandwidthInRbg();
+    NS_ASSERT(bandResources > 0);
+
     // Iterate through the different beams
     auto ctr = 0;
     for (const auto& el : activeDl)
@@ -151,25 +221,16 @@ NrMacSchedulerOfdmaDPP::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& active
         // Distribute the RBG evenly among UEs of the same beam
         uint32_t beamSym = symPerBeam.at(GetBeamId(el));
         uint32_t rbgAssignable = 1 * beamSym;
-        std::vector<UePtrAndBufferReq> ueVector;
+        const std::vector<UePtrAndBufferReq>& ueVector = GetUeVector(el);
         FTResources assigned(0, 0);
-        const std::vector<uint8_t> dlNotchedRBGsMask = GetDlNotchedRbgMask();
-        uint32_t resources = dlNotchedRBGsMask.size() > 0
-                                 ? std::count(dlNotchedRBGsMask.begin(), dlNotchedRBGsMask.end(), 1)
-                                 : GetBandwidthInRbg();
-        NS_ASSERT(resources > 0);
-
-        for (const auto& ue : GetUeVector(el))
-        {
-            ueVector.emplace_back(ue);
-        }
+        uint32_t resources = bandResources;
 
         NS_LOG_DEBUG("\n------------------------- NEW SLOT -------------------------\n" <<
         "beamSym = " << beamSym << ", rbgAssignable = " << rbgAssignable <<
         ", resources = " << resources << ", ueVector.size() = " << ueVector.size() <<
         "\n------------------------------------------------------------\n");
 
-        for (auto& ue : ueVector)
+        for (const auto& ue : ueVector)
         {
             BeforeDlSched(
                 ue,
@@ -185,32 +246,36 @@ NrMacSchedulerOfdmaDPP::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& active
         NS_LOG_DEBUG("resources = " << resources);
 
         // Llama al scheduler
-        NrMacSchedulerUeInfoDPP::LyapunovDPP(ueVector, resources, m_dlAmc);
+        m_dppContext.Refresh<NrMacSchedulerUeInfoDPP>(ueVector);
+        Time solveTime = NrMacSchedulerUeInfoDPP::LyapunovDPP(&m_dppContext, resources, m_dlAmc, GetDppSolver(GetBeamId(el)), m_dppReferenceSolver);
+        m_dppSolveTimeTrace(ueVector.size(), solveTime);
 
         // TODO asignación
         // Assign 1 RBG for each available symbols for the beam,
         // and then update the count of available resources
-        for (auto& ue : ueVector)
+        for (std::size_t n = 0; n < m_dppContext.GetSize(); n++)
         {
-            GetFirst GetUe;
-            auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPP>(GetUe(ue));
+            const UePtrAndBufferReq& ue = *m_dppContext.m_ue[n];
+            auto uePtr = m_dppContext.GetUe<NrMacSchedulerUeInfoDPP>(n);
+
+            m_dlRbgAllocationTrace(uePtr->m_rnti, uePtr->m_dlRBGallocated);
 
             // Distribute the resources allocated by the scheduler (m_dlRBGallocated) to this UE
-            GetUe(ue)->m_dlRBG = rbgAssignable*uePtr->m_dlRBGallocated; // assign RBGs
+            uePtr->m_dlRBG = rbgAssignable*uePtr->m_dlRBGallocated; // assign RBGs
             assigned.m_rbg += rbgAssignable*uePtr->m_dlRBGallocated; // Counter
-            GetUe(ue)->m_dlSym = beamSym;                // assign sym
+            uePtr->m_dlSym = beamSym;                // assign sym
             assigned.m_sym = beamSym;                    // Counter
             NS_LOG_DEBUG("q = " << ue.second);
-            NS_LOG_DEBUG("m_dlRBG = " << GetUe(ue)->m_dlRBG);
-            NS_LOG_DEBUG("m_dlSym = " << unsigned(GetUe(ue)->m_dlSym));
+            NS_LOG_DEBUG("m_dlRBG = " << uePtr->m_dlRBG);
+            NS_LOG_DEBUG("m_dlSym = " << unsigned(uePtr->m_dlSym));
             NS_LOG_DEBUG("assigned.m_sym = " << unsigned(assigned.m_sym));
             NS_LOG_DEBUG("m_dlRBGallocated = " << uePtr->m_dlRBGallocated);
             resources = resources - uePtr->m_dlRBGallocated; // Resources are RBG, so they do not consider the beamSym
 
             // Update metrics
-            NS_LOG_INFO("Assigned " << GetUe(ue)->m_dlRBG << " DL RBG, spanned over " << beamSym
-                                    << " SYM, to UE " << GetUe(ue)->m_rnti);
-            if (GetUe(ue)->m_dlRBG > 0) // If resources have been allocated to this UE
+            NS_LOG_INFO("Assigned " << uePtr->m_dlRBG << " DL RBG, spanned over " << beamSym
+                                    << " SYM, to UE " << uePtr->m_rnti);
+            if (uePtr->m_dlRBG > 0) // If resources have been allocated to this UE
             {
                 // Following call to AssignedDlResources would update the
                 // TB size in the NrMacSchedulerUeInfo of this particular UE
@@ -237,71 +302,155 @@ NrMacSchedulerOfdmaDPP::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& active
     return symPerBeam;
 }
 
+NrMacSchedulerNs3::BeamSymbolMap
+NrMacSchedulerOfdmaDPP::AssignULRBG(uint32_t symAvail, const ActiveUeMap& activeUl) const
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_enableUplinkDpp)
+    {
+        return NrMacSchedulerOfdma::AssignULRBG(symAvail, activeUl);
+    }
+
+    NS_LOG_DEBUG("# beams active flows: " << activeUl.size() << ", # sym: " << symAvail);
+
+    GetFirst GetBeamId;
+    GetSecond GetUeVector;
+    BeamSymbolMap symPerBeam = GetSymPerBeam(symAvail, activeUl);
+
+    const std::vector<uint8_t> ulNotchedRBGsMask = GetUlNotchedRbgMask();
+    const uint32_t bandResources =
+        ulNotchedRBGsMask.size() > 0
+            ? std::count(ulNotchedRBGsMask.begin(), ulNotchedRBGsMask.end(), 1)
+            : GetBandwidthInRbg();
+    NS_ASSERT(bandResources > 0);
+
+    for (const auto& el : activeUl)
+    {
+        uint32_t beamSym = symPerBeam.at(GetBeamId(el));
+        uint32_t rbgAssignable = 1 * beamSym;
+        const std::vector<UePtrAndBufferReq>& ueVector = GetUeVector(el);
+        FTResources assigned(0, 0);
+
+        // The buffers of ueVector are the ones reported in the BSR
+        m_ulDppContext.RefreshUl<NrMacSchedulerUeInfoDPP>(ueVector);
+        Time solveTime =
+            NrMacSchedulerUeInfoDPP::LyapunovDppUl(&m_ulDppContext,
+                                                   bandResources,
+                                                   m_ulAmc,
+                                                   GetDppSolver(GetBeamId(el), true),
+                                                   m_dppReferenceSolver);
+        m_dppSolveTimeTrace(ueVector.size(), solveTime);
+
+        for (std::size_t n = 0; n < m_ulDppContext.GetSize(); n++)
+        {
+            const UePtrAndBufferReq& ue = *m_ulDppContext.m_ue[n];
+            auto uePtr = m_ulDppContext.GetUe<NrMacSchedulerUeInfoDPP>(n);
+
+            uePtr->m_ulRBG = rbgAssignable * uePtr->m_ulRBGallocated;
+            assigned.m_rbg += uePtr->m_ulRBG;
+            uePtr->m_ulSym = beamSym;
+            assigned.m_sym = beamSym;
+
+            if (uePtr->m_ulRBG > 0)
+            {
+                NS_LOG_INFO("Assigned " << uePtr->m_ulRBG << " UL RBG, spanned over " << beamSym
+                                        << " SYM, to UE " << uePtr->m_rnti);
+                AssignedUlResources(ue, FTResources(uePtr->m_ulRBG, beamSym), assigned);
+            }
+            else
+            {
+                NotAssignedUlResources(ue, FTResources(0, beamSym), assigned);
+            }
+
+            if (m_enableVirtualQueue)
+            {
+                // Zero resources give a zero throughput, and the queue grows
+                uePtr->UpdateUlTputVirtualQueue(FTResources(uePtr->m_ulRBG, beamSym),
+                                                m_timeSlot,
+                                                m_ulAmc);
+            }
+        }
+    }
+
+    return symPerBeam;
+}
+
 void
 NrMacSchedulerOfdmaDPP::saveTBS(
-    const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq> ueVector)
+    const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector)
 {
-    static bool c = true;
-    if (c)
+    auto traceWriter = NrMacSchedulerDppTraceWriter::Get();
+    if (!traceWriter->IsEnabled(NrMacSchedulerDppTraceWriter::DPP_TBS) ||
+        !traceWriter->Sample(NrMacSchedulerDppTraceWriter::DPP_TBS))
     {
-        outputFileTBS << "time\tue\ttbs\n";
+        return;
     }
-    c = false;
     for (const auto& ue : ueVector)
     {
-        outputFileTBS << Simulator::Now().ToDouble(Time::MS) << "\t" <<  ue.first->m_rnti << "\t" << ue.first->m_dlTbSize.at(0) << "\n";
+        traceWriter->Write(NrMacSchedulerDppTraceWriter::DPP_TBS,
+                           ue.first->m_rnti,
+                           ue.first->m_dlTbSize.at(0));
     }
 }
 void
-NrMacSchedulerOfdmaDPP::UpdateUeDlGfbr(uint16_t rnti,
-                                       uint64_t newGfbr)
+NrMacSchedulerOfdmaDPP::UpdateUeDlGfbr(uint16_t rnti, uint64_t newGfbr)
 {
-    
+    NS_LOG_FUNCTION(this << rnti << newGfbr);
+
     auto it = m_dppUeMap.find(rnti);
+    if (it == m_dppUeMap.end())
+    {
+        NS_LOG_WARN("UE " << rnti << " not found in DPP map");
+        return;
+    }
 
+    it->second->m_dynamicGfbr = newGfbr;
+    NS_LOG_INFO("Updating GFBR for UE " << rnti << " to " << newGfbr << " bps at "
+                                        << Simulator::Now().GetSeconds() << " s");
+}
+
+uint64_t
+NrMacSchedulerOfdmaDPP::GetUeDlGfbr(uint16_t rnti) const
+{
+    auto it = m_dppUeMap.find(rnti);
+    return it != m_dppUeMap.end() ? it->second->m_dynamicGfbr : 0;
+}
+
+void
+NrMacSchedulerOfdmaDPP::UpdateUeDlLcGfbr(uint16_t rnti, uint8_t lcId, uint64_t newGfbr)
+{
+    NS_LOG_FUNCTION(this << rnti << +lcId << newGfbr);
+
+    auto it = m_dppUeMap.find(rnti);
+    if (it == m_dppUeMap.end())
+    {
+        NS_LOG_WARN("UE " << rnti << " not found in DPP map");
+        return;
+    }
+
+    it->second->SetDlLcGfbr(lcId, newGfbr);
+    NS_LOG_INFO("Updating GFBR of LC " << +lcId << " of UE " << rnti << " to " << newGfbr
+                                       << " bps at " << Simulator::Now().GetSeconds() << " s");
+}
+
+void
+NrMacSchedulerOfdmaDPP::UpdateUeUlGfbr(uint16_t rnti, uint64_t newGfbr)
+{
+    NS_LOG_FUNCTION(this << rnti << newGfbr);
+
+    auto it = m_dppUeMap.find(rnti);
     if (it == m_dppUeMap.end())
     {
         NS_LOG_WARN("UE " << rnti << " not found in DPP map");
         return;
     }
 
-    auto uePtr = it->second;
-
-    uePtr->m_dynamicGfbr = newGfbr;
-
-    NS_LOG_INFO("Updating GFBR for UE " << rnti
-                 << " to " << newGfbr << " bps at "
-                 << Simulator::Now().GetSeconds() << " s");
-
-    NS_LOG_UNCOND("[SCHED UPDATE] Time "
-              << Simulator::Now().GetSeconds()
-              << "s | RNTI=" << rnti
-              << " | GFBR set to "
-              << newGfbr / 1e6
-              << " Mbps");
-    std::cout << "UPDATE PTR: " << it->second.get() << std::endl;
-
-//    for (auto & lcgPair : uePtr->m_dlLCG)
-//     {
-//         auto& lcgPtr = lcgPair.second;
-
-//         std::vector<uint8_t> activeLcs = lcgPtr->GetActiveLCIds();
-
-//         for (auto lcId : activeLcs)
-//         {
-//             if (lcgPtr->GetTotalSizeOfLC(lcId) > 0)
-//             {
-//                 auto& lc = lcgPtr->GetLC(lcId);
-//                 lc->m_eRabGuaranteedBitrateDl = newGfbr;
-
-//                 std::cout << "[GFBR WRITE] RNTI=" << rnti
-//                         << " LC=" << unsigned(lcId)
-//                         << " GFBR=" << newGfbr/1e6 << " Mbps"
-//                         << std::endl;
-//             }
-//         }
-//     }
+    it->second->m_dynamicGfbrUl = newGfbr;
+    NS_LOG_INFO("Updating UL GFBR for UE " << rnti << " to " << newGfbr << " bps at "
+                                           << Simulator::Now().GetSeconds() << " s");
 }
+
 void 
 NrMacSchedulerOfdmaDPP::SetTimeSlot(double timeslot)
 {
@@ -62,8 +62,48 @@ class NrMacSchedulerOfdmaDPP : public NrMacSchedulerOfdma
      * @return
      */
     //double GetVlyapunov() const;
+
+    /**
+     * \brief Set the DL GFBR that the virtual queue of a UE tracks
+     * \param rnti the RNTI of the UE
+     * \param newGfbr the GFBR, in bit/s
+     *
+     * It is called at every GFBR update of every UE, e.g., by
+     * NrGfbrScheduleController, so it doesn't write to the console.
+     */
     void UpdateUeDlGfbr(uint16_t rnti, uint64_t newGfbr);
 
+    /**
+     * \brief Get the DL GFBR that the virtual queue of a UE tracks
+     * \param rnti the RNTI of the UE
+     * \return the GFBR, in bit/s, or 0 if the UE is unknown
+     */
+    uint64_t GetUeDlGfbr(uint16_t rnti) const;
+
+    /**
+     * \brief Set the DL GFBR of a LC of a UE, which gets its own virtual queue
+     * \param rnti the RNTI of the UE
+     * \param lcId the LC ID
+     * \param newGfbr the GFBR, in bit/s
+     *
+     * The virtual queue of the UE in the DPP problem is then the sum of those
+     * of its LCs, and NrMacSchedulerLcQos (attribute
+     * NrMacSchedulerNs3::SchedLcAlgorithmType) gives each GBR LC, inside the
+     * TB of the UE, the bytes of its GFBR plus its deficit.
+     *
+     * \see NrMacSchedulerUeInfoDPP::SetDlLcGfbr
+     */
+    void UpdateUeDlLcGfbr(uint16_t rnti, uint8_t lcId, uint64_t newGfbr);
+
+    /**
+     * \brief Set the UL GFBR that the UL virtual queue of a UE tracks
+     * \param rnti the RNTI of the UE
+     * \param newGfbr the GFBR, in bit/s
+     *
+     * Only used when the attribute "EnableUplinkDpp" is true.
+     */
+    void UpdateUeUlGfbr(uint16_t rnti, uint64_t newGfbr);
+
     void SetTimeSlot(double timeslot);
 
     /**
@@ -71,6 +111,32 @@ class NrMacSchedulerOfdmaDPP : public NrMacSchedulerOfdma
      */
     double GetTimeSlot() const;
 
+    /**
+     * \brief Set the type of the solver of the drift-plus-penalty problem
+     * \param type the TypeId of a NrMacSchedulerDppSolver subclass
+     */
+    void SetDppSolverType(const TypeId& type);
+
+    /**
+     * \brief Enable or disable the cross-check against the GLPK reference solver
+     * \param crossCheck true to solve every problem also with NrMacSchedulerDppSolverGlpk
+     */
+    void SetDppSolverCrossCheck(bool crossCheck);
+
+    /**
+     * \brief TracedCallback signature for the time spent solving the DPP problem
+     * \param [in] numUe number of UEs in the problem
+     * \param [in] solveTime wall-clock time spent by the solver
+     */
+    typedef void (*SolveTimeTracedCallback)(uint32_t numUe, Time solveTime);
+
+    /**
+     * \brief TracedCallback signature for the DL RBGs assigned to an UE by the DPP problem
+     * \param [in] rnti the RNTI of the UE
+     * \param [in] rbgs the RBGs assigned to the UE in the slot, per symbol
+     */
+    typedef void (*RbgAllocationTracedCallback)(uint16_t rnti, uint32_t rbgs);
+
   protected:
     /**
      * \brief Create an UE representation of the type NrMacSchedulerUeInfoDPP
@@ -142,7 +208,33 @@ class NrMacSchedulerOfdmaDPP : public NrMacSchedulerOfdma
 
     BeamSymbolMap AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl) const override;
 
-    static void saveTBS(const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq> ueVector);
+    /**
+     * \brief Assign the UL RBGs
+     * \param symAvail available symbols
+     * \param activeUl map of active UL UEs and their beam
+     * \return the symbols assigned to each beam
+     *
+     * With "EnableUplinkDpp", the RBGs of each beam are assigned solving the
+     * drift-plus-penalty problem of the beam with the buffers of the BSR and
+     * the UL virtual queues (see NrMacSchedulerUeInfoDPP::LyapunovDppUl).
+     * Otherwise, as in NrMacSchedulerOfdma.
+     */
+    BeamSymbolMap AssignULRBG(uint32_t symAvail, const ActiveUeMap& activeUl) const override;
+
+    static void saveTBS(const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq>& ueVector);
+
+    /**
+     * \brief Get the DPP solver of a beam, creating it if needed
+     * \param beamConfId the beam
+     * \param uplink whether the solver is the one of the UL problem
+     * \return the solver of the beam
+     *
+     * Each beam and direction has its own solver instance, so that solvers
+     * that keep a model across slots (e.g., NrMacSchedulerDppSolverGlpkWarm)
+     * keep one per beam and direction.
+     */
+    Ptr<NrMacSchedulerDppSolver> GetDppSolver(const BeamConfId& beamConfId,
+                                              bool uplink = false) const;
     
 
   private:
@@ -151,6 +243,17 @@ class NrMacSchedulerOfdmaDPP : public NrMacSchedulerOfdma
     mutable  std::unordered_map<uint16_t,
     std::shared_ptr<NrMacSchedulerUeInfoDPP>> m_dppUeMap;
     double m_timeSlot {1e-3}; // Default value
+    TypeId m_dppSolverType;                    //!< Type of the DPP solver
+    mutable std::unordered_map<BeamConfId, Ptr<NrMacSchedulerDppSolver>, BeamConfIdHash>
+        m_dppSolvers; //!< Solver of the DPP problem of each beam
+    mutable std::unordered_map<BeamConfId, Ptr<NrMacSchedulerDppSolver>, BeamConfIdHash>
+        m_dppUlSolvers; //!< Solver of the UL DPP problem of each beam
+    bool m_enableUplinkDpp{false}; //!< Assign the UL RBGs with the DPP problem
+    Ptr<NrMacSchedulerDppSolver> m_dppReferenceSolver; //!< Cross-check solver (null if disabled)
+    TracedCallback<uint32_t, Time> m_dppSolveTimeTrace; //!< Time spent solving each DPP problem
+    TracedCallback<uint16_t, uint32_t> m_dlRbgAllocationTrace; //!< DL RBGs assigned to each UE
+    mutable NrMacSchedulerDppContext m_dppContext; //!< State of the beam being scheduled
+    mutable NrMacSchedulerDppContext m_ulDppContext; //!< State of the UL beam being scheduled
 };
 
 } // namespace ns3
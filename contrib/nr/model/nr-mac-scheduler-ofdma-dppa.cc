@@ -6,11 +6,12 @@
 
 #include "nr-mac-scheduler-ofdma-dppa.h"
 
+#include "nr-mac-scheduler-dpp-trace-writer.h"
 #include "nr-mac-scheduler-ue-info-dppa.h"
 
 #include <ns3/log.h>
 
-#include <fstream>
+#include <algorithm>
 
 namespace ns3
 {
@@ -72,27 +73,33 @@ NrMacSchedulerOfdmaDPPA::CreateUeRepresentation(
         std::bind(&NrMacSchedulerOfdmaDPPA::GetNumRbPerRbg, this));
 }
 
-void NrMacSchedulerOfdmaDPPA::saveQueuesState(const ns3::NrMacSchedulerNs3::UePtrAndBufferReq ue) const{
-    static std::ofstream outputFileG("queue_g.txt");
-    static std::ofstream outputFileQ("queue_q.txt");
-    static bool c = true;
-    if(c){
-        outputFileG << "time\tue\tg\n";
-        outputFileQ << "time\tue\tq\n"; 
+void NrMacSchedulerOfdmaDPPA::saveQueuesState(const ns3::NrMacSchedulerNs3::UePtrAndBufferReq& ue) const{
+    auto traceWriter = NrMacSchedulerDppTraceWriter::Get();
+    if (traceWriter->IsEnabled(NrMacSchedulerDppTraceWriter::DPPA_G) &&
+        traceWriter->Sample(NrMacSchedulerDppTraceWriter::DPPA_G))
+    {
+        traceWriter->Write(NrMacSchedulerDppTraceWriter::DPPA_G, ue.first->m_rnti, static_cast<NrMacSchedulerUeInfoDPPA*>(ue.first.get())->m_g);
+    }
+    if (traceWriter->IsEnabled(NrMacSchedulerDppTraceWriter::DPPA_Q) &&
+        traceWriter->Sample(NrMacSchedulerDppTraceWriter::DPPA_Q))
+    {
+        traceWriter->Write(NrMacSchedulerDppTraceWriter::DPPA_Q, ue.first->m_rnti, ue.second);
     }
-    c = false;
-    outputFileG << Simulator::Now().ToDouble (Time::MS) << "\t" << ue.first->m_rnti << "\t" << std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPPA>(ue.first)->m_g << "\n";
-    outputFileQ << Simulator::Now().ToDouble (Time::MS) << "\t" <<  ue.first->m_rnti << "\t" << ue.second << "\n";
 }
 
-void NrMacSchedulerOfdmaDPPA::saveRBGallocation(const ns3::NrMacSchedulerNs3::UePtrAndBufferReq ue, const NrMacSchedulerNs3::FTResources& assigned) const{
-    static std::ofstream outputFileAlpha("alpha.txt");
-    static bool c = true;
-    if(c){
-        outputFileAlpha << "time\tue\tresources\tmcs\tULcqi\tULsinr\n";
+void NrMacSchedulerOfdmaDPPA::saveRBGallocation(const ns3::NrMacSchedulerNs3::UePtrAndBufferReq& ue, const NrMacSchedulerNs3::FTResources& assigned) const{
+    auto traceWriter = NrMacSchedulerDppTraceWriter::Get();
+    if (!traceWriter->IsEnabled(NrMacSchedulerDppTraceWriter::DPPA_ALPHA) ||
+        !traceWriter->Sample(NrMacSchedulerDppTraceWriter::DPPA_ALPHA))
+    {
+        return;
     }
-    c = false;
-    outputFileAlpha << Simulator::Now().ToDouble (Time::MS) << "\t" << ue.first->m_rnti << "\t" << assigned.m_rbg << "\t" << (int)ue.first->m_dlMcs.at(0) << "\t" << (ue.first->m_dlCqi.m_wbCqi.size() > 0 ? ue.first->m_dlCqi.m_wbCqi[0] : 0) << "\t" << (ue.first->m_ulCqi.m_sinr.size() > 0 ? ue.first->m_ulCqi.m_sinr[0] : 0) << "\n";
+    traceWriter->Write(NrMacSchedulerDppTraceWriter::DPPA_ALPHA,
+                       ue.first->m_rnti,
+                       assigned.m_rbg,
+                       ue.first->m_dlMcs.at(0),
+                       ue.first->m_dlCqi.m_wbCqi.size() > 0 ? ue.first->m_dlCqi.m_wbCqi[0] : 0,
+                       ue.first->m_ulCqi.m_sinr.size() > 0 ? ue.first->m_ulCqi.m_sinr[0] : 0);
 }
 
 NrMacSchedulerNs3::BeamSymbolMap
@@ -107,6 +114,13 @@ NrMacSchedulerOfdmaDPPA::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activ
     GetSecond GetUeVector;
     BeamSymbolMap symPerBeam = GetSymPerBeam(symAvail, activeDl);
 
+    const std::vector<uint8_t> dlNotchedRBGsMask = GetDlNotchedRbgMask();
+    const uint32_t bandResources =
+        dlNotchedRBGsMask.size() > 0
+            ? std::count(dlNotchedRBGsMask.begin(), dlNotchedRBGsMask.end(), 1)
+            : GetBandwidthInRbg(); // Number of RBGs (OFDMA) available for assignment
+    const double timeSlot = m_macSchedSapUser->GetSlotPeriod().GetNanoSeconds()/1e9;
+
     // Iterate through the different beams
     auto ctr = 0;
     for (const auto& el : activeDl)
@@ -115,24 +129,16 @@ NrMacSchedulerOfdmaDPPA::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activ
         // Distribute the RBG evenly among UEs of the same beam
         uint32_t beamSym = symPerBeam.at(GetBeamId(el)); // Number of symbols available for assignment
         uint32_t rbgAssignable = 1 * beamSym;
-        std::vector<UePtrAndBufferReq> ueVector; // Active UEs, i.e. with data to send
+        const std::vector<UePtrAndBufferReq>& ueVector = GetUeVector(el); // Active UEs, i.e. with data to send
         FTResources assigned(0, 0); // Total number of resources assigned (RBGs, symbols)
-        const std::vector<uint8_t> dlNotchedRBGsMask = GetDlNotchedRbgMask();
-        uint32_t resources = dlNotchedRBGsMask.size() > 0
-                                 ? std::count(dlNotchedRBGsMask.begin(), dlNotchedRBGsMask.end(), 1)
-                                 : GetBandwidthInRbg(); // Number of RBGs (OFDMA) available for assignment
-
-        for (const auto& ue : GetUeVector(el))
-        {
-            ueVector.emplace_back(ue);
-        }
+        uint32_t resources = bandResources;
 
         NS_LOG_INFO("\n------------------------- NEW SLOT -------------------------\n" <<
         "beamSym = " << beamSym << ", rbgAssignable = " << rbgAssignable <<
         ", resources = " << resources << ", ueVector.size() = " << ueVector.size() <<
         "\n------------------------------------------------------------\n");
 
-        for (auto& ue : ueVector)
+        for (const auto& ue : ueVector)
         {
             BeforeDlSched(ue,FTResources(rbgAssignable*resources,beamSym)); // Update the K metric for all the UEs in ueVector. TODO request the FH capacity control the current tput/RBGs constraint
         }
@@ -144,78 +150,49 @@ NrMacSchedulerOfdmaDPPA::AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activ
         NS_LOG_DEBUG("resources = " << resources);
 
         // Llama al scheduler
-        GetFirst GetUe;
-        //std::cout << "ueVector:" << std::endl;
-        for (auto it: ueVector){
-            NS_LOG_INFO("- UE" << it.first->m_rnti);
-            //std::cout << "- UE" << it.first->m_rnti << std::endl;
+        auto& ctx = m_dppContext;
+        ctx.Refresh<NrMacSchedulerUeInfoDPPA>(ueVector);
+        for (std::size_t n = 0; n < ctx.GetSize(); n++){
+            ctx.m_metric[n] = ctx.GetUe<NrMacSchedulerUeInfoDPPA>(n)->m_k;
+            NS_LOG_INFO("- UE" << ctx.m_rnti[n]);
         }
 
-        std::sort(ueVector.begin(), ueVector.end(), GetUeCompareDlFn()); // Sort UEs in ueVector as a function of K from smallest to largest
-
-        NS_LOG_INFO("Llama sort(" << GetUe(*ueVector.begin())->m_rnti << ", " << GetUe(ueVector.back())->m_rnti << ")");
-        NS_LOG_INFO("Usuarios ordenados: ");
-
-        //std::cout << "priority vector:" << std::endl;
-        for (auto it: ueVector){
-            NS_LOG_INFO("- UE" << GetUe(it)->m_rnti);
-            //std::cout << "- UE" << GetUe(it)->m_rnti << std::endl;
-        }
-        
-        // Here the ueVector is sorted by priority, but we need to check if V is sufficiently high that not resources must be allocated
-        auto prio_ue = ueVector.begin(); // UE to whom all resources are assigned a priori
-
         // Assigment:
-        // Assign 1 RBG for each available symbols for the beam,
-        // and then update the count of available resources
-        while (resources > 0 && prio_ue != ueVector.end()){ // As long as there are resources and UEs continue with the assignment
-            if (-m_v_lyapunov*50 >= std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPPA>(GetUe(*prio_ue))->m_k){ // The UE can receive resources
-                NS_LOG_INFO("Priority to UE" << GetUe(*prio_ue)->m_rnti);
-            }else{
-                NS_LOG_INFO("Discard UE" << GetUe(*prio_ue)->m_rnti);
-                break;
-            }
-            // If there are two streams we add the TbSizes of the two streams to satisfy the bufQueueSize
-            uint32_t tbSize = 0;
-            for (const auto& it : GetUe(*prio_ue)->m_dlTbSize)
-            {
-                tbSize += it;
-            }
-            NS_LOG_INFO("Current tbSize is " << tbSize << " and the buffer is " << prio_ue->second);
-            if (prio_ue->second > tbSize){ // Check that the UE has enough data
-                GetUe(*prio_ue)->m_dlRBG += rbgAssignable; // Assign 1 RBG for each available symbols for the beam
-                assigned.m_rbg += rbgAssignable; // Counter of assigned resources
-                GetUe(*prio_ue)->m_dlSym = beamSym; // assign symbols
+        // Assign 1 RBG for each available symbols for the beam, from the
+        // smallest K to the largest, and then update the count of available resources
+        resources = NrMacSchedulerUeInfoDPPA::AssignByK(&ctx,
+                                                        resources,
+                                                        rbgAssignable,
+                                                        -m_v_lyapunov * 50,
+                                                        m_dlAmc);
+        for (std::size_t i = 0; i < ctx.GetSize(); i++){
+            auto uePtr = ctx.GetUe<NrMacSchedulerUeInfoDPPA>(i);
+            if (uePtr->m_dlRBG > 0){
+                uePtr->m_dlSym = beamSym; // assign symbols
+                assigned.m_rbg += uePtr->m_dlRBG; // Counter of assigned resources
                 assigned.m_sym = beamSym; // Counter of assigned resources
-                resources -= 1; // Counter of available resourecs. Resources are RBG (OFDMA), so they do not consider the beamSym
-                // Update metrics
-                AssignedDlResources(*prio_ue, FTResources(rbgAssignable, beamSym), assigned);
-                NS_LOG_INFO("Assigned " << GetUe(*prio_ue)->m_dlRBG << " DL RBG, spanned over " << beamSym
-                                        << " SYM, to UE " << GetUe(*prio_ue)->m_rnti << ", " << resources << " resources remain");
-            }else{
-                prio_ue++; // Go to the next UE in the ueVector
             }
         }
+        NS_LOG_INFO(resources << " resources remain");
 
-        // Update metrics
-        for (auto it: ueVector){
-            if (GetUe(it)->m_dlRBG == 0)
+        // Update metrics, in the order of the beam vector
+        for (std::size_t i = 0; i < ctx.GetSize(); i++){
+            const UePtrAndBufferReq& ue = *ctx.m_ue[i];
+            auto uePtr = ctx.GetUe<NrMacSchedulerUeInfoDPPA>(i);
+            if (uePtr->m_dlRBG == 0)
             {
                 // NS_LOG_FUNCTION(this);
-                NotAssignedDlResources(it,FTResources(GetUe(it)->m_dlRBG, beamSym), assigned); // Update metrics for the UEs without resources
+                NotAssignedDlResources(ue,FTResources(uePtr->m_dlRBG, beamSym), assigned); // Update metrics for the UEs without resources
             }else{
                 // Update G here and not in AssignedDlResources() because we need to call UpdateDlTputVirtualQueue with the full resource assignment
-                auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPPA>(GetUe(it));
                 if(m_enableVirtualQueue)
                 {
-                    double timeSlot = m_macSchedSapUser->GetSlotPeriod().GetNanoSeconds()/1e9;
-                    //std::cout << "SlotPeriod: " << m_macSchedSapUser->GetSlotPeriod().GetNanoSeconds()/1e9 << std::endl;
                     double aux = uePtr->m_g;
-                    uePtr->UpdateDlTputVirtualQueue(FTResources(GetUe(it)->m_dlRBG, beamSym), timeSlot, m_dlAmc);
+                    uePtr->UpdateDlTputVirtualQueue(FTResources(uePtr->m_dlRBG, beamSym), timeSlot, m_dlAmc);
                     NS_LOG_INFO("Virtual queue UE" << uePtr->m_rnti << " updated " << aux << " -> " << uePtr->m_g);
                 }
-                saveRBGallocation(it, FTResources(GetUe(it)->m_dlRBG, beamSym));
-                saveQueuesState(it);
+                saveRBGallocation(ue, FTResources(uePtr->m_dlRBG, beamSym));
+                saveQueuesState(ue);
             }
         }
     }
@@ -228,7 +205,7 @@ NrMacSchedulerOfdmaDPPA::BeforeDlSched(const UePtrAndBufferReq& ue,
                                       const FTResources& assignableInIteration) const
 {
     NS_LOG_FUNCTION(this);
-    auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPPA>(ue.first);
+    auto uePtr = static_cast<NrMacSchedulerUeInfoDPPA*>(ue.first.get());
 
     //  TODO Obtener FH capacity tput constraint
 
@@ -269,7 +246,7 @@ NrMacSchedulerOfdmaDPPA::NotAssignedDlResources(
     [[maybe_unused]] const FTResources& totAssigned) const
 {
     NS_LOG_FUNCTION(this);
-    auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPPA>(ue.first);
+    auto uePtr = static_cast<NrMacSchedulerUeInfoDPPA*>(ue.first.get());
     if(m_enableVirtualQueue)
     {
         //double timeSlot = 1e-3;
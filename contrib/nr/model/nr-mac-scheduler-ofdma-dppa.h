@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "nr-mac-scheduler-dpp-context.h"
 #include "nr-mac-scheduler-ofdma.h"
 
 namespace ns3
@@ -125,14 +126,15 @@ class NrMacSchedulerOfdmaDPPA : public NrMacSchedulerOfdma
 
     BeamSymbolMap AssignDLRBG(uint32_t symAvail, const ActiveUeMap& activeDl) const override;
 
-    void saveQueuesState(const ns3::NrMacSchedulerNs3::UePtrAndBufferReq ue) const;
-    void saveRBGallocation(const ns3::NrMacSchedulerNs3::UePtrAndBufferReq ue, const NrMacSchedulerNs3::FTResources& assigned) const;
+    void saveQueuesState(const ns3::NrMacSchedulerNs3::UePtrAndBufferReq& ue) const;
+    void saveRBGallocation(const ns3::NrMacSchedulerNs3::UePtrAndBufferReq& ue, const NrMacSchedulerNs3::FTResources& assigned) const;
 
   private:
     double m_v_lyapunov; // V config parameter for Lyaponuv drif-plus-penalty
     double m_weight_q; // Weight given to Q
     double m_weight_g; // Weight given to G
     bool m_enableVirtualQueue;
+    mutable NrMacSchedulerDppContext m_dppContext; //!< State of the beam being scheduled
 };
 
 } // namespace ns3
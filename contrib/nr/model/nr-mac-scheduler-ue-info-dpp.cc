@@ -6,32 +6,24 @@
 
 #include "nr-mac-scheduler-ue-info-dpp.h"
 
-#include <ns3/log.h>
+#include "nr-mac-scheduler-dpp-trace-writer.h"
 
-#include <fstream>
+#include <ns3/abort.h>
+#include <ns3/log.h>
 
 #include <chrono>
 
 #include <ctime>
 
-#include <iomanip>
+#include <limits>
 
 namespace ns3
 {
-// At the top of the file:
-std::map<uint16_t, uint32_t> g_intervalAllocatedRBs;
 
 NS_LOG_COMPONENT_DEFINE("NrMacSchedulerUeInfoDPP");
 
 double NrMacSchedulerUeInfoDPP::m_v_lyapunov = 5.1e6;
 
-std::ofstream outputFileG("g.txt");
-std::ofstream outputFileQ("q.txt");
-std::ofstream outputFileAlpha("alpha.txt");
-
-static std::ofstream qosFile("qos_trace.csv");
-static bool qosHeaderWritten = false;
-
 
 
 
@@ -43,7 +35,7 @@ NrMacSchedulerUeInfoDPP::UpdateDlTputVirtualQueue(const NrMacSchedulerNs3::FTRes
     NS_LOG_FUNCTION(this);
     NS_LOG_DEBUG("amc->CalculateTbSize(mcs), nprb) = " << amc->CalculateTbSize(m_dlMcs.at(0), assigned.m_rbg*GetNumRbPerRbg()));
 
-    NrMacSchedulerUeInfo::UpdateDlMetric(amc); // Actualiza m_dlTbSize
+    UpdateDlMetric(amc); // Actualiza m_dlTbSize
     uint32_t tbSize = 0;
     for (const auto& it : m_dlTbSize)
     {
@@ -83,11 +75,34 @@ NrMacSchedulerUeInfoDPP::UpdateDlTputVirtualQueue(const NrMacSchedulerNs3::FTRes
     
     // avg_gfbr = gfbr/i;
     double avg_gfbr = static_cast<double>(m_dynamicGfbr);
+    if (m_numLcQueues > 0)
+    {
+        // The LC queues receive their GFBR now, and are served in
+        // DlLcBytesAssigned with the bytes that the LC algorithm gives them.
+        // A LC with nothing to send has no deficit: its queue is emptied
+        avg_gfbr = 0.0;
+        for (uint8_t i = 0; i < m_numLcQueues; ++i)
+        {
+            LcVirtualQueue& queue = m_lcQueues[i];
+            if (GetDlLcBytes(queue.m_lcId) > 0)
+            {
+                queue.m_g += queue.m_gfbr;
+                avg_gfbr += queue.m_gfbr;
+            }
+            else
+            {
+                queue.m_g = 0.0;
+            }
+        }
+        SumDlLcQueues();
+    }
+    else
+    {
+        m_g = std::max(m_g + avg_gfbr - m_currTputDl, 0.0);
+    }
     NS_LOG_DEBUG("UE" << m_rnti << " - AVRG_GFBR = " << avg_gfbr);
-
-    m_g = std::max(m_g + avg_gfbr - m_currTputDl, 0.0);
     NS_LOG_DEBUG("m_currTputDl = " << m_currTputDl << ", G de rnti " << m_rnti << " actualizada a " << m_g);
-    NS_LOG_UNCOND("[DPP STATE] Time "
+    NS_LOG_DEBUG("[DPP STATE] Time "
               << Simulator::Now().GetSeconds()
               << "s | UE "
               << m_rnti
@@ -106,143 +121,303 @@ NrMacSchedulerUeInfoDPP::UpdateDlTputVirtualQueue(const NrMacSchedulerNs3::FTRes
     //           << std::endl;
     // }
 
-        if (!qosHeaderWritten)
+    auto traceWriter = NrMacSchedulerDppTraceWriter::Get();
+    if (traceWriter->IsEnabled(NrMacSchedulerDppTraceWriter::DPP_QOS) &&
+        traceWriter->Sample(NrMacSchedulerDppTraceWriter::DPP_QOS))
     {
-        qosFile << "time,rnti,throughput_mbps,gfbr_mbps,g\n";
-        qosHeaderWritten = true;
+        traceWriter->Write(NrMacSchedulerDppTraceWriter::DPP_QOS,
+                           m_rnti,
+                           m_currTputDl / 1e6,
+                           avg_gfbr,
+                           m_g);
     }
+}
 
-    // // Avoid division by zero
-    // double avg_gfbr_mbps = 0.0;
-    // if (i > 0)
-    // {
-    //     avg_gfbr_mbps = (double)avg_gfbr / 1e6;
-    // }
+void
+NrMacSchedulerUeInfoDPP::UpdateDlMetric(const Ptr<const NrAmc>& amc)
+{
+    NrMacSchedulerUeInfo::UpdateDlMetric(amc);
+    if (m_dlRBG > 0 && !m_dlRbgMask.empty())
+    {
+        m_dlTbSize.at(0) = amc->CalculateTbSize(m_dlSlotMcs, m_dlRBG * GetNumRbPerRbg());
+    }
+}
 
-    qosFile << std::fixed << std::setprecision(6)
-            << Simulator::Now().GetSeconds() << ","
-            << m_rnti << ","
-            << m_currTputDl / 1e6 << ","
-            << avg_gfbr << ","
-            << m_g
-            << "\n";
+std::vector<uint8_t>
+NrMacSchedulerUeInfoDPP::GetDlSlotMcs() const
+{
+    std::vector<uint8_t> mcs = m_dlMcs;
+    if (m_dlRBGallocated > 0 && !m_dlRbgMask.empty())
+    {
+        mcs.at(0) = m_dlSlotMcs;
+    }
+    return mcs;
+}
 
-    qosFile.flush();
+void
+NrMacSchedulerUeInfoDPP::SetDlLcGfbr(uint8_t lcId, uint64_t gfbr)
+{
+    NS_LOG_FUNCTION(this << +lcId << gfbr);
+    for (uint8_t i = 0; i < m_numLcQueues; ++i)
+    {
+        if (m_lcQueues[i].m_lcId == lcId)
+        {
+            m_lcQueues[i].m_gfbr = gfbr;
+            return;
+        }
+    }
+    NS_ABORT_MSG_IF(m_numLcQueues == MAX_LC_QUEUES,
+                    "UE " << m_rnti << " has already " << +MAX_LC_QUEUES << " LC virtual queues");
+    m_lcQueues[m_numLcQueues++] = {lcId, gfbr, 0.0};
+    // From now on m_g is the sum of the LC queues
+    SumDlLcQueues();
+}
+
+uint64_t
+NrMacSchedulerUeInfoDPP::GetDlLcGuaranteedBitRate(uint8_t lcId, uint64_t gbr) const
+{
+    for (uint8_t i = 0; i < m_numLcQueues; ++i)
+    {
+        if (m_lcQueues[i].m_lcId == lcId)
+        {
+            // The GFBR is already in m_g, since UpdateDlTputVirtualQueue
+            return static_cast<uint64_t>(m_lcQueues[i].m_g);
+        }
+    }
+    return gbr;
 }
 
-void NrMacSchedulerUeInfoDPP::saveQueuesState(const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq> ueVector){
-    static bool c = true;
-    if(c){
-        outputFileG << "time\tue\tg\n";
-        outputFileQ << "time\tue\tq\n"; 
+void
+NrMacSchedulerUeInfoDPP::DlLcBytesAssigned(uint8_t lcId, uint32_t bytes, Time slotPeriod)
+{
+    NS_LOG_FUNCTION(this << +lcId << bytes);
+    if (m_numLcQueues == 0)
+    {
+        return;
     }
-    c = false;
-    for(const auto& ue: ueVector){
-        outputFileG << Simulator::Now().ToDouble (Time::MS) << "\t" << ue.first->m_rnti << "\t" << std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPP>(ue.first)->m_g << "\n";
-        outputFileQ << Simulator::Now().ToDouble (Time::MS) << "\t" <<  ue.first->m_rnti << "\t" << ue.second << "\n";
+    for (uint8_t i = 0; i < m_numLcQueues; ++i)
+    {
+        LcVirtualQueue& queue = m_lcQueues[i];
+        if (queue.m_lcId == lcId)
+        {
+            queue.m_g = std::max(queue.m_g - bytes * 8 / slotPeriod.GetSeconds(), 0.0);
+            NS_LOG_DEBUG("G of LC " << +lcId << " of rnti " << m_rnti << " updated to "
+                                    << queue.m_g);
+        }
     }
+    SumDlLcQueues();
 }
 
-void NrMacSchedulerUeInfoDPP::saveRBGallocation(const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq> ueVector){
-    static bool c = true;
-    if(c){
-        outputFileAlpha << "time\tUE\tresources\n";
+uint32_t
+NrMacSchedulerUeInfoDPP::GetDlLcBytes(uint8_t lcId) const
+{
+    for (const auto& lcg : m_dlLCG)
+    {
+        if (lcg.second->Contains(lcId))
+        {
+            return lcg.second->GetTotalSizeOfLC(lcId);
+        }
     }
-    c = false;
-    for(const auto& ue: ueVector){
-        auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPP>(ue.first);
+    return 0;
+}
 
-        outputFileAlpha << Simulator::Now().ToDouble (Time::MS) << "\t" << ue.first->m_rnti << "\t" << std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPP>(ue.first)->m_dlRBGallocated << "\n";
-        // 2. NEW: Send the RBGs to the main script's CSV too!
-        g_intervalAllocatedRBs[ue.first->m_rnti] += uePtr->m_dlRBGallocated;
-    
+void
+NrMacSchedulerUeInfoDPP::SumDlLcQueues()
+{
+    m_g = 0.0;
+    for (uint8_t i = 0; i < m_numLcQueues; ++i)
+    {
+        m_g += m_lcQueues[i].m_g;
     }
 }
 
-void NrMacSchedulerUeInfoDPP::LyapunovDPP(const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq> ueVector, double resources, const Ptr<const NrAmc>& amc)
+void
+NrMacSchedulerUeInfoDPP::UpdateUlTputVirtualQueue(const NrMacSchedulerNs3::FTResources& assigned,
+                                                  double timeSlot,
+                                                  const Ptr<const NrAmc>& amc)
 {
-    std::vector<std::shared_ptr<NrMacSchedulerUeInfoDPP>> uePtrContainer;
-    for (const auto& ue : ueVector){
-        auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoDPP>(ue.first);
-        if (uePtr) {
-            NS_LOG_DEBUG("rnti = " << uePtr->m_rnti);
-            uePtrContainer.push_back(uePtr);
-        }
+    NS_LOG_FUNCTION(this);
+
+    NrMacSchedulerUeInfo::UpdateUlMetric(amc); // Actualiza m_ulTbSize
+    m_currTputUl = static_cast<double>(m_ulTbSize) * 8 / timeSlot;
+    NS_LOG_DEBUG("tbSize = " << m_ulTbSize << ", m_sym = " << static_cast<double>(assigned.m_sym)
+                             << ", assigned.m_rbg = " << assigned.m_rbg);
+
+    double gfbr = static_cast<double>(m_dynamicGfbrUl);
+    m_gUl = std::max(m_gUl + gfbr - m_currTputUl, 0.0);
+    NS_LOG_DEBUG("m_currTputUl = " << m_currTputUl << ", UL G de rnti " << m_rnti
+                                   << " actualizada a " << m_gUl);
+
+    auto traceWriter = NrMacSchedulerDppTraceWriter::Get();
+    if (traceWriter->IsEnabled(NrMacSchedulerDppTraceWriter::DPP_UL_QOS) &&
+        traceWriter->Sample(NrMacSchedulerDppTraceWriter::DPP_UL_QOS))
+    {
+        traceWriter->Write(NrMacSchedulerDppTraceWriter::DPP_UL_QOS,
+                           m_rnti,
+                           m_currTputUl / 1e6,
+                           gfbr,
+                           m_gUl);
     }
-    
-    saveQueuesState(ueVector);
+}
 
-    // Parámetros del problema
-    int N = ueVector.size();
-    double gamma = std::numeric_limits<double>::infinity(); // TODO constraint FH capacity
-    
-    /* Crear un objeto de problema LP */
-    glp_prob *lp;
-    lp = glp_create_prob();
-    glp_set_prob_name(lp, "Drift_plus_penalty");
-    glp_set_obj_dir(lp, GLP_MIN);
-
-    // Añadir columnas para las variables de decisión
-    glp_add_cols(lp, N);
-    for (int n = 1; n <= N; n++) {
-        glp_set_col_name(lp, n, ("alpha_" + std::to_string(n)).c_str());
-        glp_set_col_kind(lp, n, GLP_CV);
-        glp_set_col_bnds(lp, n, GLP_LO, 0.0, 0.0);
-        //glp_set_col_bnds(lp, n, GLP_DB, 0.0, resources);
-
-        NS_ASSERT_MSG(uePtrContainer[n-1]->m_dlMcs.size() == 1, "Multiple streams not supported");
-        glp_set_obj_coef(lp, n, (m_v_lyapunov
-                                -amc->CalculateTbSize(uePtrContainer[n-1]->m_dlMcs.at(0), resources)
-                                *(ueVector[n-1].second+uePtrContainer[n-1]->m_g)));
-    }
-
-    // Rows for constraints
-    glp_add_rows(lp, 2);
-    glp_set_row_name(lp, 1, "con1");
-    glp_set_row_bnds(lp, 1, GLP_UP, 0.0, resources);
-    glp_set_row_name(lp, 2, "con2");
-    glp_set_row_bnds(lp, 2, GLP_UP, 0.0, gamma);
-
-    glp_set_obj_name(lp, "obj");
-
-    int *ia = (int*)malloc((1 + 2*N) * sizeof(int));
-    int *ja = (int*)malloc((1 + 2*N) * sizeof(int));
-    double *ar = (double*)malloc((1 + 2*N) * sizeof(double));
-    int count = 1;
-    for (int i = 1; i < 3; i++) {
-        for (int j = 1; j <= N; j++) {
-            ia[count] = i;
-            ja[count] = j;
-            ar[count] = 1;
-            count++;
+void NrMacSchedulerUeInfoDPP::saveQueuesState(const NrMacSchedulerDppContext& ctx){
+    auto traceWriter = NrMacSchedulerDppTraceWriter::Get();
+    bool saveG = traceWriter->IsEnabled(NrMacSchedulerDppTraceWriter::DPP_G) &&
+                 traceWriter->Sample(NrMacSchedulerDppTraceWriter::DPP_G);
+    bool saveQ = traceWriter->IsEnabled(NrMacSchedulerDppTraceWriter::DPP_Q) &&
+                 traceWriter->Sample(NrMacSchedulerDppTraceWriter::DPP_Q);
+    if (!saveG && !saveQ)
+    {
+        return;
+    }
+    for (std::size_t n = 0; n < ctx.GetSize(); n++){
+        if (saveG)
+        {
+            traceWriter->Write(NrMacSchedulerDppTraceWriter::DPP_G, ctx.m_rnti[n], ctx.m_g[n]);
+        }
+        if (saveQ)
+        {
+            traceWriter->Write(NrMacSchedulerDppTraceWriter::DPP_Q, ctx.m_rnti[n], ctx.m_buffer[n]);
         }
     }
+}
 
-    glp_load_matrix(lp, 2*N, ia, ja, ar);
-    free(ia);
-    free(ja);
-    free(ar);
+void NrMacSchedulerUeInfoDPP::saveRBGallocation(const NrMacSchedulerDppContext& ctx){
+    auto traceWriter = NrMacSchedulerDppTraceWriter::Get();
+    bool saveAlpha = traceWriter->IsEnabled(NrMacSchedulerDppTraceWriter::DPP_ALPHA) &&
+                     traceWriter->Sample(NrMacSchedulerDppTraceWriter::DPP_ALPHA);
+    if (!saveAlpha)
+    {
+        return;
+    }
+    for (std::size_t n = 0; n < ctx.GetSize(); n++){
+        uint32_t allocated = ctx.GetUe<NrMacSchedulerUeInfoDPP>(n)->m_dlRBGallocated;
+        traceWriter->Write(NrMacSchedulerDppTraceWriter::DPP_ALPHA, ctx.m_rnti[n], allocated);
+    }
+}
+
+Time NrMacSchedulerUeInfoDPP::SolveDpp(NrMacSchedulerDppContext* ctx, double resources, const Ptr<const NrAmc>& amc, const Ptr<NrMacSchedulerDppSolver>& solver, const Ptr<NrMacSchedulerDppSolver>& referenceSolver)
+{
+    // Parámetros del problema
+    std::size_t N = ctx->GetSize();
+    NrMacSchedulerDppSolver::Problem& problem = ctx->m_problem;
+    problem.m_rbgBudget = resources;
+    problem.m_fhBudget = std::numeric_limits<double>::infinity(); // TODO constraint FH capacity
+    problem.m_cost.resize(N);
+    for (std::size_t n = 0; n < N; n++) {
+        NS_LOG_DEBUG("rnti = " << ctx->m_rnti[n]);
+        ctx->m_tbs[n] = amc->CalculateTbSize(ctx->m_mcs[n], resources);
+        problem.m_cost[n] = m_v_lyapunov - ctx->m_tbs[n] * (ctx->m_buffer[n] + ctx->m_g[n]);
+    }
 
     // Solve problem
-    glp_term_out(GLP_OFF);
-    glp_simplex(lp, NULL);
-    glp_intopt(lp, NULL);
+    auto solveStart = std::chrono::steady_clock::now();
+    solver->Solve(problem, &ctx->m_alpha);
+    Time solveTime = NanoSeconds(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - solveStart)
+                                     .count());
+
+    if (referenceSolver != nullptr)
+    {
+        referenceSolver->Solve(problem, &ctx->m_reference);
+        NS_ABORT_MSG_UNLESS(NrMacSchedulerDppSolver::IsEquivalent(problem, ctx->m_alpha, ctx->m_reference),
+                            "DPP solver " << solver->GetInstanceTypeId().GetName()
+                                          << " disagrees with "
+                                          << referenceSolver->GetInstanceTypeId().GetName()
+                                          << ": objective "
+                                          << NrMacSchedulerDppSolver::GetObjective(problem, ctx->m_alpha)
+                                          << " vs "
+                                          << NrMacSchedulerDppSolver::GetObjective(problem, ctx->m_reference));
+    }
+    return solveTime;
+}
+
+Time NrMacSchedulerUeInfoDPP::LyapunovDPP(NrMacSchedulerDppContext* ctx, double resources, const Ptr<const NrAmc>& amc, const Ptr<NrMacSchedulerDppSolver>& solver, const Ptr<NrMacSchedulerDppSolver>& referenceSolver)
+{
+    saveQueuesState(*ctx);
+
+    for (std::size_t n = 0; n < ctx->GetSize(); n++) {
+        NS_ASSERT_MSG(ctx->GetUe<NrMacSchedulerUeInfoDPP>(n)->m_dlMcs.size() == 1, "Multiple streams not supported");
+    }
+    Time solveTime = SolveDpp(ctx, resources, amc, solver, referenceSolver);
 
     // Solution
-    // printf("Objective Value: %f\n", glp_get_obj_val(lp));
-    std::vector<uint32_t> alpha;
+    for (std::size_t n = 0; n < ctx->GetSize(); n++) {
+        auto uePtr = ctx->GetUe<NrMacSchedulerUeInfoDPP>(n);
+        uePtr->m_dlRBGallocated = ctx->m_alpha[n];
+        NS_LOG_DEBUG("Sol. UE" << uePtr->m_rnti << " = " << uePtr->m_dlRBGallocated);
+    }
+
+    // Print decision
+    saveRBGallocation(*ctx);
+
+    return solveTime;
+}
+
+Time NrMacSchedulerUeInfoDPP::LyapunovDppUl(NrMacSchedulerDppContext* ctx, double resources, const Ptr<const NrAmc>& amc, const Ptr<NrMacSchedulerDppSolver>& solver, const Ptr<NrMacSchedulerDppSolver>& referenceSolver)
+{
+    Time solveTime = SolveDpp(ctx, resources, amc, solver, referenceSolver);
+
+    for (std::size_t n = 0; n < ctx->GetSize(); n++) {
+        auto uePtr = ctx->GetUe<NrMacSchedulerUeInfoDPP>(n);
+        uePtr->m_ulRBGallocated = ctx->m_alpha[n];
+        NS_LOG_DEBUG("UL sol. UE" << uePtr->m_rnti << " = " << uePtr->m_ulRBGallocated);
+    }
 
-    for (int n = 1; n <= N; n++) {
-        uePtrContainer[n-1]->m_dlRBGallocated = glp_get_col_prim(lp, n);
-        alpha.emplace_back(glp_get_col_prim(lp, n));
-        NS_LOG_DEBUG("Sol. UE" << uePtrContainer[n-1]->m_rnti << " = " << uePtrContainer[n-1]->m_dlRBGallocated);
+    return solveTime;
+}
+
+void NrMacSchedulerUeInfoDPP::LyapunovDppPerRbg(NrMacSchedulerDppContext* ctx, const std::vector<uint8_t>& rbgMask, const Ptr<const NrAmc>& amc)
+{
+    saveQueuesState(*ctx);
+
+    const std::size_t N = ctx->GetSize();
+    const uint32_t K = ctx->m_numRbg;
+    NS_ASSERT(ctx->m_rbgMcs.size() == N * K);
+    NS_ASSERT(rbgMask.empty() || rbgMask.size() == K);
+    const uint32_t resources =
+        rbgMask.empty() ? K : std::count(rbgMask.begin(), rbgMask.end(), 1);
+
+    ctx->m_rbgOwner.assign(K, -1);
+    for (uint32_t k = 0; k < K; k++) {
+        if (!rbgMask.empty() && rbgMask[k] == 0) {
+            continue;
+        }
+        double bestCost = 0.0;
+        for (std::size_t n = 0; n < N; n++) {
+            double cost = m_v_lyapunov - amc->CalculateTbSize(ctx->m_rbgMcs[n * K + k], resources) *
+                                             (ctx->m_buffer[n] + ctx->m_g[n]);
+            if (cost < bestCost) {
+                bestCost = cost;
+                ctx->m_rbgOwner[k] = n;
+            }
+        }
+    }
+
+    // Solution
+    for (std::size_t n = 0; n < N; n++) {
+        auto uePtr = ctx->GetUe<NrMacSchedulerUeInfoDPP>(n);
+        uePtr->m_dlRBGallocated = 0;
+        uePtr->m_dlRbgMask.assign(K, 0);
+        uePtr->m_dlSlotMcs = UINT8_MAX;
+    }
+    for (uint32_t k = 0; k < K; k++) {
+        if (ctx->m_rbgOwner[k] < 0) {
+            continue;
+        }
+        auto uePtr = ctx->GetUe<NrMacSchedulerUeInfoDPP>(ctx->m_rbgOwner[k]);
+        uePtr->m_dlRBGallocated++;
+        uePtr->m_dlRbgMask[k] = 1;
+        uePtr->m_dlSlotMcs = std::min(uePtr->m_dlSlotMcs, ctx->m_rbgMcs[ctx->m_rbgOwner[k] * K + k]);
+    }
+    for (std::size_t n = 0; n < N; n++) {
+        auto uePtr = ctx->GetUe<NrMacSchedulerUeInfoDPP>(n);
+        NS_LOG_DEBUG("Sol. UE" << uePtr->m_rnti << " = " << uePtr->m_dlRBGallocated << " RBGs, MCS "
+                               << +uePtr->m_dlSlotMcs);
     }
 
     // Print decision
-    saveRBGallocation(ueVector);
-    
-    // Free
-    glp_delete_prob(lp);
+    saveRBGallocation(*ctx);
 }
 
 bool NrMacSchedulerUeInfoDPP::CompareUeWeightsDl(const NrMacSchedulerNs3::UePtrAndBufferReq& lue, const NrMacSchedulerNs3::UePtrAndBufferReq& rue)
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include "nr-mac-scheduler-dpp-context.h"
+#include "nr-mac-scheduler-dpp-solver.h"
 #include "nr-mac-scheduler-ns3.h"
-#include <glpk.h>
+
+#include <array>
 
 namespace ns3
 {
@@ -45,15 +48,41 @@ class NrMacSchedulerUeInfoDPP : public NrMacSchedulerUeInfo
     /**
      * \brief Reset DL scheduler info
      *
-     * Zeroes the average throughput as well as the current throughput.
+     * Zeroes the average throughput as well as the current throughput, and
+     * forgets the RBGs of the frequency-selective scheduler.
      *
      * It calls also NrMacSchedulerUeInfoQos::ResetDlSchedInfo.
      */
     void ResetDlSchedInfo() override
     {
         m_currTputDl = 0.0;
+        m_dlRbgMask.clear();
         NrMacSchedulerUeInfo::ResetDlSchedInfo();
     }
+
+    /**
+     * \brief Update the DL TB sizes, with the MCS of GetDlSlotMcs
+     * \param amc a pointer to the AMC
+     */
+    void UpdateDlMetric(const Ptr<const NrAmc>& amc) override;
+
+    /**
+     * \brief Get the DL MCS of the TB of this slot
+     * \return m_dlMcs, with the MCS of the RBGs chosen by the frequency-selective
+     * scheduler (m_dlSlotMcs) in the first stream, if it chose them
+     */
+    std::vector<uint8_t> GetDlSlotMcs() const;
+
+    /**
+     * \brief Reset UL scheduler info
+     *
+     * Zeroes the UL current throughput, and calls NrMacSchedulerUeInfo::ResetUlSchedInfo.
+     */
+    void ResetUlSchedInfo() override
+    {
+        m_currTputUl = 0.0;
+        NrMacSchedulerUeInfo::ResetUlSchedInfo();
+    }
     
     /**
      * \brief Update metrics for downlink
@@ -68,7 +97,125 @@ class NrMacSchedulerUeInfoDPP : public NrMacSchedulerUeInfo
                         double timeSlot,
                         const Ptr<const NrAmc>& amc);
 
-    static void LyapunovDPP(const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq> ueVector, double resources, const Ptr<const NrAmc>& amc);
+    /**
+     * \brief Set the DL GFBR of a LC, and give it its own virtual queue
+     * \param lcId the LC ID
+     * \param gfbr the GFBR, in bit/s
+     *
+     * Once a LC has its own virtual queue, the virtual queue of the UE (m_g)
+     * is the sum of those of its LCs, and m_dynamicGfbr is not used. At most
+     * MAX_LC_QUEUES LCs of a UE can have one. A LC queue grows by the GFBR only
+     * in the slots in which the LC has data to send; the queue of an idle LC
+     * is emptied.
+     */
+    void SetDlLcGfbr(uint8_t lcId, uint64_t gfbr);
+
+    /**
+     * \brief Get the DL bit rate that a GBR LC has to receive in this slot
+     * \param lcId the LC ID
+     * \param gbr the ERAB guaranteed bit rate of the LC
+     * \return the GFBR plus the deficit of the LC virtual queue, or gbr if the LC has none
+     */
+    uint64_t GetDlLcGuaranteedBitRate(uint8_t lcId, uint64_t gbr) const override;
+
+    /**
+     * \brief Serve the virtual queue of a LC with the bytes assigned to it
+     * \param lcId the LC ID
+     * \param bytes the bytes assigned to the LC
+     * \param slotPeriod the slot period
+     */
+    void DlLcBytesAssigned(uint8_t lcId, uint32_t bytes, Time slotPeriod) override;
+
+    /**
+     * \brief Get the bytes that a DL LC has to transmit
+     * \param lcId the LC ID
+     * \return the bytes in the RLC queues of the LC, or 0 if the UE has no such LC
+     */
+    uint32_t GetDlLcBytes(uint8_t lcId) const;
+
+    /**
+     * \brief Set the virtual queue of the UE (m_g) to the sum of its LC queues
+     */
+    void SumDlLcQueues();
+
+    /**
+     * \brief Update the UL throughput and the UL virtual queue
+     * \param assigned the resources assigned
+     * \param timeSlot the slot duration, in seconds
+     * \param amc a pointer to the UL AMC
+     *
+     * The same update of UpdateDlTputVirtualQueue, with the UL TB size and
+     * the UL GFBR (m_dynamicGfbrUl).
+     */
+    void UpdateUlTputVirtualQueue(const NrMacSchedulerNs3::FTResources& assigned,
+                                  double timeSlot,
+                                  const Ptr<const NrAmc>& amc);
+
+    /**
+     * \brief Solve the drift-plus-penalty problem of one beam and store the
+     * result in m_dlRBGallocated
+     * \param ctx the context, loaded with the active UEs of the beam; on return
+     * it holds the TB sizes, the costs and the solution of the problem
+     * \param resources the RBGs available
+     * \param amc a pointer to the AMC
+     * \param solver the solver of the DPP problem
+     * \param referenceSolver if not null, a second solver whose solution must match
+     * the one of solver (the simulation aborts otherwise)
+     * \return the wall-clock time spent by solver
+     */
+    static Time LyapunovDPP(NrMacSchedulerDppContext* ctx,
+                            double resources,
+                            const Ptr<const NrAmc>& amc,
+                            const Ptr<NrMacSchedulerDppSolver>& solver,
+                            const Ptr<NrMacSchedulerDppSolver>& referenceSolver);
+
+    /**
+     * \brief Solve the UL drift-plus-penalty problem of one beam and store the
+     * result in m_ulRBGallocated
+     * \param ctx the context, loaded with RefreshUl(); on return it holds the
+     * TB sizes, the costs and the solution of the problem
+     * \param resources the RBGs available
+     * \param amc a pointer to the UL AMC
+     * \param solver the solver of the DPP problem
+     * \param referenceSolver if not null, a second solver whose solution must match
+     * the one of solver (the simulation aborts otherwise)
+     * \return the wall-clock time spent by solver
+     *
+     * The problem is the one of LyapunovDPP, with the buffers of the BSR, the
+     * UL MCS and the UL virtual queues.
+     */
+    static Time LyapunovDppUl(NrMacSchedulerDppContext* ctx,
+                              double resources,
+                              const Ptr<const NrAmc>& amc,
+                              const Ptr<NrMacSchedulerDppSolver>& solver,
+                              const Ptr<NrMacSchedulerDppSolver>& referenceSolver);
+
+    /**
+     * \brief Solve the drift-plus-penalty problem of one beam RBG by RBG, and
+     * store the result in m_dlRBGallocated, m_dlRbgMask and m_dlSlotMcs
+     * \param ctx the context, loaded with the active UEs of the beam and with
+     * their MCS in each RBG (see NrMacSchedulerDppContext::RefreshRbgMcs); on
+     * return m_rbgOwner holds the UE of each RBG
+     * \param rbgMask the RBGs that can be assigned (empty for all of them)
+     * \param amc a pointer to the AMC
+     *
+     * The cost of giving RBG k to UE n is that of one RBG in LyapunovDPP, with
+     * the MCS of the UE in that RBG: V - TBS(mcs_nk, R) (q_n + g_n), where R is
+     * the number of RBGs that can be assigned. Without further constraints
+     * the problem separates by RBG, so the optimum gives each RBG to the UE
+     * with the lowest cost, if negative; with the same MCS in all the RBGs it
+     * is the solution of LyapunovDPP. A TB has a single MCS, so the UE
+     * transmits with the lowest MCS of its RBGs (m_dlSlotMcs).
+     *
+     * The price of an RBG does not see the lowest MCS: an RBG with an MCS
+     * lower than that of the other RBGs of the UE also lowers their rate, so
+     * the allocation can overestimate the rate of a UE with a selective
+     * channel. The virtual queues are updated with the TB that is sent, with
+     * m_dlSlotMcs, so the next slots compensate for it.
+     */
+    static void LyapunovDppPerRbg(NrMacSchedulerDppContext* ctx,
+                                  const std::vector<uint8_t>& rbgMask,
+                                  const Ptr<const NrAmc>& amc);
 
     /**
      * \brief comparison function object (i.e. an object that satisfies the
@@ -109,16 +256,54 @@ class NrMacSchedulerUeInfoDPP : public NrMacSchedulerUeInfo
      * \brief Function to save simulation results to a file
     */
     static void saveResultsToFile(const std::vector<uint32_t>& simulationResults, std::ofstream& file);
-    static void saveQueuesState(const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq> ueVector);
-    static void saveRBGallocation(const std::vector<ns3::NrMacSchedulerNs3::UePtrAndBufferReq> ueVector);
+    static void saveQueuesState(const NrMacSchedulerDppContext& ctx);
+    static void saveRBGallocation(const NrMacSchedulerDppContext& ctx);
+
+    /**
+     * \brief Build and solve the problem loaded in a context
+     * \param ctx the context
+     * \param resources the RBGs available
+     * \param amc a pointer to the AMC of the direction
+     * \param solver the solver of the DPP problem
+     * \param referenceSolver if not null, the cross-check solver
+     * \return the wall-clock time spent by solver
+     *
+     * On return ctx->m_alpha holds the RBGs of each entry.
+     */
+    static Time SolveDpp(NrMacSchedulerDppContext* ctx,
+                         double resources,
+                         const Ptr<const NrAmc>& amc,
+                         const Ptr<NrMacSchedulerDppSolver>& solver,
+                         const Ptr<NrMacSchedulerDppSolver>& referenceSolver);
 
     double m_currTputDl{0.0};      //!< Current slot throughput in downlink
                                    //!< (can be a symbol or a RBG)
     double m_g{0.0}; //!<  Virtual queues
     uint32_t m_dlRBGallocated{0}; //!< RBGs assigned by the scheduler
+    std::vector<uint8_t> m_dlRbgMask; //!< RBGs assigned by the frequency-selective scheduler
+    uint8_t m_dlSlotMcs{0};           //!< MCS of the RBGs assigned by the frequency-selective scheduler
     static double m_v_lyapunov; //!<  V config parameter for Lyaponuv drif-plus-penalty
     uint64_t m_dynamicGfbr{0};
 
+    /**
+     * \brief Virtual queue of the GFBR of a LC
+     */
+    struct LcVirtualQueue
+    {
+        uint8_t m_lcId{0};   //!< LC ID
+        uint64_t m_gfbr{0};  //!< GFBR, in bit/s
+        double m_g{0.0};     //!< Virtual queue (deficit, in bit/s)
+    };
+
+    static constexpr uint8_t MAX_LC_QUEUES = 4;           //!< LC virtual queues of a UE
+    std::array<LcVirtualQueue, MAX_LC_QUEUES> m_lcQueues; //!< LC virtual queues
+    uint8_t m_numLcQueues{0};                             //!< LC virtual queues in use
+
+    double m_currTputUl{0.0};      //!< Current slot throughput in uplink
+    double m_gUl{0.0};             //!< UL virtual queue
+    uint32_t m_ulRBGallocated{0};  //!< UL RBGs assigned by the scheduler
+    uint64_t m_dynamicGfbrUl{0};   //!< UL GFBR, in bit/s
+
     
 };
 } // namespace ns3
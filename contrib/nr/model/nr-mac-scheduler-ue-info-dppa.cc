@@ -8,6 +8,8 @@
 
 #include <ns3/log.h>
 
+#include <algorithm>
+
 #include <fstream>
 
 #include <chrono>
@@ -101,4 +103,68 @@ bool NrMacSchedulerUeInfoDPPA::CompareUeWeightsDl(const NrMacSchedulerNs3::UePtr
     }
 }
 
+bool NrMacSchedulerUeInfoDPPA::CompareContextDl(const NrMacSchedulerDppContext& ctx, uint32_t l, uint32_t r)
+{
+    if (ctx.m_metric[l] == ctx.m_metric[r]){
+        if (ctx.m_mcs[l] == ctx.m_mcs[r]){
+            if (ctx.m_g[l] == ctx.m_g[r]){
+                return (l < r); // First in the beam vector
+            }
+            return (ctx.m_g[l] > ctx.m_g[r]); // Mayor g
+        } else {
+            return (ctx.m_mcs[l] > ctx.m_mcs[r]); // Mayor MCS
+        }
+    } else {
+        return (ctx.m_metric[l] < ctx.m_metric[r]); // Menor k
+    }
+}
+
+uint32_t
+NrMacSchedulerUeInfoDPPA::AssignByK(NrMacSchedulerDppContext* ctx,
+                                    uint32_t resources,
+                                    uint32_t rbgAssignable,
+                                    double threshold,
+                                    const Ptr<const NrAmc>& amc)
+{
+    auto heapCompare = [ctx](uint32_t l, uint32_t r) {
+        return CompareContextDl(*ctx, r, l);
+    };
+    auto heapEnd = ctx->m_order.end();
+    std::make_heap(ctx->m_order.begin(), heapEnd, heapCompare);
+
+    while (resources > 0 && heapEnd != ctx->m_order.begin()){ // As long as there are resources and UEs continue with the assignment
+        uint32_t i = ctx->m_order.front();
+        std::pop_heap(ctx->m_order.begin(), heapEnd, heapCompare);
+        --heapEnd;
+        // Here the UEs are sorted by priority, but we need to check if V is sufficiently high that not resources must be allocated
+        if (threshold >= ctx->m_metric[i]){ // The UE can receive resources
+            NS_LOG_INFO("Priority to UE" << ctx->m_rnti[i]);
+        }else{
+            NS_LOG_INFO("Discard UE" << ctx->m_rnti[i]);
+            break;
+        }
+        auto uePtr = ctx->GetUe<NrMacSchedulerUeInfoDPPA>(i);
+        const uint32_t buffer = ctx->m_ue[i]->second;
+        // If there are two streams we add the TbSizes of the two streams to satisfy the bufQueueSize
+        uint32_t tbSize = 0;
+        for (const auto& it : uePtr->m_dlTbSize)
+        {
+            tbSize += it;
+        }
+        while (resources > 0 && buffer > tbSize){ // Check that the UE has enough data
+            uePtr->m_dlRBG += rbgAssignable; // Assign 1 RBG for each available symbols for the beam
+            resources -= 1; // Counter of available resourecs. Resources are RBG (OFDMA), so they do not consider the beamSym
+            uePtr->UpdateDlMetric(amc); // Actualiza m_dlTbSize
+            tbSize = 0;
+            for (const auto& it : uePtr->m_dlTbSize)
+            {
+                tbSize += it;
+            }
+        }
+        NS_LOG_INFO("UE" << uePtr->m_rnti << " has " << uePtr->m_dlRBG << " DL RBG, TB size "
+                         << tbSize << " for a buffer of " << buffer);
+    }
+    return resources;
+}
+
 } // namespace ns3
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "nr-mac-scheduler-dpp-context.h"
 #include "nr-mac-scheduler-ns3.h"
 
 namespace ns3
@@ -96,6 +97,43 @@ class NrMacSchedulerUeInfoDPPA : public NrMacSchedulerUeInfo
     static bool CompareUeWeightsDl(const NrMacSchedulerNs3::UePtrAndBufferReq& lue,
                                    const NrMacSchedulerNs3::UePtrAndBufferReq& rue);
 
+    /**
+     * \brief Same order as CompareUeWeightsDl, between two entries of a context
+     *
+     * UEs that CompareUeWeightsDl sees as equal are ordered by their position
+     * in the beam vector, so that the order is total and does not depend on
+     * the algorithm that sorts or selects the UEs.
+     *
+     * \param ctx the context, with the K of each UE in m_metric
+     * \param l Left entry
+     * \param r Right entry
+     * \return true if the UE of entry l is served before the one of entry r
+     */
+    static bool CompareContextDl(const NrMacSchedulerDppContext& ctx, uint32_t l, uint32_t r);
+
+    /**
+     * \brief Give the RBGs of a beam to its UEs, from the smallest K to the largest
+     * \param ctx the context, with the K of each UE in m_metric
+     * \param resources the RBGs available
+     * \param rbgAssignable the RBG count added to a UE for each RBG it receives
+     * \param threshold the largest K of a UE that can receive resources
+     * \param amc a pointer to the AMC, to update the TB size after each RBG
+     * \return the RBGs that are left
+     *
+     * A UE keeps receiving RBGs (in m_dlRBG) until its buffer fits in its TB
+     * or the resources end, and then the next UE in the order of
+     * CompareContextDl is served. Only the first UEs of that order get
+     * resources, so instead of sorting all of them they are kept in a binary
+     * heap in ctx->m_order (O(N) to build) and extracted one at a time
+     * (O(log N) each); the K of a UE does not change while it receives
+     * resources, so the allocation is the one of a full sort.
+     */
+    static uint32_t AssignByK(NrMacSchedulerDppContext* ctx,
+                              uint32_t resources,
+                              uint32_t rbgAssignable,
+                              double threshold,
+                              const Ptr<const NrAmc>& amc);
+
     /**
      * \brief comparison function object (i.e. an object that satisfies the
      * requirements of Compare) which returns ​true if the first argument is less
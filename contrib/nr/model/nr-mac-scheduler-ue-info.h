@@ -218,6 +218,35 @@ class NrMacSchedulerUeInfo
      */
     virtual void ResetUlMetric();
 
+    /**
+     * \brief Get the DL bit rate that a GBR LC has to receive in this slot
+     * \param lcId the LC ID
+     * \param gbr the ERAB guaranteed bit rate of the LC (UINT64_MAX if not set)
+     * \return the bit rate, in bit/s (UINT64_MAX if not guaranteed); by default, gbr
+     *
+     * Used by NrMacSchedulerLcQos to distribute the bytes of a TB among the
+     * LCs of the UE. UE representations that track the GFBR of each LC
+     * (e.g., NrMacSchedulerUeInfoDPP) return the GFBR plus the deficit of the LC.
+     */
+    virtual uint64_t GetDlLcGuaranteedBitRate([[maybe_unused]] uint8_t lcId, uint64_t gbr) const
+    {
+        return gbr;
+    }
+
+    /**
+     * \brief Notify the bytes of a new DL TB that have been assigned to a LC
+     * \param lcId the LC ID
+     * \param bytes the bytes assigned to the LC
+     * \param slotPeriod the slot period
+     *
+     * By default, it does nothing.
+     */
+    virtual void DlLcBytesAssigned([[maybe_unused]] uint8_t lcId,
+                                   [[maybe_unused]] uint32_t bytes,
+                                   [[maybe_unused]] Time slotPeriod)
+    {
+    }
+
     /**
      * \brief Received CQI information
      */
@@ -256,6 +285,9 @@ class NrMacSchedulerUeInfo
         uint8_t m_ri{0}; //!< The rank indicator, by default UE would have only one stream
         std::vector<double> m_sinr;   //!< Vector of SINR for the entire band
         std::vector<uint8_t> m_wbCqi; //!< CQI for each stream
+        std::vector<uint8_t> m_sbCqi; //!< CQI for each sub-band of the first stream (SB only)
+        std::vector<uint8_t> m_sbMcs; //!< MCS for each sub-band of the first stream (SB only)
+        uint16_t m_sbSize{0};         //!< Number of RBs of a sub-band (SB only)
         uint32_t m_timer{
             0}; //!< Timer (in slot number). When the timer is 0, the value is discarded
     };
@@ -399,6 +399,8 @@ struct DlCqiInfo
 
     std::vector<uint8_t> m_wbCqi; //!< WB CQI for each MIMO stream
     uint8_t m_wbPmi{0};           //!< The reported wideband pre-coding matrix index
+    std::vector<uint8_t> m_sbCqi; //!< SB CQI of the first stream, one per sub-band (SB only)
+    uint16_t m_sbSize{0};         //!< Number of RBs of a sub-band (SB only)
 };
 
 /**
@@ -0,0 +1,452 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-sinr-kernels.h"
+
+#include <ns3/abort.h>
+#include <ns3/assert.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NR_SINR_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ns3
+{
+
+namespace
+{
+
+/**
+ * \brief Detect the widest instruction set supported by the CPU
+ * \return the instruction set
+ */
+NrSinrKernels::Isa
+DetectIsa()
+{
+#ifdef NR_SINR_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return NrSinrKernels::AVX512F;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return NrSinrKernels::AVX2;
+    }
+#endif
+    return NrSinrKernels::SCALAR;
+}
+
+/**
+ * \brief Get the instruction set in use
+ * \return a reference to it, initialized with the CPU detection
+ */
+NrSinrKernels::Isa&
+IsaInUse()
+{
+    static NrSinrKernels::Isa isa = DetectIsa();
+    return isa;
+}
+
+/**
+ * \brief Scalar sum of the exponential SINRs
+ * \param sinr the linear SINR of every RB
+ * \param map the RBs of the TB
+ * \param n the number of RBs
+ * \param beta the beta of the MCS
+ * \return the sum
+ */
+double
+SumExpScalar(const double* sinr, const int* map, std::size_t n, double beta)
+{
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        sum += std::exp(-sinr[map[i]] / beta);
+    }
+    return sum;
+}
+
+/**
+ * \brief MI of a RB, as in the original per-RB loop of NrLteMiErrorModel
+ * \param sinr the linear SINR of the RB
+ * \param miTable the MI table
+ * \param tableSize the size of the table
+ * \param axisFirst the SINR of the first entry
+ * \param axisLast the SINR of the last entry
+ * \param scaling the entries per unit of linear SINR
+ * \return the MI of the RB
+ */
+inline double
+MiScalar(double sinr,
+         const double* miTable,
+         std::size_t tableSize,
+         double axisFirst,
+         double axisLast,
+         double scaling)
+{
+    if (sinr > axisLast)
+    {
+        return 1.0;
+    }
+    double indexDouble = (sinr - axisFirst) * scaling + 1;
+    auto index = static_cast<uint32_t>(std::max(0.0, std::floor(indexDouble)));
+    NS_ASSERT_MSG(index < tableSize, "MI map out of data");
+    return miTable[index];
+}
+
+/**
+ * \brief Scalar sum of the MI of the RBs
+ * \param sinr the linear SINR of every RB
+ * \param map the RBs of the TB
+ * \param n the number of RBs
+ * \param miTable the MI table
+ * \param tableSize the size of the table
+ * \param axisFirst the SINR of the first entry
+ * \param axisLast the SINR of the last entry
+ * \param scaling the entries per unit of linear SINR
+ * \return the sum
+ */
+double
+SumMiScalar(const double* sinr,
+            const int* map,
+            std::size_t n,
+            const double* miTable,
+            std::size_t tableSize,
+            double axisFirst,
+            double axisLast,
+            double scaling)
+{
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        sum += MiScalar(sinr[map[i]], miTable, tableSize, axisFirst, axisLast, scaling);
+    }
+    return sum;
+}
+
+#ifdef NR_SINR_KERNELS_X86
+
+// Coefficients of the exponential of Cephes: exp(x) = 2^n exp(r), with
+// x = n ln2 + r, |r| <= ln2/2, and exp(r) = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+const double EXP_LOG2E = 1.4426950408889634073599; //!< 1 / ln2
+const double EXP_C1 = 6.93145751953125E-1;         //!< ln2, high part
+const double EXP_C2 = 1.42860682030941723212E-6;   //!< ln2, low part
+const double EXP_P0 = 1.26177193074810590878E-4;   //!< P(x), x^2 coefficient
+const double EXP_P1 = 3.02994407707441961300E-2;   //!< P(x), x coefficient
+const double EXP_P2 = 9.99999999999999999910E-1;   //!< P(x), constant
+const double EXP_Q0 = 3.00198505138664455042E-6;   //!< Q(x), x^3 coefficient
+const double EXP_Q1 = 2.52448340349684104192E-3;   //!< Q(x), x^2 coefficient
+const double EXP_Q2 = 2.27265548208155028766E-1;   //!< Q(x), x coefficient
+const double EXP_Q3 = 2.00000000000000000009E0;    //!< Q(x), constant
+const double EXP_MIN = -708.0; //!< Below it, the result is flushed to 0 (avoids denormals)
+const double EXP_MAX = 709.0;                      //!< Above it, the input is saturated
+const double EXP_ROUND = 6755399441055744.0;       //!< 1.5 * 2^52, to convert n to an integer
+
+/**
+ * \brief Exponential of 4 values
+ * \param x the values
+ * \return exp (x)
+ */
+__attribute__((target("avx2,fma"))) inline __m256d
+Exp256(__m256d x)
+{
+    __m256d under = _mm256_cmp_pd(x, _mm256_set1_pd(EXP_MIN), _CMP_LT_OQ);
+    x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(EXP_MIN)), _mm256_set1_pd(EXP_MAX));
+
+    __m256d n = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(EXP_LOG2E)),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    x = _mm256_fnmadd_pd(n, _mm256_set1_pd(EXP_C1), x);
+    x = _mm256_fnmadd_pd(n, _mm256_set1_pd(EXP_C2), x);
+
+    __m256d xx = _mm256_mul_pd(x, x);
+    __m256d px = _mm256_fmadd_pd(_mm256_set1_pd(EXP_P0), xx, _mm256_set1_pd(EXP_P1));
+    px = _mm256_mul_pd(_mm256_fmadd_pd(px, xx, _mm256_set1_pd(EXP_P2)), x);
+    __m256d qx = _mm256_fmadd_pd(_mm256_set1_pd(EXP_Q0), xx, _mm256_set1_pd(EXP_Q1));
+    qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(EXP_Q2));
+    qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(EXP_Q3));
+    __m256d e = _mm256_div_pd(px, _mm256_sub_pd(qx, px));
+    e = _mm256_fmadd_pd(e, _mm256_set1_pd(2.0), _mm256_set1_pd(1.0));
+
+    // 2^n, built in the exponent field
+    __m256i ni = _mm256_sub_epi64(
+        _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(EXP_ROUND))),
+        _mm256_castpd_si256(_mm256_set1_pd(EXP_ROUND)));
+    __m256d pow2n =
+        _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(ni, _mm256_set1_epi64x(1023)), 52));
+    return _mm256_andnot_pd(under, _mm256_mul_pd(e, pow2n));
+}
+
+/**
+ * \brief Load 4 values of an array
+ * \param base the array
+ * \param index the indices of the values
+ * \return the values
+ *
+ * The hardware gathers are microcoded, and very slow in the CPUs with the
+ * mitigation of Gather Data Sampling, while independent loads are not.
+ */
+__attribute__((target("avx2,fma"))) inline __m256d
+Gather256(const double* base, const int* index)
+{
+    return _mm256_set_pd(base[index[3]], base[index[2]], base[index[1]], base[index[0]]);
+}
+
+/**
+ * \brief Add the lanes of a vector
+ * \param v the vector
+ * \return the sum of its lanes
+ */
+__attribute__((target("avx2,fma"))) inline double
+HorizontalSum256(__m256d v)
+{
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+/// \copydoc SumExpScalar
+__attribute__((target("avx2,fma"))) double
+SumExpAvx2(const double* sinr, const int* map, std::size_t n, double beta)
+{
+    const __m256d minusBeta = _mm256_set1_pd(-beta);
+    __m256d acc = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d v = Gather256(sinr, map + i);
+        acc = _mm256_add_pd(acc, Exp256(_mm256_div_pd(v, minusBeta)));
+    }
+    return HorizontalSum256(acc) + SumExpScalar(sinr, map + i, n - i, beta);
+}
+
+/// \copydoc SumMiScalar
+__attribute__((target("avx2,fma"))) double
+SumMiAvx2(const double* sinr,
+          const int* map,
+          std::size_t n,
+          const double* miTable,
+          std::size_t tableSize,
+          double axisFirst,
+          double axisLast,
+          double scaling)
+{
+    const __m256d first = _mm256_set1_pd(axisFirst);
+    const __m256d last = _mm256_set1_pd(axisLast);
+    const __m256d scale = _mm256_set1_pd(scaling);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d maxIndex = _mm256_set1_pd(static_cast<double>(tableSize - 1));
+    __m256d acc = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d v = Gather256(sinr, map + i);
+        __m256d above = _mm256_cmp_pd(v, last, _CMP_GT_OQ);
+        // Same operations of the scalar loop (no FMA), and the index of the
+        // RBs above the last entry kept inside the table
+        __m256d indexDouble = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(v, first), scale), one);
+        indexDouble = _mm256_max_pd(_mm256_floor_pd(indexDouble), _mm256_setzero_pd());
+        indexDouble = _mm256_min_pd(indexDouble, maxIndex);
+        alignas(16) int tableIndex[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(tableIndex), _mm256_cvttpd_epi32(indexDouble));
+        __m256d mi = Gather256(miTable, tableIndex);
+        acc = _mm256_add_pd(acc, _mm256_blendv_pd(mi, one, above));
+    }
+    return HorizontalSum256(acc) +
+           SumMiScalar(sinr, map + i, n - i, miTable, tableSize, axisFirst, axisLast, scaling);
+}
+
+// The AVX-512 intrinsics of GCC 12 start from _mm512_undefined_pd(), which
+// triggers false uninitialized warnings (GCC bug 105593)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+/**
+ * \brief Load 8 values of an array
+ * \param base the array
+ * \param index the indices of the values
+ * \return the values
+ */
+__attribute__((target("avx512f"))) inline __m512d
+Gather512(const double* base, const int* index)
+{
+    return _mm512_set_pd(base[index[7]],
+                         base[index[6]],
+                         base[index[5]],
+                         base[index[4]],
+                         base[index[3]],
+                         base[index[2]],
+                         base[index[1]],
+                         base[index[0]]);
+}
+
+/**
+ * \brief Exponential of 8 values
+ * \param x the values
+ * \return exp (x)
+ */
+__attribute__((target("avx512f"))) inline __m512d
+Exp512(__m512d x)
+{
+    __mmask8 under = _mm512_cmp_pd_mask(x, _mm512_set1_pd(EXP_MIN), _CMP_LT_OQ);
+    x = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(EXP_MIN)), _mm512_set1_pd(EXP_MAX));
+
+    __m512d n = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(EXP_LOG2E)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    x = _mm512_fnmadd_pd(n, _mm512_set1_pd(EXP_C1), x);
+    x = _mm512_fnmadd_pd(n, _mm512_set1_pd(EXP_C2), x);
+
+    __m512d xx = _mm512_mul_pd(x, x);
+    __m512d px = _mm512_fmadd_pd(_mm512_set1_pd(EXP_P0), xx, _mm512_set1_pd(EXP_P1));
+    px = _mm512_mul_pd(_mm512_fmadd_pd(px, xx, _mm512_set1_pd(EXP_P2)), x);
+    __m512d qx = _mm512_fmadd_pd(_mm512_set1_pd(EXP_Q0), xx, _mm512_set1_pd(EXP_Q1));
+    qx = _mm512_fmadd_pd(qx, xx, _mm512_set1_pd(EXP_Q2));
+    qx = _mm512_fmadd_pd(qx, xx, _mm512_set1_pd(EXP_Q3));
+    __m512d e = _mm512_div_pd(px, _mm512_sub_pd(qx, px));
+    e = _mm512_fmadd_pd(e, _mm512_set1_pd(2.0), _mm512_set1_pd(1.0));
+
+    return _mm512_maskz_scalef_pd(static_cast<__mmask8>(~under), e, n);
+}
+
+/// \copydoc SumExpScalar
+__attribute__((target("avx512f"))) double
+SumExpAvx512(const double* sinr, const int* map, std::size_t n, double beta)
+{
+    const __m512d minusBeta = _mm512_set1_pd(-beta);
+    __m512d acc = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m512d v = Gather512(sinr, map + i);
+        acc = _mm512_add_pd(acc, Exp512(_mm512_div_pd(v, minusBeta)));
+    }
+    return _mm512_reduce_add_pd(acc) + SumExpScalar(sinr, map + i, n - i, beta);
+}
+
+/// \copydoc SumMiScalar
+__attribute__((target("avx512f"))) double
+SumMiAvx512(const double* sinr,
+            const int* map,
+            std::size_t n,
+            const double* miTable,
+            std::size_t tableSize,
+            double axisFirst,
+            double axisLast,
+            double scaling)
+{
+    const __m512d first = _mm512_set1_pd(axisFirst);
+    const __m512d last = _mm512_set1_pd(axisLast);
+    const __m512d scale = _mm512_set1_pd(scaling);
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d maxIndex = _mm512_set1_pd(static_cast<double>(tableSize - 1));
+    __m512d acc = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m512d v = Gather512(sinr, map + i);
+        __mmask8 above = _mm512_cmp_pd_mask(v, last, _CMP_GT_OQ);
+        __m512d indexDouble = _mm512_add_pd(_mm512_mul_pd(_mm512_sub_pd(v, first), scale), one);
+        indexDouble = _mm512_max_pd(_mm512_floor_pd(indexDouble), _mm512_setzero_pd());
+        indexDouble = _mm512_min_pd(indexDouble, maxIndex);
+        alignas(32) int tableIndex[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(tableIndex), _mm512_cvttpd_epi32(indexDouble));
+        __m512d mi = Gather512(miTable, tableIndex);
+        acc = _mm512_add_pd(acc, _mm512_mask_blend_pd(above, mi, one));
+    }
+    return _mm512_reduce_add_pd(acc) +
+           SumMiScalar(sinr, map + i, n - i, miTable, tableSize, axisFirst, axisLast, scaling);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // NR_SINR_KERNELS_X86
+
+} // namespace
+
+NrSinrKernels::Isa
+NrSinrKernels::GetIsa()
+{
+    return IsaInUse();
+}
+
+void
+NrSinrKernels::SetIsa(Isa isa)
+{
+    NS_ABORT_MSG_IF(!IsSupported(isa), GetIsaName(isa) << " is not supported by this CPU");
+    IsaInUse() = isa;
+}
+
+bool
+NrSinrKernels::IsSupported(Isa isa)
+{
+    static const Isa widest = DetectIsa();
+    return isa <= widest;
+}
+
+std::string
+NrSinrKernels::GetIsaName(Isa isa)
+{
+    switch (isa)
+    {
+    case SCALAR:
+        return "scalar";
+    case AVX2:
+        return "AVX2";
+    case AVX512F:
+        return "AVX-512F";
+    }
+    return "unknown";
+}
+
+double
+NrSinrKernels::SumExp(const double* sinr, const int* map, std::size_t n, double beta)
+{
+    switch (IsaInUse())
+    {
+#ifdef NR_SINR_KERNELS_X86
+    case AVX512F:
+        return SumExpAvx512(sinr, map, n, beta);
+    case AVX2:
+        return SumExpAvx2(sinr, map, n, beta);
+#endif
+    default:
+        return SumExpScalar(sinr, map, n, beta);
+    }
+}
+
+double
+NrSinrKernels::SumMi(const double* sinr,
+                     const int* map,
+                     std::size_t n,
+                     const double* miTable,
+                     std::size_t tableSize,
+                     double axisFirst,
+                     double axisLast,
+                     double scaling)
+{
+    switch (IsaInUse())
+    {
+#ifdef NR_SINR_KERNELS_X86
+    case AVX512F:
+        return SumMiAvx512(sinr, map, n, miTable, tableSize, axisFirst, axisLast, scaling);
+    case AVX2:
+        return SumMiAvx2(sinr, map, n, miTable, tableSize, axisFirst, axisLast, scaling);
+#endif
+    default:
+        return SumMiScalar(sinr, map, n, miTable, tableSize, axisFirst, axisLast, scaling);
+    }
+}
+
+} // namespace ns3
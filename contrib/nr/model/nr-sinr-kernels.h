@@ -0,0 +1,108 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup error-models
+ *
+ * \brief Per-RB kernels of the effective SINR computations of the error models
+ *
+ * The error models reduce the SINR of the RBs of a TB to a single value: the
+ * EESM models with the sum of exp(-SINR/beta), the MI model with the sum of
+ * the mutual information read from a table. With 273 RBs these loops run for
+ * every TB and for every MCS probed by the AMC.
+ *
+ * The kernels gather the SINR of the RBs of the map and reduce them with the
+ * widest instruction set of the CPU, chosen once at run time: AVX-512F,
+ * AVX2 with FMA, or the scalar loop of the error models. The exponential of
+ * the vector paths is a Cephes-style rational approximation, accurate to a
+ * couple of ulp, and the partial sums are accumulated lane by lane, so the
+ * vector results differ from the scalar ones in the last bits. SetIsa() can
+ * force the scalar path to reproduce the results of another host bit by bit.
+ */
+class NrSinrKernels
+{
+  public:
+    /**
+     * \brief Instruction set of the kernels
+     */
+    enum Isa
+    {
+        SCALAR,  //!< Portable scalar loop
+        AVX2,    //!< AVX2 and FMA, 4 RBs per iteration
+        AVX512F, //!< AVX-512F, 8 RBs per iteration
+    };
+
+    /**
+     * \brief Get the instruction set in use
+     * \return the instruction set; by default, the widest one supported by the CPU
+     */
+    static Isa GetIsa();
+
+    /**
+     * \brief Select the instruction set of the kernels
+     * \param isa the instruction set; it must be supported by the CPU
+     */
+    static void SetIsa(Isa isa);
+
+    /**
+     * \brief Check if the CPU supports an instruction set
+     * \param isa the instruction set
+     * \return true if the kernels can use it
+     */
+    static bool IsSupported(Isa isa);
+
+    /**
+     * \brief Get the name of an instruction set
+     * \param isa the instruction set
+     * \return the name
+     */
+    static std::string GetIsaName(Isa isa);
+
+    /**
+     * \brief Sum of the exponential SINRs of the EESM method
+     * \param sinr the linear SINR of every RB of the band
+     * \param map the RBs of the TB
+     * \param n the number of RBs of the TB
+     * \param beta the beta of the MCS
+     * \return sum_i exp (-sinr[map[i]] / beta)
+     */
+    static double SumExp(const double* sinr, const int* map, std::size_t n, double beta);
+
+    /**
+     * \brief Sum of the mutual information of the RBs of a TB
+     * \param sinr the linear SINR of every RB of the band
+     * \param map the RBs of the TB
+     * \param n the number of RBs of the TB
+     * \param miTable the MI of the modulation, at uniformly spaced SINRs
+     * \param tableSize the number of entries of miTable
+     * \param axisFirst the SINR of the first entry of the table
+     * \param axisLast the SINR of the last entry of the table; above it the MI is 1
+     * \param scaling the entries per unit of linear SINR: (tableSize - 1) / (axisLast - axisFirst)
+     * \return sum_i MI (sinr[map[i]])
+     *
+     * The MI of a RB is the entry floor ((sinr - axisFirst) * scaling + 1) of
+     * the table, limited to 0. The index computation is the same in all the
+     * instruction sets, so only the order of the sum differs.
+     */
+    static double SumMi(const double* sinr,
+                        const int* map,
+                        std::size_t n,
+                        const double* miTable,
+                        std::size_t tableSize,
+                        double axisFirst,
+                        double axisLast,
+                        double scaling);
+};
+
+} // namespace ns3
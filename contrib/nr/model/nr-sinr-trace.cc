@@ -0,0 +1,353 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "nr-sinr-trace.h"
+
+#include "nr-spectrum-phy.h"
+
+#include <ns3/abort.h>
+#include <ns3/enum.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+
+#include <cstring>
+#include <iterator>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NrSinrTrace");
+NS_OBJECT_ENSURE_REGISTERED(NrSinrTrace);
+
+Ptr<NrSinrTrace> NrSinrTrace::m_instance = nullptr;
+
+namespace
+{
+
+const char HEADER_MAGIC[8] = {'N', 'R', 'S', 'I', 'N', 'R', '0', '2'};
+const std::size_t RECORD_HEADER_SIZE = 17; //!< Bytes of a record before the entries
+const std::size_t FLUSH_SIZE = 1 << 20;    //!< Buffered bytes that trigger a write
+
+/**
+ * \brief Append an unsigned integer in little endian
+ * \param out the buffer
+ * \param value the value
+ * \param bytes the number of bytes to write
+ */
+void
+PutLe(std::vector<uint8_t>* out, uint64_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; ++i)
+    {
+        out->push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/**
+ * \brief Read an unsigned integer in little endian
+ * \param in the buffer, at the first byte of the integer
+ * \param bytes the number of bytes to read
+ * \return the value
+ */
+uint64_t
+GetLe(const uint8_t* in, unsigned bytes)
+{
+    uint64_t value = 0;
+    for (unsigned i = 0; i < bytes; ++i)
+    {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+TypeId
+NrSinrTrace::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::NrSinrTrace")
+            .SetParent<Object>()
+            .AddConstructor<NrSinrTrace>()
+            .AddAttribute("Mode",
+                          "Whether the data SINR of the PHYs is recorded to the file or "
+                          "replayed from it",
+                          EnumValue(NrSinrTrace::DISABLED),
+                          MakeEnumAccessor(&NrSinrTrace::m_mode),
+                          MakeEnumChecker(NrSinrTrace::DISABLED,
+                                          "Disabled",
+                                          NrSinrTrace::RECORD,
+                                          "Record",
+                                          NrSinrTrace::REPLAY,
+                                          "Replay"))
+            .AddAttribute("FileName",
+                          "Name of the SINR trace file",
+                          StringValue("nr-sinr-trace.bin"),
+                          MakeStringAccessor(&NrSinrTrace::m_fileName),
+                          MakeStringChecker());
+    return tid;
+}
+
+NrSinrTrace::NrSinrTrace()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NrSinrTrace::~NrSinrTrace()
+{
+    Flush();
+}
+
+void
+NrSinrTrace::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+    if (m_output.is_open())
+    {
+        m_output.close();
+    }
+    m_replay.clear();
+    m_phys.clear();
+    Object::DoDispose();
+}
+
+NrSinrTrace*
+NrSinrTrace::Get()
+{
+    if (m_instance == nullptr)
+    {
+        m_instance = CreateObject<NrSinrTrace>();
+        Simulator::ScheduleDestroy(&NrSinrTrace::DestroyInstance);
+    }
+    return PeekPointer(m_instance);
+}
+
+void
+NrSinrTrace::DestroyInstance()
+{
+    if (m_instance != nullptr)
+    {
+        m_instance->Dispose();
+        m_instance = nullptr;
+    }
+}
+
+void
+NrSinrTrace::OpenOutput()
+{
+    if (m_output.is_open())
+    {
+        return;
+    }
+    m_output.open(m_fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_IF(!m_output.is_open(), "Can't open the SINR trace " << m_fileName);
+    m_buffer.insert(m_buffer.end(), HEADER_MAGIC, HEADER_MAGIC + sizeof(HEADER_MAGIC));
+}
+
+void
+NrSinrTrace::PutRecordHeader(const Key& key, uint16_t count)
+{
+    OpenOutput();
+    PutLe(&m_buffer, static_cast<uint64_t>(Simulator::Now().GetNanoSeconds()), 8);
+    PutLe(&m_buffer, key.m_direction, 1);
+    PutLe(&m_buffer, key.m_cellId, 2);
+    PutLe(&m_buffer, key.m_rnti, 2);
+    PutLe(&m_buffer, key.m_bwpId, 1);
+    PutLe(&m_buffer, key.m_streamId, 1);
+    PutLe(&m_buffer, count, 2);
+}
+
+void
+NrSinrTrace::RecordSinr(const Key& key, const SpectrumValue& sinr, const std::vector<int>& rbs)
+{
+    NS_LOG_FUNCTION(this << key.m_rnti << +key.m_direction);
+    NS_ASSERT(m_mode == RECORD);
+
+    // The entries are written first, as the count is known only at the end
+    std::vector<uint8_t> entries;
+    auto putRb = [&entries, &sinr](std::size_t rb) {
+        float value = static_cast<float>(sinr.ValuesAt(rb));
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        PutLe(&entries, rb, 2);
+        PutLe(&entries, bits, 4);
+    };
+    if (rbs.empty())
+    {
+        for (std::size_t rb = 0; rb < sinr.GetValuesN(); ++rb)
+        {
+            if (sinr.ValuesAt(rb) != 0.0)
+            {
+                putRb(rb);
+            }
+        }
+    }
+    else
+    {
+        for (int rb : rbs)
+        {
+            putRb(rb);
+        }
+    }
+
+    if (entries.empty())
+    {
+        return;
+    }
+    PutRecordHeader(key, static_cast<uint16_t>(entries.size() / 6));
+    m_buffer.insert(m_buffer.end(), entries.begin(), entries.end());
+    if (m_buffer.size() >= FLUSH_SIZE)
+    {
+        Flush();
+    }
+}
+
+void
+NrSinrTrace::Flush()
+{
+    if (m_output.is_open() && !m_buffer.empty())
+    {
+        m_output.write(reinterpret_cast<const char*>(m_buffer.data()),
+                       static_cast<std::streamsize>(m_buffer.size()));
+        m_output.flush();
+        m_buffer.clear();
+    }
+}
+
+void
+NrSinrTrace::AddPhy(const Ptr<NrSpectrumPhy>& phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    m_phys.push_back(phy);
+}
+
+void
+NrSinrTrace::Load()
+{
+    if (m_loaded)
+    {
+        return;
+    }
+    m_loaded = true;
+
+    std::ifstream input(m_fileName, std::ios::in | std::ios::binary);
+    NS_ABORT_MSG_IF(!input.is_open(), "Can't open the SINR trace " << m_fileName);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)),
+                              std::istreambuf_iterator<char>());
+    NS_ABORT_MSG_IF(data.size() < sizeof(HEADER_MAGIC) ||
+                        std::memcmp(data.data(), HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0,
+                    m_fileName << " is not a SINR trace");
+
+    std::size_t pos = sizeof(HEADER_MAGIC);
+    std::size_t numRecords = 0;
+    while (pos < data.size())
+    {
+        NS_ABORT_MSG_IF(pos + RECORD_HEADER_SIZE > data.size(),
+                        "Truncated record in the SINR trace " << m_fileName);
+        const uint8_t* p = data.data() + pos;
+        auto timeNs = static_cast<int64_t>(GetLe(p, 8));
+        Key key;
+        key.m_direction = static_cast<Direction>(p[8]);
+        key.m_cellId = static_cast<uint16_t>(GetLe(p + 9, 2));
+        key.m_rnti = static_cast<uint16_t>(GetLe(p + 11, 2));
+        key.m_bwpId = p[13];
+        key.m_streamId = p[14];
+        auto count = static_cast<uint16_t>(GetLe(p + 15, 2));
+        pos += RECORD_HEADER_SIZE;
+
+        const std::size_t entrySize = 6;
+        NS_ABORT_MSG_IF(pos + count * entrySize > data.size(),
+                        "Truncated record in the SINR trace " << m_fileName);
+
+        SinrRecord record;
+        record.m_timeNs = timeNs;
+        record.m_rbs.reserve(count);
+        for (uint16_t i = 0; i < count; ++i)
+        {
+            const uint8_t* e = data.data() + pos + i * entrySize;
+            auto bits = static_cast<uint32_t>(GetLe(e + 2, 4));
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            record.m_rbs.emplace_back(static_cast<uint16_t>(GetLe(e, 2)), value);
+        }
+        m_replay[key.Pack()].m_records.push_back(std::move(record));
+        ++numRecords;
+        pos += count * entrySize;
+    }
+    NS_LOG_INFO("Loaded " << numRecords << " SINR records of " << m_replay.size() << " UEs from "
+                          << m_fileName);
+}
+
+bool
+NrSinrTrace::ReplaySinr(const Key& key, SpectrumValue* sinr, const std::vector<int>& rbs)
+{
+    NS_LOG_FUNCTION(this << key.m_rnti << +key.m_direction);
+    NS_ASSERT(m_mode == REPLAY);
+    Load();
+
+    auto it = m_replay.find(key.Pack());
+    if (it == m_replay.end())
+    {
+        return false;
+    }
+    UeReplay& ue = it->second;
+
+    // Apply the records up to now
+    const int64_t now = Simulator::Now().GetNanoSeconds();
+    while (ue.m_next < ue.m_records.size() && ue.m_records[ue.m_next].m_timeNs <= now)
+    {
+        for (const auto& [rb, value] : ue.m_records[ue.m_next].m_rbs)
+        {
+            if (value == 0.0F)
+            {
+                continue;
+            }
+            if (rb >= ue.m_held.size())
+            {
+                ue.m_held.resize(rb + 1, 0.0);
+            }
+            if (ue.m_held[rb] == 0.0)
+            {
+                ++ue.m_heldCount;
+            }
+            ue.m_heldSum += value - ue.m_held[rb];
+            ue.m_held[rb] = value;
+        }
+        ++ue.m_next;
+    }
+    if (ue.m_heldCount == 0)
+    {
+        return false;
+    }
+
+    const double average = ue.m_heldSum / ue.m_heldCount;
+    auto replayRb = [&ue, sinr, average](std::size_t rb) {
+        double held = rb < ue.m_held.size() ? ue.m_held[rb] : 0.0;
+        (*sinr)[rb] = held != 0.0 ? held : average;
+    };
+    if (rbs.empty())
+    {
+        for (std::size_t rb = 0; rb < sinr->GetValuesN(); ++rb)
+        {
+            if (sinr->ValuesAt(rb) != 0.0)
+            {
+                replayRb(rb);
+            }
+        }
+    }
+    else
+    {
+        for (int rb : rbs)
+        {
+            replayRb(rb);
+        }
+    }
+    return true;
+}
+
+} // namespace ns3
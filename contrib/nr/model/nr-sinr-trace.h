@@ -0,0 +1,249 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#pragma once
+
+#include <ns3/nstime.h>
+#include <ns3/object.h>
+#include <ns3/spectrum-value.h>
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class NrSpectrumPhy;
+
+/**
+ * \ingroup utils
+ *
+ * \brief Record and replay of the data SINR perceived by the PHYs
+ *
+ * In RECORD mode, every NrSpectrumPhy writes the SINR of the RBs of each
+ * data reception, per UE: in DL the UE records the SINR of all the RBs
+ * received, in UL the gNB records the SINR of the RBs of the TB of each UE.
+ * The file is compact: only the RBs with a SINR are written, as 32-bit floats.
+ *
+ * In REPLAY mode, the PHYs replace the SINR computed from the channel with
+ * the recorded one before decoding the TBs and generating the CQI (DL CQI in
+ * the UE, UL CQI in the gNB), so that the MAC of different scheduler
+ * variants runs against the same radio conditions. The replayed SINR of a
+ * RB is the last SINR recorded for the UE on that RB up to the current time
+ * (sample and hold), or the average of the RBs recorded for the UE if that
+ * RB was never recorded; nothing is replaced before the first record of the
+ * UE.
+ *
+ * In REPLAY mode the data frames do not go through the spectrum channel:
+ * the transmitting NrSpectrumPhy hands them, with the transmitted PSD, to the
+ * PHYs of its cell registered in the trace (see AddPhy), so neither the
+ * propagation loss nor the 3GPP fading of the channel is computed for them.
+ * The PHYs of the other cells do not see these data frames, whose
+ * interference is already in the recorded SINR, and the data path loss
+ * traces show no loss. The CQI is not recorded: the PHYs compute it from the
+ * replayed SINR with the same AMC as in the recorded run, so the MAC receives
+ * the same CQI.
+ *
+ * The control frames and the SRS still go through the channel. Only the data
+ * SINR is replayed. The other uses of the channel are not: the control SINR, the SRS SINR (and with it the SRS-based UL CQI and the
+ * realistic beamforming), the RSRP, the beams chosen by the ideal
+ * beamforming algorithms that read the channel (e.g., cell scan) and the
+ * MIMO rank and precoding feedback. The channel can be swapped for a cheaper
+ * one (e.g., without fading or shadowing) in a replay run only when these
+ * do not depend on it: with the cheaper channel the control messages see a
+ * different SINR, the beams can be different, and with them the interference
+ * and the decisions of the MAC. With one cell, a beamforming that depends
+ * only on the positions (e.g., direct path), the streams of the PHYs and the
+ * MACs assigned with AssignStreams and no SRS (their offsets are shuffled
+ * before AssignStreams), the MAC takes the same decisions.
+ *
+ * Layout (all the fields are little endian):
+ *
+ *     header:  "NRSINR02"
+ *     record:  i64 timeNs, u8 direction, u16 cellId, u16 rnti, u8 bwpId,
+ *              u8 streamId, u16 count, count x {u16 rb, f32 linear SINR}
+ *
+ * The trace is shared by all the PHYs of the simulation. It is created by
+ * the first call to Get(), and it is closed and destroyed when the
+ * simulator is destroyed. Its attributes can be set with Config::SetDefault
+ * before the simulation starts, or from the command line of any example, e.g.
+ * "--ns3::NrSinrTrace::Mode=Record --ns3::NrSinrTrace::FileName=run1.bin".
+ */
+class NrSinrTrace : public Object
+{
+  public:
+    /**
+     * \brief GetTypeId
+     * \return The TypeId of the class
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief NrSinrTrace constructor
+     */
+    NrSinrTrace();
+
+    /**
+     * \brief ~NrSinrTrace deconstructor
+     */
+    ~NrSinrTrace() override;
+
+    /**
+     * \brief Operation mode
+     */
+    enum Mode
+    {
+        DISABLED, //!< The SINR is neither recorded nor replayed
+        RECORD,   //!< The SINR is written to the file
+        REPLAY    //!< The SINR is read from the file
+    };
+
+    /**
+     * \brief Direction of a record
+     */
+    enum Direction : uint8_t
+    {
+        DL = 0, //!< Recorded by the UE
+        UL = 1  //!< Recorded by the gNB
+    };
+
+    /**
+     * \brief Identity of the UE of a record
+     */
+    struct Key
+    {
+        Direction m_direction{DL}; //!< Direction
+        uint16_t m_cellId{0};      //!< Cell ID
+        uint16_t m_rnti{0};        //!< RNTI of the UE
+        uint8_t m_bwpId{0};        //!< BWP ID
+        uint8_t m_streamId{0};     //!< Stream ID
+
+        /**
+         * \brief Get the key packed in an integer
+         * \return the packed key
+         */
+        uint64_t Pack() const
+        {
+            return (static_cast<uint64_t>(m_direction) << 48) |
+                   (static_cast<uint64_t>(m_streamId) << 40) |
+                   (static_cast<uint64_t>(m_bwpId) << 32) |
+                   (static_cast<uint64_t>(m_cellId) << 16) | m_rnti;
+        }
+    };
+
+    /**
+     * \brief Get the trace, creating it at the first call
+     * \return the trace shared by all the PHYs
+     */
+    static NrSinrTrace* Get();
+
+    /**
+     * \brief Get the operation mode
+     * \return the mode
+     */
+    Mode GetMode() const
+    {
+        return m_mode;
+    }
+
+    /**
+     * \brief Record the SINR of a reception
+     * \param key the UE
+     * \param sinr the SINR of the RBs of the band
+     * \param rbs the RBs to record; if empty, all the RBs with a SINR
+     */
+    void RecordSinr(const Key& key, const SpectrumValue& sinr, const std::vector<int>& rbs);
+
+    /**
+     * \brief Replace the SINR of a reception with the recorded one
+     * \param key the UE
+     * \param sinr the SINR of the RBs of the band, replaced in place
+     * \param rbs the RBs to replace; if empty, all the RBs with a SINR
+     * \return false if there is no record of the UE up to now (sinr is unchanged)
+     */
+    bool ReplaySinr(const Key& key, SpectrumValue* sinr, const std::vector<int>& rbs);
+
+    /**
+     * \brief Write the buffered records to the file
+     */
+    void Flush();
+
+    /**
+     * \brief Register a PHY that receives the data frames in REPLAY mode
+     * \param phy the PHY
+     */
+    void AddPhy(const Ptr<NrSpectrumPhy>& phy);
+
+    /**
+     * \brief Get the PHYs that receive the data frames in REPLAY mode
+     * \return the registered PHYs
+     */
+    const std::vector<Ptr<NrSpectrumPhy>>& GetPhys() const
+    {
+        return m_phys;
+    }
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief A SINR record, as loaded for the replay
+     */
+    struct SinrRecord
+    {
+        int64_t m_timeNs{0};                           //!< Time of the record, in ns
+        std::vector<std::pair<uint16_t, float>> m_rbs; //!< SINR of the recorded RBs
+    };
+
+    /**
+     * \brief The records of a UE and the state of its replay
+     */
+    struct UeReplay
+    {
+        std::vector<SinrRecord> m_records; //!< SINR records, in time order
+        std::size_t m_next{0};             //!< First record not applied yet
+        std::vector<double> m_held;        //!< Last SINR of every RB (0 if never recorded)
+        double m_heldSum{0.0};             //!< Sum of m_held
+        uint32_t m_heldCount{0};           //!< RBs with a SINR in m_held
+    };
+
+    /**
+     * \brief Destroy the shared trace; scheduled at the first Get()
+     */
+    static void DestroyInstance();
+
+    /**
+     * \brief Open the file for writing, if not open yet
+     */
+    void OpenOutput();
+
+    /**
+     * \brief Write the header of a record into the buffer
+     * \param key the UE
+     * \param count the number of entries of the record
+     */
+    void PutRecordHeader(const Key& key, uint16_t count);
+
+    /**
+     * \brief Load the SINR records of the file, if not loaded yet
+     */
+    void Load();
+
+    Mode m_mode{DISABLED};                           //!< Operation mode
+    std::string m_fileName;                          //!< Name of the trace file
+    std::ofstream m_output;                          //!< Output file (RECORD)
+    std::vector<uint8_t> m_buffer;                   //!< Records not written yet (RECORD)
+    bool m_loaded{false};                            //!< Whether the file was loaded (REPLAY)
+    std::unordered_map<uint64_t, UeReplay> m_replay; //!< Records per packed key (REPLAY)
+    std::vector<Ptr<NrSpectrumPhy>> m_phys;          //!< Receivers of the data frames (REPLAY)
+
+    static Ptr<NrSinrTrace> m_instance; //!< The shared trace
+};
+
+} // namespace ns3
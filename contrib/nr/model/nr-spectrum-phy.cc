@@ -9,6 +9,7 @@
 #include "nr-gnb-net-device.h"
 #include "nr-gnb-phy.h"
 #include "nr-lte-mi-error-model.h"
+#include "nr-sinr-trace.h"
 #include "nr-ue-net-device.h"
 #include "nr-ue-phy.h"
 
@@ -275,6 +276,10 @@ void
 NrSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
 {
     m_channel = c;
+    if (NrSinrTrace::Get()->GetMode() == NrSinrTrace::REPLAY)
+    {
+        NrSinrTrace::Get()->AddPhy(this);
+    }
 }
 
 Ptr<const SpectrumModel>
@@ -620,7 +625,11 @@ NrSpectrumPhy::StartTxDataFrames(const Ptr<PacketBurst>& pb,
 
         m_txDataTrace(duration);
 
-        if (m_channel)
+        if (m_channel && NrSinrTrace::Get()->GetMode() == NrSinrTrace::REPLAY)
+        {
+            StartTxDataReplay(txParams);
+        }
+        else if (m_channel)
         {
             m_channel->StartTx(txParams);
         }
@@ -637,6 +646,27 @@ NrSpectrumPhy::StartTxDataFrames(const Ptr<PacketBurst>& pb,
     }
 }
 
+void
+NrSpectrumPhy::StartTxDataReplay(const Ptr<NrSpectrumSignalParametersDataFrame>& txParams)
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t txNode = m_device->GetNode()->GetId();
+    for (const auto& phy : NrSinrTrace::Get()->GetPhys())
+    {
+        if (phy->GetSpectrumChannel() != m_channel || phy->GetCellId() != GetCellId() ||
+            phy->GetDevice()->GetNode()->GetId() == txNode)
+        {
+            continue;
+        }
+        // Every receiver gets its own copy, as StartRx can scale the PSD
+        Simulator::ScheduleWithContext(phy->GetDevice()->GetNode()->GetId(),
+                                       Seconds(0),
+                                       &NrSpectrumPhy::StartRx,
+                                       phy,
+                                       txParams->Copy());
+    }
+}
+
 void
 NrSpectrumPhy::StartTxDlControlFrames(const std::list<Ptr<NrControlMessage>>& ctrlMsgList,
                                       const Time& duration)
@@ -816,6 +846,51 @@ NrSpectrumPhy::UpdateSinrPerceived(const SpectrumValue& sinr)
     NS_LOG_FUNCTION(this << sinr);
     NS_LOG_INFO("Update SINR perceived with this value: " << sinr);
     m_sinrPerceived = sinr;
+    ApplySinrTrace(&m_sinrPerceived, true);
+}
+
+void
+NrSpectrumPhy::ApplySinrTrace(SpectrumValue* sinr, bool record) const
+{
+    NrSinrTrace* trace = NrSinrTrace::Get();
+    if (trace->GetMode() == NrSinrTrace::DISABLED ||
+        (trace->GetMode() == NrSinrTrace::RECORD && !record))
+    {
+        return;
+    }
+
+    NrSinrTrace::Key key;
+    key.m_cellId = GetCellId();
+    key.m_bwpId = static_cast<uint8_t>(GetBwpId());
+    key.m_streamId = m_streamId;
+
+    auto apply = [trace, sinr](const NrSinrTrace::Key& key, const std::vector<int>& rbs) {
+        if (trace->GetMode() == NrSinrTrace::RECORD)
+        {
+            trace->RecordSinr(key, *sinr, rbs);
+        }
+        else
+        {
+            trace->ReplaySinr(key, sinr, rbs);
+        }
+    };
+
+    if (m_isEnb)
+    {
+        key.m_direction = NrSinrTrace::UL;
+        for (const auto& tb : m_transportBlocks)
+        {
+            key.m_rnti = tb.first;
+            apply(key, tb.second.m_expected.m_rbBitmap);
+        }
+    }
+    else
+    {
+        Ptr<NrUePhy> phy = DynamicCast<NrUePhy>(m_phy);
+        key.m_direction = NrSinrTrace::DL;
+        key.m_rnti = phy->GetRnti();
+        apply(key, {});
+    }
 }
 
 void
@@ -826,6 +901,13 @@ NrSpectrumPhy::GenerateDataCqiReport(const SpectrumValue& sinr)
     NS_ABORT_MSG_UNLESS(
         phy,
         "This function should only be called for NrSpectrumPhy belonging to NrGnbPhy");
+    if (NrSinrTrace::Get()->GetMode() == NrSinrTrace::REPLAY)
+    {
+        SpectrumValue replayed = sinr;
+        ApplySinrTrace(&replayed, false);
+        phy->GenerateDataCqiReport(replayed, m_streamId);
+        return;
+    }
     phy->GenerateDataCqiReport(sinr, m_streamId);
 }
 
@@ -848,6 +930,13 @@ NrSpectrumPhy::GenerateDlCqiReport(const SpectrumValue& sinr)
     NS_ABORT_MSG_UNLESS(
         phy,
         "This function should only be called for NrSpectrumPhy belonging to NrUEPhy");
+    if (NrSinrTrace::Get()->GetMode() == NrSinrTrace::REPLAY)
+    {
+        SpectrumValue replayed = sinr;
+        ApplySinrTrace(&replayed, false);
+        phy->GenerateDlCqiReport(replayed, m_streamId);
+        return;
+    }
     phy->GenerateDlCqiReport(sinr, m_streamId);
 }
 
@@ -543,6 +543,30 @@ class NrSpectrumPhy : public SpectrumPhy
      * \return true if this class is inside an enb/gnb
      */
     bool IsEnb() const;
+    /**
+     * \brief Record the SINR of the current data reception, or replace it
+     * with the recorded one, depending on the mode of NrSinrTrace
+     *
+     * The UE records the SINR of all the RBs under its RNTI, the gNB the
+     * SINR of the RBs of each expected TB under the RNTI of the TB.
+     *
+     * \param sinr the SINR of the data reception
+     * \param record whether to record it, in NrSinrTrace::RECORD mode (the
+     * SINR of a reception is recorded once, although it is passed to the CQI
+     * and to the TB decoding)
+     */
+    void ApplySinrTrace(SpectrumValue* sinr, bool record) const;
+    /**
+     * \brief Deliver a data frame to the PHYs of the cell without the
+     * spectrum channel, in NrSinrTrace::REPLAY mode
+     *
+     * The receivers are the PHYs registered in NrSinrTrace on the same
+     * channel and cell, apart from those of this node. They receive the
+     * transmitted PSD, as their SINR is replaced with the recorded one.
+     *
+     * \param txParams the parameters of the data frame
+     */
+    void StartTxDataReplay(const Ptr<NrSpectrumSignalParametersDataFrame>& txParams);
     /**
      * \brief Update the state of the spectrum phy. The states are:
      *  IDLE, TX, RX_DATA, RX_DL_CTRL, RX_UL_CTRL, CCA_BUSY.
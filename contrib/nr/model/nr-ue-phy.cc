@@ -129,6 +129,13 @@ NrUePhy::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&NrUePhy::UseFixedRankIndicator),
                           MakeBooleanChecker())
+            .AddAttribute("DlSubbandCqiSize",
+                          "Number of RBs of the sub-bands of the DL CQI. If not 0, the UE "
+                          "reports, together with the WB CQI, a CQI of the first stream for "
+                          "each sub-band (a SB report); if 0, only the WB CQI is reported",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&NrUePhy::m_dlSbCqiSize),
+                          MakeUintegerChecker<uint16_t>())
             .AddAttribute(
                 "RiSinrThreshold1",
                 "The SINR threshold 1 in dB. It is used to adaptively choose"
@@ -1217,6 +1224,10 @@ NrUePhy::GenerateDlCqiReport(const SpectrumValue& sinr, uint8_t streamId)
 
         NS_ASSERT(streamId < m_prevDlWbCqi.size());
         m_prevDlWbCqi[streamId] = wbCqi;
+        if (m_dlSbCqiSize > 0 && streamId == 0)
+        {
+            UpdateDlSbCqi(sinr, wbCqi);
+        }
         double avrgSinrdB = 10 * log10(ComputeAvgSinr(sinr));
         avrgSinr[streamId] = avrgSinrdB;
         NS_LOG_DEBUG("Stream " << +streamId << " WB CQI " << +wbCqi << " avrg MCS " << +mcs
@@ -1250,6 +1261,12 @@ NrUePhy::GenerateDlCqiReport(const SpectrumValue& sinr, uint8_t streamId)
             // if UE reports RI = 2 and one of the stream's CQI is 0, scheduler will
             // use MCS 0 to compute its TB size.
             dlcqi.m_wbCqi = m_prevDlWbCqi; // set DL CQI feedbacks
+            if (m_dlSbCqiSize > 0 && !m_prevDlSbCqi.empty())
+            {
+                dlcqi.m_cqiType = DlCqiInfo::SB;
+                dlcqi.m_sbCqi = m_prevDlSbCqi;
+                dlcqi.m_sbSize = m_dlSbCqiSize;
+            }
 
             NS_ASSERT_MSG(dlcqi.m_ri <= dlcqi.m_wbCqi.size(),
                           "Mismatch between the RI and the number of CQIs in a CQI report");
@@ -1265,6 +1282,41 @@ NrUePhy::GenerateDlCqiReport(const SpectrumValue& sinr, uint8_t streamId)
     }
 }
 
+void
+NrUePhy::UpdateDlSbCqi(const SpectrumValue& sinr, uint8_t wbCqi)
+{
+    NS_LOG_FUNCTION(this);
+    const std::size_t numRb = sinr.GetSpectrumModel()->GetNumBands();
+    const std::size_t numSb = (numRb + m_dlSbCqiSize - 1) / m_dlSbCqiSize;
+    if (m_prevDlSbCqi.size() != numSb)
+    {
+        // Sub-bands never measured take the WB CQI
+        m_prevDlSbCqi.assign(numSb, wbCqi);
+    }
+
+    // The SINR is measured only on the RBs of the received data: update the
+    // sub-bands with at least one of them, and keep the others
+    SpectrumValue sbSinr(sinr.GetSpectrumModel());
+    for (std::size_t sb = 0; sb < numSb; ++sb)
+    {
+        const std::size_t first = sb * m_dlSbCqiSize;
+        const std::size_t last = std::min(numRb, first + m_dlSbCqiSize);
+        bool measured = false;
+        sbSinr = 0.0;
+        for (std::size_t rb = first; rb < last; ++rb)
+        {
+            sbSinr[rb] = sinr[rb];
+            measured |= sinr[rb] != 0.0;
+        }
+        if (measured)
+        {
+            uint8_t mcs; // it is initialized by AMC in the following call
+            m_prevDlSbCqi[sb] = m_amc->CreateCqiFeedbackWbTdma(sbSinr, mcs);
+            NS_LOG_DEBUG("Sub-band " << sb << " CQI " << +m_prevDlSbCqi[sb] << " MCS " << +mcs);
+        }
+    }
+}
+
 void
 NrUePhy::EnqueueDlHarqFeedback(const DlHarqInfo& m)
 {
@@ -812,6 +812,15 @@ class NrUePhy : public NrPhy
      */
     uint8_t SelectRi(const std::vector<double>& avrgSinr);
 
+    /**
+     * \brief Update the cached sub-band CQI with the SINR of the first stream
+     * \param sinr the SINR
+     * \param wbCqi the WB CQI just computed from the same SINR
+     *
+     * Used when the attribute DlSubbandCqiSize is not 0.
+     */
+    void UpdateDlSbCqi(const SpectrumValue& sinr, uint8_t wbCqi);
+
     NrUePhySapUser* m_phySapUser;              //!< SAP pointer
     LteUeCphySapProvider* m_ueCphySapProvider; //!< SAP pointer
     LteUeCphySapUser* m_ueCphySapUser;         //!< SAP pointer
@@ -954,6 +963,8 @@ class NrUePhy : public NrPhy
         m_activeDlDataStreamsPerHarqId; // active streams per HARQ process ID
 
     std::vector<uint8_t> m_prevDlWbCqi; //!< Vector to cache the CQI values reported by this UE PHY
+    std::vector<uint8_t> m_prevDlSbCqi; //!< Cache of the sub-band CQI of the first stream
+    uint16_t m_dlSbCqiSize{0};          //!< RBs of a DL CQI sub-band (0: WB CQI only)
     uint8_t m_dlCqiFeedbackCounter{0};  /**< Counter to count the number of DL CQI
                                              report(s) this UE PHY prepares upon
                                              receiving SINR from underlying one or
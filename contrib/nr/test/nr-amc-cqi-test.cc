@@ -0,0 +1,214 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/enum.h>
+#include <ns3/lena-error-model.h>
+#include <ns3/nr-amc.h>
+#include <ns3/nr-eesm-cc-t1.h>
+#include <ns3/nr-eesm-cc-t2.h>
+#include <ns3/nr-eesm-ir-t1.h>
+#include <ns3/nr-eesm-ir-t2.h>
+#include <ns3/nr-lte-mi-error-model.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+#include <cmath>
+
+/**
+ * \file nr-amc-cqi-test.cc
+ * \ingroup test
+ *
+ * \brief Check that NrAmc::CreateCqiFeedbackWbTdma, with the ErrorModel AMC,
+ * selects the same CQI and MCS as a linear walk over the MCS with
+ * NrErrorModel::GetTbDecodificationStats: the highest MCS before the first
+ * one with a BLER above 10%. It is checked for each error model, in DL and
+ * UL, for flat and frequency-selective SINRs over a range of SINR values and
+ * numbers of RBs.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Check of the CQI/MCS selection of NrAmc against a linear search
+ */
+class NrAmcCqiTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param errorModel the error model type
+     * \param uplink whether the AMC is in UL mode
+     */
+    NrAmcCqiTestCase(TypeId errorModel, bool uplink)
+        : TestCase(errorModel.GetName() + (uplink ? ", UL" : ", DL")),
+          m_errorModel(errorModel),
+          m_uplink(uplink)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Select the CQI and MCS with a linear search over the MCS
+     * \param amc the AMC
+     * \param errorModel the error model of the AMC
+     * \param sinr the SINR values
+     * \param mcs the selected MCS
+     * \return the selected CQI
+     */
+    static uint8_t LinearSearch(const Ptr<NrAmc>& amc,
+                                const Ptr<NrErrorModel>& errorModel,
+                                const SpectrumValue& sinr,
+                                uint8_t& mcs);
+
+    TypeId m_errorModel; //!< Error model type
+    bool m_uplink;       //!< Whether the AMC is in UL mode
+};
+
+uint8_t
+NrAmcCqiTestCase::LinearSearch(const Ptr<NrAmc>& amc,
+                               const Ptr<NrErrorModel>& errorModel,
+                               const SpectrumValue& sinr,
+                               uint8_t& mcs)
+{
+    std::vector<int> rbMap;
+    for (uint32_t rb = 0; rb < sinr.GetValuesN(); ++rb)
+    {
+        if (sinr[rb] != 0.0)
+        {
+            rbMap.push_back(rb);
+        }
+    }
+
+    mcs = 0;
+    Ptr<NrErrorModelOutput> output;
+    while (mcs <= errorModel->GetMaxMcs())
+    {
+        output = errorModel->GetTbDecodificationStats(sinr,
+                                                      rbMap,
+                                                      amc->CalculateTbSize(mcs, rbMap.size()),
+                                                      mcs,
+                                                      NrErrorModel::NrErrorModelHistory());
+        if (output->m_tbler > 0.1)
+        {
+            break;
+        }
+        mcs++;
+    }
+    if (mcs > 0)
+    {
+        mcs--;
+    }
+
+    uint8_t cqi = 0;
+    if ((output->m_tbler > 0.1) && (mcs == 0))
+    {
+        cqi = 0;
+    }
+    else if (mcs == errorModel->GetMaxMcs())
+    {
+        cqi = 15;
+    }
+    else
+    {
+        double s = errorModel->GetSpectralEfficiencyForMcs(mcs);
+        while ((cqi < 15) && (errorModel->GetSpectralEfficiencyForCqi(cqi + 1) <= s))
+        {
+            ++cqi;
+        }
+    }
+    return cqi;
+}
+
+void
+NrAmcCqiTestCase::DoRun()
+{
+    Ptr<NrAmc> amc = CreateObject<NrAmc>();
+    amc->SetAttribute("AmcModel", EnumValue(NrAmc::ErrorModel));
+    amc->SetErrorModelType(m_errorModel);
+    if (m_uplink)
+    {
+        amc->SetUlMode();
+    }
+    else
+    {
+        amc->SetDlMode();
+    }
+
+    ObjectFactory factory;
+    factory.SetTypeId(m_errorModel);
+    Ptr<NrErrorModel> errorModel = DynamicCast<NrErrorModel>(factory.Create());
+
+    for (uint32_t numRb : {1, 6, 52, 106})
+    {
+        // From the bands, as the center frequencies need at least two RBs
+        Bands bands;
+        for (uint32_t rb = 0; rb < numRb; ++rb)
+        {
+            BandInfo band;
+            band.fc = 3.5e9 + rb * 180e3;
+            band.fl = band.fc - 90e3;
+            band.fh = band.fc + 90e3;
+            bands.push_back(band);
+        }
+        Ptr<SpectrumModel> model = Create<SpectrumModel>(bands);
+
+        for (bool selective : {false, true})
+        {
+            for (double sinrDb = -10.0; sinrDb <= 35.0; sinrDb += 0.25)
+            {
+                SpectrumValue sinr(model);
+                for (uint32_t rb = 0; rb < numRb; ++rb)
+                {
+                    double db = selective ? sinrDb + 6.0 * std::sin(0.7 * rb) : sinrDb;
+                    sinr[rb] = std::pow(10.0, db / 10.0);
+                }
+
+                uint8_t mcs = 0;
+                uint8_t expectedMcs = 0;
+                uint8_t cqi = amc->CreateCqiFeedbackWbTdma(sinr, mcs);
+                uint8_t expectedCqi = LinearSearch(amc, errorModel, sinr, expectedMcs);
+                NS_TEST_ASSERT_MSG_EQ(+mcs,
+                                      +expectedMcs,
+                                      "Wrong MCS for " << numRb << " RBs, SINR " << sinrDb
+                                                       << " dB" << (selective ? " (selective)" : ""));
+                NS_TEST_ASSERT_MSG_EQ(+cqi,
+                                      +expectedCqi,
+                                      "Wrong CQI for " << numRb << " RBs, SINR " << sinrDb
+                                                       << " dB" << (selective ? " (selective)" : ""));
+            }
+        }
+    }
+}
+
+/**
+ * \brief NrAmc CQI/MCS selection test suite
+ */
+class NrAmcCqiTestSuite : public TestSuite
+{
+  public:
+    NrAmcCqiTestSuite()
+        : TestSuite("nr-amc-cqi", UNIT)
+    {
+        for (const auto& errorModel : {NrEesmIrT1::GetTypeId(),
+                                       NrEesmIrT2::GetTypeId(),
+                                       NrEesmCcT1::GetTypeId(),
+                                       NrEesmCcT2::GetTypeId(),
+                                       NrLteMiErrorModel::GetTypeId(),
+                                       LenaErrorModel::GetTypeId()})
+        {
+            for (bool uplink : {false, true})
+            {
+                AddTestCase(new NrAmcCqiTestCase(errorModel, uplink), QUICK);
+            }
+        }
+    }
+};
+
+static NrAmcCqiTestSuite nrAmcCqiTestSuite; //!< NrAmc CQI/MCS selection test suite
+
+} // namespace ns3
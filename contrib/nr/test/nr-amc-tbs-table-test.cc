@@ -0,0 +1,143 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/lena-error-model.h>
+#include <ns3/nr-amc.h>
+#include <ns3/nr-eesm-cc-t1.h>
+#include <ns3/nr-eesm-cc-t2.h>
+#include <ns3/nr-eesm-ir-t1.h>
+#include <ns3/nr-eesm-ir-t2.h>
+#include <ns3/nr-lte-mi-error-model.h>
+#include <ns3/test.h>
+#include <ns3/uinteger.h>
+
+/**
+ * \file nr-amc-tbs-table-test.cc
+ * \ingroup test
+ *
+ * \brief Check that the table of TB sizes of NrAmc gives, for every MCS and
+ * number of RBs, the same value that the error model computes. For each error
+ * model, mode (DL or UL) and number of reference subcarriers per RB, an NrAmc
+ * with the table is compared against one with the table disabled
+ * ("TbsTableMaxPrb" = 0), also after a change of the configuration and beyond
+ * the size of the table.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Bit-exact check of the TB size table of NrAmc
+ */
+class NrAmcTbsTableTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param errorModel the error model type
+     * \param uplink whether the AMC is in UL mode
+     */
+    NrAmcTbsTableTestCase(TypeId errorModel, bool uplink)
+        : TestCase(errorModel.GetName() + (uplink ? ", UL" : ", DL")),
+          m_errorModel(errorModel),
+          m_uplink(uplink)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Compare the two AMCs for all the MCS and numbers of RBs
+     * \param table AMC with the table
+     * \param direct AMC without the table
+     * \param maxPrb largest number of RBs to check
+     */
+    void Compare(const Ptr<NrAmc>& table, const Ptr<NrAmc>& direct, uint32_t maxPrb);
+
+    TypeId m_errorModel; //!< Error model type
+    bool m_uplink;       //!< Whether the AMC is in UL mode
+};
+
+void
+NrAmcTbsTableTestCase::Compare(const Ptr<NrAmc>& table,
+                               const Ptr<NrAmc>& direct,
+                               uint32_t maxPrb)
+{
+    for (uint32_t mcs = 0; mcs <= table->GetMaxMcs(); ++mcs)
+    {
+        for (uint32_t nprb = 0; nprb <= maxPrb; ++nprb)
+        {
+            NS_TEST_ASSERT_MSG_EQ(table->CalculateTbSize(mcs, nprb),
+                                  direct->CalculateTbSize(mcs, nprb),
+                                  "TB size of the table differs for MCS " << mcs << " and "
+                                                                          << nprb << " RBs");
+        }
+    }
+}
+
+void
+NrAmcTbsTableTestCase::DoRun()
+{
+    Ptr<NrAmc> table = CreateObject<NrAmc>();
+    Ptr<NrAmc> direct = CreateObject<NrAmc>();
+    direct->SetAttribute("TbsTableMaxPrb", UintegerValue(0));
+
+    for (const auto& amc : {table, direct})
+    {
+        amc->SetErrorModelType(m_errorModel);
+        if (m_uplink)
+        {
+            amc->SetUlMode();
+        }
+        else
+        {
+            amc->SetDlMode();
+        }
+    }
+
+    // Beyond the table, the TB size is computed. The LENA error model only
+    // supports up to 110 LTE RBs, i.e., 110 * 11 RBs here
+    uint32_t maxPrb = table->GetTbsTableMaxPrb() + 5;
+    if (m_errorModel == LenaErrorModel::GetTypeId())
+    {
+        maxPrb = 110 * 11;
+    }
+
+    for (uint8_t nref : {1, 2, 4})
+    {
+        table->SetNumRefScPerRb(nref);
+        direct->SetNumRefScPerRb(nref);
+        Compare(table, direct, maxPrb);
+    }
+}
+
+/**
+ * \brief NrAmc TB size table test suite
+ */
+class NrAmcTbsTableTestSuite : public TestSuite
+{
+  public:
+    NrAmcTbsTableTestSuite()
+        : TestSuite("nr-amc-tbs-table", UNIT)
+    {
+        for (const auto& errorModel : {NrEesmIrT1::GetTypeId(),
+                                       NrEesmIrT2::GetTypeId(),
+                                       NrEesmCcT1::GetTypeId(),
+                                       NrEesmCcT2::GetTypeId(),
+                                       NrLteMiErrorModel::GetTypeId(),
+                                       LenaErrorModel::GetTypeId()})
+        {
+            for (bool uplink : {false, true})
+            {
+                AddTestCase(new NrAmcTbsTableTestCase(errorModel, uplink), QUICK);
+            }
+        }
+    }
+};
+
+static NrAmcTbsTableTestSuite nrAmcTbsTableTestSuite; //!< NrAmc TB size table test suite
+
+} // namespace ns3
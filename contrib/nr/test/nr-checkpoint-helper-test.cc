@@ -0,0 +1,221 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-checkpoint-helper.h>
+#include <ns3/nr-mac-scheduler-dpp-trace-writer.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+#include <csignal>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * \file nr-checkpoint-helper-test.cc
+ * \ingroup test
+ *
+ * \brief Kill a simulation after a checkpoint of NrCheckpointHelper, and
+ * check that once resumed it writes the same files as an uninterrupted run:
+ * a file added with AddOutputFile() and the g.txt of the DPP trace writer,
+ * whose thread and files have to survive the fork of the checkpoint. The
+ * values written are random, to check that the random streams are resumed
+ * too. Each simulation runs in a child process, since the helper turns the
+ * process that starts it into the supervisor.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Resume of a killed simulation from its last checkpoint
+ */
+class NrCheckpointHelperTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrCheckpointHelperTestCase()
+        : TestCase("Killed and resumed simulation against an uninterrupted one")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Run the simulation in a child process, in its own directory
+     * \param dir the working directory of the simulation
+     * \param kill whether the simulation is killed once, with checkpoints
+     * \return the exit status of the child
+     */
+    static int RunChild(const std::filesystem::path& dir, bool kill);
+
+    /**
+     * \brief Body of the child process
+     * \param kill whether the simulation is killed once, with checkpoints
+     */
+    [[noreturn]] static void RunSimulation(bool kill);
+
+    /**
+     * \brief Write a random value to the trace writer and to the output file
+     * \param rng the random variable
+     */
+    static void WriteSlot(Ptr<UniformRandomVariable> rng);
+
+    /**
+     * \brief Kill the simulation, unless it was resumed already
+     * \param checkpoint the checkpoint helper
+     */
+    static void Kill(Ptr<NrCheckpointHelper> checkpoint);
+
+    /**
+     * \brief Read a whole file
+     * \param fileName the file
+     * \return the content of the file
+     */
+    static std::string ReadFile(const std::filesystem::path& fileName);
+
+    static constexpr uint32_t m_numSlots = 100; //!< Slots of 1 ms
+};
+
+void
+NrCheckpointHelperTestCase::WriteSlot(Ptr<UniformRandomVariable> rng)
+{
+    double value = rng->GetValue();
+    NrMacSchedulerDppTraceWriter::Get()->Write(NrMacSchedulerDppTraceWriter::DPP_G, 1, value);
+    std::ofstream file("values.txt", std::ios::app);
+    file << Simulator::Now().GetMilliSeconds() << "\t" << value << "\n";
+}
+
+void
+NrCheckpointHelperTestCase::Kill(Ptr<NrCheckpointHelper> checkpoint)
+{
+    if (checkpoint->GetResumes() > 0)
+    {
+        return;
+    }
+    // Let the records after the checkpoint reach the files, to be truncated on resume
+    NrMacSchedulerDppTraceWriter::Get()->Flush();
+    std::ofstream("killed").close();
+    raise(SIGKILL);
+}
+
+void
+NrCheckpointHelperTestCase::RunSimulation(bool kill)
+{
+    Ptr<NrCheckpointHelper> checkpoint = CreateObject<NrCheckpointHelper>();
+    checkpoint->SetAttribute("Interval", TimeValue(kill ? MilliSeconds(10) : Seconds(0)));
+    checkpoint->AddOutputFile("values.txt");
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    for (uint32_t slot = 0; slot < m_numSlots; ++slot)
+    {
+        Simulator::Schedule(MilliSeconds(slot), &NrCheckpointHelperTestCase::WriteSlot, rng);
+    }
+    if (kill)
+    {
+        Simulator::Schedule(MicroSeconds(55500), &NrCheckpointHelperTestCase::Kill, checkpoint);
+    }
+
+    checkpoint->Start();
+    Simulator::Stop(MilliSeconds(m_numSlots));
+    Simulator::Run();
+    Simulator::Destroy();
+    _exit(0);
+}
+
+int
+NrCheckpointHelperTestCase::RunChild(const std::filesystem::path& dir, bool kill)
+{
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // The supervisor reports the resume on the standard error
+        int fd = open((dir / "stderr.txt").c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (chdir(dir.c_str()) != 0 || fd < 0)
+        {
+            _exit(1);
+        }
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+        RunSimulation(kill);
+    }
+    int status = -1;
+    if (pid > 0)
+    {
+        waitpid(pid, &status, 0);
+    }
+    return status;
+}
+
+std::string
+NrCheckpointHelperTestCase::ReadFile(const std::filesystem::path& fileName)
+{
+    std::ifstream file(fileName);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+void
+NrCheckpointHelperTestCase::DoRun()
+{
+    const std::filesystem::path dir =
+        std::filesystem::path(CreateTempDirFilename("")).parent_path();
+    const std::filesystem::path uninterrupted = dir / "nr-checkpoint-uninterrupted";
+    const std::filesystem::path resumed = dir / "nr-checkpoint-resumed";
+
+    int status = RunChild(uninterrupted, false);
+    bool success = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    NS_TEST_ASSERT_MSG_EQ(success, true, "The uninterrupted simulation failed");
+    status = RunChild(resumed, true);
+    success = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    NS_TEST_ASSERT_MSG_EQ(success, true, "The resumed simulation failed");
+    NS_TEST_ASSERT_MSG_EQ(std::filesystem::exists(resumed / "killed"),
+                          true,
+                          "The simulation was not killed");
+
+    for (const auto& file : {"values.txt", "g.txt"})
+    {
+        std::string expected = ReadFile(uninterrupted / file);
+        bool complete = std::count(expected.begin(), expected.end(), '\n') >= m_numSlots;
+        NS_TEST_ASSERT_MSG_EQ(complete, true, "Missing records in the uninterrupted " << file);
+        NS_TEST_ASSERT_MSG_EQ(ReadFile(resumed / file),
+                              expected,
+                              "The resumed simulation wrote another " << file);
+    }
+
+    std::filesystem::remove_all(uninterrupted);
+    std::filesystem::remove_all(resumed);
+}
+
+/**
+ * \brief NrCheckpointHelper test suite
+ */
+class NrCheckpointHelperTestSuite : public TestSuite
+{
+  public:
+    NrCheckpointHelperTestSuite()
+        : TestSuite("nr-checkpoint-helper", UNIT)
+    {
+#ifdef __linux__
+        AddTestCase(new NrCheckpointHelperTestCase(), QUICK);
+#endif
+    }
+};
+
+static NrCheckpointHelperTestSuite nrCheckpointHelperTestSuite; //!< Checkpoint helper test suite
+
+} // namespace ns3
@@ -0,0 +1,182 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-columnar-trace-file.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * \file nr-columnar-trace-file-test.cc
+ * \ingroup test
+ *
+ * \brief Write a NrColumnarTraceFile with an integer, a fixed-point and a
+ * float column over several chunks, read it back with
+ * NrColumnarTraceFileReader and check every value, then read time windows
+ * and check that only the chunks that overlap them are decoded.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Round trip of a NrColumnarTraceFile
+ */
+class NrColumnarTraceFileTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrColumnarTraceFileTestCase()
+        : TestCase("Write, read back and seek a columnar trace")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Read a time window and check it against the written rows
+     * \param reader the reader
+     * \param startNs start of the window
+     * \param endNs end of the window
+     */
+    void CheckWindow(NrColumnarTraceFileReader& reader, int64_t startNs, int64_t endNs);
+
+    /**
+     * \brief Time of a written row
+     * \param row the row
+     * \return the time, in ns: three rows (UEs) per 1 ms slot
+     */
+    static int64_t GetTime(uint32_t row)
+    {
+        return static_cast<int64_t>(row / 3) * 1000000;
+    }
+
+    /**
+     * \brief Values of a written row
+     * \param row the row
+     * \return the rnti, the fixed-point and the float values
+     */
+    static std::vector<double> GetValues(uint32_t row)
+    {
+        return {double(row % 3 + 1), row * 0.125 - 20.0, std::sin(row)};
+    }
+
+    static constexpr uint32_t m_numRows = 1000;     //!< Rows written
+    static constexpr uint32_t m_rowsPerChunk = 64; //!< Rows of a chunk
+};
+
+void
+NrColumnarTraceFileTestCase::CheckWindow(NrColumnarTraceFileReader& reader,
+                                         int64_t startNs,
+                                         int64_t endNs)
+{
+    std::vector<int64_t> timeNs;
+    std::vector<std::vector<double>> values;
+    uint32_t decoded = reader.Read(startNs, endNs, &timeNs, &values);
+
+    std::vector<uint32_t> rows;
+    std::vector<bool> chunks((m_numRows + m_rowsPerChunk - 1) / m_rowsPerChunk, false);
+    for (uint32_t row = 0; row < m_numRows; ++row)
+    {
+        if (GetTime(row) >= startNs && GetTime(row) < endNs)
+        {
+            rows.push_back(row);
+        }
+    }
+    for (uint32_t chunk = 0; chunk < chunks.size(); ++chunk)
+    {
+        uint32_t first = chunk * m_rowsPerChunk;
+        uint32_t last = std::min(first + m_rowsPerChunk, m_numRows) - 1;
+        chunks[chunk] = GetTime(last) >= startNs && GetTime(first) < endNs;
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(decoded,
+                          static_cast<uint32_t>(std::count(chunks.begin(), chunks.end(), true)),
+                          "Wrong number of decoded chunks for [" << startNs << ", " << endNs
+                                                                 << ")");
+    NS_TEST_ASSERT_MSG_EQ(timeNs.size(), rows.size(), "Wrong number of rows");
+    NS_TEST_ASSERT_MSG_EQ(values.size(), 3u, "Wrong number of columns");
+    for (std::size_t i = 0; i < std::min(timeNs.size(), rows.size()); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(timeNs[i], GetTime(rows[i]), "Wrong time of row " << rows[i]);
+        std::vector<double> expected = GetValues(rows[i]);
+        for (std::size_t c = 0; c < std::min<std::size_t>(values.size(), 3); ++c)
+        {
+            NS_TEST_ASSERT_MSG_EQ(values[c].size(), timeNs.size(), "Wrong column length");
+            if (i < values[c].size())
+            {
+                NS_TEST_ASSERT_MSG_EQ(values[c][i],
+                                      expected[c],
+                                      "Wrong value of column " << c << " of row " << rows[i]);
+            }
+        }
+    }
+}
+
+void
+NrColumnarTraceFileTestCase::DoRun()
+{
+    const std::string fileName = CreateTempDirFilename("nr-columnar-trace-file-test.nrct");
+    {
+        NrColumnarTraceFile file;
+        NS_TEST_ASSERT_MSG_EQ(file.Open(fileName,
+                                        {{"rnti", NrColumnarTraceFile::INTEGER, 1.0},
+                                         {"fixed", NrColumnarTraceFile::FIXED_POINT, 1e3},
+                                         {"float", NrColumnarTraceFile::FLOAT64, 1.0}},
+                                        m_rowsPerChunk),
+                              true,
+                              "Can't create " << fileName);
+        for (uint32_t row = 0; row < m_numRows; ++row)
+        {
+            std::vector<double> v = GetValues(row);
+            file.Append(GetTime(row), {v[0], v[1], v[2]});
+        }
+        file.Close();
+    }
+
+    NrColumnarTraceFileReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(fileName), true, "Can't read " << fileName);
+    NS_TEST_ASSERT_MSG_EQ(reader.GetNumRows(), uint64_t{m_numRows}, "Wrong number of rows");
+    const auto& columns = reader.GetColumns();
+    NS_TEST_ASSERT_MSG_EQ(columns.size(), 4u, "Wrong number of columns");
+    if (columns.size() == 4)
+    {
+        NS_TEST_ASSERT_MSG_EQ(columns[0].m_name, "time_ns", "Wrong time column");
+        NS_TEST_ASSERT_MSG_EQ(columns[2].m_name, "fixed", "Wrong fixed-point column");
+        NS_TEST_ASSERT_MSG_EQ(columns[2].m_kind,
+                              NrColumnarTraceFile::FIXED_POINT,
+                              "Wrong kind of the fixed-point column");
+        NS_TEST_ASSERT_MSG_EQ(columns[2].m_scale, 1e3, "Wrong scale of the fixed-point column");
+    }
+
+    // The whole file, a window inside a chunk, one across chunks, and one
+    // past the end
+    CheckWindow(reader, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+    CheckWindow(reader, GetTime(10), GetTime(20));
+    CheckWindow(reader, GetTime(100), GetTime(400));
+    CheckWindow(reader, GetTime(m_numRows) + 1, std::numeric_limits<int64_t>::max());
+}
+
+/**
+ * \brief NrColumnarTraceFile test suite
+ */
+class NrColumnarTraceFileTestSuite : public TestSuite
+{
+  public:
+    NrColumnarTraceFileTestSuite()
+        : TestSuite("nr-columnar-trace-file", UNIT)
+    {
+        AddTestCase(new NrColumnarTraceFileTestCase(), QUICK);
+    }
+};
+
+static NrColumnarTraceFileTestSuite nrColumnarTraceFileTestSuite; //!< Columnar trace test suite
+
+} // namespace ns3
@@ -0,0 +1,386 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/antenna-module.h>
+#include <ns3/applications-module.h>
+#include <ns3/double.h>
+#include <ns3/internet-module.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/nr-gfbr-prediction-stage.h>
+#include <ns3/nr-gfbr-predictor.h>
+#include <ns3/nr-mac-scheduler-ofdma-dpp.h>
+#include <ns3/nr-module.h>
+#include <ns3/object-factory.h>
+#include <ns3/point-to-point-helper.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+#include <ns3/traffic-generator-3gpp-pose-control.h>
+#include <ns3/traffic-generator-helper.h>
+#include <ns3/uinteger.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+/**
+ * \file nr-gfbr-predictor-test.cc
+ * \ingroup test
+ *
+ * \brief Feed series of offered loads to the GFBR predictors (sliding window
+ * with the maximum and with the median, EWMA with a safety margin, linear
+ * model read from a file) and check their predictions against values
+ * computed by hand, with two UEs for the linear one to check that their
+ * histories are separated.
+ *
+ * Then run a NrGfbrPredictionStage on a cell with a DPP scheduler and a
+ * periodic traffic generator, and check after every interval the offered
+ * load it measured, against the bytes of the Tx trace of the generator, and
+ * the GFBR it pushed to the scheduler for the RNTI of the UE.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Predictions of a GFBR predictor
+ */
+class NrGfbrPredictorTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief NrGfbrPredictorTestCase constructor
+     * \param name the name of the test
+     * \param predictor the factory of the predictor, created in DoRun()
+     * \param ues the UE of every observation
+     * \param loads the offered loads
+     * \param expected the expected predictions
+     * \param weights the content of the WeightsFile of a linear predictor
+     */
+    NrGfbrPredictorTestCase(const std::string& name,
+                            const ObjectFactory& predictor,
+                            const std::vector<uint32_t>& ues,
+                            const std::vector<double>& loads,
+                            const std::vector<double>& expected,
+                            const std::string& weights = "")
+        : TestCase(name),
+          m_predictor(predictor),
+          m_ues(ues),
+          m_loads(loads),
+          m_expected(expected),
+          m_weights(weights)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_predictor;      //!< Factory of the predictor
+    std::vector<uint32_t> m_ues;    //!< UE of every observation
+    std::vector<double> m_loads;    //!< Offered loads
+    std::vector<double> m_expected; //!< Expected predictions
+    std::string m_weights;          //!< Content of the WeightsFile, if any
+};
+
+void
+NrGfbrPredictorTestCase::DoRun()
+{
+    Ptr<NrGfbrPredictor> predictor = m_predictor.Create<NrGfbrPredictor>();
+    if (!m_weights.empty())
+    {
+        const std::string fileName = CreateTempDirFilename("nr-gfbr-predictor-linear.txt");
+        {
+            std::ofstream file(fileName);
+            file << m_weights;
+        }
+        predictor->SetAttribute("WeightsFile", StringValue(fileName));
+    }
+
+    for (std::size_t i = 0; i < m_loads.size(); ++i)
+    {
+        const double gfbr = predictor->Predict(m_ues[i], m_loads[i]);
+        NS_TEST_ASSERT_MSG_EQ_TOL(gfbr,
+                                  m_expected[i],
+                                  1e-6,
+                                  "Wrong prediction after observation " << i);
+    }
+}
+
+/**
+ * \brief GFBRs of a prediction stage, pushed to a DPP scheduler
+ */
+class NrGfbrPredictionStageTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrGfbrPredictionStageTestCase()
+        : TestCase("GFBRs of the prediction stage in a DPP scheduler")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Count a packet of the generator
+     * \param packet the packet
+     */
+    void GeneratorTx(Ptr<const Packet> packet);
+
+    /**
+     * \brief Check the offered load and the GFBR of the interval that just ended
+     * \param stage the prediction stage
+     * \param scheduler the scheduler
+     */
+    void CheckInterval(Ptr<NrGfbrPredictionStage> stage, Ptr<NrMacSchedulerOfdmaDPP> scheduler);
+
+    Ptr<NrUeNetDevice> m_ueDev;             //!< Device of the UE
+    const Time m_interval{MilliSeconds(50)}; //!< Interval of the stage
+    uint64_t m_txBytes{0};                  //!< Bytes of the generator in the interval
+    uint32_t m_checked{0};                  //!< Interval ends seen
+    std::vector<uint64_t> m_gfbrs;          //!< GFBRs in the scheduler, per interval
+
+    static constexpr uint32_t m_packetSize = 100; //!< Bytes of a packet of the generator
+    static constexpr double m_margin = 2.0;       //!< Margin of the predictor
+};
+
+void
+NrGfbrPredictionStageTestCase::GeneratorTx(Ptr<const Packet> packet)
+{
+    m_txBytes += packet->GetSize();
+}
+
+void
+NrGfbrPredictionStageTestCase::CheckInterval(Ptr<NrGfbrPredictionStage> stage,
+                                             Ptr<NrMacSchedulerOfdmaDPP> scheduler)
+{
+    const double load = m_txBytes * 8.0 / m_interval.GetSeconds();
+    m_txBytes = 0;
+    if (m_checked++ == 0)
+    {
+        // The stage only starts counting at its first interval end
+        return;
+    }
+    const auto gfbr = static_cast<uint64_t>(std::llround(m_margin * load));
+    const uint16_t rnti = m_ueDev->GetRrc()->GetRnti();
+    NS_TEST_EXPECT_MSG_EQ_TOL(stage->GetOfferedLoad(0),
+                              load,
+                              1e-6,
+                              "Wrong offered load at " << Simulator::Now().As(Time::MS));
+    NS_TEST_EXPECT_MSG_EQ(stage->GetGfbr(0),
+                          gfbr,
+                          "Wrong GFBR at " << Simulator::Now().As(Time::MS));
+    NS_TEST_EXPECT_MSG_EQ(scheduler->GetUeDlGfbr(rnti),
+                          gfbr,
+                          "Wrong GFBR of RNTI " << rnti << " in the scheduler at "
+                                                << Simulator::Now().As(Time::MS));
+    m_gfbrs.push_back(scheduler->GetUeDlGfbr(rnti));
+}
+
+void
+NrGfbrPredictionStageTestCase::DoRun()
+{
+    // The DPP scheduler writes its traces in the working directory
+    const std::filesystem::path previousDir = std::filesystem::current_path();
+    const std::filesystem::path dir =
+        std::filesystem::path(CreateTempDirFilename("")).parent_path() / "nr-gfbr-prediction-stage";
+    std::filesystem::create_directories(dir);
+    std::filesystem::current_path(dir);
+
+    NodeContainer gnbNodes;
+    gnbNodes.Create(1);
+    NodeContainer ueNodes;
+    ueNodes.Create(1);
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0.0, 0.0, 10.0));
+    positions->Add(Vector(60.0, 40.0, 1.5));
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(gnbNodes);
+    mobility.Install(ueNodes);
+
+    Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper>();
+    Ptr<IdealBeamformingHelper> beamformingHelper = CreateObject<IdealBeamformingHelper>();
+    beamformingHelper->SetAttribute("BeamformingMethod",
+                                    TypeIdValue(DirectPathBeamforming::GetTypeId()));
+    Ptr<NrHelper> nrHelper = CreateObject<NrHelper>();
+    nrHelper->SetBeamformingHelper(beamformingHelper);
+    nrHelper->SetEpcHelper(epcHelper);
+    nrHelper->SetSchedulerTypeId(NrMacSchedulerOfdmaDPP::GetTypeId());
+    nrHelper->SetUeAntennaAttribute("NumRows", UintegerValue(1));
+    nrHelper->SetUeAntennaAttribute("NumColumns", UintegerValue(1));
+    nrHelper->SetUeAntennaAttribute("AntennaElement",
+                                    PointerValue(CreateObject<IsotropicAntennaModel>()));
+    nrHelper->SetGnbAntennaAttribute("NumRows", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("NumColumns", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("AntennaElement",
+                                     PointerValue(CreateObject<IsotropicAntennaModel>()));
+    nrHelper->SetGnbPhyAttribute("Numerology", UintegerValue(1));
+    nrHelper->SetPathlossAttribute("ShadowingEnabled", BooleanValue(false));
+
+    CcBwpCreator ccBwpCreator;
+    CcBwpCreator::SimpleOperationBandConf bandConf(3.5e9,
+                                                   10e6,
+                                                   1,
+                                                   BandwidthPartInfo::UMi_StreetCanyon_LoS);
+    OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc(bandConf);
+    nrHelper->InitializeOperationBand(&band);
+    BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps({band});
+
+    NetDeviceContainer gnbDevs = nrHelper->InstallGnbDevice(gnbNodes, allBwps);
+    NetDeviceContainer ueDevs = nrHelper->InstallUeDevice(ueNodes, allBwps);
+    int64_t stream = nrHelper->AssignStreams(gnbDevs, 1);
+    nrHelper->AssignStreams(ueDevs, 1 + stream);
+    DynamicCast<NrGnbNetDevice>(gnbDevs.Get(0))->UpdateConfig();
+    m_ueDev = DynamicCast<NrUeNetDevice>(ueDevs.Get(0));
+    m_ueDev->UpdateConfig();
+
+    Ptr<Node> pgw = epcHelper->GetPgwNode();
+    NodeContainer remoteHostContainer;
+    remoteHostContainer.Create(1);
+    Ptr<Node> remoteHost = remoteHostContainer.Get(0);
+    InternetStackHelper internet;
+    internet.Install(remoteHostContainer);
+    PointToPointHelper p2ph;
+    p2ph.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Gb/s")));
+    p2ph.SetChannelAttribute("Delay", TimeValue(Seconds(0.0)));
+    NetDeviceContainer internetDevices = p2ph.Install(pgw, remoteHost);
+    Ipv4AddressHelper ipv4h;
+    ipv4h.SetBase("1.0.0.0", "255.0.0.0");
+    ipv4h.Assign(internetDevices);
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    ipv4RoutingHelper.GetStaticRouting(remoteHost->GetObject<Ipv4>())
+        ->AddNetworkRouteTo(Ipv4Address("7.0.0.0"), Ipv4Mask("255.0.0.0"), 1);
+    internet.Install(ueNodes);
+    Ipv4InterfaceContainer ueIpIface = epcHelper->AssignUeIpv4Address(ueDevs);
+    ipv4RoutingHelper.GetStaticRouting(ueNodes.Get(0)->GetObject<Ipv4>())
+        ->SetDefaultRoute(epcHelper->GetUeDefaultGatewayAddress(), 1);
+    nrHelper->AttachToClosestEnb(ueDevs, gnbDevs);
+
+    // One packet every 4 ms, from 100 ms to 300 ms, never at an interval end
+    const uint16_t port = 1234;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sinkHelper.Install(ueNodes.Get(0));
+    TrafficGeneratorHelper generatorHelper("ns3::UdpSocketFactory",
+                                           Address(),
+                                           TrafficGenerator3gppPoseControl::GetTypeId());
+    generatorHelper.SetAttribute("PacketSize", UintegerValue(m_packetSize));
+    generatorHelper.SetAttribute("Periodicity", UintegerValue(4));
+    generatorHelper.SetAttribute("Remote",
+                                 AddressValue(InetSocketAddress(ueIpIface.GetAddress(0), port)));
+    ApplicationContainer generatorApps = generatorHelper.Install(remoteHost);
+    sinkApps.Start(MilliSeconds(50));
+    generatorApps.Start(MilliSeconds(100));
+    generatorApps.Stop(MilliSeconds(300));
+
+    Ptr<TrafficGenerator> generator = DynamicCast<TrafficGenerator>(generatorApps.Get(0));
+    Ptr<NrMacSchedulerOfdmaDPP> scheduler =
+        DynamicCast<NrMacSchedulerOfdmaDPP>(NrHelper::GetScheduler(gnbDevs.Get(0), 0));
+    NS_TEST_ASSERT_MSG_NE(scheduler, nullptr, "The gNB has no DPP scheduler");
+
+    // The GFBR is twice the load of the last interval
+    Ptr<NrGfbrPredictionStage> stage = CreateObject<NrGfbrPredictionStage>();
+    stage->SetAttribute("PredictorType",
+                        TypeIdValue(TypeId::LookupByName("ns3::NrGfbrPredictorWindow")));
+    stage->GetPredictor()->SetAttribute("WindowSize", UintegerValue(1));
+    stage->GetPredictor()->SetAttribute("Margin", DoubleValue(m_margin));
+    stage->SetScheduler(scheduler);
+    stage->AddUe(m_ueDev, generator);
+    generator->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&NrGfbrPredictionStageTestCase::GeneratorTx, this));
+
+    const Time start = MicroSeconds(50500);
+    stage->Start(start, m_interval);
+    for (Time end = start; end < MilliSeconds(400); end += m_interval)
+    {
+        Simulator::Schedule(end + NanoSeconds(1),
+                            &NrGfbrPredictionStageTestCase::CheckInterval,
+                            this,
+                            stage,
+                            scheduler);
+    }
+
+    Simulator::Stop(MilliSeconds(400));
+    Simulator::Run();
+    stage->Dispose();
+    Simulator::Destroy();
+    std::filesystem::current_path(previousDir);
+    std::filesystem::remove_all(dir);
+
+    // 12 or 13 packets of 100 bytes in the intervals where the generator
+    // runs, none in the last one
+    NS_TEST_ASSERT_MSG_EQ(m_gfbrs.size(), 6u, "Wrong number of intervals");
+    const bool loaded = m_gfbrs.size() == 6 && m_gfbrs[2] >= 384000 && m_gfbrs[2] <= 416000;
+    NS_TEST_ASSERT_MSG_EQ(loaded, true, "Wrong GFBR during the traffic");
+    const bool idle = m_gfbrs.size() == 6 && m_gfbrs.back() == 0;
+    NS_TEST_ASSERT_MSG_EQ(idle, true, "Wrong GFBR without traffic");
+}
+
+/**
+ * \brief GFBR predictors test suite
+ */
+class NrGfbrPredictorTestSuite : public TestSuite
+{
+  public:
+    NrGfbrPredictorTestSuite()
+        : TestSuite("nr-gfbr-predictor", UNIT)
+    {
+        ObjectFactory max("ns3::NrGfbrPredictorWindow",
+                          "WindowSize",
+                          UintegerValue(3),
+                          "Margin",
+                          DoubleValue(1.5));
+        AddTestCase(new NrGfbrPredictorTestCase("Maximum of a sliding window",
+                                                max,
+                                                {0, 0, 0, 0, 0},
+                                                {1, 5, 2, 3, 1},
+                                                {1.5, 7.5, 7.5, 7.5, 4.5}),
+                    QUICK);
+
+        ObjectFactory median("ns3::NrGfbrPredictorWindow",
+                             "WindowSize",
+                             UintegerValue(3),
+                             "Quantile",
+                             DoubleValue(0.5));
+        AddTestCase(new NrGfbrPredictorTestCase("Median of a sliding window",
+                                                median,
+                                                {0, 0, 0, 0},
+                                                {4, 1, 3, 5},
+                                                {4, 1, 3, 3}),
+                    QUICK);
+
+        ObjectFactory ewma("ns3::NrGfbrPredictorEwma",
+                           "Alpha",
+                           DoubleValue(0.5),
+                           "Margin",
+                           DoubleValue(2.0));
+        AddTestCase(new NrGfbrPredictorTestCase("EWMA with a safety margin",
+                                                ewma,
+                                                {0, 0, 0},
+                                                {10, 20, 15},
+                                                {10, 25, 15 + 2 * std::sqrt(12.5)}),
+                    QUICK);
+
+        // Bias 0.5, weights 2 (last load) and -1, in Mbit/s
+        AddTestCase(new NrGfbrPredictorTestCase("Linear model from a file",
+                                                ObjectFactory("ns3::NrGfbrPredictorLinear"),
+                                                {0, 0, 1, 0},
+                                                {1e6, 3e6, 2e6, 0},
+                                                {1.5e6, 5.5e6, 2.5e6, 0},
+                                                "# bias, w1, w2\n0.5, 2\n-1\n"),
+                    QUICK);
+
+        AddTestCase(new NrGfbrPredictionStageTestCase(), QUICK);
+    }
+};
+
+static NrGfbrPredictorTestSuite nrGfbrPredictorTestSuite; //!< GFBR predictors test suite
+
+} // namespace ns3
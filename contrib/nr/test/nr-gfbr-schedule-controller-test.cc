@@ -0,0 +1,131 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-gfbr-schedule-controller.h>
+#include <ns3/nr-ue-net-device.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+#include <ns3/traffic-generator-3gpp-generic-video.h>
+
+#include <algorithm>
+
+/**
+ * \file nr-gfbr-schedule-controller-test.cc
+ * \ingroup test
+ *
+ * \brief Load the schedules of two UEs of different lengths in a
+ * NrGfbrScheduleController, save them to a binary file and load them in
+ * another controller, then run it and check, at the end of every interval,
+ * the values of the interval, and that the last values of a series stay once
+ * it ends.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Schedule of the GFBR schedule controller
+ */
+class NrGfbrScheduleControllerTestCase : public TestCase
+{
+  public:
+    NrGfbrScheduleControllerTestCase()
+        : TestCase("Schedule of the GFBR schedule controller")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Check the values of the interval that ends now
+     * \param controller the controller
+     */
+    void IntervalEnd(const NrGfbrScheduleController* controller);
+
+    std::vector<Time> m_times;                   //!< Times of the interval ends
+    std::vector<std::vector<uint64_t>> m_values; //!< Traffic and GFBR of the UEs, per interval
+};
+
+void
+NrGfbrScheduleControllerTestCase::IntervalEnd(const NrGfbrScheduleController* controller)
+{
+    m_times.push_back(Simulator::Now());
+    std::vector<uint64_t> values;
+    for (uint32_t ue = 0; ue < controller->GetNUes(); ++ue)
+    {
+        values.push_back(controller->GetTraffic(ue));
+        values.push_back(controller->GetGfbr(ue));
+    }
+    m_values.push_back(values);
+}
+
+void
+NrGfbrScheduleControllerTestCase::DoRun()
+{
+    const std::string fileName = CreateTempDirFilename("nr-gfbr-schedule.bin");
+
+    Ptr<NrGfbrScheduleController> saved = CreateObject<NrGfbrScheduleController>();
+    NS_TEST_ASSERT_MSG_EQ(saved->AddUe(nullptr, nullptr, {10, 20, 30}, {1, 2, 3}),
+                          0,
+                          "Wrong index of the first UE");
+    NS_TEST_ASSERT_MSG_EQ(saved->AddUe(nullptr, nullptr, {40}, {4}),
+                          1,
+                          "Wrong index of the second UE");
+    saved->SaveBinary(fileName);
+
+    Ptr<NrGfbrScheduleController> controller = CreateObject<NrGfbrScheduleController>();
+    controller->LoadBinary(fileName);
+    NS_TEST_ASSERT_MSG_EQ(controller->GetNUes(), 2, "Wrong number of UEs loaded");
+    controller->SetIntervalEndCallback(
+        MakeCallback(&NrGfbrScheduleControllerTestCase::IntervalEnd, this)
+            .Bind(PeekPointer(controller)));
+    controller->Start(MilliSeconds(100), MilliSeconds(50));
+
+    Simulator::Stop(MilliSeconds(310));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    const std::vector<std::vector<uint64_t>> expected = {
+        {0, 0, 0, 0},
+        {10, 1, 40, 4},
+        {20, 2, 40, 4},
+        {30, 3, 40, 4},
+        {30, 3, 40, 4},
+    };
+    NS_TEST_ASSERT_MSG_EQ(m_values.size(), expected.size(), "Wrong number of intervals");
+    for (std::size_t i = 0; i < std::min(m_values.size(), expected.size()); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_times[i],
+                              MilliSeconds(100 + 50 * i),
+                              "Wrong time of the end of interval " << i);
+        for (std::size_t j = 0; j < expected[i].size(); ++j)
+        {
+            NS_TEST_EXPECT_MSG_EQ(m_values[i][j],
+                                  expected[i][j],
+                                  "Wrong value " << j << " at the end of interval " << i);
+        }
+    }
+    controller->Dispose();
+    saved->Dispose();
+}
+
+/**
+ * \brief GFBR schedule controller test suite
+ */
+class NrGfbrScheduleControllerTestSuite : public TestSuite
+{
+  public:
+    NrGfbrScheduleControllerTestSuite()
+        : TestSuite("nr-gfbr-schedule-controller", UNIT)
+    {
+        AddTestCase(new NrGfbrScheduleControllerTestCase(), QUICK);
+    }
+};
+
+static NrGfbrScheduleControllerTestSuite
+    nrGfbrScheduleControllerTestSuite; //!< GFBR schedule controller test suite
+
+} // namespace ns3
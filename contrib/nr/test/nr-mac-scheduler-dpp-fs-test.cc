@@ -0,0 +1,201 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-amc.h>
+#include <ns3/nr-mac-scheduler-dpp-solver-native.h>
+#include <ns3/nr-mac-scheduler-ue-info-dpp.h>
+#include <ns3/test.h>
+
+/**
+ * \file nr-mac-scheduler-dpp-fs-test.cc
+ * \ingroup test
+ *
+ * \brief Check the RBG-by-RBG drift-plus-penalty allocation of
+ * NrMacSchedulerOfdmaDPPFS (NrMacSchedulerUeInfoDPP::LyapunovDppPerRbg):
+ *
+ * - with the same MCS in all the RBGs it gives the same allocation as the
+ *   wideband LyapunovDPP;
+ * - with frequency-selective UEs each RBG goes to the UE that reported the
+ *   best sub-band for it, the notched RBGs are not assigned, and each UE
+ *   transmits with the lowest MCS of its RBGs, in the TB size and in the DCI,
+ *   while its WB MCS is kept;
+ * - the RBGs take the lowest MCS of the sub-bands they overlap.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Test of the frequency-selective DPP allocation
+ */
+class NrMacSchedulerDppFsTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrMacSchedulerDppFsTestCase()
+        : TestCase("Frequency-selective DPP allocation")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Create an active UE
+     * \param rnti the RNTI
+     * \param wbMcs the WB MCS
+     * \param sbMcs the MCS of each sub-band (empty for a WB report)
+     * \param sbSize RBs of a sub-band
+     * \param buffer the buffer, in bytes
+     * \param g the virtual queue
+     * \return the UE and its buffer
+     */
+    NrMacSchedulerNs3::UePtrAndBufferReq CreateUe(uint16_t rnti,
+                                                  uint8_t wbMcs,
+                                                  const std::vector<uint8_t>& sbMcs,
+                                                  uint16_t sbSize,
+                                                  uint32_t buffer,
+                                                  double g) const;
+
+    static const uint32_t NUM_RB_PER_RBG = 2; //!< RBs of a RBG
+};
+
+NrMacSchedulerNs3::UePtrAndBufferReq
+NrMacSchedulerDppFsTestCase::CreateUe(uint16_t rnti,
+                                      uint8_t wbMcs,
+                                      const std::vector<uint8_t>& sbMcs,
+                                      uint16_t sbSize,
+                                      uint32_t buffer,
+                                      double g) const
+{
+    auto ue = std::make_shared<NrMacSchedulerUeInfoDPP>(rnti, BeamConfId(), []() {
+        return NUM_RB_PER_RBG;
+    });
+    ue->m_dlMcs = {wbMcs};
+    ue->m_g = g;
+    if (!sbMcs.empty())
+    {
+        ue->m_dlCqi.m_cqiType = NrMacSchedulerUeInfo::DlCqiInfo::SB;
+        ue->m_dlCqi.m_sbMcs = sbMcs;
+        ue->m_dlCqi.m_sbSize = sbSize;
+    }
+    return std::make_pair(ue, buffer);
+}
+
+void
+NrMacSchedulerDppFsTestCase::DoRun()
+{
+    Ptr<NrAmc> amc = CreateObject<NrAmc>();
+    NrMacSchedulerUeInfoDPP::SetDppV(1e3);
+    const uint32_t numRbg = 8;
+
+    // Same MCS in all the RBGs: the solution of LyapunovDPP
+    {
+        std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> ues = {
+            CreateUe(1, 10, {}, 0, 5000, 100.0),
+            CreateUe(2, 20, {20, 20, 20, 20}, 4, 4000, 0.0),
+            CreateUe(3, 5, {}, 0, 9000, 50.0)};
+
+        NrMacSchedulerDppContext ctx;
+        ctx.Refresh<NrMacSchedulerUeInfoDPP>(ues);
+        ctx.RefreshRbgMcs(numRbg, NUM_RB_PER_RBG);
+        NrMacSchedulerUeInfoDPP::LyapunovDppPerRbg(&ctx, {}, amc);
+        std::vector<uint32_t> perRbg;
+        for (const auto& ue : ues)
+        {
+            perRbg.push_back(static_cast<NrMacSchedulerUeInfoDPP*>(ue.first.get())->m_dlRBGallocated);
+        }
+
+        NrMacSchedulerDppContext wbCtx;
+        wbCtx.Refresh<NrMacSchedulerUeInfoDPP>(ues);
+        NrMacSchedulerUeInfoDPP::LyapunovDPP(&wbCtx,
+                                             numRbg,
+                                             amc,
+                                             CreateObject<NrMacSchedulerDppSolverNative>(),
+                                             nullptr);
+        for (std::size_t n = 0; n < ues.size(); ++n)
+        {
+            NS_TEST_ASSERT_MSG_EQ(
+                perRbg[n],
+                static_cast<NrMacSchedulerUeInfoDPP*>(ues[n].first.get())->m_dlRBGallocated,
+                "Allocation of UE " << n << " differs from LyapunovDPP");
+        }
+        NS_TEST_ASSERT_MSG_EQ(perRbg[1], numRbg, "All the RBGs should go to the best UE");
+    }
+
+    // Frequency-selective UEs, with the last RBG notched
+    {
+        std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> ues = {
+            CreateUe(1, 10, {25, 25, 3, 3}, 4, 5000, 0.0),
+            CreateUe(2, 10, {3, 3, 22, 25}, 4, 5000, 0.0)};
+
+        NrMacSchedulerDppContext ctx;
+        ctx.Refresh<NrMacSchedulerUeInfoDPP>(ues);
+        ctx.RefreshRbgMcs(numRbg, NUM_RB_PER_RBG);
+        std::vector<uint8_t> mask(numRbg, 1);
+        mask.back() = 0;
+        NrMacSchedulerUeInfoDPP::LyapunovDppPerRbg(&ctx, mask, amc);
+
+        const std::vector<int32_t> expected = {0, 0, 0, 0, 1, 1, 1, -1};
+        for (uint32_t k = 0; k < numRbg; ++k)
+        {
+            NS_TEST_ASSERT_MSG_EQ(ctx.m_rbgOwner[k], expected[k], "Wrong owner of RBG " << k);
+        }
+        auto first = static_cast<NrMacSchedulerUeInfoDPP*>(ues[0].first.get());
+        auto second = static_cast<NrMacSchedulerUeInfoDPP*>(ues[1].first.get());
+        NS_TEST_ASSERT_MSG_EQ(first->m_dlRBGallocated, 4, "Wrong number of RBGs of UE 1");
+        NS_TEST_ASSERT_MSG_EQ(second->m_dlRBGallocated, 3, "Wrong number of RBGs of UE 2");
+        NS_TEST_ASSERT_MSG_EQ(+first->m_dlSlotMcs, 25, "Wrong MCS of UE 1");
+        NS_TEST_ASSERT_MSG_EQ(+second->m_dlSlotMcs, 22, "Wrong MCS of UE 2");
+        NS_TEST_ASSERT_MSG_EQ(+second->m_dlRbgMask[7], 0, "A notched RBG was assigned");
+
+        // The TB and the DCI take the MCS of the RBGs, the WB MCS is kept
+        second->m_dlCqi.m_ri = 1;
+        second->m_dlRBG = second->m_dlRBGallocated;
+        second->UpdateDlMetric(amc);
+        NS_TEST_ASSERT_MSG_EQ(second->m_dlTbSize.at(0),
+                              amc->CalculateTbSize(22, 3 * NUM_RB_PER_RBG),
+                              "The TB size is not that of the MCS of the RBGs");
+        NS_TEST_ASSERT_MSG_EQ(+second->GetDlSlotMcs().at(0), 22, "Wrong MCS of the DCI");
+        NS_TEST_ASSERT_MSG_EQ(+second->m_dlMcs.at(0), 10, "The WB MCS was changed");
+        second->ResetDlSchedInfo();
+        NS_TEST_ASSERT_MSG_EQ(+second->GetDlSlotMcs().at(0), 10, "The RBGs outlived the slot");
+    }
+
+    // Sub-bands not aligned with the RBGs: 3 RBs, while a RBG has 2
+    {
+        std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> ues = {
+            CreateUe(1, 10, {10, 20, 15, 5, 12, 18}, 3, 5000, 0.0)};
+
+        NrMacSchedulerDppContext ctx;
+        ctx.Refresh<NrMacSchedulerUeInfoDPP>(ues);
+        ctx.RefreshRbgMcs(numRbg, NUM_RB_PER_RBG);
+        // RBG k has RBs 2k and 2k+1, in the sub-bands 2k/3 and (2k+1)/3
+        const std::vector<uint8_t> expected = {10, 10, 20, 15, 5, 5, 12, 12};
+        for (uint32_t k = 0; k < numRbg; ++k)
+        {
+            NS_TEST_ASSERT_MSG_EQ(+ctx.m_rbgMcs[k], +expected[k], "Wrong MCS of RBG " << k);
+        }
+    }
+}
+
+/**
+ * \brief Frequency-selective DPP test suite
+ */
+class NrMacSchedulerDppFsTestSuite : public TestSuite
+{
+  public:
+    NrMacSchedulerDppFsTestSuite()
+        : TestSuite("nr-mac-scheduler-dpp-fs", UNIT)
+    {
+        AddTestCase(new NrMacSchedulerDppFsTestCase(), QUICK);
+    }
+};
+
+static NrMacSchedulerDppFsTestSuite nrMacSchedulerDppFsTestSuite; //!< Frequency-selective DPP test suite
+
+} // namespace ns3
@@ -0,0 +1,196 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/boolean.h>
+#include <ns3/eps-bearer.h>
+#include <ns3/nr-amc.h>
+#include <ns3/nr-mac-scheduler-dpp-trace-writer.h>
+#include <ns3/nr-mac-scheduler-lc-qos.h>
+#include <ns3/nr-mac-scheduler-ue-info-dpp.h>
+#include <ns3/test.h>
+
+/**
+ * \file nr-mac-scheduler-dpp-lc-test.cc
+ * \ingroup test
+ *
+ * \brief Check the LC virtual queues of NrMacSchedulerUeInfoDPP. A UE has a
+ * GBR LC with its own GFBR and a non-GBR LC:
+ *
+ * - the LC queue grows by its GFBR in each slot in which it has data and no
+ *   service, and the virtual queue of the UE is the sum of the LC queues;
+ * - NrMacSchedulerLcQos gives the GBR LC, inside the TB, the bytes of its
+ *   GFBR plus its deficit, while the same LCs without the UE get a RR share;
+ * - the bytes assigned to the LC serve its queue;
+ * - the queue of the LC is emptied, and stays empty, while the LC has no data.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Test of the LC virtual queues of the DPP scheduler
+ */
+class NrMacSchedulerDppLcTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrMacSchedulerDppLcTestCase()
+        : TestCase("DPP LC virtual queues")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Add a LC to the DL LCG 1 of a UE
+     * \param ue the UE
+     * \param lcId the LC ID
+     * \param qci the QCI of the LC
+     * \param buffer the bytes in the RLC transmission queue
+     */
+    static void AddLc(NrMacSchedulerUeInfo* ue, uint8_t lcId, EpsBearer::Qci qci, uint32_t buffer);
+
+    /**
+     * \brief Get the bytes assigned to a LC
+     * \param assignations the assignations
+     * \param lcId the LC ID
+     * \return the bytes assigned
+     */
+    static uint32_t GetBytes(const std::vector<NrMacSchedulerLcAlgorithm::Assignation>& assignations,
+                             uint8_t lcId);
+};
+
+void
+NrMacSchedulerDppLcTestCase::AddLc(NrMacSchedulerUeInfo* ue,
+                                   uint8_t lcId,
+                                   EpsBearer::Qci qci,
+                                   uint32_t buffer)
+{
+    LogicalChannelConfigListElement_s conf;
+    conf.m_logicalChannelIdentity = lcId;
+    conf.m_logicalChannelGroup = 1;
+    conf.m_qci = qci;
+    if (ue->m_dlLCG.find(1) == ue->m_dlLCG.end())
+    {
+        ue->m_dlLCG.emplace(1, std::make_unique<NrMacSchedulerLCG>(1));
+    }
+    ue->m_dlLCG.at(1)->Insert(std::make_unique<NrMacSchedulerLC>(conf));
+
+    NrMacSchedSapProvider::SchedDlRlcBufferReqParameters params{};
+    params.m_rnti = ue->m_rnti;
+    params.m_logicalChannelIdentity = lcId;
+    params.m_rlcTransmissionQueueSize = buffer;
+    ue->m_dlLCG.at(1)->UpdateInfo(params);
+}
+
+uint32_t
+NrMacSchedulerDppLcTestCase::GetBytes(
+    const std::vector<NrMacSchedulerLcAlgorithm::Assignation>& assignations,
+    uint8_t lcId)
+{
+    uint32_t bytes = 0;
+    for (const auto& assignation : assignations)
+    {
+        if (assignation.m_lcId == lcId)
+        {
+            bytes += assignation.m_bytes;
+        }
+    }
+    return bytes;
+}
+
+void
+NrMacSchedulerDppLcTestCase::DoRun()
+{
+    NrMacSchedulerDppTraceWriter::Get()->SetAttribute("EnableDppQos", BooleanValue(false));
+
+    const double slot = 1e-3;
+    const uint8_t videoLc = 4;
+    const uint8_t audioLc = 5;
+    Ptr<NrAmc> amc = CreateObject<NrAmc>();
+    Ptr<NrMacSchedulerLcQos> lcAlgorithm = CreateObject<NrMacSchedulerLcQos>();
+
+    NrMacSchedulerUeInfoDPP ue(1, BeamConfId(), []() { return 1; });
+    ue.m_dlMcs = {10};
+    AddLc(&ue, videoLc, EpsBearer::GBR_CONV_VIDEO, 10000);
+    AddLc(&ue, audioLc, EpsBearer::NGBR_VIDEO_TCP_DEFAULT, 10000);
+
+    // 8 Mbit/s, 1000 bytes per slot
+    ue.SetDlLcGfbr(videoLc, 8e6);
+    NS_TEST_ASSERT_MSG_EQ(+ue.m_numLcQueues, 1, "Wrong number of LC queues");
+    NS_TEST_ASSERT_MSG_EQ(ue.GetDlLcGuaranteedBitRate(audioLc, UINT64_MAX),
+                          UINT64_MAX,
+                          "A LC without a queue is not guaranteed");
+
+    // Two slots without service
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        ue.m_dlRBG = 0;
+        ue.UpdateDlTputVirtualQueue(NrMacSchedulerNs3::FTResources(0, 0), slot, amc);
+    }
+    NS_TEST_ASSERT_MSG_EQ_TOL(ue.m_lcQueues[0].m_g, 16e6, 1e-3, "Wrong LC queue");
+    NS_TEST_ASSERT_MSG_EQ_TOL(ue.m_g, 16e6, 1e-3, "The UE queue is not the sum of the LC queues");
+
+    // The GBR LC gets 2000 bytes for its GFBR and deficit, and the rest is
+    // shared by all the active LCs
+    const uint32_t tbs = 5000;
+    auto withUe = lcAlgorithm->AssignBytesToDlLC(ue, tbs, Seconds(slot));
+    NS_TEST_ASSERT_MSG_EQ(GetBytes(withUe, videoLc), 3500, "Wrong bytes of the GBR LC");
+    NS_TEST_ASSERT_MSG_EQ(GetBytes(withUe, audioLc), 1500, "Wrong bytes of the non-GBR LC");
+
+    // Without the UE, no LC has a guaranteed bit rate
+    auto withoutUe = lcAlgorithm->AssignBytesToDlLC(ue.m_dlLCG, tbs, Seconds(slot));
+    NS_TEST_ASSERT_MSG_EQ(GetBytes(withoutUe, videoLc), 2500, "Wrong RR share");
+    NS_TEST_ASSERT_MSG_EQ(GetBytes(withoutUe, audioLc), 2500, "Wrong RR share");
+
+    // A smaller TB only serves part of the deficit
+    auto partial = lcAlgorithm->AssignBytesToDlLC(ue, 1500, Seconds(slot));
+    NS_TEST_ASSERT_MSG_EQ(GetBytes(partial, videoLc), 1500, "The GBR LC must take the whole TB");
+    for (const auto& assignation : partial)
+    {
+        ue.DlLcBytesAssigned(assignation.m_lcId, assignation.m_bytes, Seconds(slot));
+    }
+    NS_TEST_ASSERT_MSG_EQ_TOL(ue.m_lcQueues[0].m_g, 4e6, 1e-3, "Wrong LC queue after service");
+    NS_TEST_ASSERT_MSG_EQ_TOL(ue.m_g, 4e6, 1e-3, "Wrong UE queue after service");
+
+    // Once the GBR LC has nothing to send, its queue is emptied and does not grow
+    NrMacSchedSapProvider::SchedDlRlcBufferReqParameters params{};
+    params.m_rnti = ue.m_rnti;
+    params.m_logicalChannelIdentity = videoLc;
+    ue.m_dlLCG.at(1)->UpdateInfo(params);
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        ue.UpdateDlTputVirtualQueue(NrMacSchedulerNs3::FTResources(0, 0), slot, amc);
+    }
+    NS_TEST_ASSERT_MSG_EQ_TOL(ue.m_lcQueues[0].m_g, 0.0, 1e-3, "The queue of an idle LC grew");
+    NS_TEST_ASSERT_MSG_EQ_TOL(ue.m_g, 0.0, 1e-3, "Wrong UE queue with an idle LC");
+
+    // With new data, the LC queue grows again from zero
+    params.m_rlcTransmissionQueueSize = 10000;
+    ue.m_dlLCG.at(1)->UpdateInfo(params);
+    ue.UpdateDlTputVirtualQueue(NrMacSchedulerNs3::FTResources(0, 0), slot, amc);
+    NS_TEST_ASSERT_MSG_EQ_TOL(ue.m_lcQueues[0].m_g, 8e6, 1e-3, "Wrong LC queue after idle");
+    NS_TEST_ASSERT_MSG_EQ_TOL(ue.m_g, 8e6, 1e-3, "Wrong UE queue after idle");
+}
+
+/**
+ * \brief DPP LC virtual queue test suite
+ */
+class NrMacSchedulerDppLcTestSuite : public TestSuite
+{
+  public:
+    NrMacSchedulerDppLcTestSuite()
+        : TestSuite("nr-mac-scheduler-dpp-lc", UNIT)
+    {
+        AddTestCase(new NrMacSchedulerDppLcTestCase(), QUICK);
+    }
+};
+
+static NrMacSchedulerDppLcTestSuite nrMacSchedulerDppLcTestSuite; //!< DPP LC virtual queue test suite
+
+} // namespace ns3
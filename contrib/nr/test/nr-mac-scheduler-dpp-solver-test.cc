@@ -0,0 +1,162 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-mac-scheduler-dpp-solver-glpk-warm.h>
+#include <ns3/nr-mac-scheduler-dpp-solver-glpk.h>
+#include <ns3/nr-mac-scheduler-dpp-solver-native.h>
+#include <ns3/object-factory.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/rng-seed-manager.h>
+#include <ns3/test.h>
+
+/**
+ * \file nr-mac-scheduler-dpp-solver-test.cc
+ * \ingroup test
+ *
+ * \brief Check that the solvers of the drift-plus-penalty problem used by
+ * NrMacSchedulerOfdmaDPP agree. Random problems, with and without the
+ * fronthaul row, are solved with NrMacSchedulerDppSolverNative (or with the
+ * warm-started NrMacSchedulerDppSolverGlpkWarm, which sees them as a sequence
+ * of slots of different sizes) and with the GLPK reference
+ * NrMacSchedulerDppSolverGlpk, and the two solutions must be feasible and
+ * have the same objective value.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Cross-check of a DPP solver against the GLPK reference
+ */
+class NrMacSchedulerDppSolverTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param name Name of the test
+     * \param solverType the solver to check
+     * \param withFh whether the problems have a finite fronthaul budget
+     */
+    NrMacSchedulerDppSolverTestCase(const std::string& name, TypeId solverType, bool withFh)
+        : TestCase(name),
+          m_solverType(solverType),
+          m_withFh(withFh)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    TypeId m_solverType; //!< Solver under test
+    bool m_withFh;       //!< Whether the fronthaul row is active
+};
+
+void
+NrMacSchedulerDppSolverTestCase::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    ObjectFactory factory;
+    factory.SetTypeId(m_solverType);
+    Ptr<NrMacSchedulerDppSolver> solver = DynamicCast<NrMacSchedulerDppSolver>(factory.Create());
+    Ptr<NrMacSchedulerDppSolver> reference = CreateObject<NrMacSchedulerDppSolverGlpk>();
+
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    uniform->SetStream(1);
+
+    // A hand-made case: the most negative cost takes all the budget
+    {
+        NrMacSchedulerDppSolver::Problem p;
+        p.m_cost = {10.0, -3.0, -5.0, -5.0, 0.0};
+        p.m_rbgBudget = 17;
+        std::vector<double> alpha;
+        solver->Solve(p, &alpha);
+        NS_TEST_ASSERT_MSG_EQ(alpha.size(), 5, "Wrong solution size");
+        NS_TEST_ASSERT_MSG_EQ_TOL(NrMacSchedulerDppSolver::GetObjective(p, alpha),
+                                  -85.0,
+                                  1e-9,
+                                  "Wrong objective");
+    }
+
+    // Nothing is allocated when no cost is negative
+    {
+        NrMacSchedulerDppSolver::Problem p;
+        p.m_cost = {1.0, 0.0, 3.0};
+        p.m_rbgBudget = 10;
+        std::vector<double> alpha;
+        solver->Solve(p, &alpha);
+        for (const auto& a : alpha)
+        {
+            NS_TEST_ASSERT_MSG_EQ(a, 0.0, "Resources allocated with non-negative costs");
+        }
+    }
+
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        uint32_t N = uniform->GetInteger(1, 40);
+        NrMacSchedulerDppSolver::Problem p;
+        p.m_rbgBudget = uniform->GetInteger(1, 273);
+        for (uint32_t n = 0; n < N; ++n)
+        {
+            // Same shape as V - TBS * (Q + G), with some UEs not worth serving
+            p.m_cost.push_back(uniform->GetValue(-1e6, 2e5));
+            if (m_withFh)
+            {
+                p.m_fhCoef.push_back(uniform->GetValue(0.1, 10.0));
+            }
+        }
+        if (m_withFh)
+        {
+            p.m_fhBudget = uniform->GetValue(0.1, 5.0) * p.m_rbgBudget;
+        }
+
+        std::vector<double> alpha;
+        std::vector<double> alphaRef;
+        solver->Solve(p, &alpha);
+        reference->Solve(p, &alphaRef);
+
+        NS_TEST_ASSERT_MSG_EQ(NrMacSchedulerDppSolver::IsEquivalent(p, alpha, alphaRef),
+                              true,
+                              "Problem " << i << ": objective "
+                                         << NrMacSchedulerDppSolver::GetObjective(p, alpha)
+                                         << " differs from the reference "
+                                         << NrMacSchedulerDppSolver::GetObjective(p, alphaRef));
+    }
+}
+
+/**
+ * \brief DPP solver test suite
+ */
+class NrMacSchedulerDppSolverTestSuite : public TestSuite
+{
+  public:
+    NrMacSchedulerDppSolverTestSuite()
+        : TestSuite("nr-mac-scheduler-dpp-solver", UNIT)
+    {
+        AddTestCase(new NrMacSchedulerDppSolverTestCase("Native solver, RBG row only",
+                                                        NrMacSchedulerDppSolverNative::GetTypeId(),
+                                                        false),
+                    QUICK);
+        AddTestCase(new NrMacSchedulerDppSolverTestCase("Native solver, RBG and fronthaul rows",
+                                                        NrMacSchedulerDppSolverNative::GetTypeId(),
+                                                        true),
+                    QUICK);
+        AddTestCase(
+            new NrMacSchedulerDppSolverTestCase("Warm-started GLPK solver, RBG row only",
+                                                NrMacSchedulerDppSolverGlpkWarm::GetTypeId(),
+                                                false),
+            QUICK);
+        AddTestCase(
+            new NrMacSchedulerDppSolverTestCase("Warm-started GLPK solver, RBG and fronthaul rows",
+                                                NrMacSchedulerDppSolverGlpkWarm::GetTypeId(),
+                                                true),
+            QUICK);
+    }
+};
+
+static NrMacSchedulerDppSolverTestSuite nrMacSchedulerDppSolverTestSuite; //!< DPP solver test suite
+
+} // namespace ns3
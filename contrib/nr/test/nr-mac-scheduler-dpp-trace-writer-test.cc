@@ -0,0 +1,148 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-mac-scheduler-dpp-trace-writer.h>
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+#include <ns3/uinteger.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+/**
+ * \file nr-mac-scheduler-dpp-trace-writer-test.cc
+ * \ingroup test
+ *
+ * \brief Write through a NrMacSchedulerDppTraceWriter many more records than
+ * its ring holds, with a decimation period of two slots, and check that the
+ * text file has exactly the records of the decimated slots, in order and with
+ * the format of the schedulers, and that the producer stalled on the full
+ * ring instead of dropping records.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Ring, decimation and text output of the DPP trace writer
+ */
+class NrMacSchedulerDppTraceWriterTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrMacSchedulerDppTraceWriterTestCase()
+        : TestCase("Decimated records through a small ring")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Write the records of a slot, if the slot is sampled
+     * \param slot the index of the slot
+     */
+    void WriteSlot(uint32_t slot);
+
+    /**
+     * \brief Value written for a UE in a slot
+     * \param slot the slot
+     * \param rnti the RNTI
+     * \return the value
+     */
+    static double GetValue(uint32_t slot, uint16_t rnti)
+    {
+        return slot + rnti * 0.25;
+    }
+
+    static constexpr uint32_t m_numSlots = 100; //!< Slots of 1 ms
+    static constexpr uint16_t m_numUes = 100;   //!< UEs written per slot
+    static constexpr uint32_t m_bufferSize = 8; //!< Records of the ring
+
+    Ptr<NrMacSchedulerDppTraceWriter> m_writer; //!< The writer under test
+};
+
+void
+NrMacSchedulerDppTraceWriterTestCase::WriteSlot(uint32_t slot)
+{
+    if (!m_writer->Sample(NrMacSchedulerDppTraceWriter::DPP_G))
+    {
+        return;
+    }
+    for (uint16_t rnti = 1; rnti <= m_numUes; ++rnti)
+    {
+        m_writer->Write(NrMacSchedulerDppTraceWriter::DPP_G, rnti, GetValue(slot, rnti));
+    }
+}
+
+void
+NrMacSchedulerDppTraceWriterTestCase::DoRun()
+{
+    // The writer uses the file names of the schedulers, in the working directory
+    const std::filesystem::path previousDir = std::filesystem::current_path();
+    const std::filesystem::path dir =
+        std::filesystem::path(CreateTempDirFilename("")).parent_path();
+    std::filesystem::create_directories(dir);
+    std::filesystem::current_path(dir);
+
+    m_writer = CreateObject<NrMacSchedulerDppTraceWriter>();
+    m_writer->SetAttribute("BufferSize", UintegerValue(m_bufferSize));
+    m_writer->SetAttribute("DecimationPeriod", TimeValue(MilliSeconds(2)));
+    for (uint32_t slot = 0; slot < m_numSlots; ++slot)
+    {
+        Simulator::Schedule(MilliSeconds(slot),
+                            &NrMacSchedulerDppTraceWriterTestCase::WriteSlot,
+                            this,
+                            slot);
+    }
+    Simulator::Run();
+    m_writer->Flush();
+    uint64_t stalls = m_writer->GetStalls();
+    m_writer->Dispose();
+    m_writer = nullptr;
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(stalls, 0, "The producer never waited for the small ring");
+
+    // One slot every two, all the UEs of each recorded slot
+    std::ostringstream expected;
+    expected << "time\tue\tg\n";
+    for (uint32_t slot = 0; slot < m_numSlots; slot += 2)
+    {
+        for (uint16_t rnti = 1; rnti <= m_numUes; ++rnti)
+        {
+            expected << slot / 1.0 << "\t" << rnti << "\t" << GetValue(slot, rnti) << "\n";
+        }
+    }
+    std::ifstream file("g.txt");
+    std::ostringstream written;
+    written << file.rdbuf();
+    NS_TEST_ASSERT_MSG_EQ(written.str(), expected.str(), "Wrong content of g.txt");
+
+    std::filesystem::remove("g.txt");
+    std::filesystem::current_path(previousDir);
+}
+
+/**
+ * \brief DPP trace writer test suite
+ */
+class NrMacSchedulerDppTraceWriterTestSuite : public TestSuite
+{
+  public:
+    NrMacSchedulerDppTraceWriterTestSuite()
+        : TestSuite("nr-mac-scheduler-dpp-trace-writer", UNIT)
+    {
+        AddTestCase(new NrMacSchedulerDppTraceWriterTestCase(), QUICK);
+    }
+};
+
+static NrMacSchedulerDppTraceWriterTestSuite
+    nrMacSchedulerDppTraceWriterTestSuite; //!< DPP trace writer test suite
+
+} // namespace ns3
@@ -0,0 +1,221 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-amc.h>
+#include <ns3/nr-mac-scheduler-ue-info-dppa.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/rng-seed-manager.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+
+/**
+ * \file nr-mac-scheduler-dppa-test.cc
+ * \ingroup test
+ *
+ * \brief Check that the heap allocation of the DPPA scheduler
+ * (NrMacSchedulerUeInfoDPPA::AssignByK) gives every UE the same RBGs as the
+ * allocation it replaced, which sorted all the UEs of the beam with
+ * CompareContextDl and gave one RBG per iteration. K, MCS and virtual
+ * queues are drawn from small sets so that there are many ties, and the
+ * buffers and the band are such that some UEs are left without resources.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Heap and full-sort allocations of the DPPA scheduler
+ */
+class NrMacSchedulerDppaTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrMacSchedulerDppaTestCase()
+        : TestCase("DPPA heap allocation against the full sort")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Random K, MCS, virtual queue and buffer of a UE
+     */
+    struct UeParams
+    {
+        double m_k;        //!< K
+        uint8_t m_mcs;     //!< MCS
+        double m_g;        //!< Virtual queue
+        uint32_t m_buffer; //!< Buffer, in bytes
+    };
+
+    /**
+     * \brief Create the UEs of a beam
+     * \param params the parameters of each UE
+     * \param ctx the context to load with the UEs and their K
+     * \return the UEs and their buffers
+     */
+    static std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> CreateUes(
+        const std::vector<UeParams>& params,
+        NrMacSchedulerDppContext* ctx);
+
+    /**
+     * \brief The allocation before the heap: sort all the UEs, then give one
+     * RBG per iteration to the first UE whose buffer does not fit in its TB
+     * \param ctx the context, with the K of each UE in m_metric
+     * \param resources the RBGs available
+     * \param rbgAssignable the RBG count added to a UE for each RBG
+     * \param threshold the largest K of a UE that can receive resources
+     * \param amc the AMC
+     * \return the RBGs that are left
+     */
+    static uint32_t AssignBySort(NrMacSchedulerDppContext* ctx,
+                                 uint32_t resources,
+                                 uint32_t rbgAssignable,
+                                 double threshold,
+                                 const Ptr<const NrAmc>& amc);
+
+    /**
+     * \brief Sum of the TB sizes of the streams of a UE
+     * \param ue the UE
+     * \return the TB size
+     */
+    static uint32_t GetTbSize(const NrMacSchedulerUeInfoDPPA* ue);
+
+    Ptr<UniformRandomVariable> m_rng; //!< Random UE parameters
+
+    static const uint32_t NUM_RB_PER_RBG = 4; //!< RBs of a RBG
+};
+
+std::vector<NrMacSchedulerNs3::UePtrAndBufferReq>
+NrMacSchedulerDppaTestCase::CreateUes(const std::vector<UeParams>& params,
+                                      NrMacSchedulerDppContext* ctx)
+{
+    std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> ues;
+    for (std::size_t n = 0; n < params.size(); ++n)
+    {
+        auto ue = std::make_shared<NrMacSchedulerUeInfoDPPA>(n + 1, BeamConfId(), []() {
+            return NUM_RB_PER_RBG;
+        });
+        ue->m_dlCqi.m_ri = 1;
+        ue->m_dlMcs = {params[n].m_mcs};
+        ue->m_g = params[n].m_g;
+        ues.emplace_back(ue, params[n].m_buffer);
+    }
+    ctx->Refresh<NrMacSchedulerUeInfoDPPA>(ues);
+    for (std::size_t n = 0; n < params.size(); ++n)
+    {
+        ctx->m_metric[n] = params[n].m_k;
+    }
+    return ues;
+}
+
+uint32_t
+NrMacSchedulerDppaTestCase::GetTbSize(const NrMacSchedulerUeInfoDPPA* ue)
+{
+    uint32_t tbSize = 0;
+    for (const auto& it : ue->m_dlTbSize)
+    {
+        tbSize += it;
+    }
+    return tbSize;
+}
+
+uint32_t
+NrMacSchedulerDppaTestCase::AssignBySort(NrMacSchedulerDppContext* ctx,
+                                         uint32_t resources,
+                                         uint32_t rbgAssignable,
+                                         double threshold,
+                                         const Ptr<const NrAmc>& amc)
+{
+    std::sort(ctx->m_order.begin(), ctx->m_order.end(), [ctx](uint32_t l, uint32_t r) {
+        return NrMacSchedulerUeInfoDPPA::CompareContextDl(*ctx, l, r);
+    });
+    std::size_t prio = 0;
+    while (resources > 0 && prio < ctx->GetSize())
+    {
+        uint32_t i = ctx->m_order[prio];
+        if (threshold < ctx->m_metric[i])
+        {
+            break;
+        }
+        auto ue = ctx->GetUe<NrMacSchedulerUeInfoDPPA>(i);
+        if (ctx->m_ue[i]->second > GetTbSize(ue))
+        {
+            ue->m_dlRBG += rbgAssignable;
+            resources -= 1;
+            ue->UpdateDlMetric(amc);
+        }
+        else
+        {
+            prio++;
+        }
+    }
+    return resources;
+}
+
+void
+NrMacSchedulerDppaTestCase::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(1);
+    Ptr<NrAmc> amc = CreateObject<NrAmc>();
+
+    const double threshold = -1.0;
+    for (uint32_t trial = 0; trial < 200; ++trial)
+    {
+        const uint32_t numUes = m_rng->GetInteger(1, 40);
+        const uint32_t resources = m_rng->GetInteger(1, 50);
+        const uint32_t rbgAssignable = m_rng->GetInteger(1, 2);
+        std::vector<UeParams> params;
+        for (uint32_t n = 0; n < numUes; ++n)
+        {
+            params.push_back({-1.0 * m_rng->GetInteger(0, 4),
+                              static_cast<uint8_t>(5 * m_rng->GetInteger(0, 4)),
+                              100.0 * m_rng->GetInteger(0, 2),
+                              m_rng->GetInteger(1, 3000)});
+        }
+
+        // The context keeps references to the UE vectors
+        NrMacSchedulerDppContext heapCtx;
+        auto heapUes = CreateUes(params, &heapCtx);
+        NrMacSchedulerDppContext sortCtx;
+        auto sortUes = CreateUes(params, &sortCtx);
+
+        uint32_t heapLeft =
+            NrMacSchedulerUeInfoDPPA::AssignByK(&heapCtx, resources, rbgAssignable, threshold, amc);
+        uint32_t sortLeft = AssignBySort(&sortCtx, resources, rbgAssignable, threshold, amc);
+
+        NS_TEST_ASSERT_MSG_EQ(heapLeft, sortLeft, "Different RBGs left in trial " << trial);
+        for (uint32_t n = 0; n < numUes; ++n)
+        {
+            NS_TEST_ASSERT_MSG_EQ(heapUes[n].first->m_dlRBG,
+                                  sortUes[n].first->m_dlRBG,
+                                  "Different RBGs for UE " << n + 1 << " in trial " << trial);
+        }
+    }
+}
+
+/**
+ * \brief DPPA scheduler test suite
+ */
+class NrMacSchedulerDppaTestSuite : public TestSuite
+{
+  public:
+    NrMacSchedulerDppaTestSuite()
+        : TestSuite("nr-mac-scheduler-dppa", UNIT)
+    {
+        AddTestCase(new NrMacSchedulerDppaTestCase(), QUICK);
+    }
+};
+
+static NrMacSchedulerDppaTestSuite nrMacSchedulerDppaTestSuite; //!< DPPA scheduler test suite
+
+} // namespace ns3
@@ -0,0 +1,199 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/nr-eesm-cc-t1.h>
+#include <ns3/nr-lte-mi-error-model.h>
+#include <ns3/nr-sinr-kernels.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+#include <cmath>
+
+/**
+ * \file nr-sinr-kernels-test.cc
+ * \ingroup test
+ *
+ * \brief Check the vector paths of NrSinrKernels against the scalar one, for
+ * every instruction set supported by the CPU:
+ *
+ * - the sum of exponential SINRs, for every number of RBs up to 273 (all the
+ *   remainders of the vector width), over a range of SINRs and betas that
+ *   includes underflowing exponentials;
+ * - the sum of the MI, including the SINRs below and above the table;
+ * - the effective SINR of the EESM model and the BLER of the MI model.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Test of a vector instruction set of the effective SINR kernels
+ */
+class NrSinrKernelsTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param isa the instruction set to check against the scalar one
+     */
+    NrSinrKernelsTestCase(NrSinrKernels::Isa isa)
+        : TestCase("Effective SINR kernels, " + NrSinrKernels::GetIsaName(isa)),
+          m_isa(isa)
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Get the SINR of a RB
+     * \param rb the RB
+     * \param offsetDb the SINR offset, in dB
+     * \return the linear SINR, between offsetDb - 20 dB and offsetDb + 40 dB
+     */
+    static double GetSinr(uint32_t rb, double offsetDb);
+
+    NrSinrKernels::Isa m_isa; //!< Instruction set to check
+};
+
+double
+NrSinrKernelsTestCase::GetSinr(uint32_t rb, double offsetDb)
+{
+    return std::pow(10.0, (offsetDb + 10.0 + 30.0 * std::sin(0.37 * rb)) / 10.0);
+}
+
+void
+NrSinrKernelsTestCase::DoRun()
+{
+    const NrSinrKernels::Isa defaultIsa = NrSinrKernels::GetIsa();
+    const uint32_t numRbs = 273;
+
+    std::vector<double> sinr(numRbs);
+    std::vector<int> map;
+    std::vector<double> miTable(100);
+    for (std::size_t i = 0; i < miTable.size(); ++i)
+    {
+        miTable[i] = std::sqrt(i / 99.0);
+    }
+
+    for (double offsetDb : {-10.0, 0.0, 20.0})
+    {
+        for (uint32_t rb = 0; rb < numRbs; ++rb)
+        {
+            sinr[rb] = GetSinr(rb, offsetDb);
+        }
+        sinr[7] = 0.0;
+
+        for (uint32_t n = 1; n <= numRbs; ++n)
+        {
+            // RBs in a scattered order
+            map.clear();
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                map.push_back((i * 101) % numRbs);
+            }
+
+            for (double beta : {0.5, 1.6, 20.0, 300.0})
+            {
+                NrSinrKernels::SetIsa(NrSinrKernels::SCALAR);
+                double expected = NrSinrKernels::SumExp(sinr.data(), map.data(), n, beta);
+                NrSinrKernels::SetIsa(m_isa);
+                double sum = NrSinrKernels::SumExp(sinr.data(), map.data(), n, beta);
+                NS_TEST_ASSERT_MSG_EQ_TOL(sum,
+                                          expected,
+                                          std::max(expected * 1e-13, 1e-300),
+                                          "Wrong sum of exponentials with " << n << " RBs, beta "
+                                                                            << beta);
+            }
+
+            NrSinrKernels::SetIsa(NrSinrKernels::SCALAR);
+            double expected = NrSinrKernels::SumMi(sinr.data(),
+                                                   map.data(),
+                                                   n,
+                                                   miTable.data(),
+                                                   miTable.size(),
+                                                   0.5,
+                                                   50.0,
+                                                   99 / 49.5);
+            NrSinrKernels::SetIsa(m_isa);
+            double sum = NrSinrKernels::SumMi(sinr.data(),
+                                              map.data(),
+                                              n,
+                                              miTable.data(),
+                                              miTable.size(),
+                                              0.5,
+                                              50.0,
+                                              99 / 49.5);
+            NS_TEST_ASSERT_MSG_EQ_TOL(sum, expected, 1e-12, "Wrong sum of MI with " << n << " RBs");
+        }
+    }
+
+    // The error models, on a band with 273 RBs
+    std::vector<double> freqs;
+    map.clear();
+    for (uint32_t rb = 0; rb < numRbs; ++rb)
+    {
+        freqs.push_back(3.5e9 + rb * 180e3);
+        map.push_back(rb);
+    }
+    SpectrumValue sinrValue(Create<SpectrumModel>(freqs));
+    for (uint32_t rb = 0; rb < numRbs; ++rb)
+    {
+        sinrValue[rb] = GetSinr(rb, 0.0);
+    }
+
+    Ptr<NrEesmCcT1> eesm = CreateObject<NrEesmCcT1>();
+    Ptr<NrLteMiErrorModel> mi = CreateObject<NrLteMiErrorModel>();
+    for (uint8_t mcs = 0; mcs <= eesm->GetMaxMcs(); ++mcs)
+    {
+        NrSinrKernels::SetIsa(NrSinrKernels::SCALAR);
+        auto expected = DynamicCast<NrEesmErrorModelOutput>(
+            eesm->GetTbDecodificationStats(sinrValue, map, 1000, mcs, {}));
+        NrSinrKernels::SetIsa(m_isa);
+        auto output = DynamicCast<NrEesmErrorModelOutput>(
+            eesm->GetTbDecodificationStats(sinrValue, map, 1000, mcs, {}));
+        NS_TEST_ASSERT_MSG_EQ_TOL(output->m_sinrEff,
+                                  expected->m_sinrEff,
+                                  std::abs(expected->m_sinrEff) * 1e-12,
+                                  "Wrong effective SINR of the EESM model, MCS " << +mcs);
+        NS_TEST_ASSERT_MSG_EQ_TOL(output->m_sinrExp,
+                                  expected->m_sinrExp,
+                                  expected->m_sinrExp * 1e-12,
+                                  "Wrong sum of exponentials of the EESM model, MCS " << +mcs);
+    }
+    for (uint8_t mcs = 0; mcs <= mi->GetMaxMcs(); ++mcs)
+    {
+        NrSinrKernels::SetIsa(NrSinrKernels::SCALAR);
+        double expected = mi->GetTbDecodificationStats(sinrValue, map, 1000, mcs, {})->m_tbler;
+        NrSinrKernels::SetIsa(m_isa);
+        double tbler = mi->GetTbDecodificationStats(sinrValue, map, 1000, mcs, {})->m_tbler;
+        NS_TEST_ASSERT_MSG_EQ_TOL(tbler, expected, 1e-9, "Wrong TBLER of the MI model, MCS " << +mcs);
+    }
+
+    NrSinrKernels::SetIsa(defaultIsa);
+}
+
+/**
+ * \brief Effective SINR kernels test suite
+ */
+class NrSinrKernelsTestSuite : public TestSuite
+{
+  public:
+    NrSinrKernelsTestSuite()
+        : TestSuite("nr-sinr-kernels", UNIT)
+    {
+        for (auto isa : {NrSinrKernels::AVX2, NrSinrKernels::AVX512F})
+        {
+            if (NrSinrKernels::IsSupported(isa))
+            {
+                AddTestCase(new NrSinrKernelsTestCase(isa), QUICK);
+            }
+        }
+    }
+};
+
+static NrSinrKernelsTestSuite nrSinrKernelsTestSuite; //!< Effective SINR kernels test suite
+
+} // namespace ns3
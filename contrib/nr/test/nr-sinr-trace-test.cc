@@ -0,0 +1,423 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/antenna-module.h>
+#include <ns3/applications-module.h>
+#include <ns3/enum.h>
+#include <ns3/internet-module.h>
+#include <ns3/nr-module.h>
+#include <ns3/nr-sinr-trace.h>
+#include <ns3/point-to-point-helper.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+
+#include <sstream>
+
+/**
+ * \file nr-sinr-trace-test.cc
+ * \ingroup test
+ *
+ * \brief Record SINRs of two UEs (one in DL, one in UL) with NrSinrTrace, then
+ * replay them and check the sample-and-hold of each RB, the average for the
+ * RBs never recorded, and that nothing is replaced before the first record of
+ * a UE or for an unknown UE.
+ *
+ * Then record a cell with a 3GPP UMi street canyon channel, with shadowing,
+ * replay it on a RMa LoS channel without shadowing, and check that the MAC
+ * takes the same DL and UL decisions in both runs, while a run on the RMa
+ * channel without the trace takes other ones. In the replay no data frame
+ * goes through the spectrum channel.
+ */
+namespace ns3
+{
+
+/**
+ * \brief Record and replay of the SINR trace
+ */
+class NrSinrTraceTestCase : public TestCase
+{
+  public:
+    NrSinrTraceTestCase()
+        : TestCase("Record and replay of the SINR trace")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Create a SINR with the given values
+     * \param values the linear SINR of the RBs
+     * \return the SINR
+     */
+    SpectrumValue MakeSinr(const std::vector<double>& values) const;
+
+    /**
+     * \brief Replay the SINR of a UE and check it
+     * \param trace the trace, in replay mode
+     * \param key the UE
+     * \param current the SINR before the replay
+     * \param rbs the RBs to replay
+     * \param found whether the UE is expected to have records up to now
+     * \param expected the expected SINR after the replay
+     */
+    void CheckReplay(const Ptr<NrSinrTrace>& trace,
+                     const NrSinrTrace::Key& key,
+                     const std::vector<double>& current,
+                     const std::vector<int>& rbs,
+                     bool found,
+                     const std::vector<double>& expected);
+
+    Ptr<SpectrumModel> m_model; //!< Spectrum model with 8 RBs
+};
+
+SpectrumValue
+NrSinrTraceTestCase::MakeSinr(const std::vector<double>& values) const
+{
+    SpectrumValue sinr(m_model);
+    for (std::size_t rb = 0; rb < values.size(); ++rb)
+    {
+        sinr[rb] = values[rb];
+    }
+    return sinr;
+}
+
+void
+NrSinrTraceTestCase::CheckReplay(const Ptr<NrSinrTrace>& trace,
+                                 const NrSinrTrace::Key& key,
+                                 const std::vector<double>& current,
+                                 const std::vector<int>& rbs,
+                                 bool found,
+                                 const std::vector<double>& expected)
+{
+    SpectrumValue sinr = MakeSinr(current);
+    bool replayed = trace->ReplaySinr(key, &sinr, rbs);
+    NS_TEST_ASSERT_MSG_EQ(replayed,
+                          found,
+                          "Unexpected replay for RNTI " << key.m_rnti << " at "
+                                                        << Simulator::Now().As(Time::MS));
+    for (std::size_t rb = 0; rb < expected.size(); ++rb)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(sinr[rb],
+                                  expected[rb],
+                                  1e-6,
+                                  "Wrong SINR of RB " << rb << " for RNTI " << key.m_rnti << " at "
+                                                      << Simulator::Now().As(Time::MS));
+    }
+}
+
+void
+NrSinrTraceTestCase::DoRun()
+{
+    std::vector<double> freqs;
+    for (uint32_t rb = 0; rb < 8; ++rb)
+    {
+        freqs.push_back(3.5e9 + rb * 180e3);
+    }
+    m_model = Create<SpectrumModel>(freqs);
+    const std::string fileName = CreateTempDirFilename("nr-sinr-trace.bin");
+
+    NrSinrTrace::Key dlUe;
+    dlUe.m_direction = NrSinrTrace::DL;
+    dlUe.m_cellId = 1;
+    dlUe.m_rnti = 3;
+    NrSinrTrace::Key ulUe = dlUe;
+    ulUe.m_direction = NrSinrTrace::UL;
+    ulUe.m_rnti = 4;
+    NrSinrTrace::Key unknownUe = dlUe;
+    unknownUe.m_rnti = 5;
+
+    // Record
+    Ptr<NrSinrTrace> record = CreateObject<NrSinrTrace>();
+    record->SetAttribute("Mode", EnumValue(NrSinrTrace::RECORD));
+    record->SetAttribute("FileName", StringValue(fileName));
+    Simulator::Schedule(MilliSeconds(1), [&]() {
+        record->RecordSinr(dlUe, MakeSinr({1.0, 2.0, 0.0, 4.0}), {});
+        record->RecordSinr(ulUe, MakeSinr({9.0, 0.0, 0.0, 0.0, 0.0, 5.0, 7.0}), {5, 6});
+    });
+    Simulator::Schedule(MilliSeconds(2),
+                        [&]() { record->RecordSinr(dlUe, MakeSinr({0.0, 8.0}), {}); });
+    Simulator::Run();
+    Simulator::Destroy();
+    record->Dispose();
+
+    // Replay
+    Ptr<NrSinrTrace> replay = CreateObject<NrSinrTrace>();
+    replay->SetAttribute("Mode", EnumValue(NrSinrTrace::REPLAY));
+    replay->SetAttribute("FileName", StringValue(fileName));
+    Simulator::Schedule(MicroSeconds(500), [&]() {
+        CheckReplay(replay, dlUe, {3.0, 3.0}, {}, false, {3.0, 3.0});
+    });
+    Simulator::Schedule(MilliSeconds(1), [&]() {
+        // RB 2 was not recorded: average of the others
+        CheckReplay(replay,
+                    dlUe,
+                    {3.0, 3.0, 3.0, 3.0, 0.0},
+                    {},
+                    true,
+                    {1.0, 2.0, 7.0 / 3, 4.0, 0.0});
+        CheckReplay(replay,
+                    ulUe,
+                    {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0},
+                    {5, 6},
+                    true,
+                    {0.0, 0.0, 0.0, 0.0, 0.0, 5.0, 7.0});
+    });
+    Simulator::Schedule(MilliSeconds(3), [&]() {
+        // RB 1 updated at 2 ms, RB 3 without SINR now
+        CheckReplay(replay, dlUe, {3.0, 3.0, 3.0, 0.0}, {}, true, {1.0, 8.0, 13.0 / 3, 0.0});
+        // Only the RBs of the TB are replaced
+        CheckReplay(replay,
+                    ulUe,
+                    {0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0},
+                    {6, 7},
+                    true,
+                    {0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 7.0, 6.0});
+        CheckReplay(replay, unknownUe, {3.0}, {}, false, {3.0});
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+    replay->Dispose();
+}
+
+/**
+ * \brief Same MAC decisions when the SINR is replayed over another channel
+ */
+class NrSinrTraceReplayTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrSinrTraceReplayTestCase()
+        : TestCase("Same MAC decisions on a replayed SINR trace")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Run a cell with two UEs, DL and UL traffic, and adaptive MCS
+     * \param scenario the channel of the band
+     * \param shadowing whether the pathloss has shadowing
+     * \return the DL and UL decisions of the MAC, one per line
+     */
+    std::string RunCell(BandwidthPartInfo::Scenario scenario, bool shadowing);
+
+    /**
+     * \brief Write a decision of the MAC
+     * \param dir "DL" or "UL"
+     * \param info the decision
+     */
+    void Scheduled(std::string dir, NrSchedulingCallbackInfo info);
+
+    /**
+     * \brief Count the data frames transmitted on the spectrum channel
+     * \param params the parameters of the transmitted signal
+     */
+    void ChannelTx(Ptr<SpectrumSignalParameters> params);
+
+    std::ostringstream m_decisions;  //!< The decisions of the current run
+    uint32_t m_channelDataFrames{0}; //!< Data frames on the channel in the current run
+};
+
+void
+NrSinrTraceReplayTestCase::Scheduled(std::string dir, NrSchedulingCallbackInfo info)
+{
+    m_decisions << Simulator::Now().GetNanoSeconds() << " " << dir << " " << info.m_rnti << " "
+                << +info.m_symStart << " " << +info.m_numSym << " " << +info.m_mcs << " "
+                << info.m_tbSize << " " << +info.m_ndi << " " << +info.m_rv << "\n";
+}
+
+void
+NrSinrTraceReplayTestCase::ChannelTx(Ptr<SpectrumSignalParameters> params)
+{
+    if (DynamicCast<NrSpectrumSignalParametersDataFrame>(params) != nullptr)
+    {
+        ++m_channelDataFrames;
+    }
+}
+
+std::string
+NrSinrTraceReplayTestCase::RunCell(BandwidthPartInfo::Scenario scenario, bool shadowing)
+{
+    m_decisions.str("");
+    m_channelDataFrames = 0;
+    Config::SetDefault("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue(999999999));
+
+    NodeContainer gnbNodes;
+    gnbNodes.Create(1);
+    NodeContainer ueNodes;
+    ueNodes.Create(2);
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0.0, 0.0, 10.0));
+    positions->Add(Vector(60.0, 40.0, 1.5));
+    positions->Add(Vector(-150.0, 90.0, 1.5));
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(gnbNodes);
+    mobility.Install(ueNodes);
+
+    Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper>();
+    // The beams depend on the positions only, not on the channel
+    Ptr<IdealBeamformingHelper> beamformingHelper = CreateObject<IdealBeamformingHelper>();
+    beamformingHelper->SetAttribute("BeamformingMethod",
+                                    TypeIdValue(DirectPathBeamforming::GetTypeId()));
+    Ptr<NrHelper> nrHelper = CreateObject<NrHelper>();
+    nrHelper->SetBeamformingHelper(beamformingHelper);
+    nrHelper->SetEpcHelper(epcHelper);
+    nrHelper->SetUeAntennaAttribute("NumRows", UintegerValue(1));
+    nrHelper->SetUeAntennaAttribute("NumColumns", UintegerValue(1));
+    nrHelper->SetUeAntennaAttribute("AntennaElement",
+                                    PointerValue(CreateObject<IsotropicAntennaModel>()));
+    nrHelper->SetGnbAntennaAttribute("NumRows", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("NumColumns", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("AntennaElement",
+                                     PointerValue(CreateObject<IsotropicAntennaModel>()));
+    nrHelper->SetGnbPhyAttribute("Numerology", UintegerValue(1));
+    // The SRS offsets are shuffled when the scheduler is created, before
+    // AssignStreams(), with a stream that depends on the channel objects
+    // created before it
+    nrHelper->SetSchedulerAttribute("EnableSrsInUlSlots", BooleanValue(false));
+    nrHelper->SetSchedulerAttribute("EnableSrsInFSlots", BooleanValue(false));
+    nrHelper->SetPathlossAttribute("ShadowingEnabled", BooleanValue(shadowing));
+
+    CcBwpCreator ccBwpCreator;
+    CcBwpCreator::SimpleOperationBandConf bandConf(3.5e9, 10e6, 1, scenario);
+    OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc(bandConf);
+    nrHelper->InitializeOperationBand(&band);
+    BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps({band});
+    allBwps.at(0).get()->m_channel->TraceConnectWithoutContext(
+        "TxSigParams",
+        MakeCallback(&NrSinrTraceReplayTestCase::ChannelTx, this));
+
+    NetDeviceContainer gnbDevs = nrHelper->InstallGnbDevice(gnbNodes, allBwps);
+    NetDeviceContainer ueDevs = nrHelper->InstallUeDevice(ueNodes, allBwps);
+
+    // The channel objects may take a different number of streams in each
+    // scenario, so the streams of the PHYs, the MACs and the scheduler are
+    // fixed after them
+    int64_t stream = nrHelper->AssignStreams(gnbDevs, 1);
+    nrHelper->AssignStreams(ueDevs, 1 + stream);
+    Ptr<NrGnbNetDevice> gnbDev = DynamicCast<NrGnbNetDevice>(gnbDevs.Get(0));
+    gnbDev->GetScheduler(0)->AssignStreams(1000);
+    gnbDev->GetPhy(0)->GetSpectrumPhy()->AssignStreams(1100);
+    for (uint32_t i = 0; i < ueDevs.GetN(); ++i)
+    {
+        Ptr<NrUeNetDevice> ueDev = DynamicCast<NrUeNetDevice>(ueDevs.Get(i));
+        ueDev->GetMac(0)->AssignStreams(1200 + 100 * i);
+        ueDev->GetPhy(0)->GetSpectrumPhy()->AssignStreams(1250 + 100 * i);
+    }
+    DynamicCast<NrGnbNetDevice>(gnbDevs.Get(0))->UpdateConfig();
+    for (uint32_t i = 0; i < ueDevs.GetN(); ++i)
+    {
+        DynamicCast<NrUeNetDevice>(ueDevs.Get(i))->UpdateConfig();
+    }
+
+    Ptr<Node> pgw = epcHelper->GetPgwNode();
+    NodeContainer remoteHostContainer;
+    remoteHostContainer.Create(1);
+    Ptr<Node> remoteHost = remoteHostContainer.Get(0);
+    InternetStackHelper internet;
+    internet.Install(remoteHostContainer);
+    PointToPointHelper p2ph;
+    p2ph.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Gb/s")));
+    p2ph.SetChannelAttribute("Delay", TimeValue(Seconds(0.0)));
+    NetDeviceContainer internetDevices = p2ph.Install(pgw, remoteHost);
+    Ipv4AddressHelper ipv4h;
+    ipv4h.SetBase("1.0.0.0", "255.0.0.0");
+    Ipv4InterfaceContainer internetIpIfaces = ipv4h.Assign(internetDevices);
+    Ipv4Address remoteHostAddr = internetIpIfaces.GetAddress(1);
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    ipv4RoutingHelper.GetStaticRouting(remoteHost->GetObject<Ipv4>())
+        ->AddNetworkRouteTo(Ipv4Address("7.0.0.0"), Ipv4Mask("255.0.0.0"), 1);
+    internet.Install(ueNodes);
+    Ipv4InterfaceContainer ueIpIface = epcHelper->AssignUeIpv4Address(ueDevs);
+    for (uint32_t i = 0; i < ueNodes.GetN(); ++i)
+    {
+        ipv4RoutingHelper.GetStaticRouting(ueNodes.Get(i)->GetObject<Ipv4>())
+            ->SetDefaultRoute(epcHelper->GetUeDefaultGatewayAddress(), 1);
+    }
+    nrHelper->AttachToClosestEnb(ueDevs, gnbDevs);
+
+    // Enough traffic in both directions to use most of the band
+    const uint16_t dlPort = 1234;
+    const uint16_t ulPort = 2000;
+    ApplicationContainer apps;
+    apps.Add(UdpServerHelper(ulPort).Install(remoteHost));
+    for (uint32_t i = 0; i < ueNodes.GetN(); ++i)
+    {
+        apps.Add(UdpServerHelper(dlPort).Install(ueNodes.Get(i)));
+        UdpClientHelper dlClient(ueIpIface.GetAddress(i), dlPort);
+        dlClient.SetAttribute("MaxPackets", UintegerValue(1000000));
+        dlClient.SetAttribute("PacketSize", UintegerValue(1000));
+        dlClient.SetAttribute("Interval", TimeValue(MicroSeconds(500)));
+        apps.Add(dlClient.Install(remoteHost));
+        UdpClientHelper ulClient(remoteHostAddr, ulPort);
+        ulClient.SetAttribute("MaxPackets", UintegerValue(1000000));
+        ulClient.SetAttribute("PacketSize", UintegerValue(500));
+        ulClient.SetAttribute("Interval", TimeValue(MicroSeconds(500)));
+        apps.Add(ulClient.Install(ueNodes.Get(i)));
+    }
+    apps.Start(MilliSeconds(100));
+    apps.Stop(MilliSeconds(300));
+
+    Config::ConnectWithoutContext(
+        "/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/DlScheduling",
+        MakeCallback(&NrSinrTraceReplayTestCase::Scheduled, this).Bind(std::string("DL")));
+    Config::ConnectWithoutContext(
+        "/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/UlScheduling",
+        MakeCallback(&NrSinrTraceReplayTestCase::Scheduled, this).Bind(std::string("UL")));
+
+    Simulator::Stop(MilliSeconds(300));
+    Simulator::Run();
+    Simulator::Destroy();
+    return m_decisions.str();
+}
+
+void
+NrSinrTraceReplayTestCase::DoRun()
+{
+    const std::string fileName = CreateTempDirFilename("nr-sinr-trace-replay-test.bin");
+    Config::SetDefault("ns3::NrSinrTrace::FileName", StringValue(fileName));
+
+    Config::SetDefault("ns3::NrSinrTrace::Mode", EnumValue(NrSinrTrace::RECORD));
+    std::string recorded = RunCell(BandwidthPartInfo::UMi_StreetCanyon, true);
+    NS_TEST_ASSERT_MSG_GT(m_channelDataFrames, 0u, "No data frame went through the channel");
+    Config::SetDefault("ns3::NrSinrTrace::Mode", EnumValue(NrSinrTrace::REPLAY));
+    std::string replayed = RunCell(BandwidthPartInfo::RMa_LoS, false);
+    NS_TEST_ASSERT_MSG_EQ(m_channelDataFrames, 0u, "The replay sent data frames on the channel");
+    Config::SetDefault("ns3::NrSinrTrace::Mode", EnumValue(NrSinrTrace::DISABLED));
+    std::string computed = RunCell(BandwidthPartInfo::RMa_LoS, false);
+
+    NS_TEST_ASSERT_MSG_NE(recorded.size(), 0, "The MAC took no decision");
+    NS_TEST_ASSERT_MSG_EQ(replayed, recorded, "The replay changed the decisions of the MAC");
+    NS_TEST_ASSERT_MSG_NE(computed,
+                          recorded,
+                          "The RMa channel gives the decisions of the recorded one, so the "
+                          "comparison of the replay proves nothing");
+}
+
+/**
+ * \brief SINR trace test suite
+ */
+class NrSinrTraceTestSuite : public TestSuite
+{
+  public:
+    NrSinrTraceTestSuite()
+        : TestSuite("nr-sinr-trace", UNIT)
+    {
+        AddTestCase(new NrSinrTraceTestCase(), QUICK);
+        AddTestCase(new NrSinrTraceReplayTestCase(), QUICK);
+    }
+};
+
+static NrSinrTraceTestSuite nrSinrTraceTestSuite; //!< SINR trace test suite
+
+} // namespace ns3
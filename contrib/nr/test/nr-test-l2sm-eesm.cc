@@ -12,6 +12,9 @@
 #include <ns3/nr-eesm-ir-t2.h>
 #include <ns3/test.h>
 
+#include <algorithm>
+#include <cmath>
+
 /**
  * \file nr-test-l2sm-eesm.cc
  * \ingroup test
@@ -19,7 +22,9 @@
  * \brief This test validates specific functions of the NR PHY abstraction model.
  * The test checks two issues: 1) LDPC base graph (BG) selection works properly, and 2)
  * BLER values are properly obtained from the BLER-SINR look up tables for different
- * block sizes, MCS Tables, BG types, and SINR values.
+ * block sizes, MCS Tables, BG types, and SINR values. The lookup of MappingSinrBler
+ * is also checked against a binary search over the original tables, for every
+ * point and CB size of the tables.
  *
  */
 namespace ns3
@@ -50,6 +55,21 @@ class NrL2smEesmTestCase : public TestCase
     void TestMappingSinrBler2(const Ptr<NrEesmErrorModel>& em);
     void TestBgType1(const Ptr<NrEesmErrorModel>& em);
     void TestBgType2(const Ptr<NrEesmErrorModel>& em);
+    void TestFlatBlerTable(const Ptr<NrEesmErrorModel>& em);
+
+    /**
+     * \brief The BLER of MappingSinrBler, obtained with a binary search over
+     * the original table
+     * \param em the error model
+     * \param sinr the SINR (linear)
+     * \param mcs the MCS
+     * \param cbSizeBit the CB size, in bits
+     * \return the BLER
+     */
+    double ReferenceBler(const Ptr<NrEesmErrorModel>& em,
+                         double sinr,
+                         uint8_t mcs,
+                         uint32_t cbSizeBit);
 
     void TestEesmCcTable1();
     void TestEesmCcTable2();
@@ -212,6 +232,76 @@ NrL2smEesmTestCase::TestMappingSinrBler2(const Ptr<NrEesmErrorModel>& em)
     }
 }
 
+double
+NrL2smEesmTestCase::ReferenceBler(const Ptr<NrEesmErrorModel>& em,
+                                  double sinr,
+                                  uint8_t mcs,
+                                  uint32_t cbSizeBit)
+{
+    double sinrDb = 10 * log10(sinr);
+    auto bgType = em->GetBaseGraphType(cbSizeBit, mcs);
+    const auto& cbMap = em->GetSimulatedBlerFromSINR()->at(bgType).at(mcs);
+    auto cbIt = cbMap.upper_bound(cbSizeBit);
+    if (cbIt != cbMap.begin())
+    {
+        cbIt--;
+    }
+    const auto& sinrVector = std::get<0>(cbIt->second);
+    const auto& blerVector = std::get<1>(cbIt->second);
+    if (sinrDb < sinrVector.front())
+    {
+        return 1.0;
+    }
+    if (sinrDb > sinrVector.back())
+    {
+        return 0.0;
+    }
+    auto sinrIt = std::upper_bound(sinrVector.begin(), sinrVector.end(), sinrDb);
+    if (sinrIt != sinrVector.begin())
+    {
+        sinrIt--;
+    }
+    return blerVector.at(std::distance(sinrVector.begin(), sinrIt));
+}
+
+void
+NrL2smEesmTestCase::TestFlatBlerTable(const Ptr<NrEesmErrorModel>& em)
+{
+    const auto& table = *em->GetSimulatedBlerFromSINR();
+    for (const auto& graph : table)
+    {
+        for (uint8_t mcs = 0; mcs <= em->GetMaxMcs(); ++mcs)
+        {
+            for (const auto& [cbSize, values] : graph.at(mcs))
+            {
+                const auto& sinrVector = std::get<0>(values);
+                std::vector<double> sinrDbs = {sinrVector.front() - 1.0, sinrVector.back() + 1.0};
+                for (std::size_t i = 0; i < sinrVector.size(); ++i)
+                {
+                    sinrDbs.push_back(sinrVector[i]);
+                    sinrDbs.push_back(sinrVector[i] - 1e-9);
+                    if (i + 1 < sinrVector.size())
+                    {
+                        sinrDbs.push_back((sinrVector[i] + sinrVector[i + 1]) / 2);
+                    }
+                }
+                for (uint32_t cb : {cbSize, cbSize + 1, cbSize > 0 ? cbSize - 1 : 0})
+                {
+                    for (double sinrDb : sinrDbs)
+                    {
+                        double sinr = std::pow(10.0, sinrDb / 10);
+                        NS_TEST_ASSERT_MSG_EQ(em->MappingSinrBler(sinr, mcs, cb),
+                                              ReferenceBler(em, sinr, mcs, cb),
+                                              "TestFlatBlerTable: the BLER differs from the "
+                                              "table. SINR (dB)="
+                                                  << sinrDb << " MCS " << +mcs << " CBS " << cb);
+                    }
+                }
+            }
+        }
+    }
+}
+
 void
 NrL2smEesmTestCase::TestEesmCcTable1()
 {
@@ -225,6 +315,7 @@ NrL2smEesmTestCase::TestEesmCcTable1()
     // Test here the functions:
     TestBgType1(em);
     TestMappingSinrBler1(em);
+    TestFlatBlerTable(em);
 }
 
 void
@@ -240,6 +331,7 @@ NrL2smEesmTestCase::TestEesmCcTable2()
     // Test here the functions:
     TestBgType2(em);
     TestMappingSinrBler2(em);
+    TestFlatBlerTable(em);
 }
 
 void
@@ -255,6 +347,7 @@ NrL2smEesmTestCase::TestEesmIrTable1()
     // Test here the functions:
     TestBgType1(em);
     TestMappingSinrBler1(em);
+    TestFlatBlerTable(em);
 }
 
 void
@@ -270,6 +363,7 @@ NrL2smEesmTestCase::TestEesmIrTable2()
     // Test here the functions:
     TestBgType2(em);
     TestMappingSinrBler2(em);
+    TestFlatBlerTable(em);
 }
 
 void
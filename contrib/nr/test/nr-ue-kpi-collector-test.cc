@@ -0,0 +1,360 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+
+// Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <ns3/antenna-module.h>
+#include <ns3/applications-module.h>
+#include <ns3/internet-module.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/nr-mac-scheduler-ofdma-dpp.h>
+#include <ns3/nr-module.h>
+#include <ns3/nr-ue-kpi-collector.h>
+#include <ns3/point-to-point-helper.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+/**
+ * \file nr-ue-kpi-collector-test.cc
+ * \ingroup test
+ *
+ * \brief Run a cell with a DPP scheduler and a UDP flow to a UE, collect its
+ * KPIs with a NrUeKpiCollector, and check every row of the CSV file against
+ * counters kept by the test: the packets sent by the UdpClient, the packets,
+ * bytes and delays (from the SeqTsHeader) received by the PacketSink, and the
+ * RBGs of the DlRbgAllocation trace of the scheduler. The intervals end at
+ * odd times, so that packets are in flight at their ends, and the last ones
+ * have no traffic.
+ */
+namespace ns3
+{
+
+/**
+ * \brief KPIs of a known flow, per interval
+ */
+class NrUeKpiCollectorTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    NrUeKpiCollectorTestCase()
+        : TestCase("KPIs of a UDP flow, per interval")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Count a packet sent by the client
+     * \param packet the packet
+     */
+    void ClientTx(Ptr<const Packet> packet);
+
+    /**
+     * \brief Count a packet received by the sink
+     * \param packet the packet
+     * \param from the sender address
+     */
+    void SinkRx(Ptr<const Packet> packet, const Address& from);
+
+    /**
+     * \brief Count the RBGs of a UE
+     * \param rnti the RNTI
+     * \param rbgs the RBGs
+     */
+    void RbgAllocation(uint16_t rnti, uint32_t rbgs);
+
+    /**
+     * \brief Write the interval of the collector, and keep the expected row
+     * \param collector the collector
+     */
+    void EndInterval(Ptr<NrUeKpiCollector> collector);
+
+    /**
+     * \brief Expected KPIs of an interval
+     */
+    struct Row
+    {
+        double m_time;       //!< End of the interval, in s
+        uint16_t m_rnti;     //!< RNTI
+        double m_throughput; //!< Throughput, in Mbps
+        double m_delay;      //!< Mean delay, in ms
+        double m_rate;       //!< Received packets per second
+        double m_drop;       //!< Drop rate
+        uint64_t m_rbgs;     //!< RBGs
+    };
+
+    Ptr<NrUeNetDevice> m_ueDev; //!< Device of the UE
+    std::vector<Row> m_rows;    //!< Expected rows
+    Time m_intervalStart;       //!< Start of the interval
+    uint64_t m_txPackets{0};    //!< Packets sent in the interval
+    uint64_t m_rxPackets{0};    //!< Packets received in the interval
+    uint64_t m_rxBytes{0};      //!< Bytes received in the interval
+    int64_t m_delaySumNs{0};    //!< Sum of the delays of the interval
+    uint64_t m_rbgs{0};         //!< RBGs of the UE in the interval
+    uint64_t m_totalRx{0};      //!< Packets received in the run
+    uint64_t m_totalRbgs{0};    //!< RBGs of the UE in the run
+
+    static constexpr uint32_t m_ueId = 7;    //!< ID of the UE in the CSV
+    static constexpr double m_extra = 2.5;   //!< Value of the extra column
+    static constexpr double m_relTol = 1e-5; //!< The CSV has 6 significant digits
+};
+
+void
+NrUeKpiCollectorTestCase::ClientTx(Ptr<const Packet> /* packet */)
+{
+    ++m_txPackets;
+}
+
+void
+NrUeKpiCollectorTestCase::SinkRx(Ptr<const Packet> packet, const Address& /* from */)
+{
+    SeqTsHeader header;
+    packet->Copy()->RemoveHeader(header);
+    ++m_rxPackets;
+    ++m_totalRx;
+    m_rxBytes += packet->GetSize();
+    m_delaySumNs += (Simulator::Now() - header.GetTs()).GetNanoSeconds();
+}
+
+void
+NrUeKpiCollectorTestCase::RbgAllocation(uint16_t rnti, uint32_t rbgs)
+{
+    if (rnti == m_ueDev->GetRrc()->GetRnti())
+    {
+        m_rbgs += rbgs;
+        m_totalRbgs += rbgs;
+    }
+}
+
+void
+NrUeKpiCollectorTestCase::EndInterval(Ptr<NrUeKpiCollector> collector)
+{
+    collector->WriteInterval();
+
+    const double interval = (Simulator::Now() - m_intervalStart).GetSeconds();
+    m_intervalStart = Simulator::Now();
+    const auto rx = static_cast<double>(m_rxPackets);
+    const auto tx = static_cast<double>(m_txPackets);
+    m_rows.push_back({Simulator::Now().GetSeconds(),
+                      m_ueDev->GetRrc()->GetRnti(),
+                      m_rxBytes * 8.0 / (interval * 1e6),
+                      m_rxPackets > 0 ? m_delaySumNs / rx / 1e6 : 0.0,
+                      rx / interval,
+                      tx > rx ? (tx - rx) / tx : 0.0,
+                      m_rbgs});
+    m_txPackets = 0;
+    m_rxPackets = 0;
+    m_rxBytes = 0;
+    m_delaySumNs = 0;
+    m_rbgs = 0;
+}
+
+void
+NrUeKpiCollectorTestCase::DoRun()
+{
+    // The DPP scheduler writes its traces in the working directory
+    const std::filesystem::path previousDir = std::filesystem::current_path();
+    const std::filesystem::path dir =
+        std::filesystem::path(CreateTempDirFilename("")).parent_path() / "nr-ue-kpi-collector";
+    std::filesystem::create_directories(dir);
+    std::filesystem::current_path(dir);
+    const std::string fileName = (dir / "kpi.csv").string();
+    std::filesystem::remove(fileName);
+
+    NodeContainer gnbNodes;
+    gnbNodes.Create(1);
+    NodeContainer ueNodes;
+    ueNodes.Create(1);
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0.0, 0.0, 10.0));
+    positions->Add(Vector(60.0, 40.0, 1.5));
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positions);
+    mobility.Install(gnbNodes);
+    mobility.Install(ueNodes);
+
+    Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper>();
+    Ptr<IdealBeamformingHelper> beamformingHelper = CreateObject<IdealBeamformingHelper>();
+    beamformingHelper->SetAttribute("BeamformingMethod",
+                                    TypeIdValue(DirectPathBeamforming::GetTypeId()));
+    Ptr<NrHelper> nrHelper = CreateObject<NrHelper>();
+    nrHelper->SetBeamformingHelper(beamformingHelper);
+    nrHelper->SetEpcHelper(epcHelper);
+    nrHelper->SetSchedulerTypeId(NrMacSchedulerOfdmaDPP::GetTypeId());
+    nrHelper->SetUeAntennaAttribute("NumRows", UintegerValue(1));
+    nrHelper->SetUeAntennaAttribute("NumColumns", UintegerValue(1));
+    nrHelper->SetUeAntennaAttribute("AntennaElement",
+                                    PointerValue(CreateObject<IsotropicAntennaModel>()));
+    nrHelper->SetGnbAntennaAttribute("NumRows", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("NumColumns", UintegerValue(2));
+    nrHelper->SetGnbAntennaAttribute("AntennaElement",
+                                     PointerValue(CreateObject<IsotropicAntennaModel>()));
+    nrHelper->SetGnbPhyAttribute("Numerology", UintegerValue(1));
+    nrHelper->SetPathlossAttribute("ShadowingEnabled", BooleanValue(false));
+
+    CcBwpCreator ccBwpCreator;
+    CcBwpCreator::SimpleOperationBandConf bandConf(3.5e9,
+                                                   10e6,
+                                                   1,
+                                                   BandwidthPartInfo::UMi_StreetCanyon_LoS);
+    OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc(bandConf);
+    nrHelper->InitializeOperationBand(&band);
+    BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps({band});
+
+    NetDeviceContainer gnbDevs = nrHelper->InstallGnbDevice(gnbNodes, allBwps);
+    NetDeviceContainer ueDevs = nrHelper->InstallUeDevice(ueNodes, allBwps);
+    int64_t stream = nrHelper->AssignStreams(gnbDevs, 1);
+    nrHelper->AssignStreams(ueDevs, 1 + stream);
+    DynamicCast<NrGnbNetDevice>(gnbDevs.Get(0))->UpdateConfig();
+    m_ueDev = DynamicCast<NrUeNetDevice>(ueDevs.Get(0));
+    m_ueDev->UpdateConfig();
+
+    Ptr<Node> pgw = epcHelper->GetPgwNode();
+    NodeContainer remoteHostContainer;
+    remoteHostContainer.Create(1);
+    Ptr<Node> remoteHost = remoteHostContainer.Get(0);
+    InternetStackHelper internet;
+    internet.Install(remoteHostContainer);
+    PointToPointHelper p2ph;
+    p2ph.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Gb/s")));
+    p2ph.SetChannelAttribute("Delay", TimeValue(Seconds(0.0)));
+    NetDeviceContainer internetDevices = p2ph.Install(pgw, remoteHost);
+    Ipv4AddressHelper ipv4h;
+    ipv4h.SetBase("1.0.0.0", "255.0.0.0");
+    ipv4h.Assign(internetDevices);
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    ipv4RoutingHelper.GetStaticRouting(remoteHost->GetObject<Ipv4>())
+        ->AddNetworkRouteTo(Ipv4Address("7.0.0.0"), Ipv4Mask("255.0.0.0"), 1);
+    internet.Install(ueNodes);
+    Ipv4InterfaceContainer ueIpIface = epcHelper->AssignUeIpv4Address(ueDevs);
+    ipv4RoutingHelper.GetStaticRouting(ueNodes.Get(0)->GetObject<Ipv4>())
+        ->SetDefaultRoute(epcHelper->GetUeDefaultGatewayAddress(), 1);
+    nrHelper->AttachToClosestEnb(ueDevs, gnbDevs);
+
+    // One packet per ms, from 100 ms to 300 ms
+    const uint16_t port = 1234;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sinkHelper.Install(ueNodes.Get(0));
+    UdpClientHelper client(ueIpIface.GetAddress(0), port);
+    client.SetAttribute("MaxPackets", UintegerValue(1000000));
+    client.SetAttribute("PacketSize", UintegerValue(500));
+    client.SetAttribute("Interval", TimeValue(MilliSeconds(1)));
+    ApplicationContainer clientApps = client.Install(remoteHost);
+    sinkApps.Start(MilliSeconds(50));
+    clientApps.Start(MilliSeconds(100));
+    clientApps.Stop(MilliSeconds(300));
+
+    Ptr<PacketSink> sink = DynamicCast<PacketSink>(sinkApps.Get(0));
+    Ptr<NrMacSchedulerOfdmaDPP> scheduler =
+        DynamicCast<NrMacSchedulerOfdmaDPP>(NrHelper::GetScheduler(gnbDevs.Get(0), 0));
+    NS_TEST_ASSERT_MSG_NE(scheduler, nullptr, "The gNB has no DPP scheduler");
+
+    Ptr<NrUeKpiCollector> collector = CreateObject<NrUeKpiCollector>();
+    const uint32_t ue = collector->AddUe(m_ueId, m_ueDev, sink);
+    collector->AddSender(remoteHost);
+    collector->ConnectDppScheduler(scheduler);
+    collector->OpenFile(fileName, {"Extra"});
+    collector->SetExtra(ue, 0, m_extra);
+
+    clientApps.Get(0)->TraceConnectWithoutContext(
+        "Tx",
+        MakeCallback(&NrUeKpiCollectorTestCase::ClientTx, this));
+    sink->TraceConnectWithoutContext("Rx", MakeCallback(&NrUeKpiCollectorTestCase::SinkRx, this));
+    scheduler->TraceConnectWithoutContext(
+        "DlRbgAllocation",
+        MakeCallback(&NrUeKpiCollectorTestCase::RbgAllocation, this));
+
+    m_intervalStart = Simulator::Now();
+    for (Time end = MicroSeconds(90500); end < MilliSeconds(400); end += MilliSeconds(45))
+    {
+        Simulator::Schedule(end, &NrUeKpiCollectorTestCase::EndInterval, this, collector);
+    }
+
+    Simulator::Stop(MilliSeconds(400));
+    Simulator::Run();
+    collector->Dispose();
+    Simulator::Destroy();
+    std::filesystem::current_path(previousDir);
+
+    NS_TEST_ASSERT_MSG_GT(m_totalRx, 150, "The UE received too few packets");
+    NS_TEST_ASSERT_MSG_GT(m_totalRbgs, 0, "The scheduler assigned no RBG to the UE");
+
+    std::ifstream file(fileName);
+    std::string line;
+    std::getline(file, line);
+    NS_TEST_ASSERT_MSG_EQ(line,
+                          "Time(s),UE_ID,RNTI,Extra,MeasuredThroughput(Mbps),MeasuredDelay(ms),"
+                          "PacketRate(pps),DropRate,AllocatedRBGs",
+                          "Wrong header");
+    bool idle = false;
+    bool dropped = false;
+    for (const auto& row : m_rows)
+    {
+        NS_TEST_ASSERT_MSG_EQ(bool(std::getline(file, line)),
+                              true,
+                              "Missing the row at " << row.m_time << " s");
+        std::istringstream fields(line);
+        std::vector<double> values;
+        for (std::string field; std::getline(fields, field, ',');)
+        {
+            values.push_back(std::stod(field));
+        }
+        NS_TEST_ASSERT_MSG_EQ(values.size(), 9u, "Wrong number of fields in " << line);
+        NS_TEST_EXPECT_MSG_EQ_TOL(values[0], row.m_time, 1e-9, "Wrong time in " << line);
+        NS_TEST_EXPECT_MSG_EQ(values[1], m_ueId, "Wrong UE ID in " << line);
+        NS_TEST_EXPECT_MSG_EQ(values[2], row.m_rnti, "Wrong RNTI in " << line);
+        NS_TEST_EXPECT_MSG_EQ(values[3], m_extra, "Wrong extra column in " << line);
+        NS_TEST_EXPECT_MSG_EQ_TOL(values[4],
+                                  row.m_throughput,
+                                  row.m_throughput * m_relTol,
+                                  "Wrong throughput in " << line);
+        NS_TEST_EXPECT_MSG_EQ_TOL(values[5],
+                                  row.m_delay,
+                                  row.m_delay * m_relTol,
+                                  "Wrong delay in " << line);
+        NS_TEST_EXPECT_MSG_EQ_TOL(values[6],
+                                  row.m_rate,
+                                  row.m_rate * m_relTol,
+                                  "Wrong packet rate in " << line);
+        NS_TEST_EXPECT_MSG_EQ_TOL(values[7],
+                                  row.m_drop,
+                                  row.m_drop * m_relTol,
+                                  "Wrong drop rate in " << line);
+        NS_TEST_EXPECT_MSG_EQ(values[8], row.m_rbgs, "Wrong RBGs in " << line);
+        idle = idle || (row.m_rate == 0 && row.m_rbgs == 0);
+        dropped = dropped || row.m_drop > 0;
+    }
+    NS_TEST_ASSERT_MSG_EQ(bool(std::getline(file, line)), false, "Extra row " << line);
+    NS_TEST_ASSERT_MSG_EQ(idle, true, "No interval without traffic");
+    NS_TEST_ASSERT_MSG_EQ(dropped, true, "No packet in flight at the end of an interval");
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * \brief UE KPI collector test suite
+ */
+class NrUeKpiCollectorTestSuite : public TestSuite
+{
+  public:
+    NrUeKpiCollectorTestSuite()
+        : TestSuite("nr-ue-kpi-collector", UNIT)
+    {
+        AddTestCase(new NrUeKpiCollectorTestCase(), QUICK);
+    }
+};
+
+static NrUeKpiCollectorTestSuite nrUeKpiCollectorTestSuite; //!< UE KPI collector test suite
+
+} // namespace ns3
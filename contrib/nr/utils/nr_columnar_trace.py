@@ -0,0 +1,170 @@
+# Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+#
+# SPDX-License-Identifier: GPL-2.0-only
+
+"""Reader of the NrColumnarTraceFile (.nrct) traces.
+
+The file is memory mapped and the columns are decoded straight into NumPy
+arrays, chunk by chunk, with vectorized operations. Only the chunks that
+overlap the requested time window are decoded, using the index at the end of
+the file. See contrib/nr/model/nr-columnar-trace-file.h for the layout.
+
+Example:
+
+    from nr_columnar_trace import NrColumnarTrace
+
+    trace = NrColumnarTrace("g.nrct")
+    data = trace.read(t_start=10.0, t_end=20.0)   # seconds
+    data["time_ns"], data["rnti"], data["g"]
+    df = trace.to_dataframe()                      # needs pandas
+"""
+
+import mmap
+import struct
+
+import numpy as np
+
+HEADER_MAGIC = b"NRCTRC01"
+TRAILER_MAGIC = b"NRCTIDX1"
+
+INTEGER = 0
+FIXED_POINT = 1
+FLOAT64 = 2
+
+_INDEX_DTYPE = np.dtype(
+    [("offset", "<u8"), ("first_time", "<i8"), ("last_time", "<i8"), ("num_rows", "<u4")]
+)
+
+
+def _decode_varints(buf, count):
+    """Decode `count` zig-zag LEB128 varints from a uint8 array, and undo the delta."""
+    if count == 0:
+        return np.zeros(0, dtype=np.int64)
+    last = (buf & 0x80) == 0
+    ends = np.flatnonzero(last)
+    if len(ends) != count:
+        raise ValueError("Corrupted column: expected %d values, found %d" % (count, len(ends)))
+    starts = np.empty_like(ends)
+    starts[0] = 0
+    starts[1:] = ends[:-1] + 1
+    # Position of every byte inside its varint, to shift its 7 bits in place
+    group_start = np.repeat(starts, ends - starts + 1)
+    shift = ((np.arange(len(buf)) - group_start) * 7).astype(np.uint64)
+    terms = (buf & 0x7F).astype(np.uint64) << shift
+    zz = np.add.reduceat(terms, starts)
+    deltas = (zz >> np.uint64(1)).astype(np.int64) ^ -(zz & np.uint64(1)).astype(np.int64)
+    return np.cumsum(deltas)
+
+
+class NrColumnarTrace:
+    """A memory-mapped NrColumnarTraceFile."""
+
+    def __init__(self, path):
+        self.path = path
+        with open(path, "rb") as f:
+            self._map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        self._data = np.frombuffer(self._map, dtype=np.uint8)
+
+        if bytes(self._map[0:8]) != HEADER_MAGIC:
+            raise ValueError("%s is not a NrColumnarTraceFile" % path)
+        if bytes(self._map[-8:]) != TRAILER_MAGIC:
+            raise ValueError("%s has no index: the simulation did not close it" % path)
+
+        (num_columns,) = struct.unpack_from("<I", self._map, 8)
+        pos = 12
+        self.columns = []
+        for _ in range(num_columns):
+            kind, scale, name_length = struct.unpack_from("<BdH", self._map, pos)
+            pos += struct.calcsize("<BdH")
+            name = bytes(self._map[pos : pos + name_length]).decode()
+            pos += name_length
+            self.columns.append((name, kind, scale))
+
+        num_chunks, index_offset = struct.unpack_from("<QQ", self._map, len(self._map) - 24)
+        self.index = np.frombuffer(
+            self._map, dtype=_INDEX_DTYPE, count=num_chunks, offset=index_offset
+        )
+
+    def __len__(self):
+        return int(self.index["num_rows"].sum())
+
+    @property
+    def column_names(self):
+        return [name for name, _, _ in self.columns]
+
+    def _decode_chunk(self, offset, wanted):
+        (num_rows,) = struct.unpack_from("<I", self._map, offset)
+        pos = offset + 4
+        out = {}
+        for name, kind, scale in self.columns:
+            (length,) = struct.unpack_from("<I", self._map, pos)
+            pos += 4
+            if name in wanted:
+                if kind == FLOAT64:
+                    out[name] = np.frombuffer(
+                        self._map, dtype="<f8", count=num_rows, offset=pos
+                    ).copy()
+                else:
+                    values = _decode_varints(self._data[pos : pos + length], num_rows)
+                    out[name] = values / scale if kind == FIXED_POINT else values
+            pos += length
+        return out
+
+    def read(self, t_start=None, t_end=None, columns=None):
+        """Read the rows with t_start <= time < t_end (in seconds, None for no bound).
+
+        Returns a dict of NumPy arrays, one per column (all the columns by
+        default); the time is always included, as "time_ns".
+        """
+        wanted = set(self.column_names if columns is None else columns) | {"time_ns"}
+        unknown = wanted - set(self.column_names)
+        if unknown:
+            raise KeyError("Unknown columns: %s" % ", ".join(sorted(unknown)))
+
+        lo = None if t_start is None else int(round(t_start * 1e9))
+        hi = None if t_end is None else int(round(t_end * 1e9))
+        selected = np.ones(len(self.index), dtype=bool)
+        if lo is not None:
+            selected &= self.index["last_time"] >= lo
+        if hi is not None:
+            selected &= self.index["first_time"] < hi
+
+        parts = [self._decode_chunk(int(o), wanted) for o in self.index["offset"][selected]]
+        names = [n for n in self.column_names if n in wanted]
+        if not parts:
+            return {
+                n: np.zeros(0, dtype=np.float64 if k != INTEGER else np.int64)
+                for n, k, _ in self.columns
+                if n in wanted
+            }
+        data = {n: np.concatenate([p[n] for p in parts]) for n in names}
+
+        if lo is not None or hi is not None:
+            t = data["time_ns"]
+            mask = np.ones(len(t), dtype=bool)
+            if lo is not None:
+                mask &= t >= lo
+            if hi is not None:
+                mask &= t < hi
+            data = {n: v[mask] for n, v in data.items()}
+        return data
+
+    def to_dataframe(self, t_start=None, t_end=None, columns=None):
+        """Same as read(), as a pandas DataFrame with an extra "time" column in ms."""
+        import pandas as pd
+
+        data = self.read(t_start, t_end, columns)
+        df = pd.DataFrame(data)
+        df.insert(0, "time", df["time_ns"] / 1e6)
+        return df
+
+    def close(self):
+        self._data = None
+        self.index = None
+        self._map.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
@@ -87,8 +87,14 @@ PhasedArrayModel::SetBeamformingVector(const ComplexVector& beamformingVector)
     NS_LOG_FUNCTION(this << beamformingVector);
     NS_ASSERT_MSG(beamformingVector.GetSize() == GetNumberOfElements(),
                   beamformingVector.GetSize() << " != " << GetNumberOfElements());
+    if (m_isBfVectorValid && m_beamformingVector == beamformingVector)
+    {
+        // same beam, keep the version so that the users keep what they computed with it
+        return;
+    }
     m_beamformingVector = beamformingVector;
     m_isBfVectorValid = true;
+    ++m_bfVectorVersion;
 }
 
 PhasedArrayModel::ComplexVector
@@ -101,6 +107,22 @@ PhasedArrayModel::GetBeamformingVector() const
     return m_beamformingVector;
 }
 
+const PhasedArrayModel::ComplexVector&
+PhasedArrayModel::GetBeamformingVectorRef() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_isBfVectorValid,
+                  "The beamforming vector should be Set before it's Get, and should refer to the "
+                  "current array configuration");
+    return m_beamformingVector;
+}
+
+uint64_t
+PhasedArrayModel::GetBeamformingVectorVersion() const
+{
+    return m_bfVectorVersion;
+}
+
 PhasedArrayModel::ComplexVector
 PhasedArrayModel::GetBeamformingVector(Angles a) const
 {
@@ -108,6 +108,21 @@ class PhasedArrayModel : public Object
      */
     ComplexVector GetBeamformingVector() const;
 
+    /**
+     * Returns a const reference to the beamforming vector that is currently being used
+     * \return the current beamforming vector, valid until it is changed
+     */
+    const ComplexVector& GetBeamformingVectorRef() const;
+
+    /**
+     * Returns the version of the beamforming vector, which is increased every time
+     * the beamforming vector changes. Two equal versions of the same array
+     * refer to the same beamforming vector, so that the users can detect a beam
+     * change without comparing the vectors.
+     * \return the version of the current beamforming vector
+     */
+    uint64_t GetBeamformingVectorVersion() const;
+
     /**
      * Returns the beamforming vector that points towards the specified position
      * \param a the beamforming angle
@@ -144,6 +159,7 @@ class PhasedArrayModel : public Object
     ComplexVector m_beamformingVector;  //!< the beamforming vector in use
     Ptr<AntennaModel> m_antennaElement; //!< the model of the antenna element in use
     bool m_isBfVectorValid;             //!< ensures the validity of the beamforming vector
+    uint64_t m_bfVectorVersion{0};      //!< the version of the beamforming vector
     static uint32_t
         m_idCounter;  //!< the ID counter that is used to determine the unique antenna array ID
     uint32_t m_id{0}; //!< the ID of this antenna array instance
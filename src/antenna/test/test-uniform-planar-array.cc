@@ -205,6 +205,66 @@ UniformPlanarArrayTestCase::DoRun()
                               "wrong value of the radiation pattern");
 }
 
+/**
+ * \ingroup antenna-tests
+ *
+ * \brief Test case for the version of the beamforming vector of a UniformPlanarArray
+ */
+class BeamformingVectorVersionTestCase : public TestCase
+{
+  public:
+    BeamformingVectorVersionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BeamformingVectorVersionTestCase::BeamformingVectorVersionTestCase()
+    : TestCase("Check the version of the beamforming vector")
+{
+}
+
+void
+BeamformingVectorVersionTestCase::DoRun()
+{
+    Ptr<UniformPlanarArray> a = CreateObject<UniformPlanarArray>();
+    a->SetAttribute("NumRows", UintegerValue(2));
+    a->SetAttribute("NumColumns", UintegerValue(2));
+    uint64_t version = a->GetBeamformingVectorVersion();
+
+    PhasedArrayModel::ComplexVector bfv1 =
+        a->GetBeamformingVector(Angles(DegreesToRadians(0), DegreesToRadians(90)));
+    PhasedArrayModel::ComplexVector bfv2 =
+        a->GetBeamformingVector(Angles(DegreesToRadians(30), DegreesToRadians(90)));
+
+    a->SetBeamformingVector(bfv1);
+    NS_TEST_ASSERT_MSG_GT(a->GetBeamformingVectorVersion(),
+                          version,
+                          "a new beamforming vector must increase the version");
+    version = a->GetBeamformingVectorVersion();
+
+    a->SetBeamformingVector(bfv1);
+    NS_TEST_ASSERT_MSG_EQ(a->GetBeamformingVectorVersion(),
+                          version,
+                          "the same beamforming vector must keep the version");
+    NS_TEST_ASSERT_MSG_EQ((a->GetBeamformingVectorRef() == bfv1),
+                          true,
+                          "wrong beamforming vector");
+
+    a->SetBeamformingVector(bfv2);
+    NS_TEST_ASSERT_MSG_GT(a->GetBeamformingVectorVersion(),
+                          version,
+                          "a different beamforming vector must increase the version");
+    version = a->GetBeamformingVectorVersion();
+
+    // a change of the array invalidates the beamforming vector, even if it is set again
+    a->SetAttribute("AntennaHorizontalSpacing", DoubleValue(0.4));
+    a->SetBeamformingVector(bfv2);
+    NS_TEST_ASSERT_MSG_GT(a->GetBeamformingVectorVersion(),
+                          version,
+                          "the beamforming vector of a changed array must increase the version");
+}
+
 /**
  * \ingroup antenna-tests
  *
@@ -390,6 +450,7 @@ UniformPlanarArrayTestSuite::UniformPlanarArrayTestSuite()
                                                Angles(DegreesToRadians(0), DegreesToRadians(135)),
                                                28.0),
                 TestCase::QUICK);
+    AddTestCase(new BeamformingVectorVersionTestCase(), TestCase::QUICK);
 }
 
 static UniformPlanarArrayTestSuite staticUniformPlanarArrayTestSuiteInstance;
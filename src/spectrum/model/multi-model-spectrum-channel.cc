@@ -39,7 +39,9 @@
 #include <ns3/simulator.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <unordered_map>
 #include <utility>
 
 namespace ns3
@@ -80,8 +82,206 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 {
 }
 
+/**
+ * \ingroup spectrum
+ * Grid of the positions of the receivers of a MultiModelSpectrumChannel,
+ * to find the receivers near a transmitter. The grid is rebuilt when it is
+ * used after a change of the receivers or of their course.
+ */
+class MultiModelSpectrumChannel::NeighborGrid
+{
+  public:
+    /// Destructor, which disconnects the CourseChange traces.
+    ~NeighborGrid();
+
+    /// Rebuild the grid before the next query.
+    void SetDirty();
+
+    /**
+     * \return true if the grid must be rebuilt
+     */
+    bool IsDirty() const;
+
+    /**
+     * Build the grid.
+     * \param rxInfoMap the receivers
+     * \param cellSize the side of the cells (m)
+     */
+    void Build(const RxSpectrumModelInfoMap_t& rxInfoMap, double cellSize);
+
+    /**
+     * Get the receivers near a position, plus the ones not in the grid.
+     * \param position the position
+     * \param radius the distance of the receivers (m)
+     * \param neighbors the receivers, in the order of the RxSpectrumModelInfoMap_t
+     */
+    void GetNeighbors(const Vector& position, double radius, RxNeighborMap_t& neighbors) const;
+
+  private:
+    /**
+     * A receiver
+     */
+    struct Rx
+    {
+        Ptr<SpectrumPhy> m_phy;   //!< The receiver
+        SpectrumModelUid_t m_uid; //!< Its RX SpectrumModel
+        Vector m_position;        //!< Its position, if in the grid
+    };
+
+    /**
+     * Sink of the CourseChange traces.
+     * \param mobility the MobilityModel whose course changed
+     */
+    void CourseChange(Ptr<const MobilityModel> mobility);
+
+    /**
+     * \param x the cell index along x
+     * \param y the cell index along y
+     * \return the key of a cell
+     */
+    static uint64_t GetKey(int64_t x, int64_t y);
+
+    bool m_dirty{true};                                          //!< Whether to rebuild the grid
+    double m_cellSize{1};                                        //!< Side of the cells (m)
+    std::vector<Rx> m_rx;                                        //!< The receivers
+    std::vector<uint32_t> m_unindexed;                           //!< Receivers not in the grid
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells; //!< Receivers in every cell
+    std::vector<Ptr<MobilityModel>> m_mobilities;                //!< MobilityModels connected
+};
+
+MultiModelSpectrumChannel::NeighborGrid::~NeighborGrid()
+{
+    for (const auto& mobility : m_mobilities)
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&NeighborGrid::CourseChange, this));
+    }
+}
+
+void
+MultiModelSpectrumChannel::NeighborGrid::SetDirty()
+{
+    m_dirty = true;
+}
+
+bool
+MultiModelSpectrumChannel::NeighborGrid::IsDirty() const
+{
+    return m_dirty;
+}
+
+void
+MultiModelSpectrumChannel::NeighborGrid::CourseChange(Ptr<const MobilityModel> mobility)
+{
+    m_dirty = true;
+}
+
+uint64_t
+MultiModelSpectrumChannel::NeighborGrid::GetKey(int64_t x, int64_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void
+MultiModelSpectrumChannel::NeighborGrid::Build(const RxSpectrumModelInfoMap_t& rxInfoMap,
+                                               double cellSize)
+{
+    m_cellSize = cellSize;
+    m_rx.clear();
+    m_unindexed.clear();
+    m_cells.clear();
+    for (const auto& [uid, rxInfo] : rxInfoMap)
+    {
+        for (const auto& phy : rxInfo.m_rxPhys)
+        {
+            const auto index = static_cast<uint32_t>(m_rx.size());
+            m_rx.push_back({phy, uid, Vector()});
+            Ptr<MobilityModel> mobility = phy->GetMobility();
+            if (!mobility || mobility->GetVelocity().GetLength() > 0)
+            {
+                // the position is unknown, or changes without a CourseChange
+                m_unindexed.push_back(index);
+            }
+            else
+            {
+                const Vector position = mobility->GetPosition();
+                m_rx.back().m_position = position;
+                m_cells[GetKey(static_cast<int64_t>(std::floor(position.x / cellSize)),
+                               static_cast<int64_t>(std::floor(position.y / cellSize)))]
+                    .push_back(index);
+            }
+            if (mobility &&
+                std::find(m_mobilities.begin(), m_mobilities.end(), mobility) == m_mobilities.end())
+            {
+                mobility->TraceConnectWithoutContext(
+                    "CourseChange",
+                    MakeCallback(&NeighborGrid::CourseChange, this));
+                m_mobilities.push_back(mobility);
+            }
+        }
+    }
+    m_dirty = false;
+}
+
+void
+MultiModelSpectrumChannel::NeighborGrid::GetNeighbors(const Vector& position,
+                                                      double radius,
+                                                      RxNeighborMap_t& neighbors) const
+{
+    std::vector<uint32_t> indices(m_unindexed);
+    auto addCell = [this, &indices, &position, radius](const std::vector<uint32_t>& cell) {
+        for (const auto index : cell)
+        {
+            if (CalculateDistance(m_rx[index].m_position, position) <= radius)
+            {
+                indices.push_back(index);
+            }
+        }
+    };
+
+    const double span = std::ceil(radius / m_cellSize);
+    if ((2 * span + 1) * (2 * span + 1) >= m_cells.size())
+    {
+        for (const auto& cell : m_cells)
+        {
+            addCell(cell.second);
+        }
+    }
+    else
+    {
+        const auto x = static_cast<int64_t>(std::floor(position.x / m_cellSize));
+        const auto y = static_cast<int64_t>(std::floor(position.y / m_cellSize));
+        const auto n = static_cast<int64_t>(span);
+        for (int64_t i = x - n; i <= x + n; ++i)
+        {
+            for (int64_t j = y - n; j <= y + n; ++j)
+            {
+                auto cell = m_cells.find(GetKey(i, j));
+                if (cell != m_cells.end())
+                {
+                    addCell(cell->second);
+                }
+            }
+        }
+    }
+
+    // the order of the receivers is the one of the channel
+    std::sort(indices.begin(), indices.end());
+    for (const auto index : indices)
+    {
+        neighbors[m_rx[index].m_uid].push_back(m_rx[index].m_phy);
+    }
+}
+
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_neighborLossDb{1.0e9}
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MultiModelSpectrumChannel::~MultiModelSpectrumChannel()
 {
     NS_LOG_FUNCTION(this);
 }
@@ -92,6 +292,7 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_neighbors.reset();
     SpectrumChannel::DoDispose();
 }
 
@@ -102,6 +303,15 @@ MultiModelSpectrumChannel::GetTypeId()
                             .SetParent<SpectrumChannel>()
                             .SetGroupName("Spectrum")
                             .AddConstructor<MultiModelSpectrumChannel>()
+                            .AddAttribute("NeighborLossDb",
+                                          "Bound of the free-space loss (dB) from a transmitter "
+                                          "to the receivers of its transmissions, the other "
+                                          "receivers being skipped (the default considers all "
+                                          "the receivers)",
+                                          DoubleValue(1.0e9),
+                                          MakeDoubleAccessor(
+                                              &MultiModelSpectrumChannel::m_neighborLossDb),
+                                          MakeDoubleChecker<double>())
 
         ;
     return tid;
@@ -127,6 +337,10 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
             --m_numDevices;
+            if (m_neighbors)
+            {
+                m_neighbors->SetDirty();
+            }
             break; // there should be at most one entry
         }
     }
@@ -155,6 +369,10 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     // rxInfoIterator points either to the newly inserted element or to the element that
     // prevented insertion. In both cases, add the phy to the element pointed to by rxInfoIterator
     rxInfoIterator->second.m_rxPhys.push_back(phy);
+    if (m_neighbors)
+    {
+        m_neighbors->SetDirty();
+    }
 
     if (inserted)
     {
@@ -232,10 +450,13 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
     NS_ASSERT(txParams->txPhy);
     NS_ASSERT(txParams->psd);
-    Ptr<SpectrumSignalParameters> txParamsTrace =
-        txParams->Copy(); // copy it since traced value cannot be const (because of potential
-                          // underlying DynamicCasts)
-    m_txSigParamsTrace(txParamsTrace);
+    if (!m_txSigParamsTrace.IsEmpty())
+    {
+        Ptr<SpectrumSignalParameters> txParamsTrace =
+            txParams->Copy(); // copy it since traced value cannot be const (because of potential
+                              // underlying DynamicCasts)
+        m_txSigParamsTrace(txParamsTrace);
+    }
 
     Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility();
     SpectrumModelUid_t txSpectrumModelUid = txParams->psd->GetSpectrumModelUid();
@@ -252,6 +473,9 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_LOG_LOGIC("converter map first element: "
                  << txInfoIteratorerator->second.m_spectrumConverterMap.begin()->first);
 
+    RxNeighborMap_t neighbors;
+    const bool hasNeighbors = GetNeighbors(txParams, neighbors);
+
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -259,6 +483,18 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
+        const std::vector<Ptr<SpectrumPhy>>* rxPhys = &rxInfoIterator->second.m_rxPhys;
+        if (hasNeighbors)
+        {
+            auto neighborIterator = neighbors.find(rxSpectrumModelUid);
+            if (neighborIterator == neighbors.end())
+            {
+                // No receiver of this RX SpectrumModel within NeighborLossDb
+                continue;
+            }
+            rxPhys = &neighborIterator->second;
+        }
+
         Ptr<SpectrumValue> convertedTxPowerSpectrum;
         if (txSpectrumModelUid == rxSpectrumModelUid)
         {
@@ -279,9 +515,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
         }
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+        for (auto rxPhyIterator = rxPhys->begin(); rxPhyIterator != rxPhys->end(); ++rxPhyIterator)
         {
             NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
@@ -289,30 +523,13 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
             if ((*rxPhyIterator) != txParams->txPhy)
             {
-                Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
-                Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
-
-                if (rxNetDevice && txNetDevice)
-                {
-                    // we assume that devices are attached to a node
-                    if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
-                    {
-                        NS_LOG_DEBUG(
-                            "Skipping the pathloss calculation among different antennas of the "
-                            "same node, not supported yet by any pathloss model in ns-3.");
-                        continue;
-                    }
-                }
-
-                if (m_filter && m_filter->Filter(txParams, *rxPhyIterator))
+                if (IsRxSkipped(txParams, *rxPhyIterator))
                 {
                     continue;
                 }
 
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
                 Time delay = MicroSeconds(0);
+                double pathGainLinear = 1;
 
                 Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
 
@@ -322,10 +539,10 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     double rxAntennaGain = 0;
                     double propagationGainDb = 0;
                     double pathLossDb = 0;
-                    if (rxParams->txAntenna)
+                    if (txParams->txAntenna)
                     {
                         Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
-                        txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+                        txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
                         NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
                         pathLossDb -= txAntennaGain;
                     }
@@ -360,8 +577,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                         // beyond range
                         continue;
                     }
-                    double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                    *(rxParams->psd) *= pathGainLinear;
+                    pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
 
                     if (m_propagationDelay)
                     {
@@ -369,32 +585,110 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
-                if (rxNetDevice)
-                {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   rxParams,
-                                                   *rxPhyIterator);
-                }
-                else
+                // the receivers share the PSD up to here, this one gets the copy that it scales
+                NS_LOG_LOGIC("copying signal parameters " << txParams);
+                Ptr<SpectrumSignalParameters> rxParams =
+                    CopySignalParameters(txParams, convertedTxPowerSpectrum);
+                if (txMobility && receiverMobility)
                 {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay,
-                                        &MultiModelSpectrumChannel::StartRx,
-                                        this,
-                                        rxParams,
-                                        *rxPhyIterator);
+                    *(rxParams->psd) *= pathGainLinear;
                 }
+
+                ScheduleStartRx(delay, rxParams, *rxPhyIterator);
             }
         }
     }
 }
 
+bool
+MultiModelSpectrumChannel::GetNeighbors(Ptr<SpectrumSignalParameters> txParams,
+                                        RxNeighborMap_t& neighbors)
+{
+    Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility();
+    const double minFrequency = txParams->psd->GetSpectrumModel()->Begin()->fl;
+    if (!txMobility || minFrequency <= 0)
+    {
+        return false;
+    }
+
+    // distance of the bound for the free-space loss, 20 log10(4 pi d f / c)
+    const double radius =
+        299792458.0 / (4 * M_PI * minFrequency) * std::pow(10.0, m_neighborLossDb / 20);
+    if (!std::isfinite(radius))
+    {
+        return false;
+    }
+    if (!m_neighbors)
+    {
+        m_neighbors = std::make_unique<NeighborGrid>();
+    }
+    if (m_neighbors->IsDirty())
+    {
+        m_neighbors->Build(m_rxSpectrumModelInfoMap, std::max(radius, 1.0));
+    }
+    m_neighbors->GetNeighbors(txMobility->GetPosition(), radius, neighbors);
+    return true;
+}
+
+Ptr<SpectrumSignalParameters>
+MultiModelSpectrumChannel::CopySignalParameters(Ptr<SpectrumSignalParameters> txParams,
+                                                Ptr<SpectrumValue> psd) const
+{
+    // SpectrumSignalParameters::Copy copies the PSD of the parameters, so that the copy can be
+    // scaled: make it copy the one of the receiver, instead of copying the TX PSD to replace it
+    Ptr<SpectrumValue> txPsd = txParams->psd;
+    txParams->psd = psd;
+    Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+    txParams->psd = txPsd;
+    return rxParams;
+}
+
+bool
+MultiModelSpectrumChannel::IsRxSkipped(Ptr<SpectrumSignalParameters> txParams,
+                                       Ptr<SpectrumPhy> receiver) const
+{
+    Ptr<NetDevice> rxNetDevice = receiver->GetDevice();
+    Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
+
+    if (rxNetDevice && txNetDevice)
+    {
+        // we assume that devices are attached to a node
+        if (rxNetDevice->GetNode()->GetId() == txNetDevice->GetNode()->GetId())
+        {
+            NS_LOG_DEBUG("Skipping the pathloss calculation among different antennas of the "
+                         "same node, not supported yet by any pathloss model in ns-3.");
+            return true;
+        }
+    }
+
+    return m_filter && m_filter->Filter(txParams, receiver);
+}
+
+void
+MultiModelSpectrumChannel::ScheduleStartRx(Time delay,
+                                           Ptr<SpectrumSignalParameters> rxParams,
+                                           Ptr<SpectrumPhy> receiver)
+{
+    Ptr<NetDevice> rxNetDevice = receiver->GetDevice();
+    if (rxNetDevice)
+    {
+        // the receiver has a NetDevice, so we expect that it is attached to a Node
+        uint32_t dstNode = rxNetDevice->GetNode()->GetId();
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &MultiModelSpectrumChannel::StartRx,
+                                       this,
+                                       rxParams,
+                                       receiver);
+    }
+    else
+    {
+        // the receiver is not attached to a NetDevice, so we cannot assume that it is
+        // attached to a node
+        Simulator::Schedule(delay, &MultiModelSpectrumChannel::StartRx, this, rxParams, receiver);
+    }
+}
+
 void
 MultiModelSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
 {
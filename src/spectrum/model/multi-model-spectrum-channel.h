@@ -28,6 +28,7 @@
 #include <ns3/propagation-delay-model.h>
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace ns3
@@ -99,11 +100,23 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * By setting the attribute NeighborLossDb, a transmission reaches only the
+ * receivers whose free-space loss from the transmitter, at the lowest
+ * frequency of the transmission, is within the bound: the other receivers
+ * are skipped before the PropagationLossModel, the traces and the
+ * SpectrumPropagationLossModel. The receivers are found in a grid of their
+ * positions, rebuilt when a receiver is added or removed, or changes its
+ * course; the receivers that move, or have no MobilityModel, are always
+ * considered. As the propagation models can have a loss lower than the
+ * free-space one (e.g., with antenna gains or fading), the bound should
+ * include a margin over MaxLossDb.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
   public:
     MultiModelSpectrumChannel();
+    ~MultiModelSpectrumChannel() override;
 
     /**
      * \brief Get the type ID.
@@ -124,6 +137,56 @@ class MultiModelSpectrumChannel : public SpectrumChannel
     void DoDispose() override;
 
   private:
+    class NeighborGrid;
+
+    /**
+     * Container: SpectrumModelUid_t, receivers of a transmission
+     */
+    typedef std::map<SpectrumModelUid_t, std::vector<Ptr<SpectrumPhy>>> RxNeighborMap_t;
+
+    /**
+     * Get the receivers of a transmission within the coupling loss bound
+     * NeighborLossDb.
+     *
+     * \param txParams The signal parameters of the transmission.
+     * \param neighbors The receivers within the bound, for every RX SpectrumModel, in the
+     * order of m_rxSpectrumModelInfoMap.
+     * \return false if all the receivers must be considered (no bound, or no TX MobilityModel)
+     */
+    bool GetNeighbors(Ptr<SpectrumSignalParameters> txParams, RxNeighborMap_t& neighbors);
+
+    /**
+     * Check if a transmission is not delivered to a receiver, because the
+     * receiver is on the node of the transmitter or is filtered out.
+     *
+     * \param txParams The signal parameters of the transmission.
+     * \param receiver A pointer to the receiver SpectrumPhy.
+     * \return true if the transmission is not delivered to the receiver
+     */
+    bool IsRxSkipped(Ptr<SpectrumSignalParameters> txParams, Ptr<SpectrumPhy> receiver) const;
+
+    /**
+     * Copy the signal parameters of a transmission for a receiver.
+     *
+     * \param txParams The signal parameters of the transmission.
+     * \param psd The TX PSD in the RX SpectrumModel, shared by the receivers.
+     * \return A copy of the signal parameters, with a copy of psd that the receiver can scale.
+     */
+    Ptr<SpectrumSignalParameters> CopySignalParameters(Ptr<SpectrumSignalParameters> txParams,
+                                                       Ptr<SpectrumValue> psd) const;
+
+    /**
+     * Schedule the reception of a transmission, in the context of the node of
+     * the receiver if it has one.
+     *
+     * \param delay The propagation delay.
+     * \param rxParams The signal parameters of the receiver.
+     * \param receiver A pointer to the receiver SpectrumPhy.
+     */
+    void ScheduleStartRx(Time delay,
+                         Ptr<SpectrumSignalParameters> rxParams,
+                         Ptr<SpectrumPhy> receiver);
+
     /**
      * This method checks if m_rxSpectrumModelInfoMap contains an entry
      * for the given TX SpectrumModel. If such entry exists, it returns
@@ -163,6 +226,9 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    double m_neighborLossDb;                   //!< Coupling loss bound of the receivers (dB)
+    std::unique_ptr<NeighborGrid> m_neighbors; //!< Grid of the receivers, if NeighborLossDb is set
 };
 
 } // namespace ns3
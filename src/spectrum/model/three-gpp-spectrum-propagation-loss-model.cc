@@ -54,7 +54,9 @@ ThreeGppSpectrumPropagationLossModel::~ThreeGppSpectrumPropagationLossModel()
 void
 ThreeGppSpectrumPropagationLossModel::DoDispose()
 {
-    m_longTermMap.clear();
+    m_longTermTable.clear();
+    m_longTermCount = 0;
+    m_delayPhasorsMap.clear();
     m_channelModel->Dispose();
     m_channelModel = nullptr;
 }
@@ -134,10 +136,51 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
     return params->m_channel.MultiplyByLeftAndRightMatrix(uW.Transpose(), sW);
 }
 
+Ptr<const ThreeGppSpectrumPropagationLossModel::DelayPhasors>
+ThreeGppSpectrumPropagationLossModel::GetDelayPhasors(
+    Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+    Ptr<const SpectrumModel> spectrumModel,
+    std::size_t numCluster) const
+{
+    // the delays do not depend on the direction, so the key is the same for a-b and b-a
+    uint64_t key = MatrixBasedChannelModel::GetKey(channelParams->m_nodeIds.first,
+                                                   channelParams->m_nodeIds.second);
+    auto it = m_delayPhasorsMap.find(key);
+    if (it != m_delayPhasorsMap.end() && it->second->m_params == channelParams &&
+        it->second->m_spectrumModelUid == spectrumModel->GetUid() &&
+        it->second->m_numCluster == numCluster)
+    {
+        return it->second;
+    }
+
+    NS_LOG_DEBUG("compute the delay term");
+    NS_ASSERT(numCluster <= channelParams->m_delay.size());
+    Ptr<DelayPhasors> phasors = Create<DelayPhasors>();
+    phasors->m_params = channelParams;
+    phasors->m_spectrumModelUid = spectrumModel->GetUid();
+    phasors->m_numCluster = numCluster;
+    phasors->m_real.resize(spectrumModel->GetNumBands() * numCluster);
+    phasors->m_imag.resize(spectrumModel->GetNumBands() * numCluster);
+    std::size_t i = 0;
+    for (auto sbit = spectrumModel->Begin(); sbit != spectrumModel->End(); ++sbit)
+    {
+        double fsb = (*sbit).fc; // center frequency of the sub-band
+        for (std::size_t cIndex = 0; cIndex < numCluster; ++cIndex, ++i)
+        {
+            double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
+            phasors->m_real[i] = cos(delay);
+            phasors->m_imag[i] = sin(delay);
+        }
+    }
+    auto& entry = m_delayPhasorsMap[key];
+    entry = phasors;
+    return entry;
+}
+
 Ptr<SpectrumValue>
 ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
     Ptr<SpectrumValue> txPsd,
-    PhasedArrayModel::ComplexVector longTerm,
+    const PhasedArrayModel::ComplexVector& longTerm,
     Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
     Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
     const ns3::Vector& sSpeed,
@@ -145,8 +188,6 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<SpectrumValue> tempPsd = Copy<SpectrumValue>(txPsd);
-
     // channel[cluster][rx][tx]
     uint16_t numCluster = channelMatrix->m_channel.GetNumPages();
 
@@ -155,7 +196,6 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
     // each cluster in to consideration.
     double slotTime = Simulator::Now().GetSeconds();
     double factor = 2 * M_PI * slotTime * GetFrequency() / 3e8;
-    PhasedArrayModel::ComplexVector doppler(numCluster);
 
     // The following asserts might seem paranoic, but it is important to
     // make sure that all the structures that are passed to this function
@@ -173,30 +213,28 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
     // check if channelParams structure is generated in direction s-to-u or u-to-s
     bool isSameDirection = (channelParams->m_nodeIds == channelMatrix->m_nodeIds);
 
-    MatrixBasedChannelModel::DoubleVector zoa;
-    MatrixBasedChannelModel::DoubleVector zod;
-    MatrixBasedChannelModel::DoubleVector aoa;
-    MatrixBasedChannelModel::DoubleVector aod;
-
     // if channel params is generated in the same direction in which we
     // generate the channel matrix, angles and zenith od departure and arrival are ok,
-    // just set them to corresponding variable that will be used for the generation
+    // just refer to them with the corresponding variable that will be used for the generation
     // of channel matrix, otherwise we need to flip angles and zeniths of departure and arrival
-    if (isSameDirection)
-    {
-        zoa = channelParams->m_angle[MatrixBasedChannelModel::ZOA_INDEX];
-        zod = channelParams->m_angle[MatrixBasedChannelModel::ZOD_INDEX];
-        aoa = channelParams->m_angle[MatrixBasedChannelModel::AOA_INDEX];
-        aod = channelParams->m_angle[MatrixBasedChannelModel::AOD_INDEX];
-    }
-    else
-    {
-        zod = channelParams->m_angle[MatrixBasedChannelModel::ZOA_INDEX];
-        zoa = channelParams->m_angle[MatrixBasedChannelModel::ZOD_INDEX];
-        aod = channelParams->m_angle[MatrixBasedChannelModel::AOA_INDEX];
-        aoa = channelParams->m_angle[MatrixBasedChannelModel::AOD_INDEX];
-    }
-
+    const auto& angle = channelParams->m_angle;
+    const MatrixBasedChannelModel::DoubleVector& zoa =
+        angle[isSameDirection ? MatrixBasedChannelModel::ZOA_INDEX
+                              : MatrixBasedChannelModel::ZOD_INDEX];
+    const MatrixBasedChannelModel::DoubleVector& zod =
+        angle[isSameDirection ? MatrixBasedChannelModel::ZOD_INDEX
+                              : MatrixBasedChannelModel::ZOA_INDEX];
+    const MatrixBasedChannelModel::DoubleVector& aoa =
+        angle[isSameDirection ? MatrixBasedChannelModel::AOA_INDEX
+                              : MatrixBasedChannelModel::AOD_INDEX];
+    const MatrixBasedChannelModel::DoubleVector& aod =
+        angle[isSameDirection ? MatrixBasedChannelModel::AOD_INDEX
+                              : MatrixBasedChannelModel::AOA_INDEX];
+
+    // the long term component times the doppler term of each cluster, split in
+    // real and imaginary parts
+    std::vector<double> weightReal(numCluster);
+    std::vector<double> weightImag(numCluster);
     for (uint16_t cIndex = 0; cIndex < numCluster; cIndex++)
     {
         // Compute alpha and D as described in 3GPP TR 37.885 v15.3.0, Sec. 6.2.3
@@ -222,102 +260,120 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
                        sin(zod[cIndex] * M_PI / 180) * sin(aod[cIndex] * M_PI / 180) * sSpeed.y +
                        cos(zod[cIndex] * M_PI / 180) * sSpeed.z) +
                       2 * alpha * D);
-        doppler[cIndex] = std::complex<double>(cos(tempDoppler), sin(tempDoppler));
+        std::complex<double> weight =
+            longTerm[cIndex] * std::complex<double>(cos(tempDoppler), sin(tempDoppler));
+        weightReal[cIndex] = weight.real();
+        weightImag[cIndex] = weight.imag();
     }
 
-    NS_ASSERT(numCluster <= doppler.GetSize());
+    // the propagation delay term of each sub-band and cluster does not change
+    // until the channel params are updated
+    Ptr<const DelayPhasors> phasors =
+        GetDelayPhasors(channelParams, txPsd->GetSpectrumModel(), numCluster);
 
     // apply the doppler term and the propagation delay to the long term component
-    // to obtain the beamforming gain
-    auto vit = tempPsd->ValuesBegin();      // psd iterator
-    auto sbit = tempPsd->ConstBandsBegin(); // band iterator
-    while (vit != tempPsd->ValuesEnd())
+    // to obtain the beamforming gain: the gain of each sub-band is the product of
+    // its row of the delay term matrix by the weights
+    const double* delayReal = phasors->m_real.data();
+    const double* delayImag = phasors->m_imag.data();
+    for (auto vit = txPsd->ValuesBegin(); vit != txPsd->ValuesEnd();
+         ++vit, delayReal += numCluster, delayImag += numCluster)
     {
         if ((*vit) != 0.00)
         {
-            std::complex<double> subsbandGain(0.0, 0.0);
-            double fsb = (*sbit).fc; // center frequency of the sub-band
+            double gainReal = 0.0;
+            double gainImag = 0.0;
             for (uint16_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
-                double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
-                subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] *
-                                                  std::complex<double>(cos(delay), sin(delay));
+                gainReal += weightReal[cIndex] * delayReal[cIndex] -
+                            weightImag[cIndex] * delayImag[cIndex];
+                gainImag += weightReal[cIndex] * delayImag[cIndex] +
+                            weightImag[cIndex] * delayReal[cIndex];
             }
-            *vit = (*vit) * (norm(subsbandGain));
+            *vit = (*vit) * (gainReal * gainReal + gainImag * gainImag);
         }
-        vit++;
-        sbit++;
     }
-    return tempPsd;
+    return txPsd;
 }
 
-PhasedArrayModel::ComplexVector
+ThreeGppSpectrumPropagationLossModel::LongTermEntry&
+ThreeGppSpectrumPropagationLossModel::FindLongTermEntry(uint64_t key) const
+{
+    // keep the load factor below 1/2, so that the probe sequences are short
+    if (2 * (m_longTermCount + 1) > m_longTermTable.size())
+    {
+        std::vector<LongTermEntry> oldTable(std::max<std::size_t>(2 * m_longTermTable.size(), 64));
+        oldTable.swap(m_longTermTable);
+        m_longTermCount = 0;
+        for (auto& entry : oldTable)
+        {
+            if (entry.m_used)
+            {
+                FindLongTermEntry(entry.m_key) = std::move(entry);
+            }
+        }
+    }
+
+    // Fibonacci hashing of the key, then linear probing
+    const std::size_t mask = m_longTermTable.size() - 1;
+    std::size_t i = (key * 0x9E3779B97F4A7C15ULL) >> 32 & mask;
+    while (m_longTermTable[i].m_used && m_longTermTable[i].m_key != key)
+    {
+        i = (i + 1) & mask;
+    }
+    LongTermEntry& entry = m_longTermTable[i];
+    if (!entry.m_used)
+    {
+        entry.m_used = true;
+        entry.m_key = key;
+        ++m_longTermCount;
+    }
+    return entry;
+}
+
+const PhasedArrayModel::ComplexVector&
 ThreeGppSpectrumPropagationLossModel::GetLongTerm(
     Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
     Ptr<const PhasedArrayModel> aPhasedArrayModel,
     Ptr<const PhasedArrayModel> bPhasedArrayModel) const
 {
-    PhasedArrayModel::ComplexVector
-        longTerm; // vector containing the long term component for each cluster
-
     // check if the channel matrix was generated considering a as the s-node and
     // b as the u-node or vice-versa
-    PhasedArrayModel::ComplexVector sW;
-    PhasedArrayModel::ComplexVector uW;
-    if (!channelMatrix->IsReverse(aPhasedArrayModel->GetId(), bPhasedArrayModel->GetId()))
+    Ptr<const PhasedArrayModel> sPhasedArrayModel = aPhasedArrayModel;
+    Ptr<const PhasedArrayModel> uPhasedArrayModel = bPhasedArrayModel;
+    if (channelMatrix->IsReverse(aPhasedArrayModel->GetId(), bPhasedArrayModel->GetId()))
     {
-        sW = aPhasedArrayModel->GetBeamformingVector();
-        uW = bPhasedArrayModel->GetBeamformingVector();
-    }
-    else
-    {
-        sW = bPhasedArrayModel->GetBeamformingVector();
-        uW = aPhasedArrayModel->GetBeamformingVector();
+        std::swap(sPhasedArrayModel, uPhasedArrayModel);
     }
 
-    bool update = false;   // indicates whether the long term has to be updated
-    bool notFound = false; // indicates if the long term has not been computed yet
-
     // compute the long term key, the key is unique for each tx-rx pair
     uint64_t longTermId =
         MatrixBasedChannelModel::GetKey(aPhasedArrayModel->GetId(), bPhasedArrayModel->GetId());
 
-    // look for the long term in the map and check if it is valid
-    if (m_longTermMap.find(longTermId) != m_longTermMap.end())
+    // look for the long term in the table and check if it is valid: it has to be
+    // updated if the channel matrix has been updated or if the s beam or the u beam
+    // have been changed since it was computed. An update of the channel creates a
+    // new matrix, and the entry keeps the old one alive, so comparing the pointers
+    // is enough
+    LongTermEntry& entry = FindLongTermEntry(longTermId);
+    if (entry.m_channel != channelMatrix ||
+        entry.m_sWVersion != sPhasedArrayModel->GetBeamformingVectorVersion() ||
+        entry.m_uWVersion != uPhasedArrayModel->GetBeamformingVectorVersion())
     {
-        NS_LOG_DEBUG("found the long term component in the map");
-        longTerm = m_longTermMap[longTermId]->m_longTerm;
-
-        // check if the channel matrix has been updated
-        // or the s beam has been changed
-        // or the u beam has been changed
-        update = (m_longTermMap[longTermId]->m_channel->m_generatedTime !=
-                      channelMatrix->m_generatedTime ||
-                  m_longTermMap[longTermId]->m_sW != sW || m_longTermMap[longTermId]->m_uW != uW);
+        NS_LOG_DEBUG("compute the long term");
+        entry.m_longTerm = CalcLongTerm(channelMatrix,
+                                        sPhasedArrayModel->GetBeamformingVectorRef(),
+                                        uPhasedArrayModel->GetBeamformingVectorRef());
+        entry.m_channel = channelMatrix;
+        entry.m_sWVersion = sPhasedArrayModel->GetBeamformingVectorVersion();
+        entry.m_uWVersion = uPhasedArrayModel->GetBeamformingVectorVersion();
     }
     else
     {
-        NS_LOG_DEBUG("long term component NOT found");
-        notFound = true;
-    }
-
-    if (update || notFound)
-    {
-        NS_LOG_DEBUG("compute the long term");
-        // compute the long term component
-        longTerm = CalcLongTerm(channelMatrix, sW, uW);
-
-        // store the long term
-        Ptr<LongTerm> longTermItem = Create<LongTerm>();
-        longTermItem->m_longTerm = longTerm;
-        longTermItem->m_channel = channelMatrix;
-        longTermItem->m_sW = sW;
-        longTermItem->m_uW = uW;
-
-        m_longTermMap[longTermId] = longTermItem;
+        NS_LOG_DEBUG("found the long term component in the table");
     }
 
-    return longTerm;
+    return entry.m_longTerm;
 }
 
 Ptr<SpectrumValue>
@@ -352,10 +408,10 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
         m_channelModel->GetParams(a, b);
 
     // retrieve the long term component
-    PhasedArrayModel::ComplexVector longTerm =
+    const PhasedArrayModel::ComplexVector& longTerm =
         GetLongTerm(channelMatrix, aPhasedArrayModel, bPhasedArrayModel);
 
-    // apply the beamforming gain
+    // apply the beamforming gain to the copy of the tx PSD
     rxPsd = CalcBeamformingGain(rxPsd,
                                 longTerm,
                                 channelMatrix,
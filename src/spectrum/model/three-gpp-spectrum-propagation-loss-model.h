@@ -29,6 +29,7 @@
 #include <complex.h>
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -110,7 +111,10 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
      * the propagation delay.
      * To reduce the computational load, the long term component associated with
      * a certain channel is cached and recomputed only when the channel realization
-     * is updated, or when the beamforming vectors change.
+     * is updated, or when the beamforming vectors change. In the same way, the
+     * propagation delay term of each sub-band and cluster is cached until the
+     * channel parameters are updated, so that only the Doppler term is computed
+     * for each signal.
      *
      * \param params tx parameters
      * \param a first node mobility model
@@ -128,18 +132,34 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
 
   private:
     /**
-     * Data structure that stores the long term component for a tx-rx pair
+     * Entry of the table of the long term components, for a tx-rx pair. The
+     * long term component is valid for the channel matrix and the versions of
+     * the beamforming vectors with which it was computed.
      */
-    struct LongTerm : public SimpleRefCount<LongTerm>
+    struct LongTermEntry
     {
-        PhasedArrayModel::ComplexVector
-            m_longTerm; //!< vector containing the long term component for each cluster
+        uint64_t m_key{0};  //!< the key of the tx-rx pair
+        bool m_used{false}; //!< whether the entry holds a tx-rx pair
         Ptr<const MatrixBasedChannelModel::ChannelMatrix>
             m_channel; //!< pointer to the channel matrix used to compute the long term
+        uint64_t m_sWVersion{0}; //!< the version of the beamforming vector of the node s
+        uint64_t m_uWVersion{0}; //!< the version of the beamforming vector of the node u
         PhasedArrayModel::ComplexVector
-            m_sW; //!< the beamforming vector for the node s used to compute the long term
-        PhasedArrayModel::ComplexVector
-            m_uW; //!< the beamforming vector for the node u used to compute the long term
+            m_longTerm; //!< vector containing the long term component for each cluster
+    };
+
+    /**
+     * Data structure that stores the propagation delay term of each sub-band
+     * and cluster, exp(-j 2 pi f_sb tau_n), for a tx-rx pair
+     */
+    struct DelayPhasors : public SimpleRefCount<DelayPhasors>
+    {
+        Ptr<const MatrixBasedChannelModel::ChannelParams>
+            m_params; //!< the channel params with the cluster delays
+        SpectrumModelUid_t m_spectrumModelUid; //!< the UID of the model with the sub-bands
+        std::size_t m_numCluster{0};           //!< the number of clusters
+        std::vector<double> m_real;            //!< real part, m_real[sb * m_numCluster + n]
+        std::vector<double> m_imag;            //!< imaginary part, with the same layout
     };
 
     /**
@@ -149,18 +169,42 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
     double GetFrequency() const;
 
     /**
-     * Looks for the long term component in m_longTermMap. If found, checks
-     * whether it has to be updated. If not found or if it has to be updated,
-     * calls the method CalcLongTerm to compute it.
+     * Looks for the delay term of a tx-rx pair in m_delayPhasorsMap. If it is
+     * not found, or if the channel params or the spectrum model have changed,
+     * computes it again.
+     * \param channelParams the channel params
+     * \param spectrumModel the spectrum model of the signal
+     * \param numCluster the number of clusters
+     * \return the delay term of each sub-band and cluster
+     */
+    Ptr<const DelayPhasors> GetDelayPhasors(
+        Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+        Ptr<const SpectrumModel> spectrumModel,
+        std::size_t numCluster) const;
+
+    /**
+     * Looks for the long term component in m_longTermTable. If found, checks
+     * whether it has to be updated, i.e., whether the channel matrix or the
+     * version of a beamforming vector have changed. If not found or if it has
+     * to be updated, calls the method CalcLongTerm to compute it.
      * \param channelMatrix the channel matrix
      * \param aPhasedArrayModel the antenna array of the tx device
      * \param bPhasedArrayModel the antenna array of the rx device
-     * \return vector containing the long term component for each cluster
+     * \return vector containing the long term component for each cluster, valid
+     *         until the next call
      */
-    PhasedArrayModel::ComplexVector GetLongTerm(
+    const PhasedArrayModel::ComplexVector& GetLongTerm(
         Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
         Ptr<const PhasedArrayModel> aPhasedArrayModel,
         Ptr<const PhasedArrayModel> bPhasedArrayModel) const;
+    /**
+     * Finds the entry of a tx-rx pair in m_longTermTable, an open addressing
+     * hash table with linear probing, and adds it if it is not there
+     * \param key the key of the tx-rx pair
+     * \return the entry of the tx-rx pair
+     */
+    LongTermEntry& FindLongTermEntry(uint64_t key) const;
+
     /**
      * Computes the long term component
      * \param channelMatrix the channel matrix H
@@ -174,25 +218,28 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         const PhasedArrayModel::ComplexVector& uW) const;
 
     /**
-     * Computes the beamforming gain and applies it to the tx PSD
-     * \param txPsd the tx PSD
+     * Computes the beamforming gain and applies it to the PSD
+     * \param txPsd the tx PSD, which is scaled in place
      * \param longTerm the long term component
      * \param channelMatrix The channel matrix structure
      * \param channelParams The channel params structure
      * \param sSpeed speed of the first node
      * \param uSpeed speed of the second node
-     * \return the rx PSD
+     * \return the rx PSD, i.e., txPsd
      */
     Ptr<SpectrumValue> CalcBeamformingGain(
         Ptr<SpectrumValue> txPsd,
-        PhasedArrayModel::ComplexVector longTerm,
+        const PhasedArrayModel::ComplexVector& longTerm,
         Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
         Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
         const Vector& sSpeed,
         const Vector& uSpeed) const;
 
-    mutable std::unordered_map<uint64_t, Ptr<const LongTerm>>
-        m_longTermMap;                           //!< map containing the long term components
+    mutable std::vector<LongTermEntry>
+        m_longTermTable; //!< table containing the long term components, a power of 2 in size
+    mutable std::size_t m_longTermCount{0}; //!< number of tx-rx pairs in m_longTermTable
+    mutable std::unordered_map<uint64_t, Ptr<const DelayPhasors>>
+        m_delayPhasorsMap;                       //!< map containing the delay terms
     Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
 };
 } // namespace ns3
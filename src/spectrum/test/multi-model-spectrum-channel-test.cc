@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026 The 5G-LENA Lyapunov MAC scheduler contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/net-device.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("MultiModelSpectrumChannelTest");
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief A reception of a MultiModelSpectrumChannelTestPhy
+ */
+struct MultiModelSpectrumChannelTestRx
+{
+    Time m_time;               //!< Time of the reception
+    uint32_t m_receiver;       //!< Index of the receiver
+    std::vector<double> m_psd; //!< Received PSD
+};
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief SpectrumPhy that records the signals it receives
+ */
+class MultiModelSpectrumChannelTestPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     * \param index the index of the PHY
+     * \param model the RX SpectrumModel
+     * \param mobility the mobility model
+     * \param antenna the antenna
+     * \param rxs the record of the receptions
+     */
+    MultiModelSpectrumChannelTestPhy(uint32_t index,
+                                     Ptr<const SpectrumModel> model,
+                                     Ptr<MobilityModel> mobility,
+                                     Ptr<Object> antenna,
+                                     std::vector<MultiModelSpectrumChannelTestRx>* rxs)
+        : m_index(index),
+          m_model(model),
+          m_mobility(mobility),
+          m_antenna(antenna),
+          m_rxs(rxs)
+    {
+    }
+
+    void SetDevice(Ptr<NetDevice> d) override
+    {
+    }
+
+    Ptr<NetDevice> GetDevice() const override
+    {
+        return nullptr;
+    }
+
+    void SetMobility(Ptr<MobilityModel> m) override
+    {
+        m_mobility = m;
+    }
+
+    Ptr<MobilityModel> GetMobility() const override
+    {
+        return m_mobility;
+    }
+
+    void SetChannel(Ptr<SpectrumChannel> c) override
+    {
+    }
+
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override
+    {
+        return m_model;
+    }
+
+    Ptr<Object> GetAntenna() const override
+    {
+        return m_antenna;
+    }
+
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+        m_rxs->push_back({Simulator::Now(),
+                          m_index,
+                          std::vector<double>(params->psd->ConstValuesBegin(),
+                                              params->psd->ConstValuesEnd())});
+    }
+
+  protected:
+    void DoDispose() override
+    {
+        m_mobility = nullptr;
+        m_antenna = nullptr;
+        SpectrumPhy::DoDispose();
+    }
+
+  private:
+    uint32_t m_index;                                    //!< Index of the PHY
+    Ptr<const SpectrumModel> m_model;                    //!< RX SpectrumModel
+    Ptr<MobilityModel> m_mobility;                       //!< Mobility model
+    Ptr<Object> m_antenna;                               //!< Antenna
+    std::vector<MultiModelSpectrumChannelTestRx>* m_rxs; //!< Record of the receptions
+};
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check the receivers reached with the attribute NeighborLossDb.
+ *
+ * A transmitter sends two signals to receivers at different distances, one
+ * with no MobilityModel and one moving; the bound is the free-space loss at
+ * 100 m. Between the signals, a far receiver moves near the transmitter. The
+ * receivers within the bound, and only them, must receive the same signals
+ * as without the bound.
+ */
+class MultiModelSpectrumChannelNeighborTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    MultiModelSpectrumChannelNeighborTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the scenario
+     * \param neighborLossDb the value of the attribute NeighborLossDb of the channel
+     * \return the receptions
+     */
+    std::vector<MultiModelSpectrumChannelTestRx> Receive(double neighborLossDb);
+};
+
+MultiModelSpectrumChannelNeighborTestCase::MultiModelSpectrumChannelNeighborTestCase()
+    : TestCase("Receivers within NeighborLossDb")
+{
+}
+
+std::vector<MultiModelSpectrumChannelTestRx>
+MultiModelSpectrumChannelNeighborTestCase::Receive(double neighborLossDb)
+{
+    std::vector<double> freqs;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        freqs.push_back(2.0e9 + i * 180e3);
+    }
+    Ptr<SpectrumModel> model = Create<SpectrumModel>(freqs);
+
+    Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel>();
+    channel->SetAttribute("NeighborLossDb", DoubleValue(neighborLossDb));
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // The transmitter, four static receivers, one without MobilityModel, one moving
+    const std::vector<double> xs = {0, 20, 60, 140, 300, -80};
+    std::vector<MultiModelSpectrumChannelTestRx> rxs;
+    std::vector<Ptr<MultiModelSpectrumChannelTestPhy>> phys;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        Ptr<MobilityModel> mobility;
+        if (i < xs.size())
+        {
+            mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Vector(xs[i], 0, 1.5));
+        }
+        else if (i == 7)
+        {
+            Ptr<ConstantVelocityMobilityModel> moving =
+                CreateObject<ConstantVelocityMobilityModel>();
+            moving->SetPosition(Vector(500, 0, 1.5));
+            moving->SetVelocity(Vector(10, 0, 0));
+            mobility = moving;
+        }
+        phys.push_back(CreateObject<MultiModelSpectrumChannelTestPhy>(i,
+                                                                      model,
+                                                                      mobility,
+                                                                      nullptr,
+                                                                      &rxs));
+        channel->AddRx(phys.back());
+    }
+
+    for (uint32_t tx = 0; tx < 2; ++tx)
+    {
+        Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters>();
+        params->duration = MilliSeconds(1);
+        params->txPhy = phys[0];
+        params->psd = Create<SpectrumValue>(model);
+        *params->psd = 1e-9;
+        Simulator::Schedule(MilliSeconds(2 * tx),
+                            &MultiModelSpectrumChannel::StartTx,
+                            channel,
+                            params);
+    }
+    Simulator::Schedule(MilliSeconds(1),
+                        &MobilityModel::SetPosition,
+                        phys[4]->GetMobility(),
+                        Vector(50, 0, 1.5));
+
+    Simulator::Run();
+    Simulator::Destroy();
+    return rxs;
+}
+
+void
+MultiModelSpectrumChannelNeighborTestCase::DoRun()
+{
+    std::vector<MultiModelSpectrumChannelTestRx> all = Receive(1.0e9);
+    // free-space loss at 100 m, at the lower edge of the first band
+    const double neighborLossDb = 20 * std::log10(4 * M_PI * 100 * (2.0e9 - 90e3) / 299792458.0);
+    std::vector<MultiModelSpectrumChannelTestRx> neighbors = Receive(neighborLossDb);
+
+    const std::set<uint32_t> first = {1, 2, 5, 6, 7};
+    const std::set<uint32_t> second = {1, 2, 4, 5, 6, 7};
+    std::vector<MultiModelSpectrumChannelTestRx> expected;
+    for (const auto& rx : all)
+    {
+        const auto& reached = rx.m_time < MilliSeconds(1) ? first : second;
+        if (reached.count(rx.m_receiver))
+        {
+            expected.push_back(rx);
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(all.size(), 14, "Wrong number of receptions without NeighborLossDb");
+    NS_TEST_ASSERT_MSG_EQ(neighbors.size(), expected.size(), "Wrong number of receptions");
+    for (std::size_t i = 0; i < std::min(neighbors.size(), expected.size()); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(neighbors[i].m_time,
+                              expected[i].m_time,
+                              "Wrong time of reception " << i);
+        NS_TEST_ASSERT_MSG_EQ(neighbors[i].m_receiver,
+                              expected[i].m_receiver,
+                              "Wrong receiver of reception " << i);
+        NS_TEST_ASSERT_MSG_EQ((neighbors[i].m_psd == expected[i].m_psd),
+                              true,
+                              "Wrong PSD of reception " << i);
+    }
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief MultiModelSpectrumChannel TestSuite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+  public:
+    MultiModelSpectrumChannelTestSuite();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite()
+    : TestSuite("multi-model-spectrum-channel", UNIT)
+{
+    AddTestCase(new MultiModelSpectrumChannelNeighborTestCase(), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite;